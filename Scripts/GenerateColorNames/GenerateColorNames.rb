@@ -0,0 +1,318 @@
+# Generates XULWin/src/ColorNames.cpp: a perfect hash table of the CSS
+# color names.
+#
+# Run from the solution directory: ruby Scripts/GenerateColorNames/GenerateColorNames.rb
+#
+# Lookup hashes the name twice. The first hash selects a bucket, the
+# second one, seeded with the seed of that bucket, selects the slot. The
+# seeds are chosen so that no two names share a slot.
+
+$debugLoggingEnabled = true
+
+def logDebug(msg)
+  puts msg if $debugLoggingEnabled
+end
+
+def getSolutionDir
+  "."
+end
+
+def getOutputFileName
+  File.join(getSolutionDir, "XULWin", "src", "ColorNames.cpp")
+end
+
+$numBuckets = 64
+$numSlots = 256
+
+$colors = [
+  ["aliceblue", 0xF0F8FF],
+  ["antiquewhite", 0xFAEBD7],
+  ["aqua", 0x00FFFF],
+  ["aquamarine", 0x7FFFD4],
+  ["azure", 0xF0FFFF],
+  ["beige", 0xF5F5DC],
+  ["bisque", 0xFFE4C4],
+  ["black", 0x000000],
+  ["blanchedalmond", 0xFFEBCD],
+  ["blue", 0x0000FF],
+  ["blueviolet", 0x8A2BE2],
+  ["brown", 0xA52A2A],
+  ["burlywood", 0xDEB887],
+  ["cadetblue", 0x5F9EA0],
+  ["chartreuse", 0x7FFF00],
+  ["chocolate", 0xD2691E],
+  ["coral", 0xFF7F50],
+  ["cornflowerblue", 0x6495ED],
+  ["cornsilk", 0xFFF8DC],
+  ["crimson", 0xDC143C],
+  ["cyan", 0x00FFFF],
+  ["darkblue", 0x00008B],
+  ["darkcyan", 0x008B8B],
+  ["darkgoldenrod", 0xB8860B],
+  ["darkgray", 0xA9A9A9],
+  ["darkgreen", 0x006400],
+  ["darkkhaki", 0xBDB76B],
+  ["darkmagenta", 0x8B008B],
+  ["darkolivegreen", 0x556B2F],
+  ["darkorange", 0xFF8C00],
+  ["darkorchid", 0x9932CC],
+  ["darkred", 0x8B0000],
+  ["darksalmon", 0xE9967A],
+  ["darkseagreen", 0x8FBC8F],
+  ["darkslateblue", 0x483D8B],
+  ["darkslategray", 0x2F4F4F],
+  ["darkturquoise", 0x00CED1],
+  ["darkviolet", 0x9400D3],
+  ["deeppink", 0xFF1493],
+  ["deepskyblue", 0x00BFFF],
+  ["dimgray", 0x696969],
+  ["dodgerblue", 0x1E90FF],
+  ["firebrick", 0xB22222],
+  ["floralwhite", 0xFFFAF0],
+  ["forestgreen", 0x228B22],
+  ["fuchsia", 0xFF00FF],
+  ["gainsboro", 0xDCDCDC],
+  ["ghostwhite", 0xF8F8FF],
+  ["gold", 0xFFD700],
+  ["goldenrod", 0xDAA520],
+  ["gray", 0x808080],
+  ["green", 0x008000],
+  ["greenyellow", 0xADFF2F],
+  ["honeydew", 0xF0FFF0],
+  ["hotpink", 0xFF69B4],
+  ["indianred", 0xCD5C5C],
+  ["indigo", 0x4B0082],
+  ["ivory", 0xFFFFF0],
+  ["khaki", 0xF0E68C],
+  ["lavender", 0xE6E6FA],
+  ["lavenderblush", 0xFFF0F5],
+  ["lawngreen", 0x7CFC00],
+  ["lemonchiffon", 0xFFFACD],
+  ["lightblue", 0xADD8E6],
+  ["lightcoral", 0xF08080],
+  ["lightcyan", 0xE0FFFF],
+  ["lightgoldenrodyellow", 0xFAFAD2],
+  ["lightgrey", 0xD3D3D3],
+  ["lightgreen", 0x90EE90],
+  ["lightpink", 0xFFB6C1],
+  ["lightsalmon", 0xFFA07A],
+  ["lightseagreen", 0x20B2AA],
+  ["lightskyblue", 0x87CEFA],
+  ["lightslategray", 0x778899],
+  ["lightsteelblue", 0xB0C4DE],
+  ["lightyellow", 0xFFFFE0],
+  ["lime", 0x00FF00],
+  ["limegreen", 0x32CD32],
+  ["linen", 0xFAF0E6],
+  ["magenta", 0xFF00FF],
+  ["maroon", 0x800000],
+  ["mediumaquamarine", 0x66CDAA],
+  ["mediumblue", 0x0000CD],
+  ["mediumorchid", 0xBA55D3],
+  ["mediumpurple", 0x9370D8],
+  ["mediumseagreen", 0x3CB371],
+  ["mediumslateblue", 0x7B68EE],
+  ["mediumspringgreen", 0x00FA9A],
+  ["mediumturquoise", 0x48D1CC],
+  ["mediumvioletred", 0xC71585],
+  ["midnightblue", 0x191970],
+  ["mintcream", 0xF5FFFA],
+  ["mistyrose", 0xFFE4E1],
+  ["moccasin", 0xFFE4B5],
+  ["navajowhite", 0xFFDEAD],
+  ["navy", 0x000080],
+  ["oldlace", 0xFDF5E6],
+  ["olive", 0x808000],
+  ["olivedrab", 0x6B8E23],
+  ["orange", 0xFFA500],
+  ["orangered", 0xFF4500],
+  ["orchid", 0xDA70D6],
+  ["palegoldenrod", 0xEEE8AA],
+  ["palegreen", 0x98FB98],
+  ["paleturquoise", 0xAFEEEE],
+  ["palevioletred", 0xD87093],
+  ["papayawhip", 0xFFEFD5],
+  ["peachpuff", 0xFFDAB9],
+  ["peru", 0xCD853F],
+  ["pink", 0xFFC0CB],
+  ["plum", 0xDDA0DD],
+  ["powderblue", 0xB0E0E6],
+  ["purple", 0x800080],
+  ["red", 0xFF0000],
+  ["rosybrown", 0xBC8F8F],
+  ["royalblue", 0x4169E1],
+  ["saddlebrown", 0x8B4513],
+  ["salmon", 0xFA8072],
+  ["sandybrown", 0xF4A460],
+  ["seagreen", 0x2E8B57],
+  ["seashell", 0xFFF5EE],
+  ["sienna", 0xA0522D],
+  ["silver", 0xC0C0C0],
+  ["skyblue", 0x87CEEB],
+  ["slateblue", 0x6A5ACD],
+  ["slategray", 0x708090],
+  ["snow", 0xFFFAFA],
+  ["springgreen", 0x00FF7F],
+  ["steelblue", 0x4682B4],
+  ["tan", 0xD2B48C],
+  ["teal", 0x008080],
+  ["thistle", 0xD8BFD8],
+  ["tomato", 0xFF6347],
+  ["turquoise", 0x40E0D0],
+  ["violet", 0xEE82EE],
+  ["wheat", 0xF5DEB3],
+  ["white", 0xFFFFFF],
+  ["whitesmoke", 0xF5F5F5],
+  ["yellow", 0xFFFF00],
+  ["yellowgreen", 0x9ACD32],
+]
+
+# Must match Hash in the generated code: FNV-1a over the lowercase
+# characters, followed by a mixing step because the low bits of FNV are
+# weak.
+def hash(seed, name)
+  result = 2166136261 ^ seed
+  name.each_byte do |c|
+    result = ((result ^ c) * 16777619) & 0xFFFFFFFF
+  end
+  result ^= result >> 16
+  result = (result * 0x85EBCA6B) & 0xFFFFFFFF
+  result ^= result >> 13
+  result
+end
+
+def findSeeds
+  buckets = Array.new($numBuckets) { [] }
+  $colors.each do |color|
+    buckets[hash(0, color[0]) % $numBuckets] << color
+  end
+
+  # Place the largest buckets first, while most slots are free.
+  slots = Array.new($numSlots)
+  seeds = Array.new($numBuckets, 0)
+  order = (0...$numBuckets).sort_by { |bucket| [-buckets[bucket].size, bucket] }
+  order.each do |bucket|
+    next if buckets[bucket].empty?
+    seed = 1
+    loop do
+      positions = buckets[bucket].map { |color| hash(seed, color[0]) % $numSlots }
+      if positions.uniq.size == positions.size && positions.all? { |position| slots[position].nil? }
+        positions.each_with_index { |position, idx| slots[position] = buckets[bucket][idx] }
+        seeds[bucket] = seed
+        break
+      end
+      seed += 1
+    end
+  end
+  return seeds, slots
+end
+
+def formatSeeds(seeds)
+  seeds.each_slice(8).map { |slice| "            " + slice.map { |seed| seed.to_s }.join(", ") }.join(",\n")
+end
+
+def formatSlots(slots)
+  slots.map do |color|
+    if color
+      "            { \"#{color[0]}\", #{color[0].size}, 0x%06X }" % color[1]
+    else
+      "            { 0, 0, 0 }"
+    end
+  end.join(",\n")
+end
+
+def generate
+  seeds, slots = findSeeds
+  minLength = $colors.map { |color| color[0].size }.min
+  maxLength = $colors.map { |color| color[0].size }.max
+  code = <<CODE
+// Generated by Scripts/GenerateColorNames/GenerateColorNames.rb. Do not edit.
+#include "XULWin/ColorNames.h"
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        struct ColorName
+        {
+            const char * name;
+            unsigned int length;
+            unsigned int rgb;
+        };
+
+        const unsigned int cNumBuckets = #{$numBuckets};
+        const unsigned int cNumSlots = #{$numSlots};
+        const unsigned int cMinLength = #{minLength};
+        const unsigned int cMaxLength = #{maxLength};
+
+        // Seed of the slot hash, for each bucket.
+        const unsigned int cSeeds[cNumBuckets] =
+        {
+#{formatSeeds(seeds)}
+        };
+
+        const ColorName cColorNames[cNumSlots] =
+        {
+#{formatSlots(slots)}
+        };
+
+
+        char ToLower(char inChar)
+        {
+            return (inChar >= 'A' && inChar <= 'Z') ? static_cast<char>(inChar - 'A' + 'a') : inChar;
+        }
+
+
+        unsigned int Hash(unsigned int inSeed, const char * inBegin, const char * inEnd)
+        {
+            unsigned int result = 2166136261u ^ inSeed;
+            for (const char * it = inBegin; it != inEnd; ++it)
+            {
+                result = (result ^ static_cast<unsigned char>(ToLower(*it))) * 16777619u;
+            }
+            result ^= result >> 16;
+            result *= 0x85EBCA6Bu;
+            result ^= result >> 13;
+            return result;
+        }
+
+    }
+
+
+    bool FindColorName(const char * inBegin, const char * inEnd, RGBColor & outColor)
+    {
+        unsigned int length = static_cast<unsigned int>(inEnd - inBegin);
+        if (length < cMinLength || length > cMaxLength)
+        {
+            return false;
+        }
+
+        unsigned int seed = cSeeds[Hash(0, inBegin, inEnd) % cNumBuckets];
+        const ColorName & entry = cColorNames[Hash(seed, inBegin, inEnd) % cNumSlots];
+        if (!entry.name || entry.length != length)
+        {
+            return false;
+        }
+
+        for (unsigned int idx = 0; idx != length; ++idx)
+        {
+            if (ToLower(inBegin[idx]) != entry.name[idx])
+            {
+                return false;
+            }
+        }
+
+        outColor = RGBColor((entry.rgb >> 16) & 0xFF, (entry.rgb >> 8) & 0xFF, entry.rgb & 0xFF);
+        return true;
+    }
+
+} // namespace XULWin
+CODE
+  File.open(getOutputFileName, "wb") { |file| file.write(code.gsub(/\r?\n/, "\r\n")) }
+  logDebug "Wrote #{$colors.size} colors to #{getOutputFileName}"
+end
+
+generate
@@ -0,0 +1,94 @@
+#!/bin/sh
+# Title:
+# Run Portable Tests
+#
+# Purpose:
+# Builds and runs the tests that don't need Windows (see Test/PortableTests.cpp)
+# with g++ on Linux or another POSIX system. They cover the layout managers, the
+# headless layout, the layout snapshots of the xulrunnersamples, SVG path data,
+# the rendering of the svg sample, the compositing kernels and the measuring of
+# virtualized containers.
+#
+# Args:
+# --bench  Optional. Also runs the benchmarks (see RunPortableBenchmarks in
+#          Test/PortableTests.h) after the tests and prints their reports.
+# $1       Build directory, defaults to _portable_build in the root dir.
+#
+# Environment:
+# CXX, CC           The compilers, default g++ and gcc.
+# XULWIN_CXXFLAGS   Extra flags, for example "-fsanitize=address,undefined -g".
+# JOBS              Number of parallel compile jobs, defaults to nproc.
+#
+# Algorithm:
+# Compile the Poco Foundation and XML sources from 3rdParty into libpoco.a, once.
+# Compile the portable XULWin sources and the portable tests.
+# Link PortableTestMain and run it on the xulrunnersamples directory, with
+# --bench if it was given.
+# The exit code is non-zero if a test failed.
+#
+# Regenerating the layout golden files:
+# A sample whose layout changed gets a <name>-layout.txt next to its
+# <name>-layout-golden.txt. Check the reported deltas, then accept them with
+#   for f in xulrunnersamples/*/*-layout.txt; do mv "$f" "${f%.txt}-golden.txt"; done
+# and run the tests again.
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+BENCH=
+if [ "$1" = "--bench" ]; then
+    BENCH=--bench
+    shift
+fi
+BUILD=${1:-$ROOT/_portable_build}
+CXX=${CXX:-g++}
+CC=${CC:-gcc}
+JOBS=${JOBS:-$(nproc 2>/dev/null || echo 1)}
+POCO=$ROOT/3rdParty/Poco
+
+XULWIN_SOURCES="ColorNames Compositing Conversions ErrorReporter HSVColor HeadlessLayout
+    Layout LayoutSnapshot ListModel RGBColor StyleDeclarations SVGPathGeometry
+    SVGPathInstructions SVGRasterizer SVGShape Size TextMetrics Unicode UniqueId Viewport"
+TEST_SOURCES="UnitTest PortableTests PortableTestMain CompositingTest HeadlessLayoutTest
+    LayoutSnapshotTest LayoutTest ListModelTest PixelGenerator SVGPathTest SVGRenderTest
+    SVGSample ViewportTest AllocationCounter Benchmark CompositingBenchmark
+    HeadlessLayoutBenchmark HeadlessParserBenchmark SVGRenderBenchmark"
+
+DEFINES="-DXML_STATIC -DXML_NS -DXML_DTD -DHAVE_EXPAT_CONFIG_H"
+INCLUDES="-I$ROOT/XULWin/include -I$POCO/Foundation/include -I$POCO/XML/include"
+CXXFLAGS="-std=gnu++98 -O2 $DEFINES $INCLUDES $XULWIN_CXXFLAGS"
+CFLAGS="-O2 $DEFINES $INCLUDES $XULWIN_CXXFLAGS"
+
+mkdir -p "$BUILD/poco" "$BUILD/xulwin"
+
+# Writes the compile command of each source file, with the object file in
+# the directory $1.
+compile_commands()
+{
+    dir=$1
+    shift
+    for src in "$@"; do
+        obj=$dir/$(basename "$(dirname "$src")")-$(basename "$src").o
+        case $src in
+            *.c) echo "$CC $CFLAGS -c $src -o $obj" ;;
+            *) echo "$CXX $CXXFLAGS -c $src -o $obj" ;;
+        esac
+    done
+}
+
+if [ ! -f "$BUILD/poco/libpoco.a" ]; then
+    # The platform specific files are included by the generic ones.
+    POCO_SOURCES=$(ls "$POCO"/Foundation/src/*.cpp "$POCO"/Foundation/src/*.c "$POCO"/XML/src/*.cpp "$POCO"/XML/src/*.c |
+        grep -v -E '_(WIN32|WIN32U|WINCE|UNIX|POSIX|VMS|VX|C99|DEC|DUMMY|STD|QNX|SUN|HPUX)\.cpp$' |
+        grep -v -E '/(EventLogChannel|OpcomChannel|WindowsConsoleChannel)\.cpp$')
+    compile_commands "$BUILD/poco" $POCO_SOURCES | sed 's/ -c / -w -c /' | xargs -P "$JOBS" -I{} sh -c {}
+    ar rcs "$BUILD/poco/libpoco.a" "$BUILD"/poco/*.o
+fi
+
+XULWIN_FILES=""
+for name in $XULWIN_SOURCES; do XULWIN_FILES="$XULWIN_FILES $ROOT/XULWin/src/$name.cpp"; done
+TEST_FILES=""
+for name in $TEST_SOURCES; do TEST_FILES="$TEST_FILES $ROOT/Test/$name.cpp"; done
+compile_commands "$BUILD/xulwin" $XULWIN_FILES $TEST_FILES | xargs -P "$JOBS" -I{} sh -c {}
+
+$CXX $CXXFLAGS -o "$BUILD/PortableTests" "$BUILD"/xulwin/*.o "$BUILD/poco/libpoco.a" -lpthread -ldl
+"$BUILD/PortableTests" $BENCH "$ROOT/xulrunnersamples"
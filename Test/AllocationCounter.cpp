@@ -0,0 +1,166 @@
+#include "AllocationCounter.h"
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+
+namespace XULWin
+{
+
+    AllocationCounter * AllocationCounter::sActive = 0;
+
+
+    AllocationCounter::AllocationCounter() :
+        mNumAllocations(0),
+        mCurrentBytes(0),
+        mPeakBytes(0)
+    {
+        assert(!sActive);
+        sActive = this;
+    }
+
+
+    AllocationCounter::~AllocationCounter()
+    {
+        sActive = 0;
+    }
+
+
+    size_t AllocationCounter::numAllocations() const
+    {
+        return mNumAllocations;
+    }
+
+
+    size_t AllocationCounter::peakBytes() const
+    {
+        return static_cast<size_t>(mPeakBytes);
+    }
+
+
+    void AllocationCounter::OnAllocated(size_t inSize)
+    {
+        if (!sActive)
+        {
+            return;
+        }
+
+        sActive->mNumAllocations++;
+        sActive->mCurrentBytes += static_cast<ptrdiff_t>(inSize);
+        if (sActive->mCurrentBytes > sActive->mPeakBytes)
+        {
+            sActive->mPeakBytes = sActive->mCurrentBytes;
+        }
+    }
+
+
+    void AllocationCounter::OnFreed(size_t inSize)
+    {
+        // Can become negative if memory that was allocated earlier is freed.
+        if (sActive)
+        {
+            sActive->mCurrentBytes -= static_cast<ptrdiff_t>(inSize);
+        }
+    }
+
+
+} // namespace XULWin
+
+
+namespace
+{
+
+    // Stored in front of every block so that delete knows its size. The
+    // padding keeps the block as aligned as malloc's result, which the SSE2
+    // code relies on.
+    union BlockHeader
+    {
+        size_t size;
+        char padding[16];
+    };
+
+
+    void * Allocate(size_t inSize)
+    {
+        if (inSize > static_cast<size_t>(-1) - sizeof(BlockHeader))
+        {
+            return 0;
+        }
+
+        BlockHeader * header = static_cast<BlockHeader *>(std::malloc(sizeof(BlockHeader) + inSize));
+        if (!header)
+        {
+            return 0;
+        }
+        header->size = inSize;
+        XULWin::AllocationCounter::OnAllocated(inSize);
+        return header + 1;
+    }
+
+
+    void Free(void * inData)
+    {
+        if (!inData)
+        {
+            return;
+        }
+
+        BlockHeader * header = static_cast<BlockHeader *>(inData) - 1;
+        XULWin::AllocationCounter::OnFreed(header->size);
+        std::free(header);
+    }
+
+} // anonymous namespace
+
+
+void * operator new(size_t inSize) throw(std::bad_alloc)
+{
+    void * result = Allocate(inSize);
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+
+void * operator new[](size_t inSize) throw(std::bad_alloc)
+{
+    return operator new(inSize);
+}
+
+
+void * operator new(size_t inSize, const std::nothrow_t &) throw()
+{
+    return Allocate(inSize);
+}
+
+
+void * operator new[](size_t inSize, const std::nothrow_t &) throw()
+{
+    return Allocate(inSize);
+}
+
+
+void operator delete(void * inData) throw()
+{
+    Free(inData);
+}
+
+
+void operator delete[](void * inData) throw()
+{
+    Free(inData);
+}
+
+
+void operator delete(void * inData, const std::nothrow_t &) throw()
+{
+    Free(inData);
+}
+
+
+void operator delete[](void * inData, const std::nothrow_t &) throw()
+{
+    Free(inData);
+}
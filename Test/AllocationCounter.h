@@ -0,0 +1,56 @@
+#ifndef ALLOCATIONCOUNTER_H_INCLUDED
+#define ALLOCATIONCOUNTER_H_INCLUDED
+
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+
+
+namespace XULWin
+{
+
+    /**
+     * AllocationCounter counts the heap allocations that are made during
+     * its lifetime and keeps track of the high-water mark of the allocated
+     * bytes.
+     *
+     * The Test program replaces the global operator new and delete (see
+     * AllocationCounter.cpp), so the counts are available in debug and
+     * release builds. Memory that is allocated with malloc, like the buffers
+     * of the bundled expat parser, is not counted. The counter is process
+     * wide: allocations on other threads are counted as well. Only one
+     * counter can be active at a time.
+     */
+    class AllocationCounter : boost::noncopyable
+    {
+    public:
+        AllocationCounter();
+
+        ~AllocationCounter();
+
+        size_t numAllocations() const;
+
+        /**
+         * Returns the highest number of bytes that were allocated at the same
+         * time, not counting the memory that was allocated before the counter
+         * was created.
+         */
+        size_t peakBytes() const;
+
+        // Called by the replaced operator new and delete.
+        static void OnAllocated(size_t inSize);
+
+        static void OnFreed(size_t inSize);
+
+    private:
+        static AllocationCounter * sActive;
+        size_t mNumAllocations;
+        ptrdiff_t mCurrentBytes;
+        ptrdiff_t mPeakBytes;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // ALLOCATIONCOUNTER_H_INCLUDED
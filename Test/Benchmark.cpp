@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include "Poco/Stopwatch.h"
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    Benchmark::Result::Result() :
+        seconds(0),
+        numAllocations(0)
+    {
+    }
+
+
+    Benchmark::Benchmark(const std::string & inName) :
+        mName(inName)
+    {
+    }
+
+
+    Benchmark::~Benchmark()
+    {
+    }
+
+
+    const std::string & Benchmark::name() const
+    {
+        return mName;
+    }
+
+
+    std::string Benchmark::run()
+    {
+        measure();
+        return report();
+    }
+
+
+    double Benchmark::GetSeconds(const Poco::Stopwatch & inStopwatch)
+    {
+        return inStopwatch.elapsed() / 1000000.0;
+    }
+
+
+    std::string Benchmark::GetSyntheticXUL(size_t inNumElements)
+    {
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\"?>\n";
+        ss << "<window xmlns=\"http://www.mozilla.org/keymaster/gatekeeper/there.is.only.xul\" title=\"Synthetic\">\n";
+        for (size_t idx = 1; idx + 4 <= inNumElements; idx += 4)
+        {
+            ss << "  <vbox flex=\"1\">\n";
+            ss << "    <hbox align=\"center\">\n";
+            ss << "      <label id=\"label" << idx << "\" value=\"Label " << idx << "\" style=\"width: 80px; color: #333333\"/>\n";
+            ss << "      <description>Description text " << idx << "</description>\n";
+            ss << "    </hbox>\n";
+            ss << "  </vbox>\n";
+        }
+        ss << "</window>\n";
+        return ss.str();
+    }
+
+
+} // namespace XULWin
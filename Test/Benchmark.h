@@ -0,0 +1,74 @@
+#ifndef BENCHMARK_H_INCLUDED
+#define BENCHMARK_H_INCLUDED
+
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace Poco
+{
+    class Stopwatch;
+}
+
+
+namespace XULWin
+{
+
+    /**
+     * Base class of the benchmarks.
+     *
+     * A benchmark only measures and reports. It doesn't check results:
+     * that is the job of the UnitTest classes, which fail even if nobody
+     * reads the timing report.
+     */
+    class Benchmark : boost::noncopyable
+    {
+    public:
+        /**
+         * The measurements that all benchmarks have in common. The
+         * benchmarks extend it with their own counters.
+         */
+        struct Result
+        {
+            Result();
+
+            std::string name;
+            double seconds;
+
+            // Counted with an AllocationCounter.
+            size_t numAllocations;
+        };
+
+        Benchmark(const std::string & inName);
+
+        virtual ~Benchmark();
+
+        const std::string & name() const;
+
+        /**
+         * Runs the measurements and returns the report.
+         */
+        std::string run();
+
+    protected:
+        virtual void measure() = 0;
+
+        virtual std::string report() const = 0;
+
+        static double GetSeconds(const Poco::Stopwatch & inStopwatch);
+
+        // Creates a XUL document with approximately the requested number of
+        // elements.
+        static std::string GetSyntheticXUL(size_t inNumElements);
+
+    private:
+        std::string mName;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // BENCHMARK_H_INCLUDED
@@ -0,0 +1,186 @@
+#include "CompiledXULTest.h"
+#include "XULWin/CompiledXUL.h"
+#include "Poco/File.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Timestamp.h"
+#include <fstream>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    static const char * cLocale = "en-US";
+
+
+    static bool ReadFile(const std::string & inPath, std::string & outContents)
+    {
+        std::ifstream file(inPath.c_str(), std::ios::in | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        std::stringstream ss;
+        ss << file.rdbuf();
+        outContents = ss.str();
+        return true;
+    }
+
+
+    static bool WriteFile(const std::string & inPath, const std::string & inContents)
+    {
+        std::ofstream file(inPath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << inContents;
+        return file.good();
+    }
+
+
+    // Records a small document that depends on inXULPath.
+    static void Compile(const std::string & inXULPath, CompiledXUL & outCompiledXUL)
+    {
+        outCompiledXUL.setLocale(cLocale);
+        outCompiledXUL.addDependency(inXULPath);
+
+        AttributesMapping windowAttributes;
+        windowAttributes["id"] = "main";
+        windowAttributes["title"] = "Compiled";
+        outCompiledXUL.startElement("window", windowAttributes);
+
+        AttributesMapping buttonAttributes;
+        buttonAttributes["label"] = "OK";
+        buttonAttributes["id"] = "ok";
+        outCompiledXUL.startElement("button", buttonAttributes);
+        outCompiledXUL.endElement();
+
+        outCompiledXUL.startElement("description", AttributesMapping());
+        outCompiledXUL.setInnerText("Compiled");
+        outCompiledXUL.endElement();
+
+        outCompiledXUL.endElement();
+    }
+
+
+    CompiledXULTest::CompiledXULTest() :
+        UnitTest("CompiledXUL")
+    {
+    }
+
+
+    void CompiledXULTest::runTestCases()
+    {
+        Poco::TemporaryFile xulFile;
+        Poco::TemporaryFile compiledFile;
+        mXULPath = xulFile.path();
+        mCompiledPath = compiledFile.path();
+        if (!expect(WriteFile(mXULPath, "<window id=\"main\"/>"), "can't write " + mXULPath))
+        {
+            return;
+        }
+
+        testRoundTrip();
+        testCorruptFiles();
+    }
+
+
+    void CompiledXULTest::testRoundTrip()
+    {
+        CompiledXUL compiled;
+        Compile(mXULPath, compiled);
+        expect(compiled.isValid(), "the compiled document is not valid");
+        if (!expect(compiled.save(mCompiledPath), "can't save " + mCompiledPath))
+        {
+            return;
+        }
+
+        std::string saved;
+        ReadFile(mCompiledPath, saved);
+        {
+            // Loading and saving again gives the same file.
+            CompiledXUL loaded;
+            expect(loaded.load(mCompiledPath, cLocale), "can't load the saved file");
+            expect(!loaded.needsSave(), "needsSave after loading an up to date file");
+            Poco::TemporaryFile copyFile;
+            std::string copy;
+            expect(loaded.save(copyFile.path()) && ReadFile(copyFile.path(), copy) && copy == saved,
+                   "saving the loaded document gives a different file");
+        }
+
+        expect(!CompiledXUL().load(mCompiledPath, "nl-BE"), "loaded the file for another locale");
+
+        // Touching the XUL file doesn't invalidate the compiled file. Saving
+        // it again records the new modification time.
+        Poco::File xulFile(mXULPath);
+        xulFile.setLastModified(xulFile.getLastModified() - 10 * Poco::Timestamp::resolution());
+        {
+            CompiledXUL loaded;
+            expect(loaded.load(mCompiledPath, cLocale), "can't load the file after touching the XUL file");
+            expect(loaded.needsSave(), "no needsSave after touching the XUL file");
+            expect(loaded.save(mCompiledPath), "can't save the touched file");
+        }
+        {
+            CompiledXUL loaded;
+            expect(loaded.load(mCompiledPath, cLocale) && !loaded.needsSave(),
+                   "the new modification time was not saved");
+        }
+
+        // Changing the XUL file does.
+        WriteFile(mXULPath, "<window id=\"other\"/>");
+        expect(!CompiledXUL().load(mCompiledPath, cLocale), "loaded the file after changing the XUL file");
+        WriteFile(mXULPath, "<window id=\"main\"/>");
+    }
+
+
+    void CompiledXULTest::testCorruptFiles()
+    {
+        CompiledXUL compiled;
+        Compile(mXULPath, compiled);
+        std::string saved;
+        if (!expect(compiled.save(mCompiledPath) && ReadFile(mCompiledPath, saved), "can't save " + mCompiledPath))
+        {
+            return;
+        }
+
+        // Every truncated file is rejected.
+        for (size_t size = 0; size != saved.size(); ++size)
+        {
+            std::stringstream ss;
+            ss << "loaded the file truncated to " << size << " bytes";
+            WriteFile(mCompiledPath, saved.substr(0, size));
+            expect(!load(mCompiledPath, ss.str()), ss.str());
+        }
+
+        // Huge counts, lengths and indices at every position neither crash
+        // nor throw.
+        for (size_t pos = 0; pos + 4 <= saved.size(); ++pos)
+        {
+            std::string corrupt = saved;
+            corrupt.replace(pos, 4, "\xFF\xFF\xFF\x7F");
+            std::stringstream ss;
+            ss << "0x7FFFFFFF at byte " << pos;
+            WriteFile(mCompiledPath, corrupt);
+            load(mCompiledPath, ss.str());
+        }
+
+        // Sanity check: the original file still loads.
+        WriteFile(mCompiledPath, saved);
+        expect(load(mCompiledPath, "original"), "can't load the original file");
+    }
+
+
+    bool CompiledXULTest::load(const std::string & inPath, const std::string & inDescription)
+    {
+        try
+        {
+            CompiledXUL compiled;
+            return compiled.load(inPath, cLocale);
+        }
+        catch (const std::exception & exc)
+        {
+            expect(false, "load threw for " + inDescription + ": " + exc.what());
+            return false;
+        }
+    }
+
+
+} // namespace XULWin
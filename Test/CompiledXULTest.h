@@ -0,0 +1,41 @@
+#ifndef COMPILEDXULTEST_H_INCLUDED
+#define COMPILEDXULTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+#include <string>
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests saving and loading of CompiledXUL files, and that corrupt files
+     * are rejected instead of crashing or throwing. Only temporary files
+     * are written.
+     */
+    class CompiledXULTest : public UnitTest
+    {
+    public:
+        CompiledXULTest();
+
+    protected:
+        virtual void runTestCases();
+
+    private:
+        void testRoundTrip();
+
+        void testCorruptFiles();
+
+        // Loads the file and reports an exception as a failure.
+        bool load(const std::string & inPath, const std::string & inDescription);
+
+        std::string mXULPath;
+        std::string mCompiledPath;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // COMPILEDXULTEST_H_INCLUDED
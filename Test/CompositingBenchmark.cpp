@@ -0,0 +1,172 @@
+#include "CompositingBenchmark.h"
+#include "PixelGenerator.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // A row of a typical window: wide enough to leave the caches warm
+        // but not to make the loop overhead matter.
+        const int cRowWidth = 1024;
+
+        const int cSourceWidth = 640;
+        const int cSourceHeight = 480;
+        const int cScaledWidth = 1000;
+        const int cScaledHeight = 750;
+
+
+        const char * GetName(CompositingKernelSet inKernelSet)
+        {
+            return inKernelSet == CompositingKernelSet_SSE2 ? "SSE2" : "scalar";
+        }
+
+
+        // Each functor runs one kernel over its destination buffer and
+        // returns the number of pixels written.
+        struct FillSpanPass
+        {
+            FillSpanPass(const CompositingKernels & inKernels, const std::vector<unsigned char> & inCoverage, unsigned int inColor, std::vector<unsigned int> & ioPixels) :
+                mKernels(inKernels), mCoverage(inCoverage), mColor(inColor), mPixels(ioPixels) {}
+            size_t operator()() const { mKernels.fillSpan(&mPixels[0], &mCoverage[0], cRowWidth, mColor); return cRowWidth; }
+            const CompositingKernels & mKernels;
+            const std::vector<unsigned char> & mCoverage;
+            unsigned int mColor;
+            std::vector<unsigned int> & mPixels;
+        };
+
+
+        struct BlendRowPass
+        {
+            BlendRowPass(const CompositingKernels & inKernels, const std::vector<unsigned int> & inSource, std::vector<unsigned int> & ioPixels) :
+                mKernels(inKernels), mSource(inSource), mPixels(ioPixels) {}
+            size_t operator()() const { mKernels.blendRow(&mPixels[0], &mSource[0], cRowWidth); return cRowWidth; }
+            const CompositingKernels & mKernels;
+            const std::vector<unsigned int> & mSource;
+            std::vector<unsigned int> & mPixels;
+        };
+
+
+        struct ScaleImagePass
+        {
+            ScaleImagePass(const CompositingKernels & inKernels, const std::vector<unsigned int> & inSource, std::vector<unsigned int> & outPixels) :
+                mKernels(inKernels), mSource(inSource), mPixels(outPixels) {}
+            size_t operator()() const
+            {
+                ScaleImageBilinear(mKernels, &mSource[0], cSourceWidth, cSourceHeight, cSourceWidth,
+                                   &mPixels[0], cScaledWidth, cScaledHeight, cScaledWidth);
+                return cScaledWidth * cScaledHeight;
+            }
+            const CompositingKernels & mKernels;
+            const std::vector<unsigned int> & mSource;
+            std::vector<unsigned int> & mPixels;
+        };
+
+    }
+
+
+    CompositingBenchmark::Result::Result() :
+        kernelSet(CompositingKernelSet_Scalar),
+        numPixels(0)
+    {
+    }
+
+
+    CompositingBenchmark::CompositingBenchmark(size_t inNumIterations) :
+        Benchmark("Compositing benchmark"),
+        mNumIterations(inNumIterations)
+    {
+    }
+
+
+    template<class Functor>
+    void CompositingBenchmark::benchmark(const std::string & inName, CompositingKernelSet inKernelSet, size_t inNumIterations, Functor inFunctor)
+    {
+        Result result;
+        result.name = inName;
+        result.kernelSet = inKernelSet;
+
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        for (size_t idx = 0; idx != inNumIterations; ++idx)
+        {
+            result.numPixels += inFunctor();
+        }
+        stopwatch.stop();
+
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+    }
+
+
+    void CompositingBenchmark::measure()
+    {
+        PixelGenerator generator;
+        std::vector<unsigned char> coverage;
+        generator.getCoverage(cRowWidth, coverage);
+        std::vector<unsigned int> background;
+        generator.getPixels(cRowWidth, background);
+        std::vector<unsigned int> source;
+        generator.getPixels(cRowWidth, source);
+        std::vector<unsigned int> image;
+        generator.getPixels(cSourceWidth * cSourceHeight, image);
+        unsigned int color = 0xC0604020;
+
+        CompositingKernelSet kernelSets[] = { CompositingKernelSet_Scalar, CompositingKernelSet_SSE2 };
+        for (size_t idx = 0; idx != sizeof(kernelSets) / sizeof(kernelSets[0]); ++idx)
+        {
+            CompositingKernelSet kernelSet = kernelSets[idx];
+            if (!IsCompositingKernelSetSupported(kernelSet))
+            {
+                continue;
+            }
+
+            const CompositingKernels & kernels = GetCompositingKernels(kernelSet);
+            std::vector<unsigned int> fill(background);
+            benchmark("Fill span with coverage", kernelSet, mNumIterations, FillSpanPass(kernels, coverage, color, fill));
+
+            std::vector<unsigned int> blend(background);
+            benchmark("Blend premultiplied row", kernelSet, mNumIterations, BlendRowPass(kernels, source, blend));
+
+            // A scaled image has about a thousand times the pixels of a row.
+            std::vector<unsigned int> scale(cScaledWidth * cScaledHeight);
+            benchmark("Bilinear scaling", kernelSet, mNumIterations / 1000 + 1, ScaleImagePass(kernels, image, scale));
+        }
+    }
+
+
+    std::string CompositingBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double megapixels = r.numPixels / 1000000.0;
+            ss << r.name << " (" << GetName(r.kernelSet) << "): "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.seconds > 0 ? megapixels / r.seconds : 0.0) << " Mpixels/s";
+
+            // Speedup relative to the scalar kernel.
+            for (size_t scalarIdx = 0; scalarIdx != mResults.size(); ++scalarIdx)
+            {
+                const Result & scalar = mResults[scalarIdx];
+                if (r.kernelSet != CompositingKernelSet_Scalar &&
+                    scalar.kernelSet == CompositingKernelSet_Scalar &&
+                    scalar.name == r.name && r.seconds > 0)
+                {
+                    ss << ", " << std::setprecision(2) << (scalar.seconds / r.seconds) << "x" << std::setprecision(1);
+                }
+            }
+            ss << "\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,48 @@
+#ifndef COMPOSITINGBENCHMARK_H_INCLUDED
+#define COMPOSITINGBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include "XULWin/Compositing.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Measures the throughput of the compositing kernels of Compositing.h
+     * in megapixels per second, for each supported kernel set. That the
+     * kernel sets produce the same pixels is checked by CompositingTest.
+     */
+    class CompositingBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            CompositingKernelSet kernelSet;
+            size_t numPixels;
+        };
+
+        CompositingBenchmark(size_t inNumIterations);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        template<class Functor>
+        void benchmark(const std::string & inName, CompositingKernelSet inKernelSet, size_t inNumIterations, Functor inFunctor);
+
+        size_t mNumIterations;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // COMPOSITINGBENCHMARK_H_INCLUDED
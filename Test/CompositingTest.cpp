@@ -0,0 +1,109 @@
+#include "CompositingTest.h"
+#include "PixelGenerator.h"
+#include "XULWin/Compositing.h"
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        const int cMaxOffset = 4;
+        const int cMaxCount = 40;
+
+
+        const char * GetName(CompositingKernelSet inKernelSet)
+        {
+            return inKernelSet == CompositingKernelSet_SSE2 ? "SSE2" : "scalar";
+        }
+
+
+        std::string GetDescription(CompositingKernelSet inKernelSet, const char * inKernel, int inOffset, int inCount)
+        {
+            std::stringstream ss;
+            ss << inKernel << " (" << GetName(inKernelSet) << ") differs from scalar at offset "
+               << inOffset << " with " << inCount << " pixels";
+            return ss.str();
+        }
+
+
+        std::string GetScaleDescription(CompositingKernelSet inKernelSet, int inWidth, int inHeight)
+        {
+            std::stringstream ss;
+            ss << "ScaleImageBilinear (" << GetName(inKernelSet) << ") differs from scalar at "
+               << inWidth << "x" << inHeight;
+            return ss.str();
+        }
+
+    }
+
+
+    CompositingTest::CompositingTest() :
+        UnitTest("Compositing")
+    {
+    }
+
+
+    void CompositingTest::runTestCases()
+    {
+        PixelGenerator generator;
+        std::vector<unsigned char> coverage;
+        generator.getCoverage(cMaxOffset + cMaxCount, coverage);
+        std::vector<unsigned int> background;
+        generator.getPixels(cMaxOffset + cMaxCount, background);
+        std::vector<unsigned int> source;
+        generator.getPixels(cMaxOffset + cMaxCount, source);
+        unsigned int color = 0xC0604020;
+
+        const CompositingKernels & scalar = GetCompositingKernels(CompositingKernelSet_Scalar);
+        CompositingKernelSet kernelSets[] = { CompositingKernelSet_SSE2 };
+        for (size_t idx = 0; idx != sizeof(kernelSets) / sizeof(kernelSets[0]); ++idx)
+        {
+            CompositingKernelSet kernelSet = kernelSets[idx];
+            if (!IsCompositingKernelSetSupported(kernelSet))
+            {
+                continue;
+            }
+
+            const CompositingKernels & kernels = GetCompositingKernels(kernelSet);
+            for (int offset = 0; offset != cMaxOffset; ++offset)
+            {
+                for (int count = 0; count <= cMaxCount; ++count)
+                {
+                    std::vector<unsigned int> expected(background);
+                    std::vector<unsigned int> actual(background);
+                    scalar.fillSpan(&expected[offset], &coverage[offset], count, color);
+                    kernels.fillSpan(&actual[offset], &coverage[offset], count, color);
+                    expect(actual == expected, GetDescription(kernelSet, "fillSpan", offset, count));
+
+                    expected = background;
+                    actual = background;
+                    scalar.blendRow(&expected[offset], &source[offset], count);
+                    kernels.blendRow(&actual[offset], &source[offset], count);
+                    expect(actual == expected, GetDescription(kernelSet, "blendRow", offset, count));
+                }
+            }
+
+            // Enlarged, reduced and reduced by more than a factor 2.
+            const int cSourceWidth = 37;
+            const int cSourceHeight = 23;
+            const int cSizes[][2] = { { 101, 59 }, { 30, 17 }, { 11, 5 } };
+            std::vector<unsigned int> image;
+            generator.getPixels(cSourceWidth * cSourceHeight, image);
+            for (size_t sizeIdx = 0; sizeIdx != sizeof(cSizes) / sizeof(cSizes[0]); ++sizeIdx)
+            {
+                int width = cSizes[sizeIdx][0];
+                int height = cSizes[sizeIdx][1];
+                std::vector<unsigned int> expected(width * height);
+                std::vector<unsigned int> actual(width * height);
+                ScaleImageBilinear(scalar, &image[0], cSourceWidth, cSourceHeight, cSourceWidth, &expected[0], width, height, width);
+                ScaleImageBilinear(kernels, &image[0], cSourceWidth, cSourceHeight, cSourceWidth, &actual[0], width, height, width);
+                expect(actual == expected, GetScaleDescription(kernelSet, width, height));
+            }
+        }
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,31 @@
+#ifndef COMPOSITINGTEST_H_INCLUDED
+#define COMPOSITINGTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Compares the output of each supported compositing kernel set with the
+     * output of the scalar kernels, which must be identical. The spans start
+     * at every offset within a vector and have every length up to a few
+     * vectors, so the code before the first and after the last full vector
+     * is covered too.
+     */
+    class CompositingTest : public UnitTest
+    {
+    public:
+        CompositingTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // COMPOSITINGTEST_H_INCLUDED
@@ -0,0 +1,302 @@
+#include "ConversionBenchmark.h"
+#include "AllocationCounter.h"
+#include "XULWin/Conversions.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/StyleDeclarations.h"
+#include "XULWin/Windows.h"
+#include "Poco/Stopwatch.h"
+#include <boost/lexical_cast.hpp>
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        const char * cIntValues[] = { "1", "0", "120", "-5", "2147483647", "auto", "", "100%" };
+
+        const char * cFloatValues[] = { "1", "0.5", "-12.25", "3e2", "auto", "", "1.5.0" };
+
+        const char * cPointValues[] = { "0,0", "10,20", "-300,1200", "5,x" };
+
+        const char * cStyleValues[] = { "width:100px;height:20px", "margin: 4px 8px; color: #336699", "overflow-y: auto; background-color: white", "fill: SteelBlue; stroke: black" };
+
+        const char * cColorValues[] = { "#ff8000", "#F80", "rgb(10, 20, 30)", "rgba(10,20,30,0.5)", "white", "SteelBlue", " lightgoldenrodyellow ", "none" };
+
+        template<class T, size_t N>
+        size_t ArraySize(T (&)[N])
+        {
+            return N;
+        }
+
+        // The conversions as they were implemented before.
+        int LexicalString2Int(const std::string & inValue, int inDefault)
+        {
+            int result = inDefault;
+            try
+            {
+                if (!inValue.empty())
+                {
+                    result = boost::lexical_cast<int>(inValue);
+                }
+            }
+            catch (std::exception &)
+            {
+            }
+            return result;
+        }
+
+
+        float LexicalString2Float(const std::string & inValue)
+        {
+            float result(0);
+            try
+            {
+                if (!inValue.empty())
+                {
+                    result = boost::lexical_cast<float>(inValue);
+                }
+            }
+            catch (std::exception &)
+            {
+            }
+            return result;
+        }
+
+
+        std::string LexicalPoint2String(const Point & inPoint)
+        {
+            std::stringstream ss;
+            ss << boost::lexical_cast<std::string>(inPoint.x());
+            ss << ",";
+            ss << boost::lexical_cast<std::string>(inPoint.y());
+            return ss.str();
+        }
+
+
+        Point LexicalString2Point(const std::string & inValue)
+        {
+            try
+            {
+                size_t sep = inValue.find(",");
+                if (sep != std::string::npos)
+                {
+                    int x = boost::lexical_cast<int>(inValue.substr(0, sep));
+                    int y = boost::lexical_cast<int>(inValue.substr(sep + 1, inValue.size() - sep - 1));
+                    return Point(x, y);
+                }
+            }
+            catch (std::exception &)
+            {
+            }
+            return Point();
+        }
+
+
+        // Each functor converts one input and returns a value that depends
+        // on the result, so that the optimizer can't drop the work.
+        struct LexicalIntTest
+        {
+            LexicalIntTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const { return LexicalString2Int(mValues[inIndex % mValues.size()], 0); }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct IntTest
+        {
+            IntTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const { return String2Int(mValues[inIndex % mValues.size()], 0); }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct LexicalFloatTest
+        {
+            LexicalFloatTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const { return static_cast<int>(LexicalString2Float(mValues[inIndex % mValues.size()])); }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct FloatTest
+        {
+            FloatTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                float result = 0;
+                ParseFloat(mValues[inIndex % mValues.size()], result);
+                return static_cast<int>(result);
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct LexicalInt2StringTest
+        {
+            int operator()(size_t inIndex) const { return static_cast<int>(boost::lexical_cast<std::string>(static_cast<int>(inIndex)).size()); }
+        };
+
+
+        struct Int2StringTest
+        {
+            int operator()(size_t inIndex) const { return static_cast<int>(Int2String(static_cast<int>(inIndex)).size()); }
+        };
+
+
+        struct ColorTest
+        {
+            ColorTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                RGBColor color;
+                String2RGBColor(mValues[inIndex % mValues.size()], color);
+                return color.red();
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        // Parses the style string for every element, as it was done before.
+        struct StyleTest
+        {
+            StyleTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                StyleDeclarations styles(mValues[inIndex % mValues.size()]);
+                return static_cast<int>(styles.size());
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct CachedStyleTest
+        {
+            CachedStyleTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                return static_cast<int>(StyleDeclarations::Get(mValues[inIndex % mValues.size()]).size());
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct LexicalPointTest
+        {
+            LexicalPointTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                Point point = LexicalString2Point(mValues[inIndex % mValues.size()]);
+                return static_cast<int>(LexicalPoint2String(point).size());
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+
+        struct PointTest
+        {
+            PointTest(const std::vector<std::string> & inValues) : mValues(inValues) {}
+            int operator()(size_t inIndex) const
+            {
+                Point point = String2Point(mValues[inIndex % mValues.size()]);
+                return static_cast<int>(Point2String(point).size());
+            }
+            const std::vector<std::string> & mValues;
+        };
+
+    }
+
+
+    ConversionBenchmark::Result::Result() :
+        numIterations(0)
+    {
+    }
+
+
+    ConversionBenchmark::ConversionBenchmark(size_t inNumIterations) :
+        Benchmark("Conversion benchmark"),
+        mNumIterations(inNumIterations)
+    {
+    }
+
+
+    template<class Functor>
+    void ConversionBenchmark::benchmark(const std::string & inName, Functor inFunctor)
+    {
+        Result result;
+        result.name = inName;
+        result.numIterations = mNumIterations;
+
+        unsigned int checksum = 0;
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        for (size_t idx = 0; idx != mNumIterations; ++idx)
+        {
+            checksum += static_cast<unsigned int>(inFunctor(idx));
+        }
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+
+        // Keep the checksum alive.
+        if (checksum == 42)
+        {
+            ::OutputDebugStringA("");
+        }
+    }
+
+
+    void ConversionBenchmark::measure()
+    {
+        std::vector<std::string> ints(cIntValues, cIntValues + ArraySize(cIntValues));
+        std::vector<std::string> floats(cFloatValues, cFloatValues + ArraySize(cFloatValues));
+        std::vector<std::string> points(cPointValues, cPointValues + ArraySize(cPointValues));
+        std::vector<std::string> colors(cColorValues, cColorValues + ArraySize(cColorValues));
+        std::vector<std::string> styles(cStyleValues, cStyleValues + ArraySize(cStyleValues));
+
+        // String2Int(const std::string &) reports invalid input, which
+        // would dominate the timing. The variant with a default value is
+        // the one used for attributes. String2Point reports the invalid
+        // point among the inputs, so the errors are not shown.
+        ErrorCatcher errorCatcher;
+        errorCatcher.disableLogging(true);
+        benchmark("String2Int (lexical_cast)", LexicalIntTest(ints));
+        benchmark("String2Int", IntTest(ints));
+        benchmark("String2Float (lexical_cast)", LexicalFloatTest(floats));
+        benchmark("ParseFloat", FloatTest(floats));
+        benchmark("Int2String (lexical_cast)", LexicalInt2StringTest());
+        benchmark("Int2String", Int2StringTest());
+        benchmark("String2Point + Point2String (lexical_cast)", LexicalPointTest(points));
+        benchmark("String2Point + Point2String", PointTest(points));
+        benchmark("String2RGBColor", ColorTest(colors));
+        benchmark("StyleDeclarations", StyleTest(styles));
+        benchmark("StyleDeclarations::Get", CachedStyleTest(styles));
+    }
+
+
+    std::string ConversionBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double iterations = r.numIterations ? static_cast<double>(r.numIterations) : 1.0;
+            ss << r.name << ": "
+               << r.numIterations << " conversions, "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.seconds * 1e9 / iterations) << " ns/conversion, "
+               << std::setprecision(2) << (r.numAllocations / iterations) << " allocations/conversion\n"
+               << std::setprecision(1);
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,49 @@
+#ifndef CONVERSIONBENCHMARK_H_INCLUDED
+#define CONVERSIONBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Compares the numeric conversions of Conversions.h with the
+     * boost::lexical_cast based implementation they replaced.
+     *
+     * The inputs are typical attribute values, including the invalid ones
+     * that are common in XUL documents (empty strings, "auto", "100%").
+     * Also measures String2RGBColor, which should not allocate.
+     */
+    class ConversionBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numIterations;
+        };
+
+        ConversionBenchmark(size_t inNumIterations);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        template<class Functor>
+        void benchmark(const std::string & inName, Functor inFunctor);
+
+        size_t mNumIterations;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // CONVERSIONBENCHMARK_H_INCLUDED
@@ -0,0 +1,140 @@
+#include "ElementTest.h"
+#include "XULWin/Element.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // An element without component.
+        class HeadlessElement : public Element
+        {
+        public:
+            static ElementPtr Create(const std::string & inTagName, Element * inParent,
+                                     const AttributesMapping & inAttr = AttributesMapping())
+            {
+                ElementPtr result(new HeadlessElement(inTagName, inParent));
+                Initialize(result, InternTagName(inTagName), inParent, inAttr);
+                return result;
+            }
+
+        private:
+            HeadlessElement(const std::string & inTagName, Element * inParent) :
+                Element(inTagName, inParent, 0)
+            {
+            }
+        };
+
+
+        // Returns true if the elements with the tag name below inElement are
+        // exactly inExpected, in document order.
+        bool HasElements(Element * inElement, const std::string & inTagName, const std::vector<Element *> & inExpected)
+        {
+            std::vector<Element *> elements;
+            inElement->getElementsByTagName(inTagName, elements);
+            return elements == inExpected;
+        }
+
+    }
+
+
+    ElementTest::ElementTest() :
+        UnitTest("Element")
+    {
+    }
+
+
+    void ElementTest::runTestCases()
+    {
+        // window
+        //   vbox
+        //     hbox
+        //       button 1
+        //     button 2
+        //   button 3
+        ElementPtr window = HeadlessElement::Create("window", 0);
+        ElementPtr vbox = HeadlessElement::Create("vbox", window.get());
+        ElementPtr hbox = HeadlessElement::Create("hbox", vbox.get());
+        ElementPtr button1 = HeadlessElement::Create("button", hbox.get());
+        ElementPtr button2 = HeadlessElement::Create("button", vbox.get());
+
+        std::vector<Element *> buttons;
+        buttons.push_back(button1.get());
+        buttons.push_back(button2.get());
+        expect(HasElements(window.get(), "button", buttons), "the buttons of the window");
+        expect(HasElements(vbox.get(), "button", buttons), "the buttons of the vbox");
+        expect(HasElements(hbox.get(), "button", std::vector<Element *>(1, button1.get())), "the button of the hbox");
+
+        // A removed subtree is a document of its own.
+        window->removeChild(vbox.get());
+        expect(HasElements(window.get(), "button", std::vector<Element *>()), "the window has no buttons after removing the vbox");
+        expect(HasElements(vbox.get(), "button", buttons), "the buttons of the removed vbox");
+        expect(HasElements(hbox.get(), "hbox", std::vector<Element *>(1, hbox.get())), "the hbox of the removed vbox");
+
+        // Added again, the whole subtree is found in the window and in the
+        // subtree, also after an element is added at the end.
+        window->addChild(vbox);
+        ElementPtr button3 = HeadlessElement::Create("button", window.get());
+        expect(HasElements(vbox.get(), "button", buttons), "the buttons of the vbox after adding it again");
+        expect(HasElements(hbox.get(), "button", std::vector<Element *>(1, button1.get())), "the button of the hbox after adding the vbox again");
+        buttons.push_back(button3.get());
+        expect(HasElements(window.get(), "button", buttons), "the buttons of the window after adding the vbox again");
+
+        // A chain of single children, where every element follows its parent.
+        ElementPtr chain = HeadlessElement::Create("vbox", 0);
+        ElementPtr link = HeadlessElement::Create("hbox", chain.get());
+        ElementPtr end = HeadlessElement::Create("label", link.get());
+        chain->removeChild(link.get());
+        chain->addChild(link);
+        expect(HasElements(chain.get(), "label", std::vector<Element *>(1, end.get())), "the label at the end of the chain");
+        expect(HasElements(link.get(), "label", std::vector<Element *>(1, end.get())), "the label below the link of the chain");
+
+        // The id index finds the first element with the id in the subtree,
+        // also after an element was created on an earlier branch.
+        AttributesMapping idA, idB;
+        idA["id"] = "a";
+        idB["id"] = "b";
+        ElementPtr doc = HeadlessElement::Create("window", 0);
+        ElementPtr first = HeadlessElement::Create("vbox", doc.get(), idA);
+        ElementPtr second = HeadlessElement::Create("hbox", doc.get());
+        ElementPtr secondB = HeadlessElement::Create("button", second.get(), idB);
+        ElementPtr firstB = HeadlessElement::Create("button", first.get(), idB);
+        expect(doc->getElementById("a") == first.get(), "the vbox by id");
+        expect(doc->getElementById("b") == secondB.get(), "the button that was created first");
+        expect(first->getElementById("b") == firstB.get(), "the button of the vbox");
+        expect(second->getElementById("b") == secondB.get(), "the button of the hbox");
+        expect(first->getElementById("a") == 0, "an element is not its own descendant");
+        expect(second->getElementById("a") == 0, "the vbox is not below the hbox");
+        doc->removeChild(second.get());
+        expect(doc->getElementById("b") == firstB.get(), "the button of the vbox after removing the hbox");
+        expect(second->getElementById("b") == secondB.get(), "the button of the removed hbox");
+
+        // Attributes are stored in the arena of the document in which the
+        // element was created.
+        AttributesMapping attr;
+        attr["flex"] = "1";
+        attr["label"] = "Label";
+        attr["tooltiptext"] = std::string(2000, 'x');
+        ElementPtr form = HeadlessElement::Create("vbox", 0);
+        ElementPtr label = HeadlessElement::Create("label", form.get(), attr);
+        expect(label->getAttribute("flex") == "1", "the flex attribute");
+        expect(label->getAttribute("tooltiptext") == attr["tooltiptext"], "the long attribute");
+        expect(label->getAttribute("value").empty(), "an attribute that is not set");
+        label->setAttribute("label", "Text");
+        expect(label->getAttribute("label") == "Text", "a shorter value");
+        label->setAttribute("label", "A longer text");
+        expect(label->getAttribute("label") == "A longer text", "a longer value");
+        label->setAttribute("value", "");
+        expect(label->getDocumentAttribute("value").empty(), "an empty value");
+
+        // The values outlive the document.
+        form->removeChild(label.get());
+        form.reset();
+        expect(label->getAttribute("flex") == "1", "the flex attribute after the document was destroyed");
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,30 @@
+#ifndef ELEMENTTEST_H_INCLUDED
+#define ELEMENTTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests the tag and id indexes of Element: getElementsByTagName and
+     * getElementById on documents and subtrees, also after subtrees were
+     * removed and added again, and the attribute storage. The elements
+     * have no components, so no windows are created.
+     */
+    class ElementTest : public UnitTest
+    {
+    public:
+        ElementTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // ELEMENTTEST_H_INCLUDED
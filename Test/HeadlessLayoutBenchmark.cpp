@@ -0,0 +1,174 @@
+#include "HeadlessLayoutBenchmark.h"
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/TextMetrics.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        const char * cWindowStart =
+            "<?xml version=\"1.0\"?>\n"
+            "<window xmlns=\"http://www.mozilla.org/keymaster/gatekeeper/there.is.only.xul\">\n";
+
+        const char * cWindowEnd = "</window>\n";
+
+
+        size_t CountNodes(const HeadlessNode * inNode)
+        {
+            size_t result = 1;
+            for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+            {
+                result += CountNodes(inNode->getChild(idx));
+            }
+            return result;
+        }
+
+
+        // Nested boxes that alternate between horizontal and vertical, with
+        // a label and a button on each level.
+        std::string GetDeepNestingXUL(size_t inDepth)
+        {
+            std::stringstream ss;
+            ss << cWindowStart;
+            for (size_t idx = 0; idx != inDepth; ++idx)
+            {
+                ss << (idx % 2 == 0 ? "<hbox flex=\"1\">" : "<vbox flex=\"1\">")
+                   << "<label value=\"Level " << idx << "\"/>"
+                   << "<button label=\"Button " << idx << "\"/>";
+            }
+            for (size_t idx = inDepth; idx != 0; --idx)
+            {
+                ss << ((idx - 1) % 2 == 0 ? "</hbox>" : "</vbox>");
+            }
+            ss << cWindowEnd;
+            return ss.str();
+        }
+
+
+        // One horizontal box with many children, a third of them with flex.
+        std::string GetWideBoxXUL(size_t inNumChildren)
+        {
+            std::stringstream ss;
+            ss << cWindowStart << "<hbox flex=\"1\" align=\"center\">";
+            for (size_t idx = 0; idx != inNumChildren; ++idx)
+            {
+                switch (idx % 3)
+                {
+                    case 0: ss << "<button label=\"Button " << idx << "\" flex=\"1\"/>"; break;
+                    case 1: ss << "<label value=\"Label " << idx << "\"/>"; break;
+                    default: ss << "<checkbox label=\"Option " << idx << "\"/>"; break;
+                }
+            }
+            ss << "</hbox>" << cWindowEnd;
+            return ss.str();
+        }
+
+
+        // A form with a label, a flexible text box and a button on each row.
+        std::string GetLargeGridXUL(size_t inNumRows)
+        {
+            std::stringstream ss;
+            ss << cWindowStart
+               << "<grid flex=\"1\">"
+               << "<columns><column align=\"end\"/><column flex=\"1\"/><column/></columns>"
+               << "<rows>";
+            for (size_t idx = 0; idx != inNumRows; ++idx)
+            {
+                ss << "<row align=\"center\">"
+                   << "<label value=\"Field " << idx << "\"/>"
+                   << "<textbox value=\"Value " << idx << "\"/>"
+                   << "<button label=\"Edit\"/>"
+                   << "</row>";
+            }
+            ss << "</rows></grid>" << cWindowEnd;
+            return ss.str();
+        }
+
+    }
+
+
+    HeadlessLayoutBenchmark::Result::Result() :
+        numNodes(0),
+        numLayouts(0),
+        loadSeconds(0),
+        firstLayoutSeconds(0)
+    {
+    }
+
+
+    HeadlessLayoutBenchmark::HeadlessLayoutBenchmark(size_t inNumLayouts) :
+        Benchmark("Headless layout benchmark"),
+        mNumLayouts(inNumLayouts)
+    {
+    }
+
+
+    void HeadlessLayoutBenchmark::measure()
+    {
+        benchmark("deep nesting (200 levels)", GetDeepNestingXUL(200));
+        benchmark("wide box (3000 children)", GetWideBoxXUL(3000));
+        benchmark("large grid (1000 rows)", GetLargeGridXUL(1000));
+    }
+
+
+    void HeadlessLayoutBenchmark::benchmark(const std::string & inName, const std::string & inXUL)
+    {
+        Result result;
+        result.name = inName;
+
+        FixedTextMetrics textMetrics;
+        HeadlessLayout layout(textMetrics);
+
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        if (!layout.loadXUL(inXUL))
+        {
+            return;
+        }
+        stopwatch.stop();
+        result.loadSeconds = GetSeconds(stopwatch);
+        result.numNodes = CountNodes(layout.rootNode());
+
+        stopwatch.restart();
+        layout.layout(640, 480);
+        stopwatch.stop();
+        result.firstLayoutSeconds = GetSeconds(stopwatch);
+
+        // Resizing the window changes the size on every pass.
+        result.numLayouts = mNumLayouts;
+        stopwatch.restart();
+        for (size_t idx = 0; idx != result.numLayouts; ++idx)
+        {
+            layout.layout(640 + static_cast<int>(idx % 100), 480 + static_cast<int>(idx % 50));
+        }
+        stopwatch.stop();
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+    }
+
+
+    std::string HeadlessLayoutBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double layoutSeconds = r.numLayouts > 0 ? r.seconds / r.numLayouts : 0;
+            ss << r.name << ": "
+               << r.numNodes << " nodes, load "
+               << (r.loadSeconds * 1000.0) << " ms, first layout "
+               << (r.firstLayoutSeconds * 1000.0) << " ms, layout "
+               << (layoutSeconds * 1000.0) << " ms\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
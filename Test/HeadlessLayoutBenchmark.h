@@ -0,0 +1,52 @@
+#ifndef HEADLESSLAYOUTBENCHMARK_H_INCLUDED
+#define HEADLESSLAYOUTBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Measures HeadlessLayout.
+     *
+     * Generates documents with deep nesting, a wide box and a large grid,
+     * and times loading, the first layout pass, which measures every node,
+     * and the passes that follow while the window is resized. The seconds of
+     * a result are those of the resize passes. The layout results are
+     * checked by HeadlessLayoutTest.
+     */
+    class HeadlessLayoutBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numNodes;
+            size_t numLayouts;
+            double loadSeconds;
+            double firstLayoutSeconds;
+        };
+
+        HeadlessLayoutBenchmark(size_t inNumLayouts);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        void benchmark(const std::string & inName, const std::string & inXUL);
+
+        size_t mNumLayouts;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // HEADLESSLAYOUTBENCHMARK_H_INCLUDED
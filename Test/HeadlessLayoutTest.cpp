@@ -0,0 +1,117 @@
+#include "HeadlessLayoutTest.h"
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/TextMetrics.h"
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        const char * cWindowStart =
+            "<?xml version=\"1.0\"?>\n"
+            "<window xmlns=\"http://www.mozilla.org/keymaster/gatekeeper/there.is.only.xul\">\n";
+
+        const char * cWindowEnd = "</window>\n";
+
+
+        struct Expectation
+        {
+            const char * XUL;
+            int Width;
+            int Height;
+            const char * Dump;
+        };
+
+
+        // Expected rects for the default FixedTextMetrics: 6 pixels per
+        // character and 13 pixels per line.
+        const Expectation cExpectations[] =
+        {
+            {
+                "<hbox>"
+                "<button label=\"OK\"/><spacer flex=\"1\"/><button label=\"Cancel\"/>"
+                "</hbox>",
+                320, 240,
+                "window 0 0 320 240\n"
+                "  hbox 0 0 320 27\n"
+                "    button 0 0 83 27\n"
+                "    spacer 83 0 154 27\n"
+                "    button 237 0 83 27\n"
+            },
+            {
+                "<grid flex=\"1\">"
+                "<columns><column/><column flex=\"1\"/></columns>"
+                "<rows>"
+                "<row><label value=\"Name\"/><textbox id=\"name\"/></row>"
+                "<row><label value=\"Description\"/><textbox id=\"description\" rows=\"3\"/></row>"
+                "</rows>"
+                "</grid>",
+                200, 100,
+                "window 0 0 200 100\n"
+                "  grid 0 0 200 100\n"
+                "    columns 0 0 200 100\n"
+                "      column 0 0 74 100\n"
+                "      column 74 0 126 100\n"
+                "    rows 0 0 200 100\n"
+                "      row 0 0 200 25\n"
+                "        label 0 0 74 25\n"
+                "        textbox#name 74 0 126 25\n"
+                "      row 0 25 200 67\n"
+                "        label 0 25 74 67\n"
+                "        textbox#description 74 25 126 67\n"
+            },
+            {
+                "<vbox flex=\"1\" align=\"center\">"
+                "<label value=\"Centered\" style=\"margin: 0px\"/>"
+                "<separator/>"
+                "<checkbox label=\"Hidden\" hidden=\"true\"/>"
+                "</vbox>",
+                100, 50,
+                "window 0 0 100 50\n"
+                "  vbox 0 0 100 50\n"
+                "    label 26 0 48 13\n"
+                "    separator 0 13 100 5\n"
+                "    checkbox 46 18 8 4\n"
+            }
+        };
+
+    }
+
+
+    HeadlessLayoutTest::HeadlessLayoutTest() :
+        UnitTest("HeadlessLayout")
+    {
+    }
+
+
+    void HeadlessLayoutTest::runTestCases()
+    {
+        FixedTextMetrics textMetrics;
+        size_t numExpectations = sizeof(cExpectations) / sizeof(cExpectations[0]);
+        for (size_t idx = 0; idx != numExpectations; ++idx)
+        {
+            const Expectation & expectation = cExpectations[idx];
+            HeadlessLayout layout(textMetrics);
+            if (!expect(layout.loadXUL(std::string(cWindowStart) + expectation.XUL + cWindowEnd),
+                        std::string("failed to load ") + expectation.XUL))
+            {
+                continue;
+            }
+
+            // The second pass must give the same result as the first.
+            std::stringstream firstDump;
+            std::stringstream secondDump;
+            layout.layout(expectation.Width, expectation.Height);
+            layout.dump(firstDump);
+            layout.layout(expectation.Width, expectation.Height);
+            layout.dump(secondDump);
+            expect(firstDump.str() == expectation.Dump, "unexpected layout:\n" + firstDump.str() + "expected:\n" + expectation.Dump);
+            expect(secondDump.str() == firstDump.str(), "the second pass changed the layout:\n" + secondDump.str());
+        }
+    }
+
+
+} // namespace XULWin
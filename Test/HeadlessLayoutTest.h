@@ -0,0 +1,29 @@
+#ifndef HEADLESSLAYOUTTEST_H_INCLUDED
+#define HEADLESSLAYOUTTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Lays out small documents with HeadlessLayout and fixed text metrics
+     * and compares the rect trees with the expected ones. A second layout
+     * pass must not change the result.
+     */
+    class HeadlessLayoutTest : public UnitTest
+    {
+    public:
+        HeadlessLayoutTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // HEADLESSLAYOUTTEST_H_INCLUDED
@@ -0,0 +1,152 @@
+#include "HeadlessParserBenchmark.h"
+#include "AllocationCounter.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/TextMetrics.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    static size_t CountNodes(const HeadlessNode * inNode)
+    {
+        if (!inNode)
+        {
+            return 0;
+        }
+
+        size_t result = 1;
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            result += CountNodes(inNode->getChild(idx));
+        }
+        return result;
+    }
+
+
+    HeadlessParserBenchmark::Result::Result() :
+        numBytes(0),
+        numNodes(0),
+        peakMemory(0)
+    {
+    }
+
+
+    HeadlessParserBenchmark::HeadlessParserBenchmark(const std::string & inPathToXULRunnerSamples) :
+        Benchmark("Headless parser benchmark"),
+        mPathToXULRunnerSamples(inPathToXULRunnerSamples)
+    {
+    }
+
+
+    void HeadlessParserBenchmark::measure()
+    {
+        // The sample documents: <sample>/chrome/content/*.xul
+        Poco::DirectoryIterator it(mPathToXULRunnerSamples), end;
+        for (; it != end; ++it)
+        {
+            if (!it->isDirectory())
+            {
+                continue;
+            }
+
+            Poco::Path contentDir(it->path());
+            contentDir.makeDirectory();
+            contentDir.pushDirectory("chrome");
+            contentDir.pushDirectory("content");
+            if (!Poco::File(contentDir).exists())
+            {
+                continue;
+            }
+
+            // HeadlessLayout resolves chrome URLs itself, so unlike
+            // ParserBenchmark the current directory doesn't matter.
+            Poco::DirectoryIterator fileIt(contentDir), fileEnd;
+            for (; fileIt != fileEnd; ++fileIt)
+            {
+                if (Poco::Path(fileIt->path()).getExtension() == "xul")
+                {
+                    benchmarkFile(Poco::Path(fileIt->path()).getFileName(), fileIt->path());
+                }
+            }
+        }
+
+        benchmarkString("synthetic-10k", GetSyntheticXUL(10000));
+        benchmarkString("synthetic-100k", GetSyntheticXUL(100000));
+    }
+
+
+    void HeadlessParserBenchmark::benchmarkFile(const std::string & inName, const std::string & inPath)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = static_cast<size_t>(Poco::File(inPath).getSize());
+
+        ErrorCatcher errorCatcher;
+        FixedTextMetrics textMetrics;
+        HeadlessLayout layout(textMetrics);
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        layout.loadFile(inPath);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numNodes = CountNodes(layout.rootNode());
+        result.seconds = GetSeconds(stopwatch);
+        result.peakMemory = allocationCounter.peakBytes();
+        mResults.push_back(result);
+    }
+
+
+    void HeadlessParserBenchmark::benchmarkString(const std::string & inName, const std::string & inXUL)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = inXUL.size();
+
+        ErrorCatcher errorCatcher;
+        FixedTextMetrics textMetrics;
+        HeadlessLayout layout(textMetrics);
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        layout.loadXUL(inXUL);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numNodes = CountNodes(layout.rootNode());
+        result.seconds = GetSeconds(stopwatch);
+        result.peakMemory = allocationCounter.peakBytes();
+        mResults.push_back(result);
+    }
+
+
+    std::string HeadlessParserBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double seconds = r.seconds > 0 ? r.seconds : 1e-6;
+            ss << r.name << ": "
+               << r.numNodes << " nodes, "
+               << (r.numBytes / 1024.0) << " KB, "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.numBytes / seconds / (1024.0 * 1024.0)) << " MB/s, "
+               << (r.numNodes / seconds) << " nodes/s, "
+               << (r.numNodes ? static_cast<double>(r.numAllocations) / r.numNodes : 0.0) << " allocations/node, "
+               << "peak " << (r.peakMemory / 1024.0) << " KB\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,54 @@
+#ifndef HEADLESSPARSERBENCHMARK_H_INCLUDED
+#define HEADLESSPARSERBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * The portable counterpart of ParserBenchmark.
+     *
+     * Parses the same documents, the XUL files of the xulrunnersamples and
+     * the synthetic documents with 10k and 100k elements, but builds the
+     * HeadlessNode tree of HeadlessLayout instead of Element objects. It
+     * runs without Windows, see Scripts/PortableTests.
+     */
+    class HeadlessParserBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numBytes;
+            size_t numNodes;
+
+            // The high-water mark of the heap memory used while parsing the document.
+            size_t peakMemory;
+        };
+
+        HeadlessParserBenchmark(const std::string & inPathToXULRunnerSamples);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        void benchmarkFile(const std::string & inName, const std::string & inPath);
+
+        void benchmarkString(const std::string & inName, const std::string & inXUL);
+
+        std::string mPathToXULRunnerSamples;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // HEADLESSPARSERBENCHMARK_H_INCLUDED
@@ -0,0 +1,108 @@
+#include "LayoutBenchmark.h"
+#include "AllocationCounter.h"
+#include "XULWin/Layout.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Small deterministic generator so that every run solves the same boxes.
+        class Random
+        {
+        public:
+            Random(unsigned int inSeed) : mState(inSeed) {}
+
+            int next(int inRange)
+            {
+                mState = mState * 1103515245 + 12345;
+                return static_cast<int>((mState >> 16) % inRange);
+            }
+
+        private:
+            unsigned int mState;
+        };
+
+    }
+
+
+    LayoutBenchmark::Result::Result() :
+        numItems(0),
+        numIterations(0)
+    {
+    }
+
+
+    LayoutBenchmark::LayoutBenchmark(size_t inNumIterations) :
+        Benchmark("Layout benchmark"),
+        mNumIterations(inNumIterations)
+    {
+    }
+
+
+    void LayoutBenchmark::measure()
+    {
+        benchmarkGetSizes("GetSizes 10 items", 10);
+        benchmarkGetSizes("GetSizes 1000 items", 1000);
+    }
+
+
+    void LayoutBenchmark::benchmarkGetSizes(const std::string & inName, size_t inNumItems)
+    {
+        Result result;
+        result.name = inName;
+        result.numItems = inNumItems;
+        result.numIterations = mNumIterations / inNumItems;
+
+        // A third of the items has flex, like the rows of a typical dialog.
+        Random random(1);
+        std::vector<SizeInfo> sizeInfos;
+        for (size_t idx = 0; idx != inNumItems; ++idx)
+        {
+            int flex = idx % 3 == 0 ? 1 + random.next(3) : 0;
+            int minSize = random.next(40);
+            sizeInfos.push_back(SizeInfo(FlexWrap(flex), MinSizeWrap(minSize), OptSizeWrap(minSize + random.next(20))));
+        }
+        std::vector<int> sizes(inNumItems);
+
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        for (size_t idx = 0; idx != result.numIterations; ++idx)
+        {
+            // Resizing the window changes the length on every pass.
+            int length = static_cast<int>(inNumItems * 30 + idx % 1000);
+            LinearLayoutManager::GetSizes(length, &sizeInfos[0], inNumItems, &sizes[0]);
+        }
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+    }
+
+
+    std::string LayoutBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double seconds = r.seconds > 0 ? r.seconds : 1e-6;
+            ss << r.name << ": "
+               << r.numIterations << " iterations, "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.numIterations * r.numItems / seconds) << " items/s, "
+               << r.numAllocations << " allocations\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,46 @@
+#ifndef LAYOUTBENCHMARK_H_INCLUDED
+#define LAYOUTBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Measures the flex solver of LinearLayoutManager on boxes with many
+     * children, like a layout pass of a large list. The properties of the
+     * solver are checked by LayoutTest.
+     */
+    class LayoutBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numItems;
+            size_t numIterations;
+        };
+
+        LayoutBenchmark(size_t inNumIterations);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        void benchmarkGetSizes(const std::string & inName, size_t inNumItems);
+
+        size_t mNumIterations;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // LAYOUTBENCHMARK_H_INCLUDED
@@ -0,0 +1,155 @@
+#include "LayoutSnapshotTest.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/LayoutSnapshot.h"
+#include "XULWin/TextMetrics.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    static const int cWindowWidth = 640;
+    static const int cWindowHeight = 480;
+
+    // Longer lists of deltas are cut off in the report.
+    static const size_t cMaxReportedDeltas = 20;
+
+
+    static bool ReadFile(const std::string & inPath, std::string & outContents)
+    {
+        std::ifstream file(inPath.c_str(), std::ios::in | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        std::stringstream ss;
+        ss << file.rdbuf();
+        outContents = ss.str();
+        return true;
+    }
+
+
+    static bool WriteFile(const std::string & inPath, const std::string & inContents)
+    {
+        std::ofstream file(inPath.c_str(), std::ios::out | std::ios::binary);
+        file << inContents;
+        return file.good();
+    }
+
+
+    LayoutSnapshotTest::LayoutSnapshotTest(const std::string & inPathToXULRunnerSamples) :
+        UnitTest("Layout snapshots"),
+        mPathToXULRunnerSamples(inPathToXULRunnerSamples)
+    {
+    }
+
+
+    void LayoutSnapshotTest::runTestCases()
+    {
+        // The samples report the XUL features that XULWin doesn't support.
+        // Those messages are not failures, the snapshots show their effect.
+        ErrorCatcher errorCatcher;
+        errorCatcher.disableLogging(true);
+
+        // The sample documents: <sample>/chrome/content/*.xul
+        size_t numDocuments = 0;
+        Poco::DirectoryIterator it(mPathToXULRunnerSamples), end;
+        for (; it != end; ++it)
+        {
+            if (!it->isDirectory())
+            {
+                continue;
+            }
+
+            Poco::Path contentDir(it->path());
+            contentDir.makeDirectory();
+            contentDir.pushDirectory("chrome");
+            contentDir.pushDirectory("content");
+            if (!Poco::File(contentDir).exists())
+            {
+                continue;
+            }
+
+            Poco::DirectoryIterator fileIt(contentDir), fileEnd;
+            for (; fileIt != fileEnd; ++fileIt)
+            {
+                if (Poco::Path(fileIt->path()).getExtension() == "xul")
+                {
+                    testFile(it->path(), fileIt->path());
+                    numDocuments++;
+                }
+            }
+        }
+        expect(numDocuments != 0, "no documents found in " + mPathToXULRunnerSamples);
+    }
+
+
+    void LayoutSnapshotTest::testFile(const std::string & inAppDir, const std::string & inPath)
+    {
+        std::string name = Poco::Path(inPath).getBaseName();
+        FixedTextMetrics textMetrics;
+        HeadlessLayout layout(textMetrics);
+        if (!expect(layout.loadFile(inPath), name + ": failed to load " + inPath))
+        {
+            return;
+        }
+        layout.layout(cWindowWidth, cWindowHeight);
+
+        LayoutSnapshot snapshot(layout);
+        std::stringstream ss;
+        snapshot.write(ss);
+        std::string text = ss.str();
+
+        std::string goldenPath = Poco::Path(Poco::Path(inAppDir).makeDirectory(), name + "-layout-golden.txt").toString();
+        std::string newPath = Poco::Path(Poco::Path(inAppDir).makeDirectory(), name + "-layout.txt").toString();
+        std::string golden;
+        if (!ReadFile(goldenPath, golden))
+        {
+            WriteFile(newPath, text);
+            expect(false, name + ": missing " + goldenPath + ", see " + newPath);
+            return;
+        }
+
+        if (text == golden)
+        {
+            return;
+        }
+
+        WriteFile(newPath, text);
+
+        std::istringstream goldenStream(golden);
+        LayoutSnapshot goldenSnapshot;
+        if (!expect(goldenSnapshot.read(goldenStream), name + ": failed to read " + goldenPath))
+        {
+            return;
+        }
+
+        std::vector<LayoutSnapshot::Delta> deltas;
+        LayoutSnapshot::Compare(goldenSnapshot, snapshot, deltas);
+
+        std::stringstream report;
+        report << name << ": " << deltas.size() << " of " << snapshot.size() << " nodes differ from "
+               << goldenPath << ", see " << newPath << "\n";
+        size_t numReported = std::min<size_t>(deltas.size(), cMaxReportedDeltas);
+        std::vector<LayoutSnapshot::Delta> reported(deltas.begin(), deltas.begin() + numReported);
+        LayoutSnapshot::WriteDeltas(reported, report);
+        if (numReported < deltas.size())
+        {
+            report << "... and " << (deltas.size() - numReported) << " more\n";
+        }
+
+        // The deltas end with a line break, which expect adds.
+        std::string description = report.str();
+        expect(false, description.substr(0, description.size() - 1));
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,40 @@
+#ifndef LAYOUTSNAPSHOTTEST_H_INCLUDED
+#define LAYOUTSNAPSHOTTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Guards the layout of the xulrunnersamples against regressions.
+     *
+     * Lays out every XUL file in <sample>/chrome/content with HeadlessLayout
+     * and FixedTextMetrics in a 640x480 window and compares the
+     * LayoutSnapshot with <sample>/<name>-layout-golden.txt. If the golden
+     * file is missing or the snapshot is not byte-identical to it the
+     * document fails, the nodes that moved or changed size are reported and
+     * the new snapshot is written to <name>-layout.txt next to it. Replace
+     * the golden file with it to accept the change.
+     */
+    class LayoutSnapshotTest : public UnitTest
+    {
+    public:
+        LayoutSnapshotTest(const std::string & inPathToXULRunnerSamples);
+
+    protected:
+        virtual void runTestCases();
+
+    private:
+        void testFile(const std::string & inAppDir, const std::string & inPath);
+
+        std::string mPathToXULRunnerSamples;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // LAYOUTSNAPSHOTTEST_H_INCLUDED
@@ -0,0 +1,301 @@
+#include "LayoutTest.h"
+#include "XULWin/Layout.h"
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Small deterministic generator so that failures can be reproduced.
+        class Random
+        {
+        public:
+            Random(unsigned int inSeed) : mState(inSeed) {}
+
+            int next(int inRange)
+            {
+                mState = mState * 1103515245 + 12345;
+                return static_cast<int>((mState >> 16) % inRange);
+            }
+
+        private:
+            unsigned int mState;
+        };
+
+
+        int MinSize(const SizeInfo & inSizeInfo)
+        {
+            return inSizeInfo.MinSize > 0 ? inSizeInfo.MinSize : 0;
+        }
+
+
+        int OptSize(const SizeInfo & inSizeInfo)
+        {
+            return inSizeInfo.OptSize > MinSize(inSizeInfo) ? inSizeInfo.OptSize : MinSize(inSizeInfo);
+        }
+
+
+        // Verifies the properties documented for LinearLayoutManager::GetSizes.
+        bool IsValid(int inLength, const std::vector<SizeInfo> & inSizeInfos, const std::vector<int> & inSizes)
+        {
+            int sumOfSizes = 0;
+            int sumOfMinSizes = 0;
+            int sumOfOptSizes = 0;
+            bool hasFlex = false;
+            for (size_t idx = 0; idx != inSizeInfos.size(); ++idx)
+            {
+                const SizeInfo & info = inSizeInfos[idx];
+                if (inSizes[idx] < MinSize(info))
+                {
+                    return false;
+                }
+                hasFlex = hasFlex || info.Flex > 0;
+                sumOfSizes += inSizes[idx];
+                sumOfMinSizes += MinSize(info);
+                sumOfOptSizes += OptSize(info);
+            }
+
+            // Too small: everything gets its minimum size.
+            if (inLength <= sumOfMinSizes)
+            {
+                return sumOfSizes == sumOfMinSizes;
+            }
+
+            if (inLength < sumOfOptSizes)
+            {
+                // Every item shrinks towards its minimum size, in proportion
+                // to how much it can shrink, give or take one pixel.
+                int extra = inLength - sumOfMinSizes;
+                int totalShrink = sumOfOptSizes - sumOfMinSizes;
+                for (size_t idx = 0; idx != inSizeInfos.size(); ++idx)
+                {
+                    const SizeInfo & info = inSizeInfos[idx];
+                    int difference = (inSizes[idx] - MinSize(info)) * totalShrink - extra * (OptSize(info) - MinSize(info));
+                    if (difference < 0)
+                    {
+                        difference = -difference;
+                    }
+                    if (difference >= totalShrink)
+                    {
+                        return false;
+                    }
+                }
+                return sumOfSizes == inLength;
+            }
+
+            // Items without flex get their optimal size, items with flex at
+            // least their optimal size.
+            for (size_t idx = 0; idx != inSizeInfos.size(); ++idx)
+            {
+                const SizeInfo & info = inSizeInfos[idx];
+                if (info.Flex > 0 ? inSizes[idx] < OptSize(info) : inSizes[idx] != OptSize(info))
+                {
+                    return false;
+                }
+            }
+
+            // Nothing to stretch: no more than the optimal sizes.
+            if (!hasFlex)
+            {
+                return sumOfSizes == sumOfOptSizes;
+            }
+
+            if (sumOfSizes != inLength)
+            {
+                return false;
+            }
+
+            // Flex items above their optimal size get equal shares per unit
+            // of flex, give or take one pixel each. An item held at its
+            // optimal size doesn't get less per unit of flex than them.
+            for (size_t i = 0; i != inSizeInfos.size(); ++i)
+            {
+                for (size_t j = 0; j != inSizeInfos.size(); ++j)
+                {
+                    const SizeInfo & a = inSizeInfos[i];
+                    const SizeInfo & b = inSizeInfos[j];
+                    if (a.Flex > 0 && b.Flex > 0 && inSizes[j] > OptSize(b))
+                    {
+                        int difference = inSizes[i] * b.Flex - inSizes[j] * a.Flex;
+                        if (difference <= -(a.Flex + b.Flex))
+                        {
+                            return false;
+                        }
+                        if (inSizes[i] > OptSize(a) && difference >= a.Flex + b.Flex)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+
+        // Verifies the weighted overload of LinearLayoutManager::GetSizes.
+        bool IsValid(int inLength, const std::vector<int> & inWeights, const std::vector<int> & inSizes)
+        {
+            int length = inLength > 0 ? inLength : 0;
+            int totalWeight = 0;
+            for (size_t idx = 0; idx != inWeights.size(); ++idx)
+            {
+                totalWeight += inWeights[idx] > 0 ? inWeights[idx] : 0;
+            }
+
+            int sumOfSizes = 0;
+            for (size_t idx = 0; idx != inWeights.size(); ++idx)
+            {
+                int weight = inWeights[idx] > 0 ? inWeights[idx] : 0;
+
+                // |size - length * weight / totalWeight| < 1
+                int difference = inSizes[idx] * totalWeight - length * weight;
+                if (difference < 0)
+                {
+                    difference = -difference;
+                }
+                if (totalWeight == 0 ? inSizes[idx] != 0 : difference >= totalWeight)
+                {
+                    return false;
+                }
+                sumOfSizes += inSizes[idx];
+            }
+            return sumOfSizes == (totalWeight == 0 ? 0 : length);
+        }
+
+
+        std::string ToString(int inLength, const std::vector<SizeInfo> & inSizeInfos)
+        {
+            std::stringstream ss;
+            ss << "length " << inLength << ":";
+            for (size_t idx = 0; idx != inSizeInfos.size(); ++idx)
+            {
+                const SizeInfo & info = inSizeInfos[idx];
+                ss << " (flex " << info.Flex << ", min " << info.MinSize << ", opt " << info.OptSize << ")";
+            }
+            return ss.str();
+        }
+
+    }
+
+
+    LayoutTest::LayoutTest() :
+        UnitTest("LinearLayoutManager")
+    {
+    }
+
+
+    void LayoutTest::check(int inLength, const std::vector<SizeInfo> & inSizeInfos, std::vector<int> & ioSizes)
+    {
+        ioSizes.resize(inSizeInfos.size());
+        if (!inSizeInfos.empty())
+        {
+            LinearLayoutManager::GetSizes(inLength, &inSizeInfos[0], inSizeInfos.size(), &ioSizes[0]);
+        }
+        if (!IsValid(inLength, inSizeInfos, ioSizes))
+        {
+            expect(false, "invalid sizes for " + ToString(inLength, inSizeInfos));
+        }
+    }
+
+
+    void LayoutTest::check(int inLength, const std::vector<int> & inWeights, std::vector<int> & ioSizes)
+    {
+        ioSizes.resize(inWeights.size());
+        if (!inWeights.empty())
+        {
+            LinearLayoutManager::GetSizes(inLength, &inWeights[0], inWeights.size(), &ioSizes[0]);
+        }
+        if (!IsValid(inLength, inWeights, ioSizes))
+        {
+            std::stringstream ss;
+            ss << "invalid weighted sizes for length " << inLength;
+            expect(false, ss.str());
+        }
+    }
+
+
+    void LayoutTest::runTestCases()
+    {
+        std::vector<int> sizes;
+
+        // Every combination of up to three items with flex 0-3, minimum size
+        // 0-3 and optimal size 0-2 above the minimum, for lengths 0-24.
+        const int cNumValues = 4 * 4 * 3;
+        std::vector<SizeInfo> sizeInfos;
+        for (size_t numItems = 0; numItems <= 3; ++numItems)
+        {
+            int numCombinations = 1;
+            for (size_t idx = 0; idx != numItems; ++idx)
+            {
+                numCombinations *= cNumValues;
+            }
+
+            for (int combination = 0; combination != numCombinations; ++combination)
+            {
+                sizeInfos.clear();
+                int value = combination;
+                for (size_t idx = 0; idx != numItems; ++idx)
+                {
+                    int flex = value % 4;
+                    int minSize = (value / 4) % 4;
+                    int optSize = minSize + (value / 16) % 3;
+                    sizeInfos.push_back(SizeInfo(FlexWrap(flex), MinSizeWrap(minSize), OptSizeWrap(optSize)));
+                    value /= cNumValues;
+                }
+
+                for (int length = 0; length <= 24; ++length)
+                {
+                    check(length, sizeInfos, sizes);
+                }
+            }
+        }
+
+        // Every combination of up to four weights from -1 to 3.
+        std::vector<int> weights;
+        for (size_t numItems = 0; numItems <= 4; ++numItems)
+        {
+            int numCombinations = 1;
+            for (size_t idx = 0; idx != numItems; ++idx)
+            {
+                numCombinations *= 5;
+            }
+
+            for (int combination = 0; combination != numCombinations; ++combination)
+            {
+                weights.clear();
+                int value = combination;
+                for (size_t idx = 0; idx != numItems; ++idx)
+                {
+                    weights.push_back(value % 5 - 1);
+                    value /= 5;
+                }
+
+                for (int length = -2; length <= 24; ++length)
+                {
+                    check(length, weights, sizes);
+                }
+            }
+        }
+
+        // Random boxes with many items and large sizes.
+        Random random(1);
+        for (size_t idx = 0; idx != 10000; ++idx)
+        {
+            sizeInfos.clear();
+            int numItems = random.next(64);
+            for (int itemIdx = 0; itemIdx != numItems; ++itemIdx)
+            {
+                int flex = random.next(3) == 0 ? random.next(10) : 0;
+                int minSize = random.next(100);
+                int optSize = minSize + random.next(100);
+                sizeInfos.push_back(SizeInfo(FlexWrap(flex), MinSizeWrap(minSize), OptSizeWrap(optSize)));
+            }
+            check(random.next(10000), sizeInfos, sizes);
+        }
+    }
+
+
+} // namespace XULWin
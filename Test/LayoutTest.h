@@ -0,0 +1,40 @@
+#ifndef LAYOUTTEST_H_INCLUDED
+#define LAYOUTTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    struct SizeInfo;
+
+
+    /**
+     * Tests the flex solver of LinearLayoutManager.
+     *
+     * Tries every combination of up to three small items and a range of
+     * lengths, followed by random larger inputs, and verifies the documented
+     * properties of GetSizes for each.
+     */
+    class LayoutTest : public UnitTest
+    {
+    public:
+        LayoutTest();
+
+    protected:
+        virtual void runTestCases();
+
+    private:
+        void check(int inLength, const std::vector<SizeInfo> & inSizeInfos, std::vector<int> & ioSizes);
+
+        void check(int inLength, const std::vector<int> & inWeights, std::vector<int> & ioSizes);
+    };
+
+
+} // namespace XULWin
+
+
+#endif // LAYOUTTEST_H_INCLUDED
@@ -0,0 +1,96 @@
+#include "LayoutTransactionTest.h"
+#include "XULWin/LayoutTransaction.h"
+
+
+namespace XULWin
+{
+
+    LayoutTransactionTest::LayoutTransactionTest() :
+        UnitTest("LayoutTransaction")
+    {
+    }
+
+
+    void LayoutTransactionTest::runTestCases()
+    {
+        int windows[3];
+        LayoutTransaction::Handle a = &windows[0];
+        LayoutTransaction::Handle b = &windows[1];
+        LayoutTransaction::Handle c = &windows[2];
+
+        // Moves are committed once, when the outermost transaction ends.
+        {
+            LayoutTransaction::RecordingBackend backend;
+            {
+                LayoutTransaction transaction(backend);
+                expect(LayoutTransaction::Current() == &transaction, "the transaction is not active");
+                LayoutTransaction::MoveWindow(a, Rect(0, 0, 10, 10));
+                {
+                    LayoutTransaction nested(backend);
+                    expect(LayoutTransaction::Current() == &transaction, "a nested transaction doesn't join the outer one");
+                    LayoutTransaction::MoveWindow(b, Rect(10, 0, 20, 10));
+                }
+                expect(backend.commits().empty(), "the nested transaction committed");
+
+                Rect rect;
+                expect(LayoutTransaction::GetPendingRect(b, rect) && rect == Rect(10, 0, 20, 10), "wrong pending rect");
+                expect(!LayoutTransaction::GetPendingRect(c, rect), "pending rect for a window that wasn't moved");
+            }
+            expect(LayoutTransaction::Current() == 0, "the transaction is still active");
+            expect(backend.commits().size() == 1, "expected one commit");
+            if (backend.commits().size() == 1)
+            {
+                const LayoutTransaction::Moves & moves = backend.commits()[0];
+                expect(moves.size() == 2 && moves[0].handle == a && moves[1].handle == b, "the moves are not in recording order");
+            }
+            backend.clear();
+            expect(backend.commits().empty(), "clear didn't remove the commits");
+        }
+
+        // A window that is moved more than once is moved to its final rect,
+        // at the position of its first move.
+        {
+            LayoutTransaction::RecordingBackend backend;
+            {
+                LayoutTransaction transaction(backend);
+                LayoutTransaction::MoveWindow(a, Rect(0, 0, 10, 10));
+                LayoutTransaction::MoveWindow(b, Rect(0, 10, 10, 10));
+                LayoutTransaction::MoveWindow(a, Rect(5, 5, 20, 20));
+            }
+            expect(backend.commits().size() == 1, "expected one commit");
+            if (backend.commits().size() == 1)
+            {
+                const LayoutTransaction::Moves & moves = backend.commits()[0];
+                expect(moves.size() == 2, "a window that moved twice is committed twice");
+                expect(!moves.empty() && moves[0].handle == a && moves[0].rect == Rect(5, 5, 20, 20), "the last move doesn't win");
+            }
+        }
+
+        // Flush commits the moves recorded so far.
+        {
+            LayoutTransaction::RecordingBackend backend;
+            {
+                LayoutTransaction transaction(backend);
+                LayoutTransaction::MoveWindow(a, Rect(0, 0, 10, 10));
+                LayoutTransaction::Flush();
+                expect(backend.commits().size() == 1, "Flush didn't commit");
+
+                Rect rect;
+                expect(!LayoutTransaction::GetPendingRect(a, rect), "a flushed move is still pending");
+                LayoutTransaction::MoveWindow(c, Rect(0, 0, 30, 30));
+            }
+            expect(backend.commits().size() == 2, "the moves after Flush were not committed");
+        }
+
+        // Nothing is committed if nothing moved.
+        {
+            LayoutTransaction::RecordingBackend backend;
+            {
+                LayoutTransaction transaction(backend);
+            }
+            expect(backend.commits().empty(), "empty commit");
+        }
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,28 @@
+#ifndef LAYOUTTRANSACTIONTEST_H_INCLUDED
+#define LAYOUTTRANSACTIONTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests the bookkeeping of LayoutTransaction using the RecordingBackend.
+     * No windows are created: the handles are just distinct addresses.
+     */
+    class LayoutTransactionTest : public UnitTest
+    {
+    public:
+        LayoutTransactionTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // LAYOUTTRANSACTIONTEST_H_INCLUDED
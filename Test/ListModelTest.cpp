@@ -0,0 +1,168 @@
+#include "ListModelTest.h"
+#include "XULWin/ListModel.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Records the notifications of a list model.
+        class RecordingListener : public ListModel::Listener
+        {
+        public:
+            struct Notification
+            {
+                Notification(ListModel::Change inChange, size_t inRow, size_t inCount) :
+                    change(inChange),
+                    row(inRow),
+                    count(inCount)
+                {
+                }
+
+                bool operator==(const Notification & rhs) const
+                {
+                    return change == rhs.change && row == rhs.row && count == rhs.count;
+                }
+
+                ListModel::Change change;
+                size_t row;
+                size_t count;
+            };
+
+            typedef std::vector<Notification> Notifications;
+
+            virtual void onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount)
+            {
+                mNotifications.push_back(Notification(inChange, inRow, inCount));
+            }
+
+            // Returns true if exactly one notification was received and it matches.
+            bool received(ListModel::Change inChange, size_t inRow, size_t inCount)
+            {
+                bool result = mNotifications.size() == 1 && mNotifications[0] == Notification(inChange, inRow, inCount);
+                mNotifications.clear();
+                return result;
+            }
+
+            bool empty() const
+            {
+                return mNotifications.empty();
+            }
+
+        private:
+            Notifications mNotifications;
+        };
+
+
+        // Removes another listener from the model when it is notified.
+        class RemovingListener : public ListModel::Listener
+        {
+        public:
+            RemovingListener(ListModel & inModel, ListModel::Listener * inOther) :
+                mModel(inModel),
+                mOther(inOther)
+            {
+            }
+
+            virtual void onListModelChanged(ListModel::Change, size_t, size_t)
+            {
+                mModel.removeListener(this);
+                mModel.removeListener(mOther);
+            }
+
+        private:
+            ListModel & mModel;
+            ListModel::Listener * mOther;
+        };
+
+
+        ListModel::Row MakeRow(const std::string & inLabel)
+        {
+            return ListModel::Row(1, ListModel::Cell(inLabel));
+        }
+
+    } // anonymous namespace
+
+
+    ListModelTest::ListModelTest() :
+        UnitTest("ListModel")
+    {
+    }
+
+
+    void ListModelTest::runTestCases()
+    {
+        ListModel model;
+        RecordingListener listener;
+        model.addListener(&listener);
+
+        // Inserting rows
+        model.appendRow(MakeRow("b"));
+        expect(listener.received(ListModel::Change_RowsInserted, 0, 1), "appendRow notification");
+        model.appendRow(MakeRow("d"));
+        expect(listener.received(ListModel::Change_RowsInserted, 1, 1), "appendRow notification");
+        model.insertRow(0, MakeRow("a"));
+        expect(listener.received(ListModel::Change_RowsInserted, 0, 1), "insertRow notification");
+        model.insertRow(2, MakeRow("c"));
+        expect(listener.received(ListModel::Change_RowsInserted, 2, 1), "insertRow notification");
+        expect(model.rowCount() == 4, "wrong row count after inserting");
+        expect(model.getLabel(0, 0) == "a" && model.getLabel(1, 0) == "b" &&
+               model.getLabel(2, 0) == "c" && model.getLabel(3, 0) == "d", "the rows are not in insertion order");
+
+        // Out of range lookups
+        expect(model.getRow(4).empty(), "getRow out of range is not empty");
+        expect(model.getLabel(0, 1).empty(), "getLabel out of range is not empty");
+        expect(model.getImage(9, 0).empty(), "getImage out of range is not empty");
+        expect(model.columnCount(9) == 0, "columnCount out of range is not zero");
+
+        // Changing rows
+        model.setRow(1, MakeRow("B"));
+        expect(listener.received(ListModel::Change_RowChanged, 1, 1), "setRow notification");
+        expect(model.getLabel(1, 0) == "B", "setRow didn't replace the row");
+
+        model.setLabel(2, 2, "c2");
+        expect(listener.received(ListModel::Change_RowChanged, 2, 1), "setLabel notification");
+        expect(model.columnCount(2) == 3, "setLabel didn't extend the row");
+        expect(model.getLabel(2, 1).empty() && model.getLabel(2, 2) == "c2", "setLabel set the wrong cell");
+
+        model.setImage(3, 1, "d.png");
+        expect(listener.received(ListModel::Change_RowChanged, 3, 1), "setImage notification");
+        expect(model.getImage(3, 1) == "d.png" && model.getLabel(3, 0) == "d", "setImage set the wrong cell");
+
+        // Removing rows
+        model.removeRow(0);
+        expect(listener.received(ListModel::Change_RowsRemoved, 0, 1), "removeRow notification");
+        expect(model.rowCount() == 3 && model.getLabel(0, 0) == "B", "removeRow removed the wrong row");
+
+        // Replacing all rows
+        ListModel::Rows rows;
+        rows.push_back(MakeRow("x"));
+        rows.push_back(MakeRow("y"));
+        model.setRows(rows);
+        expect(listener.received(ListModel::Change_Reset, 0, 0), "setRows notification");
+        expect(model.rowCount() == 2 && model.getLabel(1, 0) == "y", "setRows didn't replace the rows");
+
+        model.clear();
+        expect(listener.received(ListModel::Change_Reset, 0, 0), "clear notification");
+        expect(model.rowCount() == 0, "clear didn't remove the rows");
+
+        // Removed listeners are not notified.
+        model.removeListener(&listener);
+        model.appendRow(MakeRow("z"));
+        expect(listener.empty(), "a removed listener was notified");
+
+        // Listeners that are removed during a notification are skipped.
+        RemovingListener remover(model, &listener);
+        model.addListener(&remover);
+        model.addListener(&listener);
+        model.appendRow(MakeRow("w"));
+        expect(listener.empty(), "a listener that was removed during the notification was notified");
+        model.appendRow(MakeRow("v"));
+        expect(listener.empty(), "a removed listener was notified");
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,28 @@
+#ifndef LISTMODELTEST_H_INCLUDED
+#define LISTMODELTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests the rows and the change notifications of ListModel.
+     * The model does not depend on the Windows API, so no windows are created.
+     */
+    class ListModelTest : public UnitTest
+    {
+    public:
+        ListModelTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // LISTMODELTEST_H_INCLUDED
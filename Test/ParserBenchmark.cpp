@@ -0,0 +1,204 @@
+#include "ParserBenchmark.h"
+#include "AllocationCounter.h"
+#include "XULWin/Element.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/WinUtils.h"
+#include "XULWin/XULParser.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    // Element that has no component.
+    class HeadlessElement : public Element
+    {
+    public:
+        static ElementPtr Create(const std::string & inTagName, Element * inParent, const AttributesMapping & inAttr)
+        {
+            ElementPtr result(new HeadlessElement(inTagName, inParent));
+            Initialize(result, InternTagName(inTagName), inParent, inAttr);
+            return result;
+        }
+
+    private:
+        HeadlessElement(const std::string & inTagName, Element * inParent) :
+            Element(inTagName, inParent, 0)
+        {
+        }
+    };
+
+
+    // Parser that creates HeadlessElement objects instead of using the ElementFactory.
+    class HeadlessParser : public AbstractXULParser
+    {
+    public:
+        HeadlessParser() :
+            mNumElements(0)
+        {
+        }
+
+        size_t numElements() const
+        {
+            return mNumElements;
+        }
+
+    protected:
+        virtual Element * getCurrentParentElement()
+        {
+            return mStack.empty() ? 0 : mStack.top();
+        }
+
+        virtual bool createElement(const std::string & inLocalName,
+                                   Element * inParent,
+                                   const AttributesMapping & inAttributes,
+                                   ElementPtr & outElement)
+        {
+            outElement = HeadlessElement::Create(inLocalName, inParent, inAttributes);
+            mNumElements++;
+            return true;
+        }
+
+        virtual void pushStack(ElementPtr inElement)
+        {
+            if (mStack.empty())
+            {
+                mRootElement = inElement;
+            }
+            mStack.push(inElement.get());
+        }
+
+        virtual void popStack()
+        {
+            mStack.top()->init();
+            mStack.pop();
+        }
+
+    private:
+        size_t mNumElements;
+    };
+
+
+    ParserBenchmark::Result::Result() :
+        numBytes(0),
+        numElements(0),
+        peakMemory(0)
+    {
+    }
+
+
+    ParserBenchmark::ParserBenchmark(const std::string & inPathToXULRunnerSamples) :
+        Benchmark("Parser benchmark"),
+        mPathToXULRunnerSamples(inPathToXULRunnerSamples)
+    {
+    }
+
+
+    void ParserBenchmark::measure()
+    {
+        // The sample documents: <sample>/chrome/content/*.xul
+        Poco::DirectoryIterator it(mPathToXULRunnerSamples), end;
+        for (; it != end; ++it)
+        {
+            if (!it->isDirectory())
+            {
+                continue;
+            }
+
+            Poco::Path contentDir(it->path());
+            contentDir.makeDirectory();
+            contentDir.pushDirectory("chrome");
+            contentDir.pushDirectory("content");
+            if (!Poco::File(contentDir).exists())
+            {
+                continue;
+            }
+
+            // Chrome URLs are resolved relative to the application directory.
+            WinAPI::CurrentDirectoryChanger curdir(it->path());
+            Poco::DirectoryIterator fileIt(contentDir), fileEnd;
+            for (; fileIt != fileEnd; ++fileIt)
+            {
+                if (Poco::Path(fileIt->path()).getExtension() == "xul")
+                {
+                    benchmarkFile(Poco::Path(fileIt->path()).getFileName(), fileIt->path());
+                }
+            }
+        }
+
+        benchmarkString("synthetic-10k", GetSyntheticXUL(10000));
+        benchmarkString("synthetic-100k", GetSyntheticXUL(100000));
+    }
+
+
+    void ParserBenchmark::benchmarkFile(const std::string & inName, const std::string & inPath)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = static_cast<size_t>(Poco::File(inPath).getSize());
+
+        ErrorCatcher errorCatcher;
+        HeadlessParser parser;
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        parser.parse(inPath);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numElements = parser.numElements();
+        result.seconds = GetSeconds(stopwatch);
+        result.peakMemory = allocationCounter.peakBytes();
+        mResults.push_back(result);
+    }
+
+
+    void ParserBenchmark::benchmarkString(const std::string & inName, const std::string & inXUL)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = inXUL.size();
+
+        ErrorCatcher errorCatcher;
+        HeadlessParser parser;
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        parser.parseString(inXUL);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numElements = parser.numElements();
+        result.seconds = GetSeconds(stopwatch);
+        result.peakMemory = allocationCounter.peakBytes();
+        mResults.push_back(result);
+    }
+
+
+    std::string ParserBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double seconds = r.seconds > 0 ? r.seconds : 1e-6;
+            ss << r.name << ": "
+               << r.numElements << " elements, "
+               << (r.numBytes / 1024.0) << " KB, "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.numBytes / seconds / (1024.0 * 1024.0)) << " MB/s, "
+               << (r.numElements / seconds) << " elements/s, "
+               << (r.numElements ? static_cast<double>(r.numAllocations) / r.numElements : 0.0) << " allocations/element, "
+               << "peak " << (r.peakMemory / 1024.0) << " KB\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
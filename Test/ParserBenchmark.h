@@ -0,0 +1,58 @@
+#ifndef PARSERBENCHMARK_H_INCLUDED
+#define PARSERBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Measures the cost of parsing XUL documents and building the element tree.
+     *
+     * Parses the XUL files in the chrome/content directory of each sample in
+     * the xulrunnersamples directory and synthetic documents with 10k and 100k
+     * elements. A headless element factory is used: the elements have no
+     * Component, so the numbers cover AbstractXULParser and Element::Create
+     * but no native controls.
+     *
+     * The allocation count and the peak memory are measured per document with
+     * an AllocationCounter.
+     */
+    class ParserBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numBytes;
+            size_t numElements;
+
+            // The high-water mark of the heap memory used while parsing the document.
+            size_t peakMemory;
+        };
+
+        ParserBenchmark(const std::string & inPathToXULRunnerSamples);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        void benchmarkFile(const std::string & inName, const std::string & inPath);
+
+        void benchmarkString(const std::string & inName, const std::string & inXUL);
+
+        std::string mPathToXULRunnerSamples;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // PARSERBENCHMARK_H_INCLUDED
@@ -0,0 +1,63 @@
+#include "PixelGenerator.h"
+
+
+namespace XULWin
+{
+
+    PixelGenerator::PixelGenerator() :
+        mState(1)
+    {
+    }
+
+
+    unsigned int PixelGenerator::next()
+    {
+        mState = mState * 1103515245 + 12345;
+        return (mState >> 16) & 0x7FFF;
+    }
+
+
+    unsigned int PixelGenerator::nextByte()
+    {
+        return next() & 0xFF;
+    }
+
+
+    unsigned int PixelGenerator::nextPixel()
+    {
+        unsigned int alpha = nextByte();
+        switch (next() % 4)
+        {
+            case 0: alpha = 255; break;
+            case 1: alpha = 0; break;
+            default: break;
+        }
+        unsigned int red = nextByte() * alpha / 255;
+        unsigned int green = nextByte() * alpha / 255;
+        unsigned int blue = nextByte() * alpha / 255;
+        return (alpha << 24) | (red << 16) | (green << 8) | blue;
+    }
+
+
+    void PixelGenerator::getPixels(size_t inCount, std::vector<unsigned int> & outPixels)
+    {
+        outPixels.resize(inCount);
+        for (size_t idx = 0; idx != outPixels.size(); ++idx)
+        {
+            outPixels[idx] = nextPixel();
+        }
+    }
+
+
+    void PixelGenerator::getCoverage(size_t inCount, std::vector<unsigned char> & outCoverage)
+    {
+        outCoverage.resize(inCount);
+        for (size_t idx = 0; idx != outCoverage.size(); ++idx)
+        {
+            unsigned int r = next() % 8;
+            outCoverage[idx] = static_cast<unsigned char>(r == 0 ? 0 : (r == 1 ? nextByte() : 255));
+        }
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,48 @@
+#ifndef PIXELGENERATOR_H_INCLUDED
+#define PIXELGENERATOR_H_INCLUDED
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Generates premultiplied pixels and coverage values for the compositing
+     * test and benchmark. A linear congruential generator is used, so every
+     * run gets the same values.
+     */
+    class PixelGenerator
+    {
+    public:
+        PixelGenerator();
+
+        /**
+         * Returns a premultiplied pixel. A quarter of them is opaque and a
+         * quarter is fully transparent.
+         */
+        unsigned int nextPixel();
+
+        void getPixels(size_t inCount, std::vector<unsigned int> & outPixels);
+
+        /**
+         * The coverage of a span of an anti-aliased shape: mostly fully
+         * covered, with partially covered pixels at the edges.
+         */
+        void getCoverage(size_t inCount, std::vector<unsigned char> & outCoverage);
+
+    private:
+        unsigned int next();
+
+        unsigned int nextByte();
+
+        unsigned int mState;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // PIXELGENERATOR_H_INCLUDED
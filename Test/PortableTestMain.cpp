@@ -0,0 +1,30 @@
+#include "PortableTests.h"
+#include "XULWin/ErrorReporter.h"
+#include <iostream>
+#include <string>
+
+
+// Entry point of the portable test runner, see Scripts/PortableTests.
+// Expects the path to the xulrunnersamples directory. Silent unless a test
+// fails, in which case the failures are written to stdout and the exit
+// code is 1. With --bench the benchmarks are run after the tests and their
+// reports are written to stdout.
+int main(int argc, char * argv[])
+{
+    bool runBenchmarks = argc == 3 && std::string(argv[1]) == "--bench";
+    if (argc != 2 && !runBenchmarks)
+    {
+        std::cerr << "Usage: " << argv[0] << " [--bench] <path to xulrunnersamples>" << std::endl;
+        return 2;
+    }
+    std::string pathToXULRunnerSamples(argv[argc - 1]);
+
+    XULWin::ErrorReporter::Initialize();
+    size_t numFailures = XULWin::RunPortableTests(pathToXULRunnerSamples, std::cout);
+    if (runBenchmarks)
+    {
+        XULWin::RunPortableBenchmarks(pathToXULRunnerSamples, std::cout);
+    }
+    XULWin::ErrorReporter::Finalize();
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include "PortableTests.h"
+#include "CompositingBenchmark.h"
+#include "CompositingTest.h"
+#include "HeadlessLayoutBenchmark.h"
+#include "HeadlessLayoutTest.h"
+#include "HeadlessParserBenchmark.h"
+#include "LayoutSnapshotTest.h"
+#include "LayoutTest.h"
+#include "ListModelTest.h"
+#include "SVGPathTest.h"
+#include "SVGRenderBenchmark.h"
+#include "SVGRenderTest.h"
+#include "ViewportTest.h"
+#include <ostream>
+
+
+namespace XULWin
+{
+
+    size_t RunPortableTests(const std::string & inPathToXULRunnerSamples, std::ostream & outReport)
+    {
+        ListModelTest listModelTest;
+        LayoutTest layoutTest;
+        HeadlessLayoutTest headlessLayoutTest;
+        LayoutSnapshotTest layoutSnapshotTest(inPathToXULRunnerSamples);
+        SVGPathTest svgPathTest(100000);
+        SVGRenderTest svgRenderTest(inPathToXULRunnerSamples);
+        CompositingTest compositingTest;
+        ViewportTest viewportTest;
+        UnitTest * tests[] =
+        {
+            &listModelTest,
+            &layoutTest,
+            &headlessLayoutTest,
+            &layoutSnapshotTest,
+            &svgPathTest,
+            &svgRenderTest,
+            &compositingTest,
+            &viewportTest
+        };
+
+        size_t numFailures = 0;
+        for (size_t idx = 0; idx != sizeof(tests) / sizeof(tests[0]); ++idx)
+        {
+            numFailures += tests[idx]->run(outReport);
+        }
+        return numFailures;
+    }
+
+
+    void RunPortableBenchmarks(const std::string & inPathToXULRunnerSamples, std::ostream & outReport)
+    {
+        HeadlessParserBenchmark headlessParserBenchmark(inPathToXULRunnerSamples);
+        HeadlessLayoutBenchmark headlessLayoutBenchmark(1000);
+        SVGRenderBenchmark svgRenderBenchmark(100, inPathToXULRunnerSamples);
+        CompositingBenchmark compositingBenchmark(100000);
+        Benchmark * benchmarks[] =
+        {
+            &headlessParserBenchmark,
+            &headlessLayoutBenchmark,
+            &svgRenderBenchmark,
+            &compositingBenchmark
+        };
+
+        for (size_t idx = 0; idx != sizeof(benchmarks) / sizeof(benchmarks[0]); ++idx)
+        {
+            outReport << (idx == 0 ? "" : "\n") << benchmarks[idx]->name() << "\n" << benchmarks[idx]->run();
+        }
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,35 @@
+#ifndef PORTABLETESTS_H_INCLUDED
+#define PORTABLETESTS_H_INCLUDED
+
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+
+namespace XULWin
+{
+
+    /**
+     * Runs the tests that don't need Windows and writes the failed
+     * expectations to outReport. Returns the number of failures.
+     *
+     * The test application runs them together with the tests that create
+     * windows. PortableTestMain runs them on other platforms, see
+     * Scripts/PortableTests.
+     */
+    size_t RunPortableTests(const std::string & inPathToXULRunnerSamples, std::ostream & outReport);
+
+
+    /**
+     * Runs the benchmarks that don't need Windows and writes their reports
+     * to outReport. PortableTestMain runs them when it gets the --bench
+     * switch.
+     */
+    void RunPortableBenchmarks(const std::string & inPathToXULRunnerSamples, std::ostream & outReport);
+
+
+} // namespace XULWin
+
+
+#endif // PORTABLETESTS_H_INCLUDED
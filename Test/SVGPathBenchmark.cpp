@@ -0,0 +1,134 @@
+#include "SVGPathBenchmark.h"
+#include "AllocationCounter.h"
+#include "XULWin/Conversions.h"
+#include "XULWin/SVGPathInstructions.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Paths from the svg sample.
+        const char * cSamplePaths[] =
+        {
+            "M250 150 L150 350 L350 350 Z",
+            "M205.2,17.1c-33.6-9.7-42,19.1-48.2,22.6c-6.2,3.5-27.9,2.2-33.3,5.8c-5.3,3.5-17.3,23.5-8.4,41.6"
+            "c8.9,18.2,32.3,10.2,32.3,10.2s-10.6,11.1-29.7,19.9C191.6,1.4,204.3,14.9,205.2,17.1z",
+            "M186.2,26s-2.3, 5.9 -5.2, 5.9S186.2,29.2 186.2,26z",
+            "m.5.5.5-1e2-2E-1 1 h10v-5.5 a25,25 -30 0,1 50,-25 A1 1 0 0010 10 q1 2 3 4 t5 6 Z"
+        };
+
+        template<class T, size_t N>
+        size_t ArraySize(T (&)[N])
+        {
+            return N;
+        }
+
+
+        std::string CreateLargePath(size_t inNumBytes)
+        {
+            std::string result;
+            result.reserve(inNumBytes + 1024);
+            result += "M0,0";
+            while (result.size() < inNumBytes)
+            {
+                for (size_t idx = 0; idx != ArraySize(cSamplePaths); ++idx)
+                {
+                    result += cSamplePaths[idx];
+                }
+            }
+            return result;
+        }
+
+    }
+
+
+    SVGPathBenchmark::Result::Result() :
+        numBytes(0),
+        numCommands(0)
+    {
+    }
+
+
+    SVGPathBenchmark::SVGPathBenchmark() :
+        Benchmark("SVG path benchmark")
+    {
+    }
+
+
+    void SVGPathBenchmark::measure()
+    {
+        std::string small(CreateLargePath(64 * 1024));
+        std::string large(CreateLargePath(4 * 1024 * 1024));
+        benchmarkPathData("SVGPathData 64 KB", small);
+        benchmarkPathData("SVGPathData 4 MB", large);
+        benchmarkPathInstructions("SVGPathInstructions 64 KB", small);
+        benchmarkPathInstructions("SVGPathInstructions 4 MB", large);
+    }
+
+
+    void SVGPathBenchmark::benchmarkPathData(const std::string & inName, const std::string & inPath)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = inPath.size();
+
+        SVGPathData data;
+        const char * begin = inPath.data();
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        ParseSVGPathData(begin, begin + inPath.size(), data);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numCommands = data.numCommands();
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+    }
+
+
+    void SVGPathBenchmark::benchmarkPathInstructions(const std::string & inName, const std::string & inPath)
+    {
+        Result result;
+        result.name = inName;
+        result.numBytes = inPath.size();
+
+        AllocationCounter allocationCounter;
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        SVGPathInstructions instructions = String2SVGPathInstructions(inPath);
+        stopwatch.stop();
+
+        result.numAllocations = allocationCounter.numAllocations();
+        result.numCommands = instructions.size();
+        result.seconds = GetSeconds(stopwatch);
+        mResults.push_back(result);
+    }
+
+
+    std::string SVGPathBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double seconds = r.seconds > 0 ? r.seconds : 1e-6;
+            ss << r.name << ": "
+               << r.numCommands << " commands, "
+               << (r.seconds * 1000.0) << " ms, "
+               << (r.numBytes / seconds / (1024.0 * 1024.0)) << " MB/s, "
+               << (r.numCommands / seconds) << " commands/s, "
+               << r.numAllocations << " allocations\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,47 @@
+#ifndef SVGPATHBENCHMARK_H_INCLUDED
+#define SVGPATHBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Measures the SVG path data parser on large generated path strings,
+     * both into SVGPathData and through String2SVGPathInstructions. The
+     * parser is checked by SVGPathTest.
+     */
+    class SVGPathBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numBytes;
+            size_t numCommands;
+        };
+
+        SVGPathBenchmark();
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        void benchmarkPathData(const std::string & inName, const std::string & inPath);
+
+        void benchmarkPathInstructions(const std::string & inName, const std::string & inPath);
+
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // SVGPATHBENCHMARK_H_INCLUDED
@@ -0,0 +1,203 @@
+#include "SVGPathTest.h"
+#include "XULWin/Conversions.h"
+#include "XULWin/SVGPathInstructions.h"
+#include <cstring>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Paths from the svg sample.
+        const char * cSamplePaths[] =
+        {
+            "M250 150 L150 350 L350 350 Z",
+            "M205.2,17.1c-33.6-9.7-42,19.1-48.2,22.6c-6.2,3.5-27.9,2.2-33.3,5.8c-5.3,3.5-17.3,23.5-8.4,41.6"
+            "c8.9,18.2,32.3,10.2,32.3,10.2s-10.6,11.1-29.7,19.9C191.6,1.4,204.3,14.9,205.2,17.1z",
+            "M186.2,26s-2.3, 5.9 -5.2, 5.9S186.2,29.2 186.2,26z",
+            "m.5.5.5-1e2-2E-1 1 h10v-5.5 a25,25 -30 0,1 50,-25 A1 1 0 0010 10 q1 2 3 4 t5 6 Z"
+        };
+
+        const char cFuzzAlphabet[] = "MmLlHhVvCcSsQqTtAaZz0123456789.-+eE, \t\n";
+
+
+        // Path data with the expected result of ParseSVGPathData. The
+        // expected commands are written in the format of Describe.
+        struct PathCase
+        {
+            const char * path;
+            bool valid;
+            const char * expected;
+        };
+
+        const PathCase cPathCases[] =
+        {
+            // Implicitly repeated commands
+            { "M1,2,3,4", true, "M1,2 L3,4" },
+            { "m1 2 3 4 5 6", true, "m1,2 l3,4 l5,6" },
+            { "M0 0l1 2 3 4", true, "M0,0 l1,2 l3,4" },
+            { "M0 0h1 2 3", true, "M0,0 h1 h2 h3" },
+            { "M1 2zm3 4", true, "M1,2 z m3,4" },
+            { "M1,2 3,4 Z", true, "M1,2 L3,4 Z" },
+
+            // Numbers without whitespace between them
+            { "M.5.5.5-1e2-2E-1 1", true, "M0.5,0.5 L0.5,-100 L-0.2,1" },
+            { "M1e2.5", true, "M100,0.5" },
+            { "M1-2", true, "M1,-2" },
+
+            // Arc flags don't need a separator
+            { "M0 0a25,25 -30 0,1 50,-25", true, "M0,0 a25,25,-30,0,1,50,-25" },
+            { "M0 0A1 1 0 0010 10", true, "M0,0 A1,1,0,0,0,10,10" },
+            { "M0 0A1 1 0 1110 10", true, "M0,0 A1,1,0,1,1,10,10" },
+            { "M0 0A1 1 0 2 1 10 10", false, "" },
+
+            // Errors
+            { "L1 2", false, "" },
+            { "M1", false, "" },
+            { "M1,2,", false, "" },
+            { "M1,2 ,", false, "" },
+            { "M1,2,L3,4", false, "" },
+            { "M,1,2", false, "" },
+            { "M1,2Z,", false, "" }
+        };
+
+
+        template<class T, size_t N>
+        size_t ArraySize(T (&)[N])
+        {
+            return N;
+        }
+
+
+        // Small deterministic generator so that failures can be reproduced.
+        class Random
+        {
+        public:
+            Random(unsigned int inSeed) : mState(inSeed) {}
+
+            size_t next(size_t inRange)
+            {
+                mState = mState * 1103515245 + 12345;
+                return (mState >> 16) % inRange;
+            }
+
+        private:
+            unsigned int mState;
+        };
+
+
+        // Checks that every command has exactly its number of arguments.
+        bool IsConsistent(const SVGPathData & inData)
+        {
+            size_t offset = 0;
+            for (size_t idx = 0; idx != inData.numCommands(); ++idx)
+            {
+                const SVGPathData::Command & command = inData.getCommand(idx);
+                if (command.offset != offset)
+                {
+                    return false;
+                }
+                offset += SVGPathData::GetNumArguments(command.type);
+            }
+            return offset == inData.values().size();
+        }
+
+
+        // Writes the commands as their letter followed by the comma separated
+        // arguments, for example "M1,2 l3,4 z".
+        std::string Describe(const SVGPathData & inData)
+        {
+            static const char cLetters[] = "MLHVCSQTAZ";
+            std::stringstream ss;
+            for (size_t idx = 0; idx != inData.numCommands(); ++idx)
+            {
+                const SVGPathData::Command & command = inData.getCommand(idx);
+                char letter = cLetters[command.type];
+                if (command.positioning == PathInstruction::Relative)
+                {
+                    letter = static_cast<char>(letter | 0x20);
+                }
+                ss << (idx == 0 ? "" : " ") << letter;
+
+                const float * values = inData.getValues(idx);
+                for (size_t valueIdx = 0; valueIdx != SVGPathData::GetNumArguments(command.type); ++valueIdx)
+                {
+                    ss << (valueIdx == 0 ? "" : ",") << values[valueIdx];
+                }
+            }
+            return ss.str();
+        }
+
+    }
+
+
+    SVGPathTest::SVGPathTest(size_t inNumFuzzIterations) :
+        UnitTest("ParseSVGPathData"),
+        mNumFuzzIterations(inNumFuzzIterations)
+    {
+    }
+
+
+    void SVGPathTest::runTestCases()
+    {
+        SVGPathData data;
+        for (size_t idx = 0; idx != ArraySize(cPathCases); ++idx)
+        {
+            const PathCase & pathCase = cPathCases[idx];
+            const char * begin = pathCase.path;
+            bool valid = ParseSVGPathData(begin, begin + strlen(begin), data);
+            expect(valid == pathCase.valid && (!valid || Describe(data) == pathCase.expected),
+                   "unexpected result for path data: " + std::string(pathCase.path));
+        }
+
+        // Converting the instructions back to a string gives the same path.
+        for (size_t idx = 0; idx != ArraySize(cSamplePaths); ++idx)
+        {
+            std::string path = SVGPathInstructions2String(String2SVGPathInstructions(cSamplePaths[idx]));
+            const char * begin = path.data();
+            bool valid = ParseSVGPathData(begin, begin + path.size(), data);
+            std::string expected = Describe(data);
+            begin = cSamplePaths[idx];
+            expect(valid && ParseSVGPathData(begin, begin + strlen(begin), data) && Describe(data) == expected,
+                   "SVGPathInstructions2String changed the path: " + path);
+        }
+
+        Random random(1);
+        std::string input;
+        for (size_t idx = 0; idx != mNumFuzzIterations; ++idx)
+        {
+            // Alternate between random strings and mutated sample paths.
+            if (idx % 2 == 0)
+            {
+                input.resize(random.next(64));
+                for (size_t charIdx = 0; charIdx != input.size(); ++charIdx)
+                {
+                    input[charIdx] = cFuzzAlphabet[random.next(sizeof(cFuzzAlphabet) - 1)];
+                }
+            }
+            else
+            {
+                input = cSamplePaths[random.next(ArraySize(cSamplePaths))];
+                for (size_t numMutations = 1 + random.next(4); numMutations != 0 && !input.empty(); --numMutations)
+                {
+                    size_t pos = random.next(input.size());
+                    switch (random.next(3))
+                    {
+                        case 0: input.erase(pos, 1); break;
+                        case 1: input.insert(pos, 1, cFuzzAlphabet[random.next(sizeof(cFuzzAlphabet) - 1)]); break;
+                        case 2: input[pos] = cFuzzAlphabet[random.next(sizeof(cFuzzAlphabet) - 1)]; break;
+                    }
+                }
+            }
+
+            const char * begin = input.data();
+            ParseSVGPathData(begin, begin + input.size(), data);
+            expect(IsConsistent(data), "inconsistent result for path data: " + input);
+        }
+    }
+
+
+} // namespace XULWin
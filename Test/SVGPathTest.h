@@ -0,0 +1,34 @@
+#ifndef SVGPATHTEST_H_INCLUDED
+#define SVGPATHTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests and fuzzes the SVG path data parser.
+     *
+     * First checks the result of ParseSVGPathData for a list of known
+     * inputs. Then it feeds random and mutated path strings to it and checks
+     * that the resulting command buffer is consistent.
+     */
+    class SVGPathTest : public UnitTest
+    {
+    public:
+        SVGPathTest(size_t inNumFuzzIterations);
+
+    protected:
+        virtual void runTestCases();
+
+    private:
+        size_t mNumFuzzIterations;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // SVGPATHTEST_H_INCLUDED
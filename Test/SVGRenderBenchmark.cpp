@@ -0,0 +1,72 @@
+#include "SVGRenderBenchmark.h"
+#include "SVGSample.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/SVGRasterizer.h"
+#include "Poco/Stopwatch.h"
+#include <iomanip>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    SVGRenderBenchmark::Result::Result() :
+        numFrames(0),
+        numPixelsFilled(0)
+    {
+    }
+
+
+    SVGRenderBenchmark::SVGRenderBenchmark(size_t inNumFrames, const std::string & inPathToXULRunnerSamples) :
+        Benchmark("SVG render benchmark"),
+        mNumFrames(inNumFrames),
+        mPathToXULRunnerSamples(inPathToXULRunnerSamples)
+    {
+    }
+
+
+    void SVGRenderBenchmark::measure()
+    {
+        SVGSample sample(mPathToXULRunnerSamples);
+        if (!sample.load())
+        {
+            ReportError("SVGRenderBenchmark: failed to load the svg sample.");
+            return;
+        }
+
+        Result result;
+        result.name = "svg sample";
+        result.numFrames = mNumFrames;
+
+        SVGRasterizer image(SVGSample::Width, SVGSample::Height);
+        Poco::Stopwatch stopwatch;
+        stopwatch.start();
+        for (size_t frame = 0; frame != mNumFrames; ++frame)
+        {
+            sample.render(image);
+        }
+        stopwatch.stop();
+
+        result.seconds = GetSeconds(stopwatch);
+        result.numPixelsFilled = image.numPixelsFilled();
+        mResults.push_back(result);
+    }
+
+
+    std::string SVGRenderBenchmark::report() const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        for (size_t idx = 0; idx != mResults.size(); ++idx)
+        {
+            const Result & r = mResults[idx];
+            double seconds = r.seconds > 0 ? r.seconds : 1e-6;
+            ss << r.name << ": " << r.numFrames << " frames of " << SVGSample::Width << "x" << SVGSample::Height << ", "
+               << (r.numFrames ? seconds * 1000.0 / r.numFrames : 0.0) << " ms/frame, "
+               << (r.numPixelsFilled / seconds / 1000000.0) << " Mpixels/s filled\n";
+        }
+        return ss.str();
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,45 @@
+#ifndef SVGRENDERBENCHMARK_H_INCLUDED
+#define SVGRENDERBENCHMARK_H_INCLUDED
+
+
+#include "Benchmark.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Renders the svg sample with the software SVGRasterizer and reports the
+     * time per frame and the fill rate in megapixels per second. The
+     * rendered image is checked by SVGRenderTest.
+     */
+    class SVGRenderBenchmark : public Benchmark
+    {
+    public:
+        struct Result : public Benchmark::Result
+        {
+            Result();
+
+            size_t numFrames;
+            size_t numPixelsFilled;
+        };
+
+        SVGRenderBenchmark(size_t inNumFrames, const std::string & inPathToXULRunnerSamples);
+
+    protected:
+        virtual void measure();
+
+        virtual std::string report() const;
+
+    private:
+        size_t mNumFrames;
+        std::string mPathToXULRunnerSamples;
+        std::vector<Result> mResults;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // SVGRENDERBENCHMARK_H_INCLUDED
@@ -0,0 +1,256 @@
+#include "SVGRenderTest.h"
+#include "SVGSample.h"
+#include "XULWin/SVGPathGeometry.h"
+#include "XULWin/SVGRasterizer.h"
+#include "Poco/Path.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    // Converts a premultiplied ARGB pixel to RGBA bytes with straight alpha.
+    static void GetRGBA(unsigned int inPixel, unsigned char * outRGBA)
+    {
+        unsigned int alpha = inPixel >> 24;
+        unsigned int channels[3] = { (inPixel >> 16) & 0xFF, (inPixel >> 8) & 0xFF, inPixel & 0xFF };
+        for (size_t idx = 0; idx != 3; ++idx)
+        {
+            outRGBA[idx] = static_cast<unsigned char>(alpha ? (channels[idx] * 255 + alpha / 2) / alpha : 0);
+        }
+        outRGBA[3] = static_cast<unsigned char>(alpha);
+    }
+
+
+    static int GetWindingNumber(const Points & inPolygon, float inX, float inY)
+    {
+        int winding = 0;
+        for (size_t idx = 0; idx != inPolygon.size(); ++idx)
+        {
+            const Point & begin = inPolygon[idx];
+            const Point & end = inPolygon[(idx + 1) % inPolygon.size()];
+            if ((begin.y() <= inY) != (end.y() <= inY))
+            {
+                float x = begin.x() + (inY - begin.y()) * (end.x() - begin.x()) / (end.y() - begin.y());
+                if (x > inX)
+                {
+                    winding += end.y() > begin.y() ? 1 : -1;
+                }
+            }
+        }
+        return winding;
+    }
+
+
+    // Small deterministic generator so that failures can be reproduced.
+    static int GetRandom(unsigned int & ioState, int inRange)
+    {
+        ioState = ioState * 1103515245 + 12345;
+        return static_cast<int>((ioState >> 16) % inRange);
+    }
+
+
+    SVGRenderTest::SVGRenderTest(const std::string & inPathToXULRunnerSamples) :
+        UnitTest("SVG rendering"),
+        mPathToXULRunnerSamples(inPathToXULRunnerSamples)
+    {
+    }
+
+
+    void SVGRenderTest::runTestCases()
+    {
+        testClipping();
+
+        SVGSample sample(mPathToXULRunnerSamples);
+        if (!expect(sample.load(), "failed to load the svg sample"))
+        {
+            return;
+        }
+
+        SVGRasterizer image(SVGSample::Width, SVGSample::Height);
+        sample.render(image);
+
+        std::string goldenPath = Poco::Path(sample.directory(), "svg-golden.pam").toString();
+        std::string actualPath = Poco::Path(sample.directory(), "svg-actual.pam").toString();
+        int numDifferent = CompareImage(image, goldenPath, 2);
+        if (numDifferent != 0)
+        {
+            std::stringstream ss;
+            if (numDifferent < 0)
+            {
+                ss << "can't read " << goldenPath;
+            }
+            else
+            {
+                ss << numDifferent << " pixels differ from " << goldenPath;
+            }
+            ss << (SaveImage(image, actualPath) ? ", saved " : ", failed to save ") << actualPath;
+            expect(false, ss.str());
+        }
+    }
+
+
+    void SVGRenderTest::testClipping()
+    {
+        // Edges that cross the left border ran out of the accumulation
+        // buffer due to rounding.
+        static const int cLeft[] = { 47, 40, -18, 9, 56, 8, 30, 22, 31, 16, -3, 15 };
+        Points polygon;
+        for (size_t idx = 0; idx + 1 < sizeof(cLeft) / sizeof(cLeft[0]); idx += 2)
+        {
+            polygon.push_back(Point(cLeft[idx], cLeft[idx + 1]));
+        }
+        testFill(3, 28, polygon);
+
+        // A diamond that crosses all four borders.
+        polygon.clear();
+        polygon.push_back(Point(10, -6));
+        polygon.push_back(Point(27, 5));
+        polygon.push_back(Point(10, 16));
+        polygon.push_back(Point(-7, 5));
+        testFill(20, 10, polygon);
+
+        // Random polygons around small images.
+        unsigned int state = 1;
+        for (size_t idx = 0; idx != 2000; ++idx)
+        {
+            int width = 1 + GetRandom(state, 8);
+            int height = 1 + GetRandom(state, 8);
+            polygon.clear();
+            int numPoints = 3 + GetRandom(state, 5);
+            for (int pointIdx = 0; pointIdx != numPoints; ++pointIdx)
+            {
+                polygon.push_back(Point(GetRandom(state, 3 * width + 1) - width,
+                                        GetRandom(state, 3 * height + 1) - height));
+            }
+            testFill(width, height, polygon);
+        }
+    }
+
+
+    void SVGRenderTest::testFill(int inWidth, int inHeight, const Points & inPolygon)
+    {
+        SVGPathGeometry geometry;
+        geometry.buildPolygon(inPolygon);
+        SVGRasterizer image(inWidth, inHeight);
+        image.fillPath(geometry, RGBColor(0, 0, 0));
+
+        const int cNumSamples = 16;
+        for (int y = 0; y != inHeight; ++y)
+        {
+            for (int x = 0; x != inWidth; ++x)
+            {
+                // The rasterizer uses the average winding number as the
+                // coverage, which is exact where the polygon doesn't
+                // overlap itself.
+                int winding = 0;
+                for (int sampleY = 0; sampleY != cNumSamples; ++sampleY)
+                {
+                    for (int sampleX = 0; sampleX != cNumSamples; ++sampleX)
+                    {
+                        winding += GetWindingNumber(inPolygon, x + (sampleX + 0.5f) / cNumSamples, y + (sampleY + 0.5f) / cNumSamples);
+                    }
+                }
+
+                int expected = std::min<int>(std::abs(winding) * 255 / (cNumSamples * cNumSamples), 255);
+                int alpha = static_cast<int>(image.pixels()[y * inWidth + x] >> 24);
+                if (std::abs(alpha - expected) > 16)
+                {
+                    std::stringstream ss;
+                    ss << "pixel " << x << "," << y << " of a " << inWidth << "x" << inHeight
+                       << " image has alpha " << alpha << " instead of " << expected << " for the polygon";
+                    for (size_t idx = 0; idx != inPolygon.size(); ++idx)
+                    {
+                        ss << " " << inPolygon[idx].x() << "," << inPolygon[idx].y();
+                    }
+                    expect(false, ss.str());
+                    return;
+                }
+            }
+        }
+    }
+
+
+    bool SVGRenderTest::SaveImage(const SVGRasterizer & inImage, const std::string & inPath)
+    {
+        std::ofstream file(inPath.c_str(), std::ios::out | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        file << "P7\nWIDTH " << inImage.width() << "\nHEIGHT " << inImage.height()
+             << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+        std::vector<unsigned char> row(4 * inImage.width());
+        for (int y = 0; y != inImage.height(); ++y)
+        {
+            const unsigned int * pixels = inImage.pixels() + y * inImage.width();
+            for (int x = 0; x != inImage.width(); ++x)
+            {
+                GetRGBA(pixels[x], &row[4 * x]);
+            }
+            file.write(reinterpret_cast<const char *>(&row[0]), row.size());
+        }
+        return file.good();
+    }
+
+
+    int SVGRenderTest::CompareImage(const SVGRasterizer & inImage, const std::string & inPath, int inTolerance)
+    {
+        std::ifstream file(inPath.c_str(), std::ios::in | std::ios::binary);
+        int width = 0;
+        int height = 0;
+        std::string line;
+        while (std::getline(file, line) && line != "ENDHDR")
+        {
+            std::istringstream fields(line);
+            std::string key;
+            fields >> key;
+            if (key == "WIDTH")
+            {
+                fields >> width;
+            }
+            else if (key == "HEIGHT")
+            {
+                fields >> height;
+            }
+        }
+
+        if (!file || width != inImage.width() || height != inImage.height())
+        {
+            return -1;
+        }
+
+        int numDifferent = 0;
+        std::vector<unsigned char> golden(4 * width);
+        unsigned char rgba[4];
+        for (int y = 0; y != height; ++y)
+        {
+            if (!file.read(reinterpret_cast<char *>(&golden[0]), golden.size()))
+            {
+                return -1;
+            }
+
+            const unsigned int * pixels = inImage.pixels() + y * width;
+            for (int x = 0; x != width; ++x)
+            {
+                GetRGBA(pixels[x], rgba);
+                for (size_t channel = 0; channel != 4; ++channel)
+                {
+                    if (std::abs(rgba[channel] - golden[4 * x + channel]) > inTolerance)
+                    {
+                        numDifferent++;
+                        break;
+                    }
+                }
+            }
+        }
+        return numDifferent;
+    }
+
+
+} // namespace XULWin
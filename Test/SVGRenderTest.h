@@ -0,0 +1,58 @@
+#ifndef SVGRENDERTEST_H_INCLUDED
+#define SVGRENDERTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+#include "XULWin/Point.h"
+
+
+namespace XULWin
+{
+
+    class SVGRasterizer;
+
+
+    /**
+     * Renders the svg sample with the software SVGRasterizer and compares
+     * the result with the checked in xulrunnersamples/svg/svg-golden.pam,
+     * so that changes to the rasterizer or the SVG components that alter the
+     * output are noticed.
+     *
+     * A missing or different golden image is a failure. The rendered image
+     * is then saved as svg-actual.pam in the same directory, so that it can
+     * be inspected and copied over the golden image to accept the change.
+     *
+     * Also checks the coverage of shapes that stick out of the image on
+     * every side, where the rasterizer clips the edges.
+     */
+    class SVGRenderTest : public UnitTest
+    {
+    public:
+        SVGRenderTest(const std::string & inPathToXULRunnerSamples);
+
+    protected:
+        virtual void runTestCases();
+
+    private:
+        void testClipping();
+
+        // Fills the polygon in black on a transparent image and compares the
+        // alpha of each pixel with the winding numbers of 16x16 samples.
+        void testFill(int inWidth, int inHeight, const Points & inPolygon);
+
+        // Writes the image as PAM file with RGB_ALPHA tuples.
+        static bool SaveImage(const SVGRasterizer & inImage, const std::string & inPath);
+
+        // Returns the number of pixels that differ by more than inTolerance
+        // in any channel, or -1 if the golden image can't be read or has a
+        // different size.
+        static int CompareImage(const SVGRasterizer & inImage, const std::string & inPath, int inTolerance);
+
+        std::string mPathToXULRunnerSamples;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // SVGRENDERTEST_H_INCLUDED
@@ -0,0 +1,170 @@
+#include "SVGSample.h"
+#include "XULWin/Conversions.h"
+#include "XULWin/SVGRasterizer.h"
+#include "XULWin/SVGShape.h"
+#include "XULWin/StyleDeclarations.h"
+#include "Poco/Path.h"
+
+
+namespace XULWin
+{
+
+    static void FindSVGs(const HeadlessNode * inNode, std::vector<const HeadlessNode *> & outSVGs)
+    {
+        if (inNode->tagName() == "svg")
+        {
+            outSVGs.push_back(inNode);
+            return;
+        }
+
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            FindSVGs(inNode->getChild(idx), outSVGs);
+        }
+    }
+
+
+    // The SVGStyleNode of a node of the sample. It lives on the stack of
+    // SVGSample::Paint, like the chain of its parents.
+    class HeadlessStyleNode : public SVGStyleNode
+    {
+    public:
+        HeadlessStyleNode(const HeadlessNode * inNode, const SVGStyleNode * inParent) :
+            mNode(inNode),
+            mParent(inParent)
+        {
+        }
+
+        const HeadlessNode * node() const
+        {
+            return mNode;
+        }
+
+        virtual const SVGStyleNode * SVGStyleNode_parent() const
+        {
+            return mParent;
+        }
+
+        virtual bool SVGStyleNode_getCSSFill(RGBColor & outColor) const
+        {
+            const StyleDeclaration * fill = StyleDeclarations::Get(mNode->attributes()).find(CSSProperty_Fill);
+            if (fill && fill->hasColor())
+            {
+                outColor = fill->color();
+                return true;
+            }
+            return false;
+        }
+
+        virtual bool SVGStyleNode_getFill(RGBColor & outColor) const
+        {
+            return String2RGBColor(mNode->getAttribute("fill"), outColor);
+        }
+
+        virtual bool SVGStyleNode_getStroke(RGBColor & outColor) const
+        {
+            return String2RGBColor(mNode->getAttribute("stroke"), outColor);
+        }
+
+        virtual bool SVGStyleNode_getStrokeWidth(int & outWidth) const
+        {
+            const std::string & strokeWidth = mNode->getAttribute("stroke-width");
+            if (strokeWidth.empty())
+            {
+                return false;
+            }
+            outWidth = String2Int(strokeWidth, 1);
+            return true;
+        }
+
+    private:
+        const HeadlessNode * mNode;
+        const SVGStyleNode * mParent;
+    };
+
+
+    SVGSample::SVGSample(const std::string & inPathToXULRunnerSamples) :
+        mLayout(mTextMetrics)
+    {
+        Poco::Path directory(inPathToXULRunnerSamples);
+        directory.makeDirectory();
+        directory.pushDirectory("svg");
+        mDirectory = directory.toString();
+    }
+
+
+    const std::string & SVGSample::directory() const
+    {
+        return mDirectory;
+    }
+
+
+    bool SVGSample::load()
+    {
+        mSVGs.clear();
+
+        Poco::Path path(mDirectory);
+        path.pushDirectory("chrome");
+        path.pushDirectory("content");
+        path.setFileName("svg.xul");
+        if (!mLayout.loadFile(path.toString()))
+        {
+            return false;
+        }
+        mLayout.layout(Width, Height);
+        FindSVGs(mLayout.rootNode(), mSVGs);
+        return true;
+    }
+
+
+    void SVGSample::render(SVGRasterizer & ioImage) const
+    {
+        ioImage.clear(RGBColor(255, 255, 255));
+        for (size_t idx = 0; idx != mSVGs.size(); ++idx)
+        {
+            HeadlessStyleNode svg(mSVGs[idx], 0);
+            for (size_t childIdx = 0; childIdx != svg.node()->getChildCount(); ++childIdx)
+            {
+                Paint(svg.node()->getChild(childIdx), &svg, ioImage);
+            }
+        }
+    }
+
+
+    void SVGSample::Paint(const HeadlessNode * inNode, const SVGStyleNode * inParent, SVGRenderer & ioRenderer)
+    {
+        HeadlessStyleNode style(inNode, inParent);
+        if (inNode->tagName() == "g")
+        {
+            for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+            {
+                Paint(inNode->getChild(idx), &style, ioRenderer);
+            }
+        }
+        else if (inNode->tagName() == "polygon")
+        {
+            SVGShape shape(SVGShape::Type_Polygon);
+            shape.setPoints(String2Points(inNode->getAttribute("points")));
+            shape.paint(style, ioRenderer);
+        }
+        else if (inNode->tagName() == "rect")
+        {
+            SVGShape shape(SVGShape::Type_Rect);
+            shape.setRect(RectF(static_cast<float>(String2Int(inNode->getAttribute("x"), 0)),
+                                static_cast<float>(String2Int(inNode->getAttribute("y"), 0)),
+                                static_cast<float>(String2Int(inNode->getAttribute("width"), 0)),
+                                static_cast<float>(String2Int(inNode->getAttribute("height"), 0))));
+            shape.paint(style, ioRenderer);
+        }
+        else if (inNode->tagName() == "path")
+        {
+            SVGPathData data;
+            String2SVGPathData(inNode->getAttribute("d"), data);
+            SVGShape shape(SVGShape::Type_Path);
+            shape.setPathData(data);
+            shape.paint(style, ioRenderer);
+        }
+    }
+
+
+} // namespace XULWin
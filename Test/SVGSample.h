@@ -0,0 +1,70 @@
+#ifndef SVGSAMPLE_H_INCLUDED
+#define SVGSAMPLE_H_INCLUDED
+
+
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/TextMetrics.h"
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    class SVGRasterizer;
+    class SVGRenderer;
+    class SVGStyleNode;
+
+
+    /**
+     * The svg sample of the xulrunnersamples directory, loaded with
+     * HeadlessLayout and FixedTextMetrics. No components or windows are
+     * created, so it also runs without Windows, and the rendered image is
+     * the same on every machine.
+     *
+     * The SVG elements are painted with SVGShape, like the SVG components
+     * paint them. Like the SVGCanvas of each svg element, the children are
+     * painted in their own coordinates.
+     */
+    class SVGSample : boost::noncopyable
+    {
+    public:
+        static const int Width = 600;
+        static const int Height = 400;
+
+        SVGSample(const std::string & inPathToXULRunnerSamples);
+
+        /**
+         * The directory of the sample.
+         */
+        const std::string & directory() const;
+
+        /**
+         * Loads the sample and lays it out in a Width x Height window.
+         * Returns false if the document can't be loaded.
+         */
+        bool load();
+
+        /**
+         * Clears the image to white and renders the svg elements of the
+         * sample into it.
+         */
+        void render(SVGRasterizer & ioImage) const;
+
+    private:
+        static void Paint(const HeadlessNode * inNode, const SVGStyleNode * inParent, SVGRenderer & ioRenderer);
+
+        std::string mDirectory;
+        FixedTextMetrics mTextMetrics;
+        HeadlessLayout mLayout;
+
+        // The svg elements, owned by the layout.
+        std::vector<const HeadlessNode *> mSVGs;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // SVGSAMPLE_H_INCLUDED
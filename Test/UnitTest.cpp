@@ -0,0 +1,69 @@
+#include "UnitTest.h"
+#include <ostream>
+#include <stdexcept>
+
+
+namespace XULWin
+{
+
+    // The failures after these are only counted.
+    static const size_t cMaxReportedFailures = 20;
+
+
+    UnitTest::UnitTest(const std::string & inName) :
+        mName(inName),
+        mReport(0),
+        mNumFailures(0)
+    {
+    }
+
+
+    UnitTest::~UnitTest()
+    {
+    }
+
+
+    const std::string & UnitTest::name() const
+    {
+        return mName;
+    }
+
+
+    size_t UnitTest::run(std::ostream & outReport)
+    {
+        mReport = &outReport;
+        mNumFailures = 0;
+        try
+        {
+            runTestCases();
+        }
+        catch (const std::exception & exc)
+        {
+            expect(false, std::string("unexpected exception: ") + exc.what());
+        }
+
+        if (mNumFailures > cMaxReportedFailures)
+        {
+            outReport << mName << ": ... and " << (mNumFailures - cMaxReportedFailures) << " more failures\n";
+        }
+
+        mReport = 0;
+        return mNumFailures;
+    }
+
+
+    bool UnitTest::expect(bool inCondition, const std::string & inDescription)
+    {
+        if (!inCondition)
+        {
+            if (mNumFailures < cMaxReportedFailures)
+            {
+                *mReport << mName << ": " << inDescription << "\n";
+            }
+            mNumFailures++;
+        }
+        return inCondition;
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,56 @@
+#ifndef UNITTEST_H_INCLUDED
+#define UNITTEST_H_INCLUDED
+
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+
+namespace XULWin
+{
+
+    /**
+     * Base class of the tests that main.cpp runs before the benchmarks and
+     * the samples.
+     *
+     * A test is silent unless it fails. The failed expectations are written
+     * to the report, prefixed with the name of the test. After the first
+     * twenty they are only counted.
+     */
+    class UnitTest : boost::noncopyable
+    {
+    public:
+        UnitTest(const std::string & inName);
+
+        virtual ~UnitTest();
+
+        const std::string & name() const;
+
+        /**
+         * Runs the test cases and writes the failed ones to outReport.
+         * Returns the number of failures.
+         */
+        size_t run(std::ostream & outReport);
+
+    protected:
+        virtual void runTestCases() = 0;
+
+        /**
+         * Reports inDescription as a failure if inCondition is false.
+         * Returns inCondition.
+         */
+        bool expect(bool inCondition, const std::string & inDescription);
+
+    private:
+        std::string mName;
+        std::ostream * mReport;
+        size_t mNumFailures;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // UNITTEST_H_INCLUDED
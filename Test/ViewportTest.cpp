@@ -0,0 +1,122 @@
+#include "ViewportTest.h"
+#include "XULWin/Viewport.h"
+#include <vector>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        // Items with a fixed preferred size and half of it as minimum size.
+        // Remembers which items were asked for their size.
+        class TestMeasurer : public VirtualItems::Measurer
+        {
+        public:
+            TestMeasurer(const std::vector<int> & inSizes) :
+                mSizes(inSizes),
+                mQueried(inSizes.size(), false)
+            {
+            }
+
+            virtual int VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const
+            {
+                mQueried[idx] = true;
+                return inSizeConstraint == Minimum ? mSizes[idx] / 2 : mSizes[idx];
+            }
+
+            // Returns true if only the items in [inBegin, inEnd) were asked
+            // for their size, apart from the items before inSampleEnd.
+            bool onlyQueried(size_t inSampleEnd, size_t inBegin, size_t inEnd) const
+            {
+                for (size_t idx = 0; idx != mQueried.size(); ++idx)
+                {
+                    bool expected = idx < inSampleEnd || (idx >= inBegin && idx < inEnd);
+                    if (mQueried[idx] && !expected)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            std::vector<int> mSizes;
+            mutable std::vector<bool> mQueried;
+        };
+
+    }
+
+
+    ViewportTest::ViewportTest() :
+        UnitTest("Viewport")
+    {
+    }
+
+
+    void ViewportTest::runTestCases()
+    {
+        // 1000 items of 20 pixels, and 40 pixels from item 500 on.
+        std::vector<int> sizes(1000, 20);
+        for (size_t idx = 500; idx != sizes.size(); ++idx)
+        {
+            sizes[idx] = 40;
+        }
+        TestMeasurer measurer(sizes);
+
+        // A view of 100 pixels at the top only needs the first items.
+        VirtualItems items;
+        items.reset(sizes.size());
+        expect(items.measureRange(measurer, 0, 100), "the first pass measures items");
+        expect(items.numMeasured() == 10, "the items up to two view lengths below the top are measured");
+        expect(measurer.onlyQueried(10, 0, 0), "an item far below the view was measured");
+        expect(items.getTotalSize(measurer, Preferred) == 20000, "the total preferred size is estimated from the measured items");
+        expect(items.getTotalSize(measurer, Minimum) == 10000, "the total minimum size is estimated from the measured items");
+        expect(!items.measureRange(measurer, 0, 100), "the same view measures nothing new");
+
+        // Scrolled to item 500, the items within one view length around
+        // the view are measured: 495 to 499 above it and 500 to 504 in it.
+        expect(items.measureRange(measurer, 10000, 100), "scrolling measures new items");
+        expect(items.numMeasured() == 20, "the items around the view are measured");
+        expect(items.isMeasured(495) && items.isMeasured(504), "an item around the view was not measured");
+        expect(!items.isMeasured(494) && !items.isMeasured(505), "an item outside the measured range was measured");
+        expect(measurer.onlyQueried(10, 495, 505), "an item outside the measured range was asked for its size");
+
+        // The estimate follows: 20 items of 25 pixels on average.
+        expect(items.getTotalSize(measurer, Preferred) == 25000, "the estimate doesn't follow the measured items");
+
+        std::vector<int> estimated;
+        items.getSizes(measurer, Preferred, estimated);
+        expect(estimated.size() == 1000 && estimated[500] == 40 && estimated[700] == 25, "wrong measured or estimated size");
+
+        // Marking an item as measured once.
+        expect(items.setMeasured(700), "an unmeasured item was already measured");
+        expect(!items.setMeasured(700), "an item was measured twice");
+        expect(items.numMeasured() == 21, "wrong number of measured items");
+
+        // Reset forgets all measurements.
+        items.reset(sizes.size());
+        expect(items.numMeasured() == 0 && !items.isMeasured(0), "reset kept the measurements");
+        expect(items.getTotalSize(measurer, Preferred) == 0, "no estimate without measured items");
+
+        // A short list is measured completely.
+        std::vector<int> shortSizes;
+        shortSizes.push_back(10);
+        shortSizes.push_back(30);
+        shortSizes.push_back(20);
+        TestMeasurer shortMeasurer(shortSizes);
+        VirtualItems shortItems;
+        shortItems.reset(shortSizes.size());
+        shortItems.measureRange(shortMeasurer, 0, 100);
+        expect(shortItems.numMeasured() == 3, "an item of a short list was not measured");
+        expect(shortItems.getTotalSize(shortMeasurer, Preferred) == 60, "wrong size of a short list");
+
+        // An empty list.
+        VirtualItems noItems;
+        expect(!noItems.measureRange(shortMeasurer, 0, 100), "an empty list measured items");
+        expect(noItems.getTotalSize(shortMeasurer, Preferred) == 0, "an empty list has a size");
+    }
+
+
+} // namespace XULWin
@@ -0,0 +1,29 @@
+#ifndef VIEWPORTTEST_H_INCLUDED
+#define VIEWPORTTEST_H_INCLUDED
+
+
+#include "UnitTest.h"
+
+
+namespace XULWin
+{
+
+    /**
+     * Tests VirtualItems, which decides the children of a virtualized box
+     * or grid that are measured: only the items near the visible area are
+     * measured, and the estimated size follows the measured items.
+     */
+    class ViewportTest : public UnitTest
+    {
+    public:
+        ViewportTest();
+
+    protected:
+        virtual void runTestCases();
+    };
+
+
+} // namespace XULWin
+
+
+#endif // VIEWPORTTEST_H_INCLUDED
@@ -1,5 +1,18 @@
 #include "Tester.h"
+#include "Config.h"
+#include "CompiledXULTest.h"
+#include "CompositingBenchmark.h"
 #include "ConfigSample.h"
+#include "ConversionBenchmark.h"
+#include "ElementTest.h"
+#include "HeadlessLayoutBenchmark.h"
+#include "HeadlessParserBenchmark.h"
+#include "LayoutBenchmark.h"
+#include "LayoutTransactionTest.h"
+#include "ParserBenchmark.h"
+#include "PortableTests.h"
+#include "SVGPathBenchmark.h"
+#include "SVGRenderBenchmark.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/Unicode.h"
 #include "XULWin/Windows.h"
@@ -25,6 +38,73 @@ void runImageViewerSample(HMODULE inModuleHandle, const std::string & inPathToXU
 }
 
 
+// Silent unless a test fails. Returns the number of failures.
+size_t runTests(const std::string & inPathToXULRunnerSamples)
+{
+    // The tests that need the Windows build of XULWin, the others are in
+    // RunPortableTests.
+    LayoutTransactionTest layoutTransactionTest;
+    CompiledXULTest compiledXULTest;
+    ElementTest elementTest;
+    UnitTest * tests[] =
+    {
+        &layoutTransactionTest,
+        &compiledXULTest,
+        &elementTest
+    };
+
+    std::stringstream report;
+    size_t numFailures = RunPortableTests(inPathToXULRunnerSamples, report);
+    for (size_t idx = 0; idx != sizeof(tests) / sizeof(tests[0]); ++idx)
+    {
+        numFailures += tests[idx]->run(report);
+    }
+
+    if (numFailures != 0)
+    {
+        std::string text = report.str();
+        ::OutputDebugStringA(text.c_str());
+        ::MessageBoxA(0, text.c_str(), "Test failures", MB_OK | MB_ICONERROR);
+    }
+    return numFailures;
+}
+
+
+// Shows the timing reports of all benchmarks in one message box.
+void runBenchmarks(const std::string & inPathToXULRunnerSamples)
+{
+    ParserBenchmark parserBenchmark(inPathToXULRunnerSamples);
+    HeadlessParserBenchmark headlessParserBenchmark(inPathToXULRunnerSamples);
+    ConversionBenchmark conversionBenchmark(1000000);
+    LayoutBenchmark layoutBenchmark(1000000);
+    HeadlessLayoutBenchmark headlessLayoutBenchmark(1000);
+    SVGPathBenchmark svgPathBenchmark;
+    SVGRenderBenchmark svgRenderBenchmark(100, inPathToXULRunnerSamples);
+    CompositingBenchmark compositingBenchmark(100000);
+    Benchmark * benchmarks[] =
+    {
+        &parserBenchmark,
+        &headlessParserBenchmark,
+        &conversionBenchmark,
+        &layoutBenchmark,
+        &headlessLayoutBenchmark,
+        &svgPathBenchmark,
+        &svgRenderBenchmark,
+        &compositingBenchmark
+    };
+
+    std::stringstream report;
+    for (size_t idx = 0; idx != sizeof(benchmarks) / sizeof(benchmarks[0]); ++idx)
+    {
+        report << (idx == 0 ? "" : "\n") << benchmarks[idx]->name() << "\n" << benchmarks[idx]->run();
+    }
+
+    std::string text = report.str();
+    ::OutputDebugStringA(text.c_str());
+    ::MessageBoxA(0, text.c_str(), "Benchmarks", MB_OK);
+}
+
+
 void startTest(HINSTANCE hInstance, Tester & tester, const std::string & inPathToXULRunnerSamples)
 {
     tester.runXULSample("hello");
@@ -52,12 +132,32 @@ std::string unquote(const std::string & inString)
 }
 
 
+// Removes inSwitch from the start of ioCommandLine. Returns false if the
+// command line doesn't start with it.
+bool consumeSwitch(const std::string & inSwitch, std::string & ioCommandLine)
+{
+    if (ioCommandLine.compare(0, inSwitch.size(), inSwitch) != 0 ||
+        (ioCommandLine.size() > inSwitch.size() && ioCommandLine[inSwitch.size()] != ' '))
+    {
+        return false;
+    }
+    size_t pathIdx = ioCommandLine.find_first_not_of(' ', inSwitch.size());
+    ioCommandLine = pathIdx == std::string::npos ? std::string() : unquote(ioCommandLine.substr(pathIdx));
+    return true;
+}
+
+
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
+    // "--run-tests <path>" only runs the tests, see runTests.
+    // "--bench <path>" runs the benchmarks before the samples and shows
+    // their timing report. They take a while, so they are off by default.
     std::string commandLine(unquote(lpCmdLine));
+    bool testsOnly = consumeSwitch("--run-tests", commandLine);
+    bool benchmarks = !testsOnly && consumeSwitch("--bench", commandLine);
     if (commandLine.empty())
     {
-        ::MessageBox(0, TEXT("Expected argument: path to the 'xulrunnersamples' directory.\nIn \"Project Settings\" -> \"Debugging\" -> \"Command Arguments\"\nset the value \"$(SolutionDir)xulrunnersamples\"."), 0, MB_OK);
+        ::MessageBox(0, TEXT("Expected argument: path to the 'xulrunnersamples' directory.\nIn \"Project Settings\" -> \"Debugging\" -> \"Command Arguments\"\nset the value \"$(SolutionDir)xulrunnersamples\".\nPrefix it with --run-tests to run the tests instead of the samples,\nor with --bench to run the benchmarks before the samples."), 0, MB_OK);
         return 1;
     }
 
@@ -69,6 +169,17 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     // Ensure that the common control DLL is loaded.
     WinAPI::CommonControlsInitializer ccInit;
 
+    // A failed test gives a non-zero exit code.
+    if (testsOnly)
+    {
+        return runTests(commandLine) == 0 ? 0 : 1;
+    }
+
+    if (benchmarks)
+    {
+        runBenchmarks(commandLine);
+    }
+
     Tester tester(hInstance, commandLine, Tester::Features_TestWithMozillaXULRunner);
 
     startTest(hInstance, tester, commandLine);
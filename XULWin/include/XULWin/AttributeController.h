@@ -2,6 +2,7 @@
 #define ATTRIBUTECONTROLLER_H_INCLUDED
 
 
+#include "XULWin/AttributeValue.h"
 #include "XULWin/Enums.h"
 #include "XULWin/Point.h"
 #include "XULWin/SVGPathInstructions.h"
@@ -44,6 +45,12 @@ namespace XULWin
     public:
         virtual void get(std::string & outValue) = 0;
         virtual void set(const std::string & inValue) = 0;
+
+        // Typed access, see AttributeValue. Controllers of int, bool, enum
+        // and color attributes override these. The default implementations
+        // go through the string API.
+        virtual void get(AttributeValue & outValue);
+        virtual void set(const AttributeValue & inValue);
     };
 
 
@@ -87,6 +94,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getWidth() const = 0;
 
         virtual void setWidth(int inWidth) = 0;
@@ -110,6 +121,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getHeight() const = 0;
 
         virtual void setHeight(int inHeight) = 0;
@@ -133,6 +148,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getScreenX() const = 0;
 
         virtual void setScreenX(int inX) = 0;
@@ -156,6 +175,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getScreenY() const = 0;
 
         virtual void setScreenY(int inY) = 0;
@@ -181,6 +204,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getFlex() const = 0;
 
         virtual void setFlex(int inFlex) = 0;
@@ -204,6 +231,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool isDisabled() const = 0;
 
         virtual void setDisabled(bool inDisabled) = 0;
@@ -227,6 +258,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool isSelected() const = 0;
 
         virtual void setSelected(bool inSelected) = 0;
@@ -275,6 +310,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool isHidden() const = 0;
 
         virtual void setHidden(bool inHidden) = 0;
@@ -347,6 +386,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool isReadOnly() const = 0;
 
         virtual void setReadOnly(bool inReadOnly) = 0;
@@ -372,6 +415,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getRows() const = 0;
 
         virtual void setRows(int inRows) = 0;
@@ -395,6 +442,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool isChecked() const = 0;
 
         virtual void setChecked(bool inChecked) = 0;
@@ -421,6 +472,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual Orient getOrient() const = 0;
 
         virtual void setOrient(Orient inOrient) = 0;
@@ -451,6 +506,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual Align getAlign() const = 0;
 
         virtual void setAlign(Align inAlign) = 0;
@@ -469,6 +528,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getValue() const = 0;
 
         virtual void setValue(int inValue) = 0;
@@ -487,6 +550,10 @@ namespace XULWin
 
         virtual void set(const std::string & inSelectedIndex);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getSelectedIndex() const = 0;
 
         virtual void setSelectedIndex(int inSelectedIndex) = 0;
@@ -505,6 +572,10 @@ namespace XULWin
 
         virtual void set(const std::string & inCurpos);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getCurrentPosition() const = 0;
 
         virtual void setCurrentPosition(int inCurrentPosition) = 0;
@@ -523,6 +594,10 @@ namespace XULWin
 
         virtual void set(const std::string & inMaxPosition);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getMaxPosition() const = 0;
 
         virtual void setMaxPosition(int inMaxPosition) = 0;
@@ -541,6 +616,10 @@ namespace XULWin
 
         virtual void set(const std::string & inIncrement);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getIncrement() const = 0;
 
         virtual void setIncrement(int inIncrement) = 0;
@@ -559,6 +638,10 @@ namespace XULWin
 
         virtual void set(const std::string & inPageIncrement);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual int getPageIncrement() const = 0;
 
         virtual void setPageIncrement(int inPageIncrement) = 0;
@@ -619,12 +702,46 @@ namespace XULWin
 
         virtual void set(const std::string & inPageIncrement);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual bool getKeepAspectRatio() const = 0;
 
         virtual void setKeepAspectRatio(bool inKeepAspectRatio) = 0;
     };
 
 
+    /**
+     * This is a non-standard extension that applies to box and grid
+     * elements. The attribute "virtualize" has a boolean value indicating
+     * that only the children inside the visible area of the scroll box
+     * should be measured, laid out and shown. The native windows of all
+     * children are still created by the parser; the ones outside the
+     * visible area are hidden.
+     */
+    class VirtualizeController : public AttributeController
+    {
+    public:
+        static const char * AttributeName()
+        {
+            return "virtualize";
+        }
+
+        virtual void get(std::string & outVirtualize);
+
+        virtual void set(const std::string & inVirtualize);
+
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
+        virtual bool isVirtualized() const = 0;
+
+        virtual void setVirtualized(bool inVirtualized) = 0;
+    };
+
+
     /**
      * Attribute: image on listcell element.
      * Type: image URL
@@ -680,9 +797,9 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
-        virtual const SVGPathInstructions & getPathInstructions() const = 0;
+        virtual const SVGPathData & getPathData() const = 0;
 
-        virtual void setPathInstructions(const SVGPathInstructions & inPathInstructions) = 0;
+        virtual void setPathData(const SVGPathData & inPathData) = 0;
     };
 
 
@@ -698,6 +815,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual void setSVGFill(const RGBColor & inColor) = 0;
 
         virtual const RGBColor & getSVGFill() const = 0;
@@ -716,6 +837,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual void setSVGStroke(const RGBColor & inColor) = 0;
 
         virtual const RGBColor & getSVGStroke() const = 0;
@@ -734,6 +859,10 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void get(AttributeValue & outValue);
+
+        virtual void set(const AttributeValue & inValue);
+
         virtual void setSVGStrokeWidth(int inStrokeWidth) = 0;
 
         virtual int getSVGStrokeWidth() const = 0;
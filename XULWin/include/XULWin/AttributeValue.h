@@ -0,0 +1,80 @@
+#ifndef ATTRIBUTEVALUE_H_INCLUDED
+#define ATTRIBUTEVALUE_H_INCLUDED
+
+
+#include "XULWin/RGBColor.h"
+#include <string>
+
+
+namespace XULWin
+{
+
+    /**
+     * AttributeValue
+     *
+     * The value of an attribute in its native type. Attribute controllers
+     * exchange these with the components, so that a caller that wants an
+     * int doesn't need to convert it to a string and back.
+     *
+     * Enumerations such as Orient and Align are stored as their integer
+     * value.
+     */
+    class AttributeValue
+    {
+    public:
+        enum Type
+        {
+            Type_Null,
+            Type_Int,
+            Type_Bool,
+            Type_Color,
+            Type_String
+        };
+
+        AttributeValue();
+
+        explicit AttributeValue(int inValue);
+
+        explicit AttributeValue(bool inValue);
+
+        explicit AttributeValue(const RGBColor & inValue);
+
+        explicit AttributeValue(const std::string & inValue);
+
+        Type type() const;
+
+        bool isNull() const;
+
+        /**
+         * Booleans convert to 0 or 1, strings are parsed. Returns inDefault
+         * for other types and for strings that are not a number.
+         */
+        int toInt(int inDefault) const;
+
+        /**
+         * Integers convert to true if they are not 0, strings are parsed.
+         */
+        bool toBool(bool inDefault) const;
+
+        /**
+         * Strings are parsed as CSS colors.
+         */
+        RGBColor toColor(const RGBColor & inDefault) const;
+
+        /**
+         * Returns the text that the string API would return for the
+         * value. Enumerations are returned as their integer value.
+         */
+        std::string toString() const;
+
+    private:
+        Type mType;
+        int mInt;
+        RGBColor mColor;
+        std::string mString;
+    };
+
+} // namespace XULWin
+
+
+#endif // ATTRIBUTEVALUE_H_INCLUDED
@@ -2,24 +2,133 @@
 #define ATTRIBUTESMAPPING_H_INCLUDED
 
 
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 namespace XULWin
 {
 
-    //
-    // !!! HIGHLY EXPERIMENTAL !!!
-    //
-    // Alternative to typedefs:
+    /**
+     * FlatMap is a map that stores its entries in a sorted vector.
+     *
+     * It supports the subset of the std::map interface that is needed
+     * for attributes and styles. An element usually has only a few
+     * attributes, so a single contiguous buffer is cheaper to build,
+     * copy and search than a tree with one node per entry.
+     *
+     * Iteration order is sorted by key, like std::map. Unlike std::map,
+     * inserting an entry invalidates iterators.
+     */
+    template<class Key, class Value>
+    class FlatMap
+    {
+    public:
+        typedef Key key_type;
+        typedef Value mapped_type;
+        typedef std::pair<Key, Value> value_type;
+        typedef std::vector<value_type> Container;
+        typedef typename Container::iterator iterator;
+        typedef typename Container::const_iterator const_iterator;
+        typedef typename Container::size_type size_type;
+
+        iterator begin() { return mEntries.begin(); }
+
+        iterator end() { return mEntries.end(); }
+
+        const_iterator begin() const { return mEntries.begin(); }
+
+        const_iterator end() const { return mEntries.end(); }
+
+        bool empty() const { return mEntries.empty(); }
+
+        size_type size() const { return mEntries.size(); }
+
+        void clear() { mEntries.clear(); }
+
+        void reserve(size_type inSize) { mEntries.reserve(inSize); }
+
+        iterator find(const Key & inKey)
+        {
+            iterator it = mEntries.begin() + lowerBound(inKey);
+            return (it != mEntries.end() && !(inKey < it->first)) ? it : mEntries.end();
+        }
+
+        const_iterator find(const Key & inKey) const
+        {
+            const_iterator it = mEntries.begin() + lowerBound(inKey);
+            return (it != mEntries.end() && !(inKey < it->first)) ? it : mEntries.end();
+        }
+
+        size_type count(const Key & inKey) const
+        {
+            return find(inKey) != end() ? 1 : 0;
+        }
+
+        Value & operator[](const Key & inKey)
+        {
+            return insert(value_type(inKey, Value())).first->second;
+        }
+
+        std::pair<iterator, bool> insert(const value_type & inValue)
+        {
+            size_type idx = lowerBound(inValue.first);
+            if (idx != mEntries.size() && !(inValue.first < mEntries[idx].first))
+            {
+                return std::make_pair(mEntries.begin() + idx, false);
+            }
+            return std::make_pair(mEntries.insert(mEntries.begin() + idx, inValue), true);
+        }
+
+        void erase(iterator inIterator)
+        {
+            mEntries.erase(inIterator);
+        }
+
+        size_type erase(const Key & inKey)
+        {
+            iterator it = find(inKey);
+            if (it == mEntries.end())
+            {
+                return 0;
+            }
+            mEntries.erase(it);
+            return 1;
+        }
+
+    private:
+        size_type lowerBound(const Key & inKey) const
+        {
+            size_type first = 0;
+            size_type count = mEntries.size();
+            while (count > 0)
+            {
+                size_type step = count / 2;
+                if (mEntries[first + step].first < inKey)
+                {
+                    first += step + 1;
+                    count -= step + 1;
+                }
+                else
+                {
+                    count = step;
+                }
+            }
+            return first;
+        }
+
+        Container mEntries;
+    };
+
+
+    // Distinct classes instead of typedefs:
     //
     // * Provides type-safety (can't mix up AttributesMappping or StylesMapping objects)
     // * Can be forward declared
-    // * Enables template typedefs (the code below is not an example of that however)
     //
-    class AttributesMapping : public std::map<std::string, std::string> { };
-    class StylesMapping : public std::map<std::string, std::string> { };
+    class AttributesMapping : public FlatMap<std::string, std::string> { };
+    class StylesMapping : public FlatMap<std::string, std::string> { };
 
 
 } // namespace XULWin
@@ -3,14 +3,18 @@
 
 
 #include "XULWin/Enums.h"
+#include "XULWin/Point.h"
 #include "XULWin/Rect.h"
+#include "XULWin/Viewport.h"
+#include <vector>
 
 
 namespace XULWin
 {
     class Component;
+    struct ExtendedSizeInfo;
 
-    class BoxLayouter
+    class BoxLayouter : public VirtualItems::Measurer
     {
     public:
         class ContentProvider
@@ -38,8 +42,61 @@ namespace XULWin
 
         int calculateHeight(SizeConstraint inSizeConstraint) const;
 
+        /**
+         * In virtualized mode only the children that intersect the client
+         * rect, after moving them by the scroll offset, are positioned and
+         * shown. Only the children near the visible area are measured, the
+         * others get the average size of the measured children (see
+         * VirtualItems).
+         */
+        bool isVirtualized() const;
+
+        void setVirtualized(bool inVirtualized);
+
+        void setScrollOffset(const Point & inScrollOffset);
+
+        /**
+         * Returns true if the child at idx was shown by the last layout pass.
+         */
+        bool isRealized(size_t idx) const;
+
+        /**
+         * Returns the number of children that were measured in virtualized
+         * mode. When it changes, so does the estimated size of the box.
+         */
+        size_t numMeasured() const;
+
+        /**
+         * Must be called when a child is removed. The next layout pass then
+         * treats all children as new, because a child that is created later
+         * can get the address of the removed one.
+         */
+        void onChildRemoved();
+
+        // VirtualItems::Measurer methods
+        virtual int VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const;
+
     private:
+        // Resets the measured children if the child count has changed.
+        void syncItems() const;
+
+        void getSizeInfos(std::vector<ExtendedSizeInfo> & outSizeInfos) const;
+
+        int calculateVirtualizedSize(bool inWidth, SizeConstraint inSizeConstraint) const;
+
         ContentProvider * mContentProvider;
+        bool mVirtualized;
+        Point mScrollOffset;
+        mutable VirtualItems mItems;
+
+        // Children and their rects from the previous layout pass. Children
+        // that keep the same rect are not moved again.
+        std::vector<const Component *> mPrevChildren;
+        std::vector<Rect> mPrevRects;
+
+        // Per child of the previous layout pass: whether its native windows
+        // are shown.
+        std::vector<bool> mPrevRealized;
     };
 
 } // namespace XULWin
@@ -0,0 +1,19 @@
+#ifndef COLORNAMES_H_INCLUDED
+#define COLORNAMES_H_INCLUDED
+
+
+#include "XULWin/RGBColor.h"
+
+
+namespace XULWin
+{
+
+    // Looks up the CSS color name in the range [inBegin, inEnd), ignoring
+    // case, for example "white" or "SteelBlue". Uses a perfect hash table
+    // that is generated by Scripts/GenerateColorNames. Does not allocate.
+    bool FindColorName(const char * inBegin, const char * inEnd, RGBColor & outColor);
+
+} // namespace XULWin
+
+
+#endif // COLORNAMES_H_INCLUDED
@@ -0,0 +1,141 @@
+#ifndef COMPILEDXUL_H_INCLUDED
+#define COMPILEDXUL_H_INCLUDED
+
+
+#include "XULWin/AttributesMapping.h"
+#include "XULWin/Element.h"
+#include "Poco/Types.h"
+#include <boost/noncopyable.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * CompiledXUL is a binary serialization of a parsed XUL document.
+     *
+     * It contains the elements as the SAX parser produced them: tag names,
+     * attributes and inner text, with entities already resolved. Each
+     * distinct string is stored once and referenced by index. Loading a
+     * compiled document creates the Element tree through the ElementFactory
+     * without running the XML parser.
+     *
+     * The compiled file also records the size, modification time and hash of
+     * the XUL file and of every DTD that was resolved through a chrome URL,
+     * and the locale. It is only loaded if all of these still match. If the
+     * document references an entity that can't be tracked this way then the
+     * document is not compiled.
+     */
+    class CompiledXUL : private boost::noncopyable
+    {
+    public:
+        CompiledXUL();
+
+        /**
+         * Returns the path of the compiled file for a XUL file.
+         * This is the XUL path with a "c" appended (foo.xul -> foo.xulc).
+         */
+        static std::string GetCompiledPath(const std::string & inXULFile);
+
+        void setLocale(const std::string & inLocale);
+
+        /**
+         * Adds a file that the document depends on.
+         */
+        void addDependency(const std::string & inPath);
+
+        /**
+         * Methods for recording the document while it is being parsed.
+         */
+        void startElement(const std::string & inTagName, const AttributesMapping & inAttributes);
+
+        void setInnerText(const std::string & inText);
+
+        void endElement();
+
+        /**
+         * Marks the document as not cacheable.
+         */
+        void setInvalid();
+
+        bool isValid() const;
+
+        /**
+         * Writes the compiled document. Returns false on failure.
+         */
+        bool save(const std::string & inFileName) const;
+
+        /**
+         * Reads a compiled document.
+         *
+         * Returns false if the file could not be read, if it is corrupt, if
+         * it was written for another locale or if one of its dependencies
+         * has changed.
+         */
+        bool load(const std::string & inFileName, const std::string & inLocale);
+
+        /**
+         * Returns true if load found dependencies whose modification time
+         * changed but whose contents didn't. Saving the document again
+         * records the new times, so that the next load doesn't hash them.
+         */
+        bool needsSave() const;
+
+        /**
+         * Creates the elements of the loaded document and returns the root.
+         */
+        ElementPtr createElements() const;
+
+    private:
+        typedef Poco::UInt32 StringId;
+
+        static const StringId cNoString = 0xFFFFFFFF;
+
+        struct Dependency
+        {
+            Dependency();
+
+            std::string path;
+            Poco::Int64 modified;
+            Poco::UInt64 size;
+            Poco::UInt32 hash;
+        };
+
+        struct Node
+        {
+            Node();
+
+            StringId tagName;
+            std::vector<std::pair<StringId, StringId> > attributes;
+            StringId innerText;
+            Poco::UInt32 childCount;
+        };
+
+        static bool GetDependency(const std::string & inPath, Dependency & outDependency, bool inComputeHash);
+
+        // Updates the modification time if only that changed.
+        static bool IsUpToDate(Dependency & ioDependency);
+
+        StringId intern(const std::string & inString);
+
+        ElementPtr createElement(Element * inParent, size_t & ioNodeIndex) const;
+
+        void skipNode(size_t & ioNodeIndex) const;
+
+        bool mValid;
+        bool mNeedsSave;
+        std::string mLocale;
+        std::vector<Dependency> mDependencies;
+        std::vector<std::string> mStrings;
+        std::map<std::string, StringId> mStringIds;
+        std::vector<Node> mNodes;
+        std::vector<size_t> mOpenNodes;
+    };
+
+} // namespace XULWin
+
+
+#endif // COMPILEDXUL_H_INCLUDED
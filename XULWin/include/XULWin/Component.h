@@ -272,6 +272,17 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const = 0;
 
+        // Discards the cached results of calculateWidth and calculateHeight
+        // for this component and all of its ancestors. Must be called when
+        // something changes that affects the component's size.
+        virtual void invalidateSizeCache() = 0;
+
+        // Returns false if a cached size differs from the result of
+        // calculateWidth or calculateHeight, which means that something
+        // changed the size without calling invalidateSizeCache. Doesn't
+        // change the cache. Used by debug checks.
+        virtual bool isSizeCacheValid() const = 0;
+
         // Tendency to expand, used for separators, scrollbars, etc..
         virtual bool expansive() const = 0;
 
@@ -291,6 +302,16 @@ namespace XULWin
 
         virtual void rebuildChildLayouts() = 0;
 
+        // Marks the layout of this component and of all its ancestors as
+        // out of date. Top-level windows respond by scheduling a layout pass.
+        virtual void invalidateLayout() = 0;
+
+        virtual bool needsLayout() const = 0;
+
+        // Calls rebuildLayout if the layout has been invalidated since the
+        // last layout pass.
+        virtual void updateLayout() = 0;
+
         virtual LRESULT handleMessage(UINT inMessage, WPARAM wParam, LPARAM lParam) = 0;
 
         virtual bool getAttribute(const std::string & inName, std::string & outValue) = 0;
@@ -299,8 +320,14 @@ namespace XULWin
 
         virtual bool setStyle(const std::string & inName, const std::string & inValue) = 0;
 
+        virtual bool setStyle(const StyleDeclaration & inDeclaration) = 0;
+
         virtual bool setAttribute(const std::string & inName, const std::string & inValue) = 0;
 
+        virtual bool getAttributeValue(const std::string & inName, AttributeValue & outValue) = 0;
+
+        virtual bool setAttributeValue(const std::string & inName, const AttributeValue & inValue) = 0;
+
         virtual bool initAttributeControllers() = 0;
 
         virtual bool initStyleControllers() = 0;
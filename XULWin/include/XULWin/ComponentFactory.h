@@ -5,7 +5,7 @@
 #include "XULWin/Component.h"
 #include "XULWin/Decorator.h"
 #include "XULWin/Element.h"
-#include "Poco/StringTokenizer.h"
+#include "XULWin/StyleDeclarations.h"
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
 
@@ -22,6 +22,8 @@ namespace XULWin
 
         static CSSOverflow GetOverflow(const StylesMapping & inStyles, const std::string & inOverflow);
 
+        static CSSOverflow GetOverflow(const StyleDeclarations & inStyles, CSSProperty inOverflow);
+
         /**
          * createComponent
          * @DecoratorType: decorator type, for example Decorator or MarginDecorator.
@@ -53,10 +55,9 @@ namespace XULWin
         template<class DecoratorType, class VirtualType, class NativeType>
         Component * createContainer(Component * inParent, const AttributesMapping & inAttr)
         {
-            StylesMapping styles;
-            GetStyles(inAttr, styles);
-            CSSOverflow overflowX = GetOverflow(styles, "overflow-x");
-            CSSOverflow overflowY = GetOverflow(styles, "overflow-y");
+            const StyleDeclarations & styles = StyleDeclarations::Get(inAttr);
+            CSSOverflow overflowX = GetOverflow(styles, CSSProperty_OverflowX);
+            CSSOverflow overflowY = GetOverflow(styles, CSSProperty_OverflowY);
             if (overflowX != CSSOverflow_Hidden || overflowY != CSSOverflow_Hidden)
             {
                 return new ScrollDecorator(inParent,
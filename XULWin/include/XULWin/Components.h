@@ -7,16 +7,19 @@
 #include "XULWin/PhonyComponent.h"
 #include "XULWin/NativeControl.h"
 #include "XULWin/Node.h"
+#include "XULWin/Viewport.h"
 #include <boost/function.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace XULWin
 {
+    struct SizeInfo;
 
     /**
      * Label
@@ -323,6 +326,8 @@ namespace XULWin
 
         virtual void rebuildLayout();
 
+        virtual void onChildRemoved(Component * inChild);
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const
         {
             return mBoxLayouter.calculateWidth(inSizeConstraint);
@@ -375,7 +380,7 @@ namespace XULWin
 
         virtual void BoxLayouter_rebuildChildLayouts()
         {
-            rebuildChildLayouts();
+            rebuildInvalidatedChildLayouts();
         }
 
     protected:
@@ -384,7 +389,9 @@ namespace XULWin
 
 
     class Box : public VirtualComponent,
-                public BoxLayouter::ContentProvider
+                public BoxLayouter::ContentProvider,
+                public Viewport,
+                public virtual VirtualizeController
     {
     public:
         typedef VirtualComponent Super;
@@ -397,8 +404,20 @@ namespace XULWin
 
         virtual Align getAlign() const;
 
+        // VirtualizeController methods
+        virtual bool isVirtualized() const;
+
+        virtual void setVirtualized(bool inVirtualized);
+
+        // Viewport methods
+        virtual void setScrollOffset(const Point & inScrollOffset);
+
+        virtual bool initAttributeControllers();
+
         virtual void rebuildLayout();
 
+        virtual void onChildRemoved(Component * inChild);
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
@@ -441,10 +460,7 @@ namespace XULWin
             return clientRect();
         }
 
-        virtual void BoxLayouter_rebuildChildLayouts()
-        {
-            rebuildChildLayouts();
-        }
+        virtual void BoxLayouter_rebuildChildLayouts();
 
     private:
         BoxLayouter mBoxLayouter;
@@ -490,6 +506,45 @@ namespace XULWin
     };
 
 
+    /**
+     * GridTracks
+     *
+     * The widths of the columns of a grid. The width of a column is the
+     * width of its widest cell, so it depends on every row. Instead of
+     * letting each column scan all rows, the grid measures all columns in
+     * a single pass over the cells and keeps the result until its size
+     * cache is invalidated.
+     */
+    class GridTracks
+    {
+    public:
+        GridTracks();
+
+        /**
+         * Returns the width of the widest cell in inColumn. inGrid is the
+         * grid element. Returns 0 if inColumn is not one of its columns.
+         * If inMeasuredRows is set, only the cells of the rows that it has
+         * measured are taken into account.
+         */
+        int getColumnWidth(const Element * inGrid,
+                           const Element * inColumn,
+                           SizeConstraint inSizeConstraint,
+                           const VirtualItems * inMeasuredRows = 0);
+
+        /**
+         * Forgets all measurements.
+         */
+        void clear();
+
+    private:
+        void measure(const Element * inGrid, SizeConstraint inSizeConstraint, const VirtualItems * inMeasuredRows);
+
+        std::vector<const Element *> mColumns;
+        std::vector<int> mColumnWidths[Maximum + 1];
+        bool mMeasured[Maximum + 1];
+    };
+
+
     class VirtualGrid : public VirtualComponent
     {
     public:
@@ -502,21 +557,71 @@ namespace XULWin
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
         virtual void rebuildLayout();
+
+        virtual void invalidateSizeCache();
+
+        int getColumnWidth(const Element * inColumn, SizeConstraint inSizeConstraint) const;
+
+    private:
+        mutable GridTracks mTracks;
     };
 
 
-    class Grid : public NativeControl
+    class Grid : public NativeControl,
+                 public Viewport,
+                 public VirtualItems::Measurer,
+                 public virtual VirtualizeController
     {
     public:
         typedef NativeControl Super;
 
         Grid(Component * inParent, const AttributesMapping & inAttr);
 
+        // VirtualizeController methods
+        virtual bool isVirtualized() const;
+
+        virtual void setVirtualized(bool inVirtualized);
+
+        // Viewport methods
+        virtual void setScrollOffset(const Point & inScrollOffset);
+
+        virtual bool initAttributeControllers();
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
         virtual void rebuildLayout();
+
+        virtual void invalidateSizeCache();
+
+        int getColumnWidth(const Element * inColumn, SizeConstraint inSizeConstraint) const;
+
+        // VirtualItems::Measurer methods
+        virtual int VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const;
+
+    private:
+        // Resets the measured rows if the row count has changed, and
+        // measures the first rows for an estimate.
+        void syncRowItems() const;
+
+        bool getSizeInfos(const ElementPtr & inColumns,
+                          const ElementPtr & inRows,
+                          std::vector<SizeInfo> & outColWidths,
+                          std::vector<SizeInfo> & outRowHeights);
+
+        mutable GridTracks mTracks;
+        bool mVirtualized;
+        Point mScrollOffset;
+
+        // In virtualized mode only the cells of the measured rows are
+        // measured. The other rows get the average height.
+        mutable VirtualItems mRowItems;
+
+        // Rows of the previous layout pass, and whether their native
+        // windows are shown.
+        std::vector<const Component *> mPrevRows;
+        std::vector<bool> mPrevRowsRealized;
     };
 
 
@@ -914,6 +1019,8 @@ namespace XULWin
 
         virtual void rebuildLayout();
 
+        virtual void onChildRemoved(Component * inChild);
+
         virtual Orient BoxLayouter_getOrient() const
         {
             return getOrient();
@@ -946,7 +1053,7 @@ namespace XULWin
 
         virtual void BoxLayouter_rebuildChildLayouts()
         {
-            rebuildChildLayouts();
+            rebuildInvalidatedChildLayouts();
         }
 
     private:
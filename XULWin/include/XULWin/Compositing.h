@@ -0,0 +1,75 @@
+#ifndef COMPOSITING_H_INCLUDED
+#define COMPOSITING_H_INCLUDED
+
+
+namespace XULWin
+{
+
+    // Pixel kernels for software compositing.
+    //
+    // Pixels are 32-bit premultiplied ARGB values (0xAARRGGBB), the format of
+    // SVGRasterizer and of Gdiplus::PixelFormat32bppPARGB. Each kernel has a
+    // portable implementation and an SSE2 implementation. The implementation
+    // is selected at run time, and all implementations produce exactly the
+    // same pixels.
+
+    // Blends a solid color over a span of pixels (source over). inCoverage
+    // holds the coverage of each pixel in the range [0, 255].
+    typedef void (*FillSpanFunction)(unsigned int * ioPixels,
+                                     const unsigned char * inCoverage,
+                                     int inCount,
+                                     unsigned int inColor);
+
+    // Blends a row of pixels over another one (source over).
+    typedef void (*BlendRowFunction)(unsigned int * ioPixels,
+                                     const unsigned int * inSource,
+                                     int inCount);
+
+    // Writes one row of a bilinearly scaled image. inRow0 and inRow1 are the
+    // source rows above and below the sample position and inWeightY, in the
+    // range [0, 256), is the weight of inRow1. The row is stretched from
+    // inSourceWidth to inWidth pixels.
+    typedef void (*ScaleRowFunction)(const unsigned int * inRow0,
+                                     const unsigned int * inRow1,
+                                     int inSourceWidth,
+                                     int inWeightY,
+                                     unsigned int * outRow,
+                                     int inWidth);
+
+    struct CompositingKernels
+    {
+        FillSpanFunction fillSpan;
+        BlendRowFunction blendRow;
+        ScaleRowFunction scaleRow;
+    };
+
+    enum CompositingKernelSet
+    {
+        CompositingKernelSet_Scalar,
+        CompositingKernelSet_SSE2
+    };
+
+    // Returns true if the processor and the build support the kernel set.
+    bool IsCompositingKernelSetSupported(CompositingKernelSet inKernelSet);
+
+    // Returns the requested kernel set, or the scalar kernels if it is not
+    // supported.
+    const CompositingKernels & GetCompositingKernels(CompositingKernelSet inKernelSet);
+
+    // Returns the fastest kernel set that is supported.
+    const CompositingKernels & GetCompositingKernels();
+
+    // Scales an image with bilinear filtering. Strides are in pixels. Sample
+    // positions are pixel centers, so the image is not shifted. Reduction by
+    // more than a factor 2 skips source pixels. Sizes must be below 32768.
+    void ScaleImageBilinear(const unsigned int * inSource, int inSourceWidth, int inSourceHeight, int inSourceStride,
+                            unsigned int * outPixels, int inWidth, int inHeight, int inStride);
+
+    void ScaleImageBilinear(const CompositingKernels & inKernels,
+                            const unsigned int * inSource, int inSourceWidth, int inSourceHeight, int inSourceStride,
+                            unsigned int * outPixels, int inWidth, int inHeight, int inStride);
+
+} // namespace XULWin
+
+
+#endif // COMPOSITING_H_INCLUDED
@@ -3,8 +3,8 @@
 
 
 #include "XULWin/Component.h"
+#include "XULWin/ControllerTable.h"
 #include "XULWin/Fallible.h"
-#include <map>
 #include <string>
 
 
@@ -174,6 +174,10 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const = 0;
 
+        virtual void invalidateSizeCache();
+
+        virtual bool isSizeCacheValid() const;
+
         // Tendency to expand, used for separators, scrollbars, etc..
         bool expansive() const;
 
@@ -193,6 +197,15 @@ namespace XULWin
 
         void rebuildChildLayouts();
 
+        // Only rebuilds the layouts of the children that need it.
+        void rebuildInvalidatedChildLayouts();
+
+        virtual void invalidateLayout();
+
+        virtual bool needsLayout() const;
+
+        virtual void updateLayout();
+
         virtual LRESULT handleMessage(UINT inMessage, WPARAM wParam, LPARAM lParam) = 0;
 
         virtual bool getAttribute(const std::string & inName, std::string & outValue);
@@ -201,31 +214,45 @@ namespace XULWin
 
         virtual bool setStyle(const std::string & inName, const std::string & inValue);
 
+        virtual bool setStyle(const StyleDeclaration & inDeclaration);
+
         virtual bool setAttribute(const std::string & inName, const std::string & inValue);
 
+        virtual bool getAttributeValue(const std::string & inName, AttributeValue & outValue);
+
+        virtual bool setAttributeValue(const std::string & inName, const AttributeValue & inValue);
+
         virtual bool initAttributeControllers();
 
         virtual bool initStyleControllers();
 
-        template<class T>
-        void setAttributeController(T * inAttributeController)
+        template<class T, class ComponentType>
+        void setAttributeController(ComponentType * inComponent)
         {
-            AttributeControllers::iterator it = mAttributeControllers.find(T::AttributeName());
-            assert(it == mAttributeControllers.end());
-            if (it == mAttributeControllers.end())
+            assert(static_cast<ConcreteComponent *>(inComponent) == this);
+            if (!mAttributeControllers)
             {
-                mAttributeControllers.insert(std::make_pair(T::AttributeName(), inAttributeController));
+                mAttributeControllers = &AttributeControllers::Get(typeid(*this));
+            }
+            if (!mAttributeControllers->complete())
+            {
+                mAttributeControllers->add(T::AttributeName(),
+                                           &GetController<AttributeController, ComponentType, T>);
             }
         }
 
-        template<class T>
-        void setStyleController(T * inStyleController)
+        template<class T, class ComponentType>
+        void setStyleController(ComponentType * inComponent)
         {
-            StyleControllers::iterator it = mStyleControllers.find(T::PropertyName());
-            assert(it == mStyleControllers.end());
-            if (it == mStyleControllers.end())
+            assert(static_cast<ConcreteComponent *>(inComponent) == this);
+            if (!mStyleControllers)
+            {
+                mStyleControllers = &StyleControllers::Get(typeid(*this));
+            }
+            if (!mStyleControllers->complete())
             {
-                mStyleControllers.insert(std::make_pair(T::PropertyName(), inStyleController));
+                mStyleControllers->add(T::PropertyName(),
+                                       &GetController<StyleController, ComponentType, T>);
             }
         }
 
@@ -261,6 +288,19 @@ namespace XULWin
         Fallible<Align> mAlign;
         bool mIsInitialized;
 
+        // True if the layout needs to be rebuilt. New components start out
+        // with an invalid layout. Cleared by rebuildChildLayouts.
+        bool mNeedsLayout;
+
+        // Results of calculateWidth and calculateHeight, indexed by
+        // SizeConstraint. Cleared by invalidateSizeCache.
+        // Components whose size depends on elements outside of their own
+        // subtree (for example grid columns) must set mCacheSizes to false
+        // because they won't be notified when those elements change.
+        bool mCacheSizes;
+        mutable Fallible<int> mCachedWidths[Maximum + 1];
+        mutable Fallible<int> mCachedHeights[Maximum + 1];
+
         // We need to remember the hidden state ourselves because we can't
         // rely on WinAPI IsWindowVisible call, because it will return false
         // for child windows of which the parent is not visible.
@@ -272,11 +312,18 @@ namespace XULWin
         // 'minified' window state.
         bool mHidden;
 
-        typedef std::map<std::string, AttributeController *> AttributeControllers;
-        AttributeControllers mAttributeControllers;
+        // Shared by all instances of the class, see ControllerTable. Null
+        // until the first controller is registered.
+        typedef ControllerTable<AttributeController> AttributeControllers;
+        AttributeControllers * mAttributeControllers;
+
+        typedef ControllerTable<StyleController> StyleControllers;
+        StyleControllers * mStyleControllers;
+
+    private:
+        AttributeController * findAttributeController(const std::string & inName);
 
-        typedef std::map<std::string, StyleController *> StyleControllers;
-        StyleControllers mStyleControllers;
+        StyleController * findStyleController(const std::string & inName);
     };
 
 } // namespace XULWin
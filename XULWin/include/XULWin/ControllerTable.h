@@ -0,0 +1,149 @@
+#ifndef CONTROLLERTABLE_H_INCLUDED
+#define CONTROLLERTABLE_H_INCLUDED
+
+
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    class ConcreteComponent;
+
+
+    /**
+     * ControllerTable
+     *
+     * Maps attribute or style names to the controllers of a component class.
+     *
+     * Which controllers a component has depends only on its class. So the
+     * table is filled once, by the initAttributeControllers or
+     * initStyleControllers calls of the first instance, and shared by all
+     * instances of that class. An entry doesn't store a controller but an
+     * adaptor that returns the controller of a given component.
+     *
+     * The entries are sorted by name, lookups use a binary search.
+     */
+    template<class ControllerType>
+    class ControllerTable
+    {
+    public:
+        typedef ControllerType * (*Adaptor)(ConcreteComponent * inComponent);
+
+        ControllerTable() :
+            mComplete(false)
+        {
+        }
+
+        /**
+         * Returns the table of the component class inType.
+         */
+        static ControllerTable & Get(const std::type_info & inType)
+        {
+            static Tables fTables;
+            return fTables[&inType];
+        }
+
+        /**
+         * The table is complete after the first instance has registered all
+         * of its controllers. Further registrations are ignored.
+         */
+        bool complete() const
+        {
+            return mComplete;
+        }
+
+        void setComplete()
+        {
+            mComplete = true;
+        }
+
+        void add(const char * inName, Adaptor inAdaptor)
+        {
+            size_t idx = lowerBound(inName);
+            bool exists = idx != mEntries.size() && std::strcmp(mEntries[idx].name, inName) == 0;
+            assert(!exists);
+            if (!exists)
+            {
+                Entry entry;
+                entry.name = inName;
+                entry.adaptor = inAdaptor;
+                mEntries.insert(mEntries.begin() + idx, entry);
+            }
+        }
+
+        /**
+         * Returns the controller of inComponent for the given name, or null
+         * if there is none.
+         */
+        ControllerType * find(ConcreteComponent * inComponent, const std::string & inName) const
+        {
+            size_t idx = lowerBound(inName.c_str());
+            if (idx != mEntries.size() && inName == mEntries[idx].name)
+            {
+                return mEntries[idx].adaptor(inComponent);
+            }
+            return 0;
+        }
+
+    private:
+        size_t lowerBound(const char * inName) const
+        {
+            size_t first = 0;
+            size_t count = mEntries.size();
+            while (count > 0)
+            {
+                size_t half = count / 2;
+                if (std::strcmp(mEntries[first + half].name, inName) < 0)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        struct Entry
+        {
+            const char * name;
+            Adaptor adaptor;
+        };
+
+        struct TypeInfoLess
+        {
+            bool operator()(const std::type_info * lhs, const std::type_info * rhs) const
+            {
+                return lhs->before(*rhs) != 0;
+            }
+        };
+
+        typedef std::map<const std::type_info *, ControllerTable, TypeInfoLess> Tables;
+
+        std::vector<Entry> mEntries;
+        bool mComplete;
+    };
+
+
+    /**
+     * Adaptor for ControllerTable. ComponentType is the class that
+     * registered the controller T, inComponent must be an instance of it.
+     */
+    template<class ControllerType, class ComponentType, class T>
+    ControllerType * GetController(ConcreteComponent * inComponent)
+    {
+        return static_cast<T *>(static_cast<ComponentType *>(inComponent));
+    }
+
+} // namespace XULWin
+
+
+#endif // CONTROLLERTABLE_H_INCLUDED
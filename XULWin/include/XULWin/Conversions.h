@@ -12,6 +12,28 @@
 namespace XULWin
 {
 
+    // Maximum number of characters written by FormatInt: sign and ten digits.
+    enum { cMaxIntChars = 11 };
+
+    // Parses a decimal integer from the range [inBegin, inEnd): an optional
+    // sign followed by one or more digits. Returns false if the range holds
+    // anything else or if the value does not fit in an int. outValue is only
+    // written on success. Does not throw or allocate.
+    bool ParseInt(const char * inBegin, const char * inEnd, int & outValue);
+
+    bool ParseInt(const std::string & inValue, int & outValue);
+
+    // Parses a decimal floating point number, for example "-1.5" or "2e3",
+    // from the range [inBegin, inEnd). Same rules as ParseInt.
+    bool ParseFloat(const char * inBegin, const char * inEnd, float & outValue);
+
+    bool ParseFloat(const std::string & inValue, float & outValue);
+
+    // Writes the decimal representation of inValue to outBuffer, which must
+    // have room for cMaxIntChars characters. No terminating zero is written.
+    // Returns the number of characters written.
+    size_t FormatInt(int inValue, char * outBuffer);
+
     std::string Int2String(int inValue);
 
     int String2Int(const std::string & inValue, int inDefault);
@@ -47,11 +69,17 @@ namespace XULWin
     // hex values, rgba values, etc.
     std::string RGBColor2String(const RGBColor & inColor);
 
+    // Parses a CSS color from the range [inBegin, inEnd): "#rgb", "#rrggbb",
+    // "rgb(r, g, b)", "rgba(r, g, b, a)" or a color name. Components of
+    // rgb() can be percentages. Surrounding whitespace is ignored. Does not
+    // allocate.
+    bool ParseRGBColor(const char * inBegin, const char * inEnd, RGBColor & outResult);
+
     // HTML (hex) style formatting, for example: "eb8080"
     RGBColor HTMLColor2RGBColor(const std::string & inHTMLColor);
     bool HTMLColor2RGBColor(const std::string & inValue, RGBColor & outResult);
 
-    // RGB style formatting, for example: "rgb(0,0,255)"
+    // RGB style formatting, for example: "rgb(0,0,255)" or "rgba(0,0,255,0.5)"
     bool RGBString2RGBColor(const std::string & inValue, RGBColor & outResult);
 
     // Color name, for example: "white"
@@ -67,6 +95,14 @@ namespace XULWin
 
     Points String2Points(const std::string & inValue);
 
+    std::string SVGPathData2String(const SVGPathData & inPathData);
+
+    // Reports an error and returns false if the path data contains an error.
+    // outPathData then contains the path up to the error.
+    bool String2SVGPathData(const std::string & inValue, SVGPathData & outPathData);
+
+    // The instructions store one PointFs per command. Use SVGPathData instead,
+    // these are only kept for compatibility.
     std::string SVGPathInstructions2String(const SVGPathInstructions & inPathInstructions);
 
     SVGPathInstructions String2SVGPathInstructions(const std::string & inValue);
@@ -167,6 +167,10 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
+        virtual void invalidateSizeCache();
+
+        virtual bool isSizeCacheValid() const;
+
         // Tendency to expand, used for separators, scrollbars, etc..
         virtual bool expansive() const;
 
@@ -186,6 +190,12 @@ namespace XULWin
 
         virtual void rebuildChildLayouts();
 
+        virtual void invalidateLayout();
+
+        virtual bool needsLayout() const;
+
+        virtual void updateLayout();
+
         virtual LRESULT handleMessage(UINT inMessage, WPARAM wParam, LPARAM lParam);
 
         virtual bool initAttributeControllers();
@@ -205,8 +215,14 @@ namespace XULWin
 
         virtual bool setAttribute(const std::string & inName, const std::string & inValue);
 
+        virtual bool getAttributeValue(const std::string & inName, AttributeValue & outValue);
+
+        virtual bool setAttributeValue(const std::string & inName, const AttributeValue & inValue);
+
         virtual bool setStyle(const std::string & inName, const std::string & inValue);
 
+        virtual bool setStyle(const StyleDeclaration & inDeclaration);
+
         virtual void onChildAdded(Component * inChild);
 
         virtual void onChildRemoved(Component * inChild);
@@ -94,6 +94,12 @@ namespace XULWin
         LRESULT handleMouseWheel(WPARAM wParam, LPARAM lParam);
 
     private:
+        // Returns the decorated component if it is a virtualized viewport.
+        Viewport * getVirtualizedViewport();
+
+        // Offset in pixels that corresponds with the scrollbar positions.
+        Point getScrollOffset() const;
+
         void updateWindowScroll();
         void updateHorizontalScrollInfo();
         void updateVerticalScrollInfo();
@@ -59,8 +59,12 @@ namespace XULWin
 
         virtual void move(int x, int y, int w, int h);
 
+        virtual void invalidateLayout();
+
         virtual void rebuildLayout();
 
+        virtual void onChildRemoved(Component * inChild);
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
@@ -105,7 +109,7 @@ namespace XULWin
 
         virtual void BoxLayouter_rebuildChildLayouts()
         {
-            rebuildChildLayouts();
+            rebuildInvalidatedChildLayouts();
         }
 
         virtual LRESULT handleMessage(UINT inMessage, WPARAM wParam, LPARAM lParam);
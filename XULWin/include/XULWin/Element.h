@@ -3,12 +3,16 @@
 
 
 #include "XULWin/AttributesMapping.h"
+#include "XULWin/AttributeValue.h"
+#include "XULWin/ElementAttributes.h"
 #include "XULWin/Enums.h"
 #include "XULWin/ForwardDeclarations.h"
 #include <boost/noncopyable.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -36,6 +40,56 @@ namespace XULWin
     class Element : private boost::noncopyable
     {
     public:
+        /**
+         * Interned tag name.
+         *
+         * Each distinct tag name is mapped to a small integer so that
+         * type checks and tag queries don't need string compares.
+         */
+        typedef int TagId;
+
+        static const TagId cNoTagId = -1;
+
+        /**
+         * Returns the id for the given tag name.
+         *
+         * A new id is assigned the first time a tag name is seen.
+         */
+        static TagId InternTagName(const std::string & inTagName);
+
+        /**
+         * Returns the id for the given tag name, or cNoTagId if it was
+         * never interned.
+         */
+        static TagId FindTagId(const std::string & inTagName);
+
+        /**
+         * Interns the tag name of an Element subclass.
+         *
+         * Called by ElementFactory::registerElement, and by Create for
+         * element types that were never registered.
+         */
+        template<class ElementType>
+        static TagId RegisterTagName()
+        {
+            TagId & tagId = TagIdSlot<ElementType>();
+            if (tagId == cNoTagId)
+            {
+                tagId = InternTagName(ElementType::TagName());
+            }
+            return tagId;
+        }
+
+        /**
+         * Returns the tag id for an Element subclass, or cNoTagId if no
+         * element of that type was registered or created yet.
+         */
+        template<class ElementType>
+        static TagId TagIdOf()
+        {
+            return TagIdSlot<ElementType>();
+        }
+
         /**
          * Factory method for all elements.
          *
@@ -60,15 +114,7 @@ namespace XULWin
                                  const AttributesMapping & inAttr)
         {
             ElementPtr result(new ElementType(inParent, inAttr));
-            result->initAttributeControllers();
-            result->setAttributes(inAttr);
-            result->initStyleControllers();
-            result->setStyles(inAttr);
-            if (inParent)
-            {
-                // The addChild() method also calls Component::onChildAdded
-                inParent->addChild(result);
-            }
+            Initialize(result, RegisterTagName<ElementType>(), inParent, inAttr);
             return result;
         }
 
@@ -125,6 +171,11 @@ namespace XULWin
          */
         const std::string & tagName() const;
 
+        /**
+         * Returns the interned id of the tagname.
+         */
+        TagId tagId() const;
+
         /**
          * Returns the parent element.
          *
@@ -167,6 +218,25 @@ namespace XULWin
          */
         void setAttribute(const std::string & inName, const std::string & inValue);
 
+        /**
+         * Gets an attribute in its native type.
+         *
+         * Works like getAttribute, but natively mapped int, bool, enum and
+         * color attributes are returned without a conversion to string.
+         * Attributes that are not natively mapped are returned as strings.
+         *
+         * Returns a null value if the attribute was not found.
+         */
+        AttributeValue getAttributeValue(const std::string & inName) const;
+
+        /**
+         * Sets an attribute from a value in its native type.
+         *
+         * Works like setAttribute. If no attribute controller is found the
+         * value is stored as a string in the attributes mapping.
+         */
+        void setAttributeValue(const std::string & inName, const AttributeValue & inValue);
+
         /**
          * Gets an attribute without querying the component.
          *
@@ -196,16 +266,40 @@ namespace XULWin
 
         /**
          * Sets the text between an Element's opening and closing tags.
+         *
+         * Text that consists of whitespace only is not stored, the inner
+         * text is then empty.
          */
         void setInnerText(const std::string & inText);
 
+        /**
+         * Sets the text between an Element's opening and closing tags.
+         *
+         * The buffer is shared instead of copied. Text that consists of
+         * whitespace only is not stored.
+         */
+        void setInnerText(const boost::shared_ptr<const std::string> & inText);
+
         /**
          * Returns the text between an Element's opening and closing tags.
          */
         const std::string & innerText() const;
 
+        /**
+         * Returns the text between an Element's opening and closing tags
+         * as a shared buffer. Returns a null pointer if there is no text.
+         */
+        boost::shared_ptr<const std::string> sharedInnerText() const;
+
         /**
          * Finds an element in the DOM tree with the requested id.
+         *
+         * Only descendants of this element are considered. The lookup
+         * uses the id index of the document element so it does not
+         * need to walk the tree.
+         *
+         * Returns 0 if there is no such element. This is not an error:
+         * callers use it to test for optional elements.
          */
         Element * getElementById(const std::string & inId);
 
@@ -215,6 +309,17 @@ namespace XULWin
         void getElementsByTagName(const std::string & inType,
                                   std::vector<Element *> & outElements);
 
+        /**
+         * Returns this element and its descendants that have the requested
+         * tag id, in document order.
+         *
+         * The document element keeps an index of its elements ordered by tag
+         * id and document position, so the cost is proportional to the
+         * number of matches.
+         */
+        void getElementsByTagId(TagId inTagId,
+                                std::vector<Element *> & outElements);
+
         /**
          * Returns all elements that have the requested type.
          *
@@ -223,13 +328,11 @@ namespace XULWin
         template<class ElementType>
         void getElementsByType(std::vector<ElementType *> & outElements)
         {
-            if (ElementType * element = downcast<ElementType>())
+            std::vector<Element *> elements;
+            getElementsByTagId(TagIdOf<ElementType>(), elements);
+            for (size_t idx = 0; idx != elements.size(); ++idx)
             {
-                outElements.push_back(element);
-            }
-            for (size_t idx = 0; idx != mChildren.size(); ++idx)
-            {
-                mChildren[idx]->getElementsByType<ElementType>(outElements);
+                outElements.push_back(static_cast<ElementType *>(elements[idx]));
             }
         }
 
@@ -275,9 +378,9 @@ namespace XULWin
         template<class ElementType>
         const ElementType * downcast() const
         {
-            if (tagName() == ElementType::TagName())
+            if (mTagId == TagIdOf<ElementType>())
             {
-                return static_cast<ElementType *>(this);
+                return static_cast<const ElementType *>(this);
             }
             return 0;
         }
@@ -290,7 +393,7 @@ namespace XULWin
         template<class ElementType>
         ElementType * downcast()
         {
-            if (tagName() == ElementType::TagName())
+            if (mTagId == TagIdOf<ElementType>())
             {
                 return static_cast<ElementType *>(this);
             }
@@ -330,14 +433,27 @@ namespace XULWin
     protected:
         Element(const std::string & inType, Element * inParent, Component * inNative);
 
+        /**
+         * Performs the creation steps that follow the constructor.
+         *
+         * Only needed by subclasses that construct their objects themselves
+         * instead of using Create, for example because one class is used for
+         * several tags. The tag id must match the tag name that was passed
+         * to the constructor.
+         */
+        static void Initialize(ElementPtr inElement,
+                               TagId inTagId,
+                               Element * inParent,
+                               const AttributesMapping & inAttr);
+
         Element * mParent;
         Children mChildren;
-        AttributesMapping mAttributes;
+        ElementAttributes mAttributes;
 
     private:
         void setAttributes(const AttributesMapping & inAttributes);
 
-        void setStyle(const std::string & inName, const std::string & inValue);
+        void setStyle(const StyleDeclaration & inDeclaration);
 
         void setStyles(const AttributesMapping & inAttributes);
 
@@ -345,10 +461,76 @@ namespace XULWin
 
         void initStyleControllers();
 
+        // Adds this element to the id index of its document.
+        void registerId();
+
+        // Removes this element from the id index of its document.
+        void unregisterId();
+
+        // Called after a child was removed from mChildren.
+        void detachChild(Element * inChild);
+
+        // Moves this element and its descendants to another document.
+        void setDocument(Element * inDocument);
+
+        // Sets the tag id and adds this element to the tag index of its document.
+        void registerTag(TagId inTagId);
+
+        // Adds this element to the tag index of its document.
+        void registerTag();
+
+        // Removes this element from the tag index of its document.
+        void unregisterTag();
+
+        // Renumbers the elements of this document in document order and
+        // rebuilds the tag index. Only called on the document element.
+        void reindexTags();
+
+        void reindexTags(Element * inElement);
+
+        // Tests whether the position of this element is in the range of
+        // inElement. Only valid while the positions of the document follow
+        // document order, see mTagIndexInDocumentOrder.
+        bool isDescendantOf(const Element * inElement) const;
+
+        template<class ElementType>
+        static TagId & TagIdSlot()
+        {
+            static TagId fTagId = cNoTagId;
+            return fTagId;
+        }
+
         friend class ElementFactory;
+        // Maps an id to the first element that has it. The elements
+        // that share an id are chained through mNextWithSameId.
+        typedef std::tr1::unordered_map<std::string, Element *> IdIndex;
+
+        // Tag id and document position
+        typedef std::pair<TagId, size_t> TagKey;
+        typedef std::map<TagKey, Element *> TagIndex;
+
         std::string mType;
         StylesMapping mStyles;
-        std::string mInnerText;
+        boost::shared_ptr<const std::string> mInnerText;
+        Element * mDocument;
+        IdIndex mIdIndex; // only used by the document element
+        std::string mIndexedId;
+        Element * mNextWithSameId;
+        TagId mTagId;
+
+        // Position of this element in its document, and the position of the
+        // last element of its subtree. A subtree is a contiguous range.
+        size_t mPosition;
+        size_t mLastPosition;
+
+        // Only used by the document element. Positions are assigned in
+        // creation order. This is also document order as long as new
+        // elements are created on the last branch of the tree, which is
+        // what the parser does. Otherwise the next query renumbers the
+        // document.
+        TagIndex mTagIndex;
+        size_t mNextPosition;
+        bool mTagIndexInDocumentOrder;
         boost::scoped_ptr<Component> mComponent;
     };
 
@@ -0,0 +1,110 @@
+#ifndef ELEMENTATTRIBUTES_H_INCLUDED
+#define ELEMENTATTRIBUTES_H_INCLUDED
+
+
+#include "XULWin/AttributesMapping.h"
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * AttributeArena
+     *
+     * Storage for the attribute values of the elements of a document.
+     * Values are copied into large blocks, which are all freed together
+     * when the arena is destroyed. Each element keeps the arena of the
+     * document it was created in alive, also if it is moved to another
+     * document later.
+     */
+    class AttributeArena : boost::noncopyable
+    {
+    public:
+        AttributeArena();
+
+        ~AttributeArena();
+
+        /**
+         * Returns a buffer of inSize characters that stays valid until the
+         * arena is destroyed.
+         */
+        char * allocate(size_t inSize);
+
+    private:
+        static const size_t cBlockSize = 4096;
+
+        std::vector<char *> mBlocks;
+        char * mFree;
+        size_t mNumFree;
+    };
+
+    typedef boost::shared_ptr<AttributeArena> AttributeArenaPtr;
+
+
+    /**
+     * ElementAttributes
+     *
+     * The attributes of an Element. The names are interned, so each
+     * distinct name is stored only once per process, and the values are
+     * stored in the AttributeArena of the document. Storing the attributes
+     * of a new element takes one allocation for the entries, not one per
+     * attribute.
+     *
+     * A value that is set again reuses its slice of the arena if the new
+     * value fits in it. Otherwise the value is copied to a new slice, and
+     * the old one is only freed with the arena.
+     */
+    class ElementAttributes
+    {
+    public:
+        ElementAttributes(const AttributeArenaPtr & inArena);
+
+        const AttributeArenaPtr & arena() const;
+
+        size_t size() const;
+
+        /**
+         * Replaces the attributes.
+         */
+        void assign(const AttributesMapping & inAttributes);
+
+        /**
+         * Returns false if the attribute is not set.
+         */
+        bool get(const std::string & inName, std::string & outValue) const;
+
+        void set(const std::string & inName, const std::string & inValue);
+
+        /**
+         * Returns the interned copy of an attribute name.
+         */
+        static const char * InternName(const std::string & inName);
+
+    private:
+        struct Entry
+        {
+            const char * name;
+            char * value;
+            size_t size;
+            size_t capacity;
+        };
+
+        typedef std::vector<Entry> Entries;
+
+        Entries::const_iterator find(const std::string & inName) const;
+
+        void setValue(Entry & ioEntry, const std::string & inValue);
+
+        Entries mEntries;
+        AttributeArenaPtr mArena;
+    };
+
+
+} // namespace XULWin
+
+
+#endif // ELEMENTATTRIBUTES_H_INCLUDED
@@ -5,6 +5,7 @@
 #include "XULWin/Element.h"
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <map>
 
 
 namespace XULWin
@@ -46,6 +47,7 @@ namespace XULWin
         template<class ElementType>
         void registerElement()
         {
+            Element::RegisterTagName<ElementType>();
             mFactoryMethods.insert(std::make_pair(ElementType::TagName(),
                                                   boost::bind(ElementType::Create, _1, _2)));
         }
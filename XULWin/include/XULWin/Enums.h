@@ -61,6 +61,26 @@ namespace XULWin
     };
 
 
+    enum CSSProperty
+    {
+        CSSProperty_Unknown,
+        CSSProperty_X,
+        CSSProperty_Y,
+        CSSProperty_Width,
+        CSSProperty_Height,
+        CSSProperty_Margin,
+        CSSProperty_TextAlign,
+        CSSProperty_Color,
+        CSSProperty_BackgroundColor,
+        CSSProperty_Fill,
+        CSSProperty_Stroke,
+        CSSProperty_ListStyleImage,
+        CSSProperty_Overflow,
+        CSSProperty_OverflowX,
+        CSSProperty_OverflowY
+    };
+
+
 } // namespace XULWin
 
 
@@ -18,6 +18,7 @@ namespace XULWin
     class ElementFactory;
     class EventListener;
     class NativeComponent;
+    class StyleDeclaration;
     typedef boost::shared_ptr<Component> ComponentPtr;
     typedef boost::shared_ptr<Element> ElementPtr;
     typedef std::vector<ElementPtr> Children;
@@ -2,6 +2,7 @@
 #define GENERIC_GRID_H
 
 
+#include <cstddef>
 #include <vector>
 
 
@@ -0,0 +1,209 @@
+#ifndef HEADLESSLAYOUT_H_INCLUDED
+#define HEADLESSLAYOUT_H_INCLUDED
+
+
+#include "XULWin/AttributesMapping.h"
+#include "XULWin/Enums.h"
+#include "XULWin/Rect.h"
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    class TextMetrics;
+
+
+    /**
+     * HeadlessNode
+     *
+     * An element of a XUL document loaded by HeadlessLayout. Unlike Element
+     * it has no component, so it can be created and laid out on machines
+     * without a window system.
+     */
+    class HeadlessNode : boost::noncopyable
+    {
+    public:
+        /**
+         * The node is added to the children of inParent, which owns it.
+         */
+        HeadlessNode(HeadlessNode * inParent,
+                     const std::string & inTagName,
+                     const AttributesMapping & inAttributes);
+
+        ~HeadlessNode();
+
+        const std::string & tagName() const;
+
+        HeadlessNode * parent() const;
+
+        size_t getChildCount() const;
+
+        const HeadlessNode * getChild(size_t idx) const;
+
+        const AttributesMapping & attributes() const;
+
+        /**
+         * Returns an empty string if the attribute is not set.
+         */
+        const std::string & getAttribute(const std::string & inName) const;
+
+        const std::string & innerText() const;
+
+        void setInnerText(const std::string & inText);
+
+        /**
+         * Returns the rect that the last layout pass assigned to the node,
+         * in window client coordinates. Like the rect of a MarginDecorator
+         * it includes the margins. Nodes that are not part of the layout,
+         * like script, have an empty rect.
+         */
+        const Rect & rect() const;
+
+    private:
+        friend class HeadlessLayout;
+
+        std::string mTagName;
+        HeadlessNode * mParent;
+        std::vector<HeadlessNode *> mChildren;
+        AttributesMapping mAttributes;
+        std::string mInnerText;
+
+        // Resolved from the attributes when the document is loaded. The
+        // type is -1 for nodes that are not part of the layout.
+        int mType;
+        int mFlex;
+        bool mHidden;
+        int mWidth;
+        int mHeight;
+        int mCSSWidth;
+        int mCSSHeight;
+        int mMargin[4];
+        Orient mOrient;
+        Align mAlign;
+        bool mScrollX;
+        bool mScrollY;
+
+        // Sizes without margins, -1 until measured.
+        mutable int mCachedWidths[Maximum + 1];
+        mutable int mCachedHeights[Maximum + 1];
+
+        // Column widths of a grid, measured in one pass over the cells.
+        mutable std::vector<int> mColumnWidths[Maximum + 1];
+
+        Rect mRect;
+    };
+
+
+    /**
+     * HeadlessLayout
+     *
+     * Loads a XUL document and lays it out without creating any windows.
+     * Text is measured by a TextMetrics provider instead of a device
+     * context.
+     *
+     * The size of each element follows the calculateWidth and
+     * calculateHeight implementation of its component, and boxes and grids
+     * are laid out by the same LinearLayoutManager and GridLayoutManager
+     * as the native containers. Elements that the XULParser doesn't know
+     * and elements outside the client area, like script and menupopup,
+     * are kept in the tree but not laid out. Scrollbars, images and the
+     * contents of native lists and trees are not measured; lists, trees,
+     * toolbars and SVG get a default control size unless their width and
+     * height are set.
+     */
+    class HeadlessLayout : boost::noncopyable
+    {
+    public:
+        /**
+         * The text metrics must outlive the layout.
+         */
+        HeadlessLayout(const TextMetrics & inTextMetrics);
+
+        ~HeadlessLayout();
+
+        /**
+         * Loads a XUL file. chrome:// URLs, for example of a locale DTD,
+         * are resolved relative to the application directory, which is the
+         * directory that contains the "chrome" directory of the file.
+         * Reports an error and returns false if the file can't be parsed.
+         */
+        bool loadFile(const std::string & inPath);
+
+        /**
+         * Loads a XUL document from a string.
+         */
+        bool loadXUL(const std::string & inXUL);
+
+        /**
+         * Returns null if no document is loaded.
+         */
+        const HeadlessNode * rootNode() const;
+
+        /**
+         * Lays out the document for a window client area of inWidth by
+         * inHeight pixels. Measured sizes are kept between passes, so
+         * laying out the same document at another size is cheap.
+         */
+        void layout(int inWidth, int inHeight);
+
+        /**
+         * Returns the size that the node asks for, including its margins.
+         */
+        int getWidth(const HeadlessNode * inNode, SizeConstraint inSizeConstraint) const;
+
+        int getHeight(const HeadlessNode * inNode, SizeConstraint inSizeConstraint) const;
+
+        /**
+         * Writes the rect of each node on a line of its own, indented by
+         * its depth, for example:
+         *
+         *   window 0 0 320 240
+         *     button#ok 4 2 75 23
+         */
+        void dump(std::ostream & outStream) const;
+
+    private:
+        bool load(const std::string & inXUL, const std::string & inPath);
+
+        void init(HeadlessNode * inNode);
+
+        // Width or height without margins, like calculateWidth/Height.
+        int getSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const;
+
+        int calculateSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const;
+
+        int calculateBoxSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const;
+
+        int calculateChildSize(const HeadlessNode * inNode, bool inWidth, bool inSum, SizeConstraint inSizeConstraint) const;
+
+        int getTextWidth(const std::string & inText) const;
+
+        int getTextHeight(const std::string & inText) const;
+
+        // The width or height that a grid gives to its cells, like the
+        // no-argument Component::getWidth and getHeight.
+        int getCellSize(const HeadlessNode * inNode, bool inWidth) const;
+
+        int getColumnWidth(const HeadlessNode * inColumn, SizeConstraint inSizeConstraint) const;
+
+        void layoutNode(HeadlessNode * inNode, const Rect & inRect);
+
+        void layoutBox(HeadlessNode * inNode, const Rect & inClientRect);
+
+        void layoutGrid(HeadlessNode * inNode, const Rect & inClientRect);
+
+        void dump(const HeadlessNode * inNode, int inDepth, std::ostream & outStream) const;
+
+        const TextMetrics & mTextMetrics;
+        boost::scoped_ptr<HeadlessNode> mRootNode;
+    };
+
+} // namespace XULWin
+
+
+#endif // HEADLESSLAYOUT_H_INCLUDED
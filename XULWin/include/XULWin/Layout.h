@@ -90,6 +90,32 @@ namespace XULWin
         static void GetSizes(int inLength, const std::vector<SizeInfo> & inSizeInfos, std::vector<int> & outSizes);
         static void GetSizes(int inLength, const std::vector<int> & inSizeInfos, std::vector<int> & outSizes);
 
+        /**
+         * Divides inLength over inCount items and writes their sizes to
+         * outSizes. Does not allocate.
+         *
+         * Items without flex get their optimal size. Items with flex share
+         * the rest in proportion to their flex, but never get less than
+         * their optimal size. If the optimal sizes don't fit, every item
+         * shrinks towards its minimum size, in proportion to how much it can
+         * shrink. Takes O(n log n) time for n items.
+         *
+         * The sizes add up to inLength, except if the minimum sizes don't
+         * fit, or if no item has flex and the optimal sizes are smaller.
+         */
+        static void GetSizes(int inLength, const SizeInfo * inSizeInfos, size_t inCount, int * outSizes);
+
+        static void GetSizes(int inLength, const ExtendedSizeInfo * inSizeInfos, size_t inCount, int * outSizes);
+
+        /**
+         * Divides inLength over inCount items in proportion to their weights
+         * and writes their sizes to outSizes. Each size differs less than one
+         * from its exact share, and the sizes add up to inLength unless all
+         * weights are zero. Negative lengths and weights count as zero.
+         * Does not allocate.
+         */
+        static void GetSizes(int inLength, const int * inWeights, size_t inCount, int * outSizes);
+
         Orient orientation() const;
 
     private:
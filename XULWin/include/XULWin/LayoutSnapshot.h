@@ -0,0 +1,128 @@
+#ifndef LAYOUTSNAPSHOT_H_INCLUDED
+#define LAYOUTSNAPSHOT_H_INCLUDED
+
+
+#include "XULWin/Rect.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    class HeadlessLayout;
+    class HeadlessNode;
+
+
+    /**
+     * LayoutSnapshot
+     *
+     * Records the result of a HeadlessLayout pass: the rect of every node
+     * together with its minimum and preferred size. Snapshots are written
+     * as text, one node per line in document order:
+     *
+     *   # XULWin layout snapshot 1
+     *   window 0 0 320 240 166 27 166 27
+     *   window/hbox 0 0 320 27 166 27 166 27
+     *   window/hbox/button[1]#ok 0 0 83 27 83 27 83 27
+     *   window/hbox/spacer 83 0 154 27 0 0 0 0
+     *   window/hbox/button[2]#cancel 237 0 83 27 83 27 83 27
+     *
+     * The fields after the path are x, y, width, height, minimum width,
+     * minimum height, preferred width and preferred height. The path is
+     * made of the tag names from the root down. A tag name is followed by
+     * its position among the siblings with the same tag name, counting from
+     * one, if there is more than one of them, and by the id if it has one.
+     * The output only depends on the layout, so two runs that give the same
+     * layout give byte-identical snapshots.
+     */
+    class LayoutSnapshot
+    {
+    public:
+        struct Entry
+        {
+            Entry();
+
+            std::string path;
+            Rect rect;
+            int minimumWidth;
+            int minimumHeight;
+            int preferredWidth;
+            int preferredHeight;
+
+            bool operator==(const Entry & inOther) const;
+
+            bool operator!=(const Entry & inOther) const;
+        };
+
+        /**
+         * A node that is in only one of the snapshots, or that has a
+         * different rect or size in each of them.
+         */
+        struct Delta
+        {
+            enum Kind
+            {
+                Kind_Changed,
+                Kind_Added,
+                Kind_Removed
+            };
+
+            Kind kind;
+            Entry before;
+            Entry after;
+        };
+
+        LayoutSnapshot();
+
+        /**
+         * Records the current layout of the document.
+         */
+        explicit LayoutSnapshot(const HeadlessLayout & inLayout);
+
+        size_t size() const;
+
+        const Entry & get(size_t idx) const;
+
+        bool operator==(const LayoutSnapshot & inOther) const;
+
+        bool operator!=(const LayoutSnapshot & inOther) const;
+
+        void write(std::ostream & outStream) const;
+
+        /**
+         * Replaces the entries with those read from the stream. Reports an
+         * error and returns false if the stream doesn't contain a snapshot.
+         */
+        bool read(std::istream & inStream);
+
+        /**
+         * Returns the differences between two snapshots of the same
+         * document, matched by path. Changed and removed nodes come first,
+         * in the order of inBefore, followed by the added nodes in the
+         * order of inAfter.
+         */
+        static void Compare(const LayoutSnapshot & inBefore,
+                            const LayoutSnapshot & inAfter,
+                            std::vector<Delta> & outDeltas);
+
+        /**
+         * Writes one line per delta, for example:
+         *
+         *   changed window/hbox/spacer: width 154 -> 71
+         *   changed window/hbox/button[2]#cancel: x 237 -> 154
+         *   added window/hbox/button[3]#help: 237 0 83 27 83 27 83 27
+         */
+        static void WriteDeltas(const std::vector<Delta> & inDeltas, std::ostream & outStream);
+
+    private:
+        void add(const HeadlessLayout & inLayout, const HeadlessNode * inNode, const std::string & inPath);
+
+        std::vector<Entry> mEntries;
+    };
+
+} // namespace XULWin
+
+
+#endif // LAYOUTSNAPSHOT_H_INCLUDED
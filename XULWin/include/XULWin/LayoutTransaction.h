@@ -0,0 +1,148 @@
+#ifndef LAYOUTTRANSACTION_H_INCLUDED
+#define LAYOUTTRANSACTION_H_INCLUDED
+
+
+#include "XULWin/Rect.h"
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * LayoutTransaction collects the window moves of a layout pass and
+     * commits them in one batch when the outermost transaction goes out of
+     * scope.
+     *
+     * LayoutTransaction objects should always be created on the stack.
+     * Only one transaction is active at a time. Creating a transaction while
+     * another one is active joins the active one. A joining transaction
+     * doesn't have a backend of its own: the moves are committed by the
+     * backend of the outermost transaction.
+     *
+     * Windows are identified by an opaque handle. Only the backend knows
+     * what it refers to, so the bookkeeping can be tested without creating
+     * any windows.
+     *
+     * While a move is pending the window still has its old geometry, so
+     * code that needs the new geometry should use GetPendingRect, or call
+     * Flush to commit the moves recorded so far.
+     */
+    class LayoutTransaction : boost::noncopyable
+    {
+    public:
+        // The HWND for the DeferWindowPos backend.
+        typedef void * Handle;
+
+        struct Move
+        {
+            Move(Handle inHandle, const Rect & inRect) :
+                handle(inHandle),
+                rect(inRect)
+            {
+            }
+
+            Handle handle;
+
+            // Position relative to the parent window's client area.
+            Rect rect;
+        };
+
+        typedef std::vector<Move> Moves;
+
+
+        /**
+         * Backend applies the collected moves.
+         */
+        class Backend
+        {
+        public:
+            virtual ~Backend() {}
+
+            virtual void commit(const Moves & inMoves) = 0;
+        };
+
+
+        /**
+         * Moves the windows using BeginDeferWindowPos/EndDeferWindowPos.
+         * This is the default backend. The handles must be HWNDs.
+         */
+        class DeferWindowPosBackend : public Backend
+        {
+        public:
+            virtual void commit(const Moves & inMoves);
+        };
+
+
+        /**
+         * Only records the moves. Windows are left untouched.
+         * Useful for inspecting the outcome of a layout pass.
+         */
+        class RecordingBackend : public Backend
+        {
+        public:
+            virtual void commit(const Moves & inMoves);
+
+            // One entry per commit.
+            const std::vector<Moves> & commits() const;
+
+            void clear();
+
+        private:
+            std::vector<Moves> mCommits;
+        };
+
+
+        // Starts a new transaction using the DeferWindowPos backend,
+        // or joins the active transaction.
+        LayoutTransaction();
+
+        // Starts a new transaction using the given backend. Joining an
+        // active transaction that uses a different backend is an error,
+        // because the moves would not reach the given backend.
+        LayoutTransaction(Backend & inBackend);
+
+        // Commits the pending moves if this is the outermost transaction.
+        ~LayoutTransaction();
+
+        // Returns the active transaction, or 0 if there is none.
+        static LayoutTransaction * Current();
+
+        // Records the move if a transaction is active, or moves the window
+        // immediately otherwise.
+        static void MoveWindow(Handle inHandle, const Rect & inRect);
+
+        // Gets the rect the window will have once the active transaction
+        // is committed. Returns false if no move is pending for the window.
+        static bool GetPendingRect(Handle inHandle, Rect & outRect);
+
+        // Commits the moves recorded so far by the active transaction.
+        static void Flush();
+
+    private:
+        void record(Handle inHandle, const Rect & inRect);
+
+        bool getPendingRect(Handle inHandle, Rect & outRect) const;
+
+        void commit();
+
+        DeferWindowPosBackend mDefaultBackend;
+        Backend * mBackend;
+        Moves mMoves;
+
+        // Maps a window handle to its index in mMoves, so that a window
+        // that is moved more than once only gets moved to its final rect.
+        typedef std::map<Handle, size_t> Indices;
+        Indices mIndices;
+
+        bool mOwns;
+        static LayoutTransaction * sCurrent;
+    };
+
+} // namespace XULWin
+
+
+#endif // LAYOUTTRANSACTION_H_INCLUDED
@@ -4,6 +4,7 @@
 
 #include "XULWin/NativeControl.h"
 #include "XULWin/EventListener.h"
+#include "XULWin/ListModel.h"
 #include "XULWin/VirtualComponent.h"
 #include "XULWin/PhonyComponent.h"
 #include "XULWin/WindowsListView.h"
@@ -45,18 +46,30 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
+        virtual void onChildRemoved(Component * inChild);
+
+        /**
+         * Returns the model that contains the rows of the listbox.
+         */
+        ListModel & listModel();
+
+        const ListModel & listModel() const;
+
     private:
         bool isListView() const;
 
         Fallible<int> mRows;
+        ListModel mListModel;
         boost::scoped_ptr<ListBoxImpl> mListBoxImpl;
     };
 
     
     /**
      * ListBoxImpl is the base class for either a Window list box or a Windows list view.
+     *
+     * The contents are taken from the list model of the ListBox.
      */
-    class ListBoxImpl
+    class ListBoxImpl : public ListModel::Listener
     {
     public:
         ListBoxImpl(ListBox * inListBox);
@@ -67,6 +80,9 @@ namespace XULWin
 
         virtual void rebuild();
 
+        // Rebuilds by default.
+        virtual void onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount);
+
     protected:
         ListBox * mListBox;
     };
@@ -84,6 +100,8 @@ namespace XULWin
 
         virtual void rebuild();
 
+        virtual void onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount);
+
     private:
         boost::scoped_ptr<WinAPI::ListBox> mWinAPI_ListBox;
     };
@@ -132,9 +150,33 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
+        /**
+         * Returns the list model row for this item.
+         *
+         * Contains the listcell children, or the item label if
+         * there are no cells.
+         */
+        ListModel::Row getListModelRow() const;
+
+        /**
+         * Writes the item's row back to the list model after
+         * the item or one of its cells has changed.
+         */
+        void updateListModelRow();
+
+        /**
+         * Removes the item's row from the list model. The rows of the
+         * following list items move up.
+         */
+        void removeListModelRow();
+
     private:
         std::string mLabel;
         bool mSelected;
+
+        // The model that contains the item's row, or 0 if the item has no row.
+        ListModel * mListModel;
+        size_t mListModelRow;
     };
 
 
@@ -210,7 +252,15 @@ namespace XULWin
     };
 
 
-    class ListView : public NativeControl
+    /**
+     * ListView shows the rows of its list model in a WinAPI list view.
+     *
+     * The items are kept in sync with the model: rows that are inserted or
+     * removed are inserted or deleted in the control. The text is requested
+     * from the model when an item is drawn.
+     */
+    class ListView : public NativeControl,
+                     public ListModel::Listener
     {
     public:
         typedef NativeControl Super;
@@ -230,11 +280,23 @@ namespace XULWin
 
         virtual void onChildAdded(Component * inChild);
 
+        virtual void onChildRemoved(Component * inChild);
+
         void addListHeader(ListHeader * inListHeader);
 
+        /**
+         * Returns the model that contains the rows of the list view.
+         */
+        ListModel & listModel();
+
+        virtual void onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount);
+
     private:
         LRESULT handleGetDispInfo(WPARAM wParam, LPARAM lParam);
 
+        void insertItem(size_t inRow);
+
+        ListModel mListModel;
         ScopedEventListener mEventListener;
     };
 
@@ -0,0 +1,134 @@
+#ifndef LISTMODEL_H_INCLUDED
+#define LISTMODEL_H_INCLUDED
+
+
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * ListModel contains the rows that are shown by a list box or list view.
+     *
+     * Each row consists of cells that have a label and an optional image.
+     * Lookups by row and column index take constant time.
+     *
+     * A XUL listbox keeps its model in sync with its listitem and listcell
+     * elements. The model can also be filled directly from C++, which avoids
+     * creating an element for each row. In that case the listbox should not
+     * have any listitem children.
+     *
+     * This class does not depend on the Windows API.
+     */
+    class ListModel : private boost::noncopyable
+    {
+    public:
+        struct Cell
+        {
+            Cell();
+
+            Cell(const std::string & inLabel,
+                 const std::string & inImage = std::string());
+
+            std::string label;
+            std::string image;
+        };
+
+        typedef std::vector<Cell> Row;
+
+        typedef std::vector<Row> Rows;
+
+        enum Change
+        {
+            Change_RowsInserted,
+            Change_RowsRemoved,
+            Change_RowChanged,
+            Change_Reset
+        };
+
+        /**
+         * Listener objects are notified after the model has changed.
+         *
+         * The row and count arguments are zero for Change_Reset. A listener
+         * may add or remove listeners from onListModelChanged.
+         */
+        class Listener
+        {
+        public:
+            virtual ~Listener() {}
+
+            virtual void onListModelChanged(Change inChange, size_t inRow, size_t inCount) = 0;
+        };
+
+        ListModel();
+
+        size_t rowCount() const;
+
+        size_t columnCount(size_t inRow) const;
+
+        /**
+         * Returns an empty row if the index is out of range.
+         */
+        const Row & getRow(size_t inRow) const;
+
+        /**
+         * Returns an empty string if the cell does not exist.
+         */
+        const std::string & getLabel(size_t inRow, size_t inColumn) const;
+
+        /**
+         * Returns an empty string if the cell does not exist.
+         */
+        const std::string & getImage(size_t inRow, size_t inColumn) const;
+
+        void appendRow(const Row & inRow);
+
+        void insertRow(size_t inIndex, const Row & inRow);
+
+        void setRow(size_t inIndex, const Row & inRow);
+
+        void removeRow(size_t inIndex);
+
+        /**
+         * Sets the label of a cell.
+         *
+         * The row is extended with empty cells if needed.
+         */
+        void setLabel(size_t inRow, size_t inColumn, const std::string & inLabel);
+
+        /**
+         * Sets the image of a cell.
+         *
+         * The row is extended with empty cells if needed.
+         */
+        void setImage(size_t inRow, size_t inColumn, const std::string & inImage);
+
+        /**
+         * Replaces all rows.
+         */
+        void setRows(const Rows & inRows);
+
+        void clear();
+
+        void addListener(Listener * inListener);
+
+        void removeListener(Listener * inListener);
+
+    private:
+        const Cell * getCell(size_t inRow, size_t inColumn) const;
+
+        Cell * getOrCreateCell(size_t inRow, size_t inColumn);
+
+        void notify(Change inChange, size_t inRow, size_t inCount);
+
+        Rows mRows;
+        std::vector<Listener *> mListeners;
+    };
+
+} // namespace XULWin
+
+
+#endif // LISTMODEL_H_INCLUDED
@@ -3,6 +3,7 @@
 
 
 #include "XULWin/ConcreteComponent.h"
+#include <map>
 #include <set>
 
 
@@ -11,6 +12,13 @@ namespace XULWin
 
     class EventListener;
 
+    /**
+     * Posted to a top-level window after its layout has been invalidated.
+     * The layout pass runs when the message is processed so that a series
+     * of changes only results in one layout pass.
+     */
+    const UINT WM_XULWIN_UPDATELAYOUT = WM_APP + 1;
+
     /**
      * NativeComponent
      *
@@ -106,6 +114,15 @@ namespace XULWin
         bool mOwnsHandle;
     };
 
+
+    /**
+     * Shows or hides the native windows of inComponent and its descendants
+     * without changing their hidden attribute. Used for children that are
+     * scrolled into or out of the visible area of a virtualized container.
+     * Components that are hidden stay hidden.
+     */
+    void SetRealized(Component * inComponent, bool inRealized);
+
 } // namespace XULWin
 
 
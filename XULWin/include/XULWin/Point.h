@@ -16,12 +16,12 @@ namespace XULWin
 
         GenericPoint(T x, T y) : mX(x), mY(y) {}
 
-        bool operator==(const GenericPoint & inOtherPoint)
+        bool operator==(const GenericPoint & inOtherPoint) const
         {
             return mX == inOtherPoint.mX && mY == inOtherPoint.mY;
         }
 
-        bool operator!=(const GenericPoint & inOtherPoint)
+        bool operator!=(const GenericPoint & inOtherPoint) const
         {
             return mX != inOtherPoint.mX || mY != inOtherPoint.mY;
         }
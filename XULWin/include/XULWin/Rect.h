@@ -29,12 +29,12 @@ namespace XULWin
         {
         }
 
-        bool operator==(const GenericRect<T> & inOtherRect)
+        bool operator==(const GenericRect<T> & inOtherRect) const
         {
             return mLocation == inOtherRect.mLocation && mSize == inOtherRect.mSize;
         }
 
-        bool operator!=(const GenericRect<T> & inOtherRect)
+        bool operator!=(const GenericRect<T> & inOtherRect) const
         {
             return !(inOtherRect == *this);
         }
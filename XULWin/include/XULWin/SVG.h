@@ -6,13 +6,19 @@
 #include "XULWin/Decorator.h"
 #include "XULWin/GdiplusLoader.h"
 #include "XULWin/NativeControl.h"
+#include "XULWin/SVGPathGeometry.h"
+#include "XULWin/SVGRenderer.h"
+#include "XULWin/SVGShape.h"
 #include "XULWin/VirtualComponent.h"
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
 
 
 namespace Gdiplus
 {
     class Graphics;
-    class PointF;
+    class GraphicsPath;
 }
 
 
@@ -22,32 +28,157 @@ namespace XULWin
     class SVGPainter
     {
     public:
-        virtual void paint(Gdiplus::Graphics & g) = 0;
+        virtual void paint(SVGRenderer & inRenderer) = 0;
+
+        /**
+         * The area that paint draws to, in canvas coordinates. Empty if
+         * nothing is drawn.
+         */
+        virtual RectF getPaintBounds() const = 0;
+    };
+
+
+    /**
+     * Keeps a GDI+ path per geometry, so that a geometry is only converted
+     * again after it has been rebuilt.
+     *
+     * Entries are keyed by the geometry's address and hold the geometry's
+     * version at the time of the conversion.
+     */
+    class GdiplusPathCache : boost::noncopyable
+    {
+    public:
+        GdiplusPathCache();
+
+        ~GdiplusPathCache();
+
+        /**
+         * Returns the path of a geometry that is not empty.
+         */
+        Gdiplus::GraphicsPath & getPath(const SVGPathGeometry & inGeometry);
+
+        /**
+         * Releases the paths that were not requested since the previous call.
+         * Should be called after everything has been rendered, so that the
+         * paths of removed shapes are released.
+         */
+        void releaseUnused();
+
+    private:
+        struct Entry
+        {
+            Entry();
+
+            boost::shared_ptr<Gdiplus::GraphicsPath> path;
+            unsigned int version;
+            bool used;
+        };
+
+        typedef std::map<const SVGPathGeometry *, Entry> Entries;
+        Entries mEntries;
+    };
+
+
+    /**
+     * SVGRenderer that draws with GDI+.
+     */
+    class GdiplusSVGRenderer : public SVGRenderer
+    {
+    public:
+        GdiplusSVGRenderer(Gdiplus::Graphics & inGraphics, GdiplusPathCache & inPathCache);
+
+        virtual void fillPath(const SVGPathGeometry & inGeometry, const RGBColor & inColor);
+
+        virtual void strokePath(const SVGPathGeometry & inGeometry, const RGBColor & inColor, float inWidth);
+
+        virtual bool isVisible(const RectF & inRect) const;
+
+    private:
+        Gdiplus::Graphics & mGraphics;
+        GdiplusPathCache & mPathCache;
     };
 
 
     class SVGCanvas : public NativeControl,
-                      public GdiplusLoader
+                      public GdiplusLoader,
+                      public SVGStyleNode
     {
     public:
         typedef NativeControl Super;
 
         SVGCanvas(Component * inParent, const AttributesMapping & inAttr);
 
+        virtual ~SVGCanvas();
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
         virtual LRESULT handleMessage(UINT inMessage, WPARAM wParam, LPARAM lParam);
 
+        /**
+         * Damages the paint bounds of the added child.
+         */
+        virtual void onChildAdded(Component * inChild);
+
+        /**
+         * Damages the paint bounds of the removed child.
+         */
+        virtual void onChildRemoved(Component * inChild);
+
+        /**
+         * Paints the SVG child components with the given renderer.
+         */
+        void render(SVGRenderer & inRenderer);
+
+        /**
+         * Marks an area, in canvas coordinates, for repainting. The canvas
+         * keeps the rendered image in a back buffer. On the next paint only
+         * the shapes that intersect a damaged area are rendered again.
+         */
+        void invalidateRect(const RectF & inRect);
+
+        // SVGStyleNode methods
+        virtual const SVGStyleNode * SVGStyleNode_parent() const;
+
+        virtual bool SVGStyleNode_getCSSFill(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getFill(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getStroke(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getStrokeWidth(int & outWidth) const;
+
     private:
-        void bufferedPaint(HDC inHDC);
+        void bufferedPaint(HDC inHDC, const RECT & inPaintRect);
 
         virtual void paint(HDC inHDC);
+
+        // Creates the back buffer, or recreates it if the size changed.
+        // A new buffer is damaged entirely.
+        void updateBuffer(HDC inHDC, int inWidth, int inHeight);
+
+        void releaseBuffer();
+
+        // Renders the damaged areas into the back buffer.
+        void repairBuffer();
+
+        HDC mBufferDC;
+        HBITMAP mBuffer;
+        HGDIOBJ mOriginalBitmap;
+        int mBufferWidth;
+        int mBufferHeight;
+
+        // Damaged areas of the back buffer. Overlapping areas are merged.
+        std::vector<RECT> mDamage;
+
+        // Declared last, so that the paths are deleted before GDI+ is shut down.
+        GdiplusPathCache mPathCache;
     };
 
 
     class SVG : public VirtualComponent,
+                public SVGStyleNode,
                 public virtual SVG_FillController,
                 public virtual SVG_StrokeController,
                 public virtual SVG_StrokeWidthController
@@ -77,6 +208,28 @@ namespace XULWin
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
+        // Children of groups are damaged in the canvas like children of the canvas.
+        virtual void onChildAdded(Component * inChild);
+
+        virtual void onChildRemoved(Component * inChild);
+
+        // SVGStyleNode methods
+        virtual const SVGStyleNode * SVGStyleNode_parent() const;
+
+        virtual bool SVGStyleNode_getCSSFill(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getFill(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getStroke(RGBColor & outColor) const;
+
+        virtual bool SVGStyleNode_getStrokeWidth(int & outWidth) const;
+
+    protected:
+        // Damages the paint bounds of this component in the canvas. Must be
+        // called before and after each change that moves or resizes the
+        // shape, and after each change of its appearance.
+        void invalidateCanvas();
+
     private:
         Fallible<RGBColor> mSVGFill;
         Fallible<RGBColor> mSVGStroke;
@@ -94,7 +247,9 @@ namespace XULWin
 
         virtual bool initStyleControllers();
 
-        virtual void paint(Gdiplus::Graphics & g);
+        virtual void paint(SVGRenderer & inRenderer);
+
+        virtual RectF getPaintBounds() const;
     };
 
 
@@ -113,11 +268,13 @@ namespace XULWin
 
         virtual void setPoints(const Points & inPoints);
 
-        virtual void paint(Gdiplus::Graphics & g);
+        virtual void paint(SVGRenderer & inRenderer);
+
+        virtual RectF getPaintBounds() const;
 
     private:
         Points mPoints;
-        std::vector<Gdiplus::PointF> mPointFs;
+        SVGShape mShape;
     };
 
 
@@ -129,12 +286,31 @@ namespace XULWin
 
         SVGRect(Component * inParent, const AttributesMapping & inAttr);
 
+        virtual bool init();
+
         virtual bool initStyleControllers();
 
-        virtual void paint(Gdiplus::Graphics & g);
+        virtual void setCSSX(int inX);
+
+        virtual void setCSSY(int inY);
+
+        virtual void setCSSWidth(int inWidth);
+
+        virtual void setCSSHeight(int inHeight);
+
+        virtual void setWidth(int inWidth);
+
+        virtual void setHeight(int inHeight);
+
+        virtual void paint(SVGRenderer & inRenderer);
+
+        virtual RectF getPaintBounds() const;
 
     private:
-        std::vector<Gdiplus::PointF> mPoints;
+        // Builds the geometry from the position and size.
+        void updateGeometry();
+
+        SVGShape mShape;
     };
 
 
@@ -151,35 +327,30 @@ namespace XULWin
 
         virtual bool initStyleControllers();
 
-        virtual void paint(Gdiplus::Graphics & g);
-
-        virtual const SVGPathInstructions & getPathInstructions() const;
-
-        virtual void setPathInstructions(const SVGPathInstructions & inPathInstructions);
-
-    private:
-        void getFloatPoints(const PathInstruction & instruction,
-                            const Gdiplus::PointF & inPrevPoint,
-                            std::vector<Gdiplus::PointF> & outPoints);
+        virtual void paint(SVGRenderer & inRenderer);
 
-        static void GetAbsolutePositions(const PathInstruction & instruction,
-                                         const PointF & inPrevPoint,
-                                         PointFs & outPoints);
+        /**
+         * Includes the stroke.
+         */
+        virtual RectF getPaintBounds() const;
 
-        static void GetAbsolutePositions(const PointFs & inRelativePoints,
-                                         const PointF & inPrevPoint,
-                                         PointFs & outPoints);
+        virtual const SVGPathData & getPathData() const;
 
-        //bool getFillColor(Gdiplus::Color & outColor);
+        virtual void setPathData(const SVGPathData & inPathData);
 
-        //bool getStrokeColor(Gdiplus::Color & outColor);
+        virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
-        static void GetPreparedInstructions(const SVGPathInstructions & inData, SVGPathInstructions & outPrepData);
+        virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
 
-        static void GetPointReflection(const PointF & inPoint, const PointF & inOrigin, PointF & outReflection);
+        /**
+         * The path in absolute coordinates. It is built once when the path
+         * data is set.
+         */
+        const SVGPathGeometry & geometry() const;
 
-        SVGPathInstructions mInstructions;
-        SVGPathInstructions mPreparedInstructions;
+    private:
+        SVGPathData mPathData;
+        SVGShape mShape;
     };
 
 } // namespace XULWin
@@ -0,0 +1,118 @@
+#ifndef SVGPATHGEOMETRY_H_INCLUDED
+#define SVGPATHGEOMETRY_H_INCLUDED
+
+
+#include "XULWin/Rect.h"
+#include "XULWin/SVGPathInstructions.h"
+#include <cstddef>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Path geometry in absolute coordinates, ready to be painted.
+     *
+     * All path commands are reduced to straight lines and cubic beziers:
+     * relative coordinates are resolved, the control points of smooth curves
+     * are reflected, quadratic curves are raised to cubic ones and elliptical
+     * arcs are approximated by cubic beziers.
+     *
+     * The geometry is stored as a list of points with a type per point. A
+     * figure starts with a Start point, followed by Line points and groups of
+     * three Bezier points (two control points and the end point).
+     */
+    class SVGPathGeometry
+    {
+    public:
+        enum PointType
+        {
+            PointType_Start,
+            PointType_Line,
+            PointType_Bezier
+        };
+
+        typedef std::vector<PointType> PointTypes;
+
+        struct Figure
+        {
+            // Range of the figure in points().
+            size_t begin;
+            size_t end;
+
+            // True if the figure ends with a ClosePath command.
+            bool closed;
+        };
+
+        typedef std::vector<Figure> Figures;
+
+        SVGPathGeometry();
+
+        /**
+         * Replaces the geometry with that of the given path data.
+         */
+        void build(const SVGPathData & inPathData);
+
+        /**
+         * Replaces the geometry with a closed polygon.
+         */
+        void buildPolygon(const Points & inPoints);
+
+        /**
+         * Replaces the geometry with a rectangle.
+         */
+        void buildRect(const RectF & inRect);
+
+        void clear();
+
+        bool empty() const;
+
+        const PointFs & points() const;
+
+        const PointTypes & pointTypes() const;
+
+        const Figures & figures() const;
+
+        /**
+         * The smallest rectangle that contains the path. This is exact for
+         * curves as well: it is not the bounding box of the control points.
+         */
+        const RectF & bounds() const;
+
+        /**
+         * Changes whenever the geometry is built or cleared. Versions are
+         * unique across all geometries, so renderers can use them to cache
+         * their own representation of the geometry.
+         */
+        unsigned int version() const;
+
+    private:
+        void moveTo(const PointF & inPoint);
+
+        void lineTo(const PointF & inPoint);
+
+        void bezierTo(const PointF & inControl1, const PointF & inControl2, const PointF & inEnd);
+
+        void arcTo(float inRadiusX, float inRadiusY, float inRotation,
+                   bool inLargeArc, bool inSweep, const PointF & inEnd);
+
+        void closeFigure();
+
+        void endFigure();
+
+        void calculateBounds();
+
+        PointFs mPoints;
+        PointTypes mPointTypes;
+        Figures mFigures;
+        bool mFigureOpen;
+        RectF mBounds;
+        unsigned int mVersion;
+        static unsigned int sLastVersion;
+    };
+
+} // namespace XULWin
+
+
+#endif // SVGPATHGEOMETRY_H_INCLUDED
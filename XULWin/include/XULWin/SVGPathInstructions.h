@@ -1,9 +1,11 @@
-#ifndef PATHINSTRUCTIONS_H_INCLUDED
-#define PATHINSTRUCTIONS_H_INCLUDED
+#ifndef SVGPATHINSTRUCTIONS_H_INCLUDED
+#define SVGPATHINSTRUCTIONS_H_INCLUDED
 
 
 #include "XULWin/Point.h"
+#include <cstddef>
 #include <utility>
+#include <vector>
 
 
 namespace XULWin
@@ -56,7 +58,85 @@ namespace XULWin
 
     typedef std::vector<PathInstruction> SVGPathInstructions;
 
+
+    /**
+     * Compact representation of SVG path data.
+     *
+     * Every segment of the path is a Command. The arguments of all commands
+     * are stored in one contiguous array of floats, in the order in which
+     * they appear in the path data. Implicitly repeated commands ("L 1 2 3 4")
+     * are stored as separate commands, and the implicit lineto after a moveto
+     * is stored as a LineTo command.
+     */
+    class SVGPathData
+    {
+    public:
+        struct Command
+        {
+            PathInstruction::Type type;
+            PathInstruction::Positioning positioning;
+
+            // Index of the first argument in values().
+            size_t offset;
+        };
+
+        typedef std::vector<Command> Commands;
+
+        typedef std::vector<float> Values;
+
+        /**
+         * Returns the number of arguments of a command of the given type.
+         * For example 2 for MoveTo, 6 for CurveTo and 0 for ClosePath.
+         */
+        static size_t GetNumArguments(PathInstruction::Type inType);
+
+        SVGPathData();
+
+        void clear();
+
+        void reserve(size_t inNumCommands, size_t inNumValues);
+
+        bool empty() const;
+
+        size_t numCommands() const;
+
+        const Command & getCommand(size_t inIdx) const;
+
+        // Returns the arguments of the command at the given index.
+        const float * getValues(size_t inIdx) const;
+
+        const Commands & commands() const;
+
+        const Values & values() const;
+
+        void addCommand(PathInstruction::Type inType, PathInstruction::Positioning inPositioning);
+
+        // Adds an argument to the last command.
+        void addValue(float inValue);
+
+        // Removes the last command and its arguments.
+        void removeLastCommand();
+
+    private:
+        Commands mCommands;
+        Values mValues;
+    };
+
+
+    /**
+     * Parses SVG path data in a single pass.
+     *
+     * Supports the full path grammar of SVG 1.1: all commands, numbers with
+     * exponents, implicitly repeated commands, and numbers that are not
+     * separated by whitespace ("1-2", "0.5.5", "a1 1 0 0010 10").
+     *
+     * Returns false if the path data contains an error. As required by the
+     * SVG specification, outData then contains the path up to the last
+     * complete segment before the error.
+     */
+    bool ParseSVGPathData(const char * inBegin, const char * inEnd, SVGPathData & outData);
+
 } // namespace XULWin
 
 
-#endif // PATHINSTRUCTIONS_H_INCLUDED
+#endif // SVGPATHINSTRUCTIONS_H_INCLUDED
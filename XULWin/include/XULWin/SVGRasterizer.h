@@ -0,0 +1,102 @@
+#ifndef SVGRASTERIZER_H_INCLUDED
+#define SVGRASTERIZER_H_INCLUDED
+
+
+#include "XULWin/SVGRenderer.h"
+#include "XULWin/Point.h"
+#include <cstddef>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Software implementation of SVGRenderer.
+     *
+     * Renders into a pixel buffer owned by the rasterizer. Edges are
+     * anti-aliased by computing the exact area that the shape covers in each
+     * pixel. Curves are flattened to line segments first.
+     *
+     * The pixels are 32-bit premultiplied ARGB values (0xAARRGGBB), stored
+     * row by row from the top. This is the layout of a 32-bit DIB section
+     * and of Gdiplus::PixelFormat32bppPARGB.
+     *
+     * Does not depend on any platform API.
+     */
+    class SVGRasterizer : public SVGRenderer
+    {
+    public:
+        SVGRasterizer(int inWidth, int inHeight);
+
+        int width() const;
+
+        int height() const;
+
+        const unsigned int * pixels() const;
+
+        unsigned int * pixels();
+
+        /**
+         * Sets all pixels to the given color.
+         */
+        void clear(const RGBColor & inColor);
+
+        virtual void fillPath(const SVGPathGeometry & inGeometry, const RGBColor & inColor);
+
+        /**
+         * Strokes are drawn with butt caps and round joins.
+         */
+        virtual void strokePath(const SVGPathGeometry & inGeometry, const RGBColor & inColor, float inWidth);
+
+        virtual bool isVisible(const RectF & inRect) const;
+
+        /**
+         * Maximum distance in pixels between a curve and its flattened
+         * approximation. The default is 0.25.
+         */
+        void setTolerance(float inTolerance);
+
+        /**
+         * Number of pixels that were blended since the construction of the
+         * rasterizer. Used to measure the fill rate.
+         */
+        size_t numPixelsFilled() const;
+
+        /**
+         * Converts a color to the pixel format of the rasterizer.
+         */
+        static unsigned int GetPremultipliedColor(const RGBColor & inColor);
+
+    private:
+        typedef std::vector<PointFs> Polygons;
+
+        void flatten(const SVGPathGeometry & inGeometry, Polygons & outPolygons, std::vector<bool> & outClosed) const;
+
+        void fillPolygons(const Polygons & inPolygons, const RGBColor & inColor);
+
+        void addLine(PointF inBegin, PointF inEnd);
+
+        void accumulateLine(const PointF & inBegin, const PointF & inEnd);
+
+        int mWidth;
+        int mHeight;
+        std::vector<unsigned int> mPixels;
+        float mTolerance;
+        size_t mNumPixelsFilled;
+
+        // Scratch buffers, kept to avoid allocations. The area accumulation
+        // buffer only covers the bounding box of the shape being filled.
+        Polygons mPolygons;
+        Polygons mStrokePolygons;
+        std::vector<bool> mClosed;
+        std::vector<float> mAccumulation;
+        std::vector<unsigned char> mCoverage;
+        int mBoxWidth;
+        int mBoxHeight;
+    };
+
+} // namespace XULWin
+
+
+#endif // SVGRASTERIZER_H_INCLUDED
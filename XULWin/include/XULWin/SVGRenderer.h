@@ -0,0 +1,50 @@
+#ifndef SVGRENDERER_H_INCLUDED
+#define SVGRENDERER_H_INCLUDED
+
+
+#include "XULWin/Rect.h"
+#include "XULWin/RGBColor.h"
+
+
+namespace XULWin
+{
+
+    class SVGPathGeometry;
+
+
+    /**
+     * Rendering backend for the SVG components.
+     *
+     * The SVG components reduce their shapes to SVGPathGeometry objects and
+     * pass them to the renderer. GdiplusSVGRenderer draws them in a window,
+     * SVGRasterizer draws them in a memory buffer without using any platform
+     * API.
+     */
+    class SVGRenderer
+    {
+    public:
+        virtual ~SVGRenderer() {}
+
+        /**
+         * Fills the geometry using the nonzero winding rule. Open figures are
+         * closed implicitly.
+         */
+        virtual void fillPath(const SVGPathGeometry & inGeometry, const RGBColor & inColor) = 0;
+
+        /**
+         * Draws the outline of the geometry with the given line width.
+         */
+        virtual void strokePath(const SVGPathGeometry & inGeometry, const RGBColor & inColor, float inWidth) = 0;
+
+        /**
+         * Returns false if nothing drawn inside the rectangle would show up,
+         * for example because it lies outside the clip region. Shapes that
+         * are not visible are skipped.
+         */
+        virtual bool isVisible(const RectF & inRect) const = 0;
+    };
+
+} // namespace XULWin
+
+
+#endif // SVGRENDERER_H_INCLUDED
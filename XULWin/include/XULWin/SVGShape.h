@@ -0,0 +1,110 @@
+#ifndef SVGSHAPE_H_INCLUDED
+#define SVGSHAPE_H_INCLUDED
+
+
+#include "XULWin/Point.h"
+#include "XULWin/Rect.h"
+#include "XULWin/RGBColor.h"
+#include "XULWin/SVGPathGeometry.h"
+
+
+namespace XULWin
+{
+
+    class SVGRenderer;
+
+
+    /**
+     * SVGStyleNode gives access to the paint attributes of an element of
+     * an SVG drawing.
+     *
+     * The SVG components implement it with their attribute and style
+     * controllers. The headless renderer of the tests implements it with
+     * the attributes of a HeadlessNode. The inheritance of the attributes
+     * and their defaults are resolved by SVGShape, so that both paint the
+     * same.
+     *
+     * The getters return false if the element doesn't set the value
+     * itself.
+     */
+    class SVGStyleNode
+    {
+    public:
+        virtual ~SVGStyleNode() {}
+
+        // The parent element, or null for the svg element.
+        virtual const SVGStyleNode * SVGStyleNode_parent() const = 0;
+
+        // The fill property of the style attribute, for example
+        // style="fill: #f2cc99".
+        virtual bool SVGStyleNode_getCSSFill(RGBColor & outColor) const = 0;
+
+        virtual bool SVGStyleNode_getFill(RGBColor & outColor) const = 0;
+
+        virtual bool SVGStyleNode_getStroke(RGBColor & outColor) const = 0;
+
+        virtual bool SVGStyleNode_getStrokeWidth(int & outWidth) const = 0;
+    };
+
+
+    /**
+     * SVGShape
+     *
+     * The geometry of a polygon, rect or path element and the way it is
+     * painted:
+     * - polygons are filled with the CSS fill
+     * - rects are filled with the fill attribute
+     * - paths are filled with the fill attribute and stroked with the
+     *   stroke and stroke-width attributes
+     *
+     * Elements that don't set an attribute inherit it from their nearest
+     * ancestor that does. The defaults are a black fill and no stroke.
+     *
+     * This class does not depend on the Windows API.
+     */
+    class SVGShape
+    {
+    public:
+        enum Type
+        {
+            Type_Polygon,
+            Type_Rect,
+            Type_Path
+        };
+
+        SVGShape(Type inType);
+
+        Type type() const;
+
+        void setPoints(const Points & inPoints);
+
+        void setRect(const RectF & inRect);
+
+        void setPathData(const SVGPathData & inPathData);
+
+        const SVGPathGeometry & geometry() const;
+
+        void paint(const SVGStyleNode & inStyle, SVGRenderer & inRenderer) const;
+
+        /**
+         * The area that paint draws to. Includes the stroke of a path.
+         */
+        RectF getPaintBounds(const SVGStyleNode & inStyle) const;
+
+        static RGBColor GetCSSFill(const SVGStyleNode & inStyle);
+
+        static RGBColor GetFill(const SVGStyleNode & inStyle);
+
+        static RGBColor GetStroke(const SVGStyleNode & inStyle);
+
+        static int GetStrokeWidth(const SVGStyleNode & inStyle);
+
+    private:
+        Type mType;
+        SVGPathGeometry mGeometry;
+    };
+
+} // namespace XULWin
+
+
+#endif // SVGSHAPE_H_INCLUDED
@@ -21,6 +21,16 @@ namespace XULWin
         {
         }
 
+        bool operator==(const GenericSize & inOtherSize) const
+        {
+            return mWidth == inOtherSize.mWidth && mHeight == inOtherSize.mHeight;
+        }
+
+        bool operator!=(const GenericSize & inOtherSize) const
+        {
+            return !(*this == inOtherSize);
+        }
+
 
         const T & width() const
         {
@@ -3,6 +3,7 @@
 
 
 #include "XULWin/Enums.h"
+#include "XULWin/ForwardDeclarations.h"
 #include "XULWin/RGBColor.h"
 #include <string>
 
@@ -15,6 +16,10 @@ namespace XULWin
     public:
         virtual void get(std::string & outValue) = 0;
         virtual void set(const std::string & inValue) = 0;
+
+        // Sets a value that was parsed in advance, see StyleDeclarations.
+        // The default implementation passes the text of the value.
+        virtual void set(const StyleDeclaration & inDeclaration);
     };
 
 
@@ -30,6 +35,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual int getCSSX() const = 0;
 
         virtual void setCSSX(int inX) = 0;
@@ -48,6 +55,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual int getCSSY() const = 0;
 
         virtual void setCSSY(int inY) = 0;
@@ -66,6 +75,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual int getCSSWidth() const = 0;
 
         virtual void setCSSWidth(int inWidth) = 0;
@@ -84,6 +95,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual int getCSSHeight() const = 0;
 
         virtual void setCSSHeight(int inHeight) = 0;
@@ -102,6 +115,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual CSSTextAlign getCSSTextAlign() const = 0;
 
         virtual void setCSSTextAlign(CSSTextAlign inValue) = 0;
@@ -120,6 +135,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual void getCSSMargin(int & outTop, int & outLeft, int & outRight, int & outBottom) const = 0;
 
         virtual void setCSSMargin(int inTop, int inLeft, int inRight, int inBottom) = 0;
@@ -138,6 +155,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual void setCSSFill(const RGBColor & inColor) = 0;
 
         virtual const RGBColor & getCSSFill() const = 0;
@@ -156,6 +175,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual void setCSSStroke(const RGBColor & inColor) = 0;
 
         virtual const RGBColor & getCSSStroke() const = 0;
@@ -190,6 +211,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual void setCSSColor(const RGBColor & inColor) = 0;
 
         virtual RGBColor getCSSColor() const = 0;
@@ -207,6 +230,8 @@ namespace XULWin
 
         virtual void set(const std::string & inValue);
 
+        virtual void set(const StyleDeclaration & inDeclaration);
+
         virtual void setCSSBackgroundColor(const RGBColor & inColor) = 0;
 
         virtual RGBColor getCSSBackgroundColor() const = 0;
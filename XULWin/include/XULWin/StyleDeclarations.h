@@ -0,0 +1,126 @@
+#ifndef STYLEDECLARATIONS_H_INCLUDED
+#define STYLEDECLARATIONS_H_INCLUDED
+
+
+#include "XULWin/AttributesMapping.h"
+#include "XULWin/Enums.h"
+#include "XULWin/RGBColor.h"
+#include <string>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * A single CSS declaration, for example "width: 10px".
+     *
+     * The value is parsed once, according to the type of the property. The
+     * typed value that matches the property is valid, the others keep
+     * their defaults. The text of the value is always available.
+     */
+    class StyleDeclaration
+    {
+    public:
+        StyleDeclaration(const std::string & inName, const std::string & inValue);
+
+        const std::string & name() const;
+
+        const std::string & value() const;
+
+        CSSProperty property() const;
+
+        /**
+         * x, y, width and height. Invalid sizes are 0.
+         */
+        int size() const;
+
+        /**
+         * margin: one to four sizes, expanded to all four sides.
+         */
+        void getMargin(int & outTop, int & outLeft, int & outRight, int & outBottom) const;
+
+        /**
+         * color, background-color, fill and stroke. Invalid colors are
+         * black and hasColor returns false.
+         */
+        const RGBColor & color() const;
+
+        bool hasColor() const;
+
+        /**
+         * text-align. Unknown values are left aligned.
+         */
+        CSSTextAlign textAlign() const;
+
+        /**
+         * overflow, overflow-x and overflow-y. Unknown values are visible.
+         */
+        CSSOverflow overflow() const;
+
+        /**
+         * Returns CSSProperty_Unknown for properties that have no typed
+         * value.
+         */
+        static CSSProperty GetProperty(const std::string & inName);
+
+    private:
+        void parseMargin();
+
+        std::string mName;
+        std::string mValue;
+        CSSProperty mProperty;
+        int mSize;
+        int mMargin[4];
+        RGBColor mColor;
+        bool mHasColor;
+        CSSTextAlign mTextAlign;
+        CSSOverflow mOverflow;
+    };
+
+
+    /**
+     * The declarations of a style attribute, for example
+     * "width: 10px; color: red", in the order in which they appear.
+     *
+     * Documents repeat the same style attribute on many elements. Get
+     * returns a shared, immutable instance for each distinct string, so that
+     * each one is parsed only once per process.
+     */
+    class StyleDeclarations
+    {
+    public:
+        explicit StyleDeclarations(const std::string & inStyle);
+
+        /**
+         * Returns the interned declarations for the style string. The
+         * result remains valid until the program ends.
+         */
+        static const StyleDeclarations & Get(const std::string & inStyle);
+
+        /**
+         * Returns the declarations of the "style" attribute. Empty if there
+         * is no style attribute.
+         */
+        static const StyleDeclarations & Get(const AttributesMapping & inAttributes);
+
+        size_t size() const;
+
+        bool empty() const;
+
+        const StyleDeclaration & get(size_t inIndex) const;
+
+        /**
+         * Returns the last declaration of the property, or null if there is
+         * none.
+         */
+        const StyleDeclaration * find(CSSProperty inProperty) const;
+
+    private:
+        std::vector<StyleDeclaration> mDeclarations;
+    };
+
+} // namespace XULWin
+
+
+#endif // STYLEDECLARATIONS_H_INCLUDED
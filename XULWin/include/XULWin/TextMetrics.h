@@ -0,0 +1,55 @@
+#ifndef TEXTMETRICS_H_INCLUDED
+#define TEXTMETRICS_H_INCLUDED
+
+
+#include "XULWin/Size.h"
+#include <string>
+
+
+namespace XULWin
+{
+
+    /**
+     * TextMetrics
+     *
+     * Measures text for a layout that has no windows and therefore no
+     * device context, see HeadlessLayout.
+     */
+    class TextMetrics
+    {
+    public:
+        virtual ~TextMetrics() {}
+
+        /**
+         * Returns the size of the UTF-8 encoded text. Lines are separated
+         * by '\n'. The width is that of the longest line. Empty text still
+         * has the height of one line, like GetTextExtentPoint32 reports.
+         */
+        virtual Size getTextSize(const std::string & inText) const = 0;
+    };
+
+
+    /**
+     * FixedTextMetrics
+     *
+     * Gives every character the same width. The sizes only depend on the
+     * text, so layouts come out the same on every machine, which makes it
+     * the provider of choice for regression tests. The defaults are close
+     * to the average character of the 8pt dialog font.
+     */
+    class FixedTextMetrics : public TextMetrics
+    {
+    public:
+        FixedTextMetrics(int inCharWidth = 6, int inLineHeight = 13);
+
+        virtual Size getTextSize(const std::string & inText) const;
+
+    private:
+        int mCharWidth;
+        int mLineHeight;
+    };
+
+} // namespace XULWin
+
+
+#endif // TEXTMETRICS_H_INCLUDED
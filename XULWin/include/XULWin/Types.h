@@ -2,6 +2,9 @@
 #define XULWIN_TYPES_H_INCLUDED
 
 
+#include <boost/cstdint.hpp>
+
+
 namespace XULWin
 {
 
@@ -16,8 +19,8 @@ namespace XULWin
     typedef unsigned short         UInt16;
     typedef signed int             Int32;
     typedef unsigned int           UInt32;
-    typedef signed __int64         Int64;
-    typedef unsigned __int64       UInt64;
+    typedef boost::int64_t         Int64;
+    typedef boost::uint64_t        UInt64;
 
 } // namespace XULWin
 
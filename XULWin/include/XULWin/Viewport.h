@@ -0,0 +1,128 @@
+#ifndef VIEWPORT_H_INCLUDED
+#define VIEWPORT_H_INCLUDED
+
+
+#include "XULWin/Enums.h"
+#include "XULWin/Point.h"
+#include "XULWin/Rect.h"
+#include <cstddef>
+#include <vector>
+
+
+namespace XULWin
+{
+
+    /**
+     * Viewport
+     *
+     * Implemented by containers that support the "virtualize" attribute.
+     * A virtualized container only positions the children that intersect
+     * its visible area. The ScrollDecorator passes the scroll offset to a
+     * virtualized container instead of scrolling its child windows.
+     */
+    class Viewport
+    {
+    public:
+        virtual bool isVirtualized() const = 0;
+
+        /**
+         * Sets the offset of the visible area relative to the unscrolled
+         * content. Takes effect on the next layout pass.
+         */
+        virtual void setScrollOffset(const Point & inScrollOffset) = 0;
+    };
+
+
+    /**
+     * VirtualItems
+     *
+     * Keeps track of the items of a virtualized container that were
+     * measured. The items are placed one after another along the scroll
+     * direction. An item that was never measured is assumed to have the
+     * average size of the measured items, so the size of the container and
+     * the positions of the items can be estimated without measuring all
+     * items.
+     *
+     * The sizes themselves are not stored. They are asked from the Measurer
+     * each time, which is cheap for the components because they cache their
+     * sizes.
+     */
+    class VirtualItems
+    {
+    public:
+        class Measurer
+        {
+        public:
+            /**
+             * Returns the size of the item along the scroll direction.
+             */
+            virtual int VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const = 0;
+        };
+
+        VirtualItems();
+
+        /**
+         * Forgets which items were measured and sets the number of items.
+         */
+        void reset(size_t inItemCount);
+
+        size_t size() const;
+
+        bool isMeasured(size_t idx) const;
+
+        /**
+         * Returns false if the item was measured already.
+         */
+        bool setMeasured(size_t idx);
+
+        size_t numMeasured() const;
+
+        /**
+         * Measures the first items if none were measured yet, so that there
+         * is an estimate for the others. Returns true if any item was
+         * measured.
+         */
+        bool measureSample();
+
+        /**
+         * Measures the items that are less than inLength away from the
+         * visible range [inStart, inStart + inLength). The positions follow
+         * the preferred sizes. Returns true if any item was measured, which
+         * changes the estimate.
+         */
+        bool measureRange(const Measurer & inMeasurer, int inStart, int inLength);
+
+        /**
+         * Returns the size of each item. Items that were not measured get the
+         * average size of the measured items.
+         */
+        void getSizes(const Measurer & inMeasurer,
+                      SizeConstraint inSizeConstraint,
+                      std::vector<int> & outSizes) const;
+
+        /**
+         * Returns the sum of getSizes.
+         */
+        int getTotalSize(const Measurer & inMeasurer, SizeConstraint inSizeConstraint) const;
+
+    private:
+        std::vector<bool> mMeasured;
+        size_t mNumMeasured;
+    };
+
+
+    /**
+     * Returns inRect moved by -inScrollOffset.
+     */
+    Rect ScrollRect(const Rect & inRect, const Point & inScrollOffset);
+
+
+    /**
+     * Returns true if the rects overlap.
+     */
+    bool Intersects(const Rect & inRect, const Rect & inOtherRect);
+
+} // namespace XULWin
+
+
+#endif // VIEWPORT_H_INCLUDED
@@ -54,8 +54,12 @@ namespace XULWin
 
         virtual void move(int x, int y, int w, int h);
 
+        virtual void invalidateLayout();
+
         virtual void rebuildLayout();
 
+        virtual void onChildRemoved(Component * inChild);
+
         virtual int calculateWidth(SizeConstraint inSizeConstraint) const;
 
         virtual int calculateHeight(SizeConstraint inSizeConstraint) const;
@@ -23,6 +23,15 @@ namespace XULWin
 
         virtual bool init();
 
+        /**
+         * Returns the script body.
+         *
+         * The buffer is shared with the parser output, so it can be passed
+         * on to a script engine without copying. Returns a null pointer if
+         * the script is empty.
+         */
+        boost::shared_ptr<const std::string> script() const;
+
     private:
         friend class Element;
         XMLScript(Element * inParent, const AttributesMapping & inAttr);
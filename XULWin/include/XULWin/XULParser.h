@@ -10,11 +10,15 @@
 #include "Poco/Exception.h"
 #include <stack>
 #include <string>
+#include <vector>
 
 
 namespace XULWin
 {
 
+    class CompiledXUL;
+
+
     class AbstractXULParser : public Poco::XML::SAXParser,
         public Poco::XML::ContentHandler,
         public Poco::XML::EntityResolver
@@ -28,6 +32,21 @@ namespace XULWin
          */
         ElementPtr rootElement() const;
 
+        /**
+         * Inner text of at least this many bytes is handed to the element
+         * as a shared buffer instead of being copied. Smaller texts are
+         * copied so that the parser can reuse its buffer.
+         *
+         * The default is 4096 bytes.
+         */
+        void setSharedTextThreshold(size_t inNumBytes);
+
+        /**
+         * Records the created elements into a compiled document.
+         * Pass a null pointer to stop recording.
+         */
+        void setCompiledXUL(CompiledXUL * inCompiledXUL);
+
     protected:
         virtual Element * getCurrentParentElement() = 0;
 
@@ -91,8 +110,24 @@ namespace XULWin
         void getAttributes(const Poco::XML::Attributes & inXMLAttributes,
                            AttributesMapping & outXULAttributes);
 
+        // Starts collecting the inner text of a new element.
+        void pushTextBuffer();
+
+        // Passes the collected inner text to the current element.
+        void popTextBuffer();
+
         const Poco::XML::Locator * mLocator;
         std::string mLanguage;
+
+        // Reused for each element to avoid reallocating the attribute buffer.
+        AttributesMapping mAttributes;
+
+        // One text buffer for each open element. Only the first
+        // mTextDepth entries are in use, the others are kept for reuse.
+        std::vector<std::string> mTextBuffers;
+        size_t mTextDepth;
+        size_t mSharedTextThreshold;
+        CompiledXUL * mCompiledXUL;
     };
 
 
@@ -28,6 +28,23 @@ namespace XULWin
 
         static void SetModuleHandle(HMODULE inModuleHandle);
 
+        /**
+         * Enables or disables the compiled XUL cache. Disabled by default.
+         *
+         * When enabled, a XUL file that is loaded from disk is saved in a
+         * compiled form next to the original (see CompiledXUL.h). Later loads
+         * use the compiled file as long as the XUL file and the DTDs it uses
+         * have not changed.
+         *
+         * Only enable it if the application directory is writable and the
+         * .xulc files may be written into it, for example for an
+         * application that is installed per user. Call it before the first
+         * XUL file is loaded.
+         */
+        static void SetCompiledXULEnabled(bool inEnabled);
+
+        static bool IsCompiledXULEnabled();
+
         /**
          * Searches for an image file with the name <inWindowId>.<inExtension>
          * in the directory <mozilla-directory>/chrome/icons/default/.
@@ -121,7 +138,9 @@ namespace XULWin
     private:
         static Fallible<std::string> sLocale;
         static HMODULE sModuleHandle;
+        static bool sCompiledXULEnabled;
 
+        static ElementPtr LoadFile(const std::string & inXULFile);
         static ElementPtr ParseFile(AbstractXULParser & inParser, const std::string & inXULURL);
         static ElementPtr ParseString(AbstractXULParser & inParser, const std::string & inXULURL);
         std::string getOverlayElementId(const std::string & inXULURL);
@@ -6,6 +6,20 @@
 namespace XULWin
 {
 
+    void AttributeController::get(AttributeValue & outValue)
+    {
+        std::string value;
+        get(value);
+        outValue = AttributeValue(value);
+    }
+
+
+    void AttributeController::set(const AttributeValue & inValue)
+    {
+        set(inValue.toString());
+    }
+
+
     void TitleController::get(std::string & outValue)
     {
         outValue = getTitle();
@@ -30,6 +44,25 @@ namespace XULWin
     }
 
 
+    void WidthController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getWidth());
+    }
+
+
+    void WidthController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setWidth(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void HeightController::get(std::string & outValue)
     {
         outValue = Int2String(getHeight());
@@ -42,6 +75,25 @@ namespace XULWin
     }
 
 
+    void HeightController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getHeight());
+    }
+
+
+    void HeightController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setHeight(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScreenXController::get(std::string & outValue)
     {
         outValue = Int2String(getScreenX());
@@ -54,6 +106,25 @@ namespace XULWin
     }
 
 
+    void ScreenXController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getScreenX());
+    }
+
+
+    void ScreenXController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setScreenX(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScreenYController::get(std::string & outValue)
     {
         outValue = Int2String(getScreenY());
@@ -66,6 +137,25 @@ namespace XULWin
     }
 
 
+    void ScreenYController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getScreenY());
+    }
+
+
+    void ScreenYController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setScreenY(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void FlexController::get(std::string & outValue)
     {
         outValue = Int2String(getFlex());
@@ -78,6 +168,25 @@ namespace XULWin
     }
 
 
+    void FlexController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getFlex());
+    }
+
+
+    void FlexController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setFlex(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void DisabledController::get(std::string & outValue)
     {
         outValue = Bool2String(isDisabled());
@@ -90,6 +199,25 @@ namespace XULWin
     }
 
 
+    void DisabledController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isDisabled());
+    }
+
+
+    void DisabledController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setDisabled(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void SelectedController::get(std::string & outValue)
     {
         outValue = Bool2String(isSelected());
@@ -102,6 +230,25 @@ namespace XULWin
     }
 
 
+    void SelectedController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isSelected());
+    }
+
+
+    void SelectedController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setSelected(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void SelectedIndexController::get(std::string & outValue)
     {
         outValue = Int2String(getSelectedIndex());
@@ -114,6 +261,25 @@ namespace XULWin
     }
 
 
+    void SelectedIndexController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getSelectedIndex());
+    }
+
+
+    void SelectedIndexController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setSelectedIndex(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void HiddenController::get(std::string & outValue)
     {
         outValue = Bool2String(isHidden());
@@ -126,6 +292,25 @@ namespace XULWin
     }
 
 
+    void HiddenController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isHidden());
+    }
+
+
+    void HiddenController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setHidden(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void LabelController::get(std::string & outValue)
     {
         outValue = getLabel();
@@ -162,6 +347,25 @@ namespace XULWin
     }
 
 
+    void ReadOnlyController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isReadOnly());
+    }
+
+
+    void ReadOnlyController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setReadOnly(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void RowsController::get(std::string & outValue)
     {
         outValue = Int2String(getRows());
@@ -174,6 +378,25 @@ namespace XULWin
     }
 
 
+    void RowsController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getRows());
+    }
+
+
+    void RowsController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setRows(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void CheckedController::get(std::string & outValue)
     {
         outValue = Bool2String(isChecked());
@@ -186,6 +409,25 @@ namespace XULWin
     }
 
 
+    void CheckedController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isChecked());
+    }
+
+
+    void CheckedController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setChecked(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void OrientController::get(std::string & outValue)
     {
         outValue = Orient2String(getOrient());
@@ -198,6 +440,25 @@ namespace XULWin
     }
 
 
+    void OrientController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(static_cast<int>(getOrient()));
+    }
+
+
+    void OrientController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setOrient(static_cast<Orient>(inValue.toInt(0)));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void AlignController::get(std::string & outValue)
     {
         outValue = Align2String(getAlign());
@@ -210,6 +471,25 @@ namespace XULWin
     }
 
 
+    void AlignController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(static_cast<int>(getAlign()));
+    }
+
+
+    void AlignController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setAlign(static_cast<Align>(inValue.toInt(0)));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void IntValueController::get(std::string & outValue)
     {
         outValue = Int2String(getValue());
@@ -222,6 +502,25 @@ namespace XULWin
     }
 
 
+    void IntValueController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getValue());
+    }
+
+
+    void IntValueController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setValue(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScrollbarCurrentPositionController::get(std::string & outCurrentPosition)
     {
         outCurrentPosition = Int2String(getCurrentPosition());
@@ -234,6 +533,25 @@ namespace XULWin
     }
 
 
+    void ScrollbarCurrentPositionController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getCurrentPosition());
+    }
+
+
+    void ScrollbarCurrentPositionController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setCurrentPosition(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScrollbarMaxPositionController::get(std::string & outMaxPosition)
     {
         outMaxPosition = Int2String(getMaxPosition());
@@ -246,6 +564,25 @@ namespace XULWin
     }
 
 
+    void ScrollbarMaxPositionController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getMaxPosition());
+    }
+
+
+    void ScrollbarMaxPositionController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setMaxPosition(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScrollbarIncrementController::get(std::string & outIncrement)
     {
         outIncrement = Int2String(getIncrement());
@@ -258,6 +595,25 @@ namespace XULWin
     }
 
 
+    void ScrollbarIncrementController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getIncrement());
+    }
+
+
+    void ScrollbarIncrementController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setIncrement(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ScrollbarPageIncrementController::get(std::string & outPageIncrement)
     {
         outPageIncrement = Int2String(getPageIncrement());
@@ -270,6 +626,25 @@ namespace XULWin
     }
 
 
+    void ScrollbarPageIncrementController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getPageIncrement());
+    }
+
+
+    void ScrollbarPageIncrementController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setPageIncrement(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void HrefController::get(std::string & outHref)
     {
         outHref = getHref();
@@ -306,6 +681,56 @@ namespace XULWin
     }
 
 
+    void KeepAspectRatioController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getKeepAspectRatio());
+    }
+
+
+    void KeepAspectRatioController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setKeepAspectRatio(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
+    void VirtualizeController::get(std::string & outVirtualize)
+    {
+        outVirtualize = Bool2String(isVirtualized());
+    }
+
+
+    void VirtualizeController::set(const std::string & inVirtualize)
+    {
+        setVirtualized(String2Bool(inVirtualize, false));
+    }
+
+
+    void VirtualizeController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(isVirtualized());
+    }
+
+
+    void VirtualizeController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Bool)
+        {
+            setVirtualized(inValue.toBool(false));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void ListCell_ImageController::get(std::string & outImage)
     {
         outImage = getImage();
@@ -331,13 +756,15 @@ namespace XULWin
 
     void SVG_Path_InstructionsController::get(std::string & outValue)
     {
-        outValue = SVGPathInstructions2String(getPathInstructions());
+        outValue = SVGPathData2String(getPathData());
     }
 
 
     void SVG_Path_InstructionsController::set(const std::string & inPathInstructions)
     {
-        setPathInstructions(String2SVGPathInstructions(inPathInstructions));
+        SVGPathData data;
+        String2SVGPathData(inPathInstructions, data);
+        setPathData(data);
     }
 
 
@@ -357,6 +784,25 @@ namespace XULWin
     }
 
 
+    void SVG_FillController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getSVGFill());
+    }
+
+
+    void SVG_FillController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Color)
+        {
+            setSVGFill(inValue.toColor(RGBColor()));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void SVG_StrokeController::get(std::string & outValue)
     {
         outValue = RGBColor2String(getSVGStroke());
@@ -373,6 +819,25 @@ namespace XULWin
     }
 
 
+    void SVG_StrokeController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getSVGStroke());
+    }
+
+
+    void SVG_StrokeController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Color)
+        {
+            setSVGStroke(inValue.toColor(RGBColor()));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
+
     void SVG_StrokeWidthController::get(std::string & outValue)
     {
         outValue = Int2String(getSVGStrokeWidth());
@@ -384,4 +849,23 @@ namespace XULWin
         setSVGStrokeWidth(String2Int(inValue));
     }
 
+
+    void SVG_StrokeWidthController::get(AttributeValue & outValue)
+    {
+        outValue = AttributeValue(getSVGStrokeWidth());
+    }
+
+
+    void SVG_StrokeWidthController::set(const AttributeValue & inValue)
+    {
+        if (inValue.type() == AttributeValue::Type_Int)
+        {
+            setSVGStrokeWidth(inValue.toInt(0));
+        }
+        else
+        {
+            AttributeController::set(inValue);
+        }
+    }
+
 } // namespace XULWin
@@ -0,0 +1,142 @@
+#include "XULWin/AttributeValue.h"
+#include "XULWin/Conversions.h"
+
+
+namespace XULWin
+{
+
+    AttributeValue::AttributeValue() :
+        mType(Type_Null),
+        mInt(0)
+    {
+    }
+
+
+    AttributeValue::AttributeValue(int inValue) :
+        mType(Type_Int),
+        mInt(inValue)
+    {
+    }
+
+
+    AttributeValue::AttributeValue(bool inValue) :
+        mType(Type_Bool),
+        mInt(inValue ? 1 : 0)
+    {
+    }
+
+
+    AttributeValue::AttributeValue(const RGBColor & inValue) :
+        mType(Type_Color),
+        mInt(0),
+        mColor(inValue)
+    {
+    }
+
+
+    AttributeValue::AttributeValue(const std::string & inValue) :
+        mType(Type_String),
+        mInt(0),
+        mString(inValue)
+    {
+    }
+
+
+    AttributeValue::Type AttributeValue::type() const
+    {
+        return mType;
+    }
+
+
+    bool AttributeValue::isNull() const
+    {
+        return mType == Type_Null;
+    }
+
+
+    int AttributeValue::toInt(int inDefault) const
+    {
+        switch (mType)
+        {
+            case Type_Int:
+            case Type_Bool:
+            {
+                return mInt;
+            }
+            case Type_String:
+            {
+                return String2Int(mString, inDefault);
+            }
+            default:
+            {
+                return inDefault;
+            }
+        }
+    }
+
+
+    bool AttributeValue::toBool(bool inDefault) const
+    {
+        switch (mType)
+        {
+            case Type_Int:
+            case Type_Bool:
+            {
+                return mInt != 0;
+            }
+            case Type_String:
+            {
+                return String2Bool(mString, inDefault);
+            }
+            default:
+            {
+                return inDefault;
+            }
+        }
+    }
+
+
+    RGBColor AttributeValue::toColor(const RGBColor & inDefault) const
+    {
+        if (mType == Type_Color)
+        {
+            return mColor;
+        }
+
+        RGBColor result(inDefault);
+        if (mType == Type_String && !String2RGBColor(mString, result))
+        {
+            result = inDefault;
+        }
+        return result;
+    }
+
+
+    std::string AttributeValue::toString() const
+    {
+        switch (mType)
+        {
+            case Type_Int:
+            {
+                return Int2String(mInt);
+            }
+            case Type_Bool:
+            {
+                return Bool2String(mInt != 0);
+            }
+            case Type_Color:
+            {
+                return RGBColor2String(mColor);
+            }
+            case Type_String:
+            {
+                return mString;
+            }
+            default:
+            {
+                return std::string();
+            }
+        }
+    }
+
+} // namespace XULWin
@@ -1,10 +1,13 @@
 #include "XULWin/BoxLayouter.h"
 #include "XULWin/Component.h"
-#include "XULWin/Conversions.h"
 #include "XULWin/Decorator.h"
 #include "XULWin/Element.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/Layout.h"
+#include "XULWin/LayoutTransaction.h"
+#include "XULWin/NativeComponent.h"
+#include "XULWin/Viewport.h"
+#include <algorithm>
 
 
 namespace XULWin
@@ -12,13 +15,110 @@ namespace XULWin
 
 
     BoxLayouter::BoxLayouter(ContentProvider * inContentProvider) :
-        mContentProvider(inContentProvider)
+        mContentProvider(inContentProvider),
+        mVirtualized(false)
     {
     }
 
 
+    bool BoxLayouter::isVirtualized() const
+    {
+        return mVirtualized;
+    }
+
+
+    void BoxLayouter::setVirtualized(bool inVirtualized)
+    {
+        mVirtualized = inVirtualized;
+        mItems.reset(0);
+        if (!mVirtualized)
+        {
+            mScrollOffset = Point();
+        }
+    }
+
+
+    void BoxLayouter::setScrollOffset(const Point & inScrollOffset)
+    {
+        mScrollOffset = inScrollOffset;
+    }
+
+
+    bool BoxLayouter::isRealized(size_t idx) const
+    {
+        return idx >= mPrevRealized.size() || mPrevRealized[idx];
+    }
+
+
+    size_t BoxLayouter::numMeasured() const
+    {
+        return mItems.numMeasured();
+    }
+
+
+    void BoxLayouter::onChildRemoved()
+    {
+        mPrevChildren.clear();
+        mPrevRects.clear();
+        mPrevRealized.clear();
+        mItems.reset(0);
+    }
+
+
+    int BoxLayouter::VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const
+    {
+        const Component * child = mContentProvider->BoxLayouter_getChild(idx);
+        if (mContentProvider->BoxLayouter_getOrient() == Horizontal)
+        {
+            return child->getWidth(inSizeConstraint);
+        }
+        return child->getHeight(inSizeConstraint);
+    }
+
+
+    void BoxLayouter::syncItems() const
+    {
+        size_t childCount = mContentProvider->BoxLayouter_getChildCount();
+        if (mItems.size() != childCount)
+        {
+            mItems.reset(childCount);
+        }
+    }
+
+
+    int BoxLayouter::calculateVirtualizedSize(bool inWidth, SizeConstraint inSizeConstraint) const
+    {
+        syncItems();
+        mItems.measureSample();
+
+        bool horizontal = mContentProvider->BoxLayouter_getOrient() == Horizontal;
+        if (inWidth == horizontal)
+        {
+            return mItems.getTotalSize(*this, inSizeConstraint);
+        }
+
+        // Only the measured children are asked for their size.
+        int result = 0;
+        for (size_t idx = 0; idx != mItems.size(); ++idx)
+        {
+            if (mItems.isMeasured(idx))
+            {
+                const Component * child = mContentProvider->BoxLayouter_getChild(idx);
+                int size = inWidth ? child->getWidth(inSizeConstraint) : child->getHeight(inSizeConstraint);
+                result = std::max<int>(result, size);
+            }
+        }
+        return result;
+    }
+
+
     int BoxLayouter::calculateWidth(SizeConstraint inSizeConstraint) const
     {
+        if (mVirtualized)
+        {
+            return calculateVirtualizedSize(true, inSizeConstraint);
+        }
+
         if (mContentProvider->BoxLayouter_getOrient() == Horizontal)
         {
             int result = 0;
@@ -51,6 +151,11 @@ namespace XULWin
 
     int BoxLayouter::calculateHeight(SizeConstraint inSizeConstraint) const
     {
+        if (mVirtualized)
+        {
+            return calculateVirtualizedSize(false, inSizeConstraint);
+        }
+
         if (mContentProvider->BoxLayouter_getOrient() == Horizontal)
         {
             int result = 0;
@@ -81,43 +186,153 @@ namespace XULWin
     }
 
 
-    void BoxLayouter::rebuildLayout()
+    void BoxLayouter::getSizeInfos(std::vector<ExtendedSizeInfo> & outSizeInfos) const
     {
-        Rect clientR(mContentProvider->BoxLayouter_clientRect());
-        LinearLayoutManager layout(mContentProvider->BoxLayouter_getOrient());
         bool horizontal = mContentProvider->BoxLayouter_getOrient() == Horizontal;
-        std::vector<ExtendedSizeInfo> sizeInfos;
+
+        // Children that were not measured get the average size.
+        std::vector<int> estimatedMinSizes;
+        std::vector<int> estimatedOptSizes;
+        if (mVirtualized)
+        {
+            mItems.getSizes(*this, Minimum, estimatedMinSizes);
+            mItems.getSizes(*this, Preferred, estimatedOptSizes);
+        }
 
         for (size_t idx = 0; idx != mContentProvider->BoxLayouter_getChildCount(); ++idx)
         {
-            Component * child = mContentProvider->BoxLayouter_getChild(idx);
-            std::string flex;
-            if (child->el())
+            const Component * child = mContentProvider->BoxLayouter_getChild(idx);
+            int flexValue = child->getFlex();
+            if (mVirtualized && !mItems.isMeasured(idx))
             {
-                flex = child->el()->getAttribute("flex");
+                outSizeInfos.push_back(
+                    ExtendedSizeInfo(FlexWrap(flexValue),
+                                     MinSizeWrap(estimatedMinSizes[idx]),
+                                     OptSizeWrap(estimatedOptSizes[idx]),
+                                     MinSizeOppositeWrap(0),
+                                     false));
+                continue;
             }
-            int flexValue = String2Int(flex, 0);
+
             int optSize = horizontal ? child->getWidth(Preferred) : child->getHeight(Preferred);
             int minSize = horizontal ? child->getWidth(Minimum) : child->getHeight(Minimum);
             int minSizeOpposite = horizontal ? child->getHeight(Minimum) : child->getWidth(Minimum);
-            sizeInfos.push_back(
+            outSizeInfos.push_back(
                 ExtendedSizeInfo(FlexWrap(flexValue),
                                  MinSizeWrap(minSize),
                                  OptSizeWrap(optSize),
                                  MinSizeOppositeWrap(minSizeOpposite),
                                  child->expansive()));
         }
+    }
+
+
+    void BoxLayouter::rebuildLayout()
+    {
+        // Native children are moved in one batch at the end of the pass.
+        LayoutTransaction transaction;
+
+        Rect clientR(mContentProvider->BoxLayouter_clientRect());
+        LinearLayoutManager layout(mContentProvider->BoxLayouter_getOrient());
+        size_t childCount = mContentProvider->BoxLayouter_getChildCount();
+
+        if (mVirtualized)
+        {
+            // The measurements are by index, so they are forgotten when the
+            // children change.
+            bool childrenChanged = childCount != mPrevChildren.size() || childCount != mItems.size();
+            for (size_t idx = 0; idx != childCount && !childrenChanged; ++idx)
+            {
+                childrenChanged = mPrevChildren[idx] != mContentProvider->BoxLayouter_getChild(idx);
+            }
+            if (childrenChanged)
+            {
+                mItems.reset(childCount);
+            }
+
+            bool horizontal = mContentProvider->BoxLayouter_getOrient() == Horizontal;
+            mItems.measureRange(*this,
+                                horizontal ? mScrollOffset.x() : mScrollOffset.y(),
+                                horizontal ? clientR.width() : clientR.height());
+        }
+
+        std::vector<ExtendedSizeInfo> sizeInfos;
+        getSizeInfos(sizeInfos);
 
         std::vector<Rect> childRects;
         layout.getRects(clientR, mContentProvider->BoxLayouter_getAlign(), sizeInfos, childRects);
 
-        for (size_t idx = 0; idx != mContentProvider->BoxLayouter_getChildCount(); ++idx)
+        // Estimated children that turn out to be visible are measured, and
+        // the rects are calculated again with their real sizes.
+        bool remeasure = mVirtualized;
+        while (remeasure)
+        {
+            remeasure = false;
+            for (size_t idx = 0; idx != childCount; ++idx)
+            {
+                if (!mItems.isMeasured(idx) && Intersects(ScrollRect(childRects[idx], mScrollOffset), clientR))
+                {
+                    mItems.setMeasured(idx);
+                    remeasure = true;
+                }
+            }
+            if (remeasure)
+            {
+                sizeInfos.clear();
+                getSizeInfos(sizeInfos);
+                childRects.clear();
+                layout.getRects(clientR, mContentProvider->BoxLayouter_getAlign(), sizeInfos, childRects);
+            }
+        }
+
+        std::vector<const Component *> children;
+        std::vector<bool> realized;
+        for (size_t idx = 0; idx != childCount; ++idx)
         {
             Component * child = mContentProvider->BoxLayouter_getChild(idx);
-            const Rect & rect = childRects[idx];
-            child->move(rect.x(), rect.y(), rect.width(), rect.height());
+            children.push_back(child);
+
+            // Native windows are created visible. New children are not known
+            // to be shown in virtualized mode, so their state is always set.
+            bool sameChild = idx < mPrevChildren.size() && mPrevChildren[idx] == child;
+            bool wasRealized = !sameChild || mPrevRealized[idx];
+
+            Rect & rect = childRects[idx];
+            bool visible = true;
+            if (mVirtualized)
+            {
+                rect = ScrollRect(rect, mScrollOffset);
+                visible = Intersects(rect, clientR);
+            }
+            if (visible != wasRealized || (mVirtualized && !sameChild))
+            {
+                SetRealized(child, visible);
+            }
+            realized.push_back(visible);
+
+            // Children outside the visible area are left where they are.
+            if (!visible)
+            {
+                continue;
+            }
+
+            bool rectChanged = !sameChild
+                            || !wasRealized
+                            || mPrevRects[idx] != rect;
+            if (rectChanged || child->needsLayout())
+            {
+                child->move(rect.x(), rect.y(), rect.width(), rect.height());
+            }
+            if (rectChanged)
+            {
+                child->invalidateLayout();
+            }
         }
+        mPrevChildren.swap(children);
+        mPrevRects.swap(childRects);
+        mPrevRealized.swap(realized);
 
+        // Only the children that were moved or invalidated are rebuilt.
         mContentProvider->BoxLayouter_rebuildChildLayouts();
     }
 
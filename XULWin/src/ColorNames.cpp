@@ -0,0 +1,346 @@
+// Generated by Scripts/GenerateColorNames/GenerateColorNames.rb. Do not edit.
+#include "XULWin/ColorNames.h"
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        struct ColorName
+        {
+            const char * name;
+            unsigned int length;
+            unsigned int rgb;
+        };
+
+        const unsigned int cNumBuckets = 64;
+        const unsigned int cNumSlots = 256;
+        const unsigned int cMinLength = 3;
+        const unsigned int cMaxLength = 20;
+
+        // Seed of the slot hash, for each bucket.
+        const unsigned int cSeeds[cNumBuckets] =
+        {
+            2, 0, 0, 2, 2, 2, 2, 5,
+            0, 9, 3, 1, 1, 1, 0, 1,
+            5, 1, 1, 1, 3, 1, 2, 1,
+            2, 2, 2, 3, 0, 1, 3, 1,
+            3, 0, 1, 2, 2, 0, 0, 1,
+            4, 1, 3, 1, 2, 6, 1, 2,
+            2, 2, 9, 4, 3, 0, 2, 4,
+            1, 8, 1, 6, 1, 4, 0, 12
+        };
+
+        const ColorName cColorNames[cNumSlots] =
+        {
+            { "antiquewhite", 12, 0xFAEBD7 },
+            { "salmon", 6, 0xFA8072 },
+            { "wheat", 5, 0xF5DEB3 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "darkkhaki", 9, 0xBDB76B },
+            { "yellow", 6, 0xFFFF00 },
+            { "darkgoldenrod", 13, 0xB8860B },
+            { "slateblue", 9, 0x6A5ACD },
+            { "mediumaquamarine", 16, 0x66CDAA },
+            { "seashell", 8, 0xFFF5EE },
+            { "midnightblue", 12, 0x191970 },
+            { "lime", 4, 0x00FF00 },
+            { "ghostwhite", 10, 0xF8F8FF },
+            { "lightblue", 9, 0xADD8E6 },
+            { "lightslategray", 14, 0x778899 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "lightskyblue", 12, 0x87CEFA },
+            { 0, 0, 0 },
+            { "white", 5, 0xFFFFFF },
+            { 0, 0, 0 },
+            { "seagreen", 8, 0x2E8B57 },
+            { "ivory", 5, 0xFFFFF0 },
+            { "palevioletred", 13, 0xD87093 },
+            { "black", 5, 0x000000 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "mediumorchid", 12, 0xBA55D3 },
+            { "lightcoral", 10, 0xF08080 },
+            { "burlywood", 9, 0xDEB887 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "maroon", 6, 0x800000 },
+            { "coral", 5, 0xFF7F50 },
+            { "blue", 4, 0x0000FF },
+            { "greenyellow", 11, 0xADFF2F },
+            { "lightpink", 9, 0xFFB6C1 },
+            { 0, 0, 0 },
+            { "forestgreen", 11, 0x228B22 },
+            { "yellowgreen", 11, 0x9ACD32 },
+            { "steelblue", 9, 0x4682B4 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "oldlace", 7, 0xFDF5E6 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "limegreen", 9, 0x32CD32 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "cornsilk", 8, 0xFFF8DC },
+            { "violet", 6, 0xEE82EE },
+            { 0, 0, 0 },
+            { "fuchsia", 7, 0xFF00FF },
+            { "orange", 6, 0xFFA500 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "darkblue", 8, 0x00008B },
+            { "darkmagenta", 11, 0x8B008B },
+            { "orchid", 6, 0xDA70D6 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "purple", 6, 0x800080 },
+            { 0, 0, 0 },
+            { "blanchedalmond", 14, 0xFFEBCD },
+            { "papayawhip", 10, 0xFFEFD5 },
+            { "sienna", 6, 0xA0522D },
+            { "orangered", 9, 0xFF4500 },
+            { 0, 0, 0 },
+            { "aquamarine", 10, 0x7FFFD4 },
+            { "mediumslateblue", 15, 0x7B68EE },
+            { 0, 0, 0 },
+            { "springgreen", 11, 0x00FF7F },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "cyan", 4, 0x00FFFF },
+            { 0, 0, 0 },
+            { "darkgray", 8, 0xA9A9A9 },
+            { "aliceblue", 9, 0xF0F8FF },
+            { "lavenderblush", 13, 0xFFF0F5 },
+            { "mediumblue", 10, 0x0000CD },
+            { "tomato", 6, 0xFF6347 },
+            { "gray", 4, 0x808080 },
+            { "rosybrown", 9, 0xBC8F8F },
+            { 0, 0, 0 },
+            { "dimgray", 7, 0x696969 },
+            { "mintcream", 9, 0xF5FFFA },
+            { "olivedrab", 9, 0x6B8E23 },
+            { 0, 0, 0 },
+            { "lightsteelblue", 14, 0xB0C4DE },
+            { "darkviolet", 10, 0x9400D3 },
+            { 0, 0, 0 },
+            { "cadetblue", 9, 0x5F9EA0 },
+            { "mediumspringgreen", 17, 0x00FA9A },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "mistyrose", 9, 0xFFE4E1 },
+            { 0, 0, 0 },
+            { "snow", 4, 0xFFFAFA },
+            { "floralwhite", 11, 0xFFFAF0 },
+            { 0, 0, 0 },
+            { "gold", 4, 0xFFD700 },
+            { 0, 0, 0 },
+            { "darkorange", 10, 0xFF8C00 },
+            { 0, 0, 0 },
+            { "plum", 4, 0xDDA0DD },
+            { 0, 0, 0 },
+            { "khaki", 5, 0xF0E68C },
+            { 0, 0, 0 },
+            { "hotpink", 7, 0xFF69B4 },
+            { "palegreen", 9, 0x98FB98 },
+            { "mediumturquoise", 15, 0x48D1CC },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "chocolate", 9, 0xD2691E },
+            { "indigo", 6, 0x4B0082 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "navajowhite", 11, 0xFFDEAD },
+            { "lightyellow", 11, 0xFFFFE0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "pink", 4, 0xFFC0CB },
+            { "azure", 5, 0xF0FFFF },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "silver", 6, 0xC0C0C0 },
+            { "beige", 5, 0xF5F5DC },
+            { "cornflowerblue", 14, 0x6495ED },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "red", 3, 0xFF0000 },
+            { "peru", 4, 0xCD853F },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "mediumvioletred", 15, 0xC71585 },
+            { "linen", 5, 0xFAF0E6 },
+            { "saddlebrown", 11, 0x8B4513 },
+            { 0, 0, 0 },
+            { "lightgoldenrodyellow", 20, 0xFAFAD2 },
+            { 0, 0, 0 },
+            { "darkcyan", 8, 0x008B8B },
+            { "navy", 4, 0x000080 },
+            { "lightseagreen", 13, 0x20B2AA },
+            { 0, 0, 0 },
+            { "mediumseagreen", 14, 0x3CB371 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "deepskyblue", 11, 0x00BFFF },
+            { "darkgreen", 9, 0x006400 },
+            { "lemonchiffon", 12, 0xFFFACD },
+            { "palegoldenrod", 13, 0xEEE8AA },
+            { 0, 0, 0 },
+            { "darkseagreen", 12, 0x8FBC8F },
+            { "darkturquoise", 13, 0x00CED1 },
+            { "powderblue", 10, 0xB0E0E6 },
+            { "sandybrown", 10, 0xF4A460 },
+            { "paleturquoise", 13, 0xAFEEEE },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "turquoise", 9, 0x40E0D0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "gainsboro", 9, 0xDCDCDC },
+            { 0, 0, 0 },
+            { "lightsalmon", 11, 0xFFA07A },
+            { "darkolivegreen", 14, 0x556B2F },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "darksalmon", 10, 0xE9967A },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "lightgrey", 9, 0xD3D3D3 },
+            { 0, 0, 0 },
+            { "darkred", 7, 0x8B0000 },
+            { "darkslateblue", 13, 0x483D8B },
+            { "dodgerblue", 10, 0x1E90FF },
+            { "skyblue", 7, 0x87CEEB },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "darkorchid", 10, 0x9932CC },
+            { 0, 0, 0 },
+            { "mediumpurple", 12, 0x9370D8 },
+            { "lawngreen", 9, 0x7CFC00 },
+            { 0, 0, 0 },
+            { "lightcyan", 9, 0xE0FFFF },
+            { 0, 0, 0 },
+            { "slategray", 9, 0x708090 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "green", 5, 0x008000 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "crimson", 7, 0xDC143C },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "lavender", 8, 0xE6E6FA },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "royalblue", 9, 0x4169E1 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "goldenrod", 9, 0xDAA520 },
+            { "darkslategray", 13, 0x2F4F4F },
+            { 0, 0, 0 },
+            { "lightgreen", 10, 0x90EE90 },
+            { 0, 0, 0 },
+            { "thistle", 7, 0xD8BFD8 },
+            { 0, 0, 0 },
+            { "peachpuff", 9, 0xFFDAB9 },
+            { "deeppink", 8, 0xFF1493 },
+            { "brown", 5, 0xA52A2A },
+            { "chartreuse", 10, 0x7FFF00 },
+            { "whitesmoke", 10, 0xF5F5F5 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { "olive", 5, 0x808000 },
+            { "indianred", 9, 0xCD5C5C },
+            { "tan", 3, 0xD2B48C },
+            { 0, 0, 0 },
+            { "blueviolet", 10, 0x8A2BE2 },
+            { "teal", 4, 0x008080 },
+            { "firebrick", 9, 0xB22222 },
+            { "magenta", 7, 0xFF00FF },
+            { "aqua", 4, 0x00FFFF },
+            { "honeydew", 8, 0xF0FFF0 },
+            { "moccasin", 8, 0xFFE4B5 },
+            { 0, 0, 0 },
+            { "bisque", 6, 0xFFE4C4 },
+            { 0, 0, 0 },
+            { 0, 0, 0 },
+            { 0, 0, 0 }
+        };
+
+
+        char ToLower(char inChar)
+        {
+            return (inChar >= 'A' && inChar <= 'Z') ? static_cast<char>(inChar - 'A' + 'a') : inChar;
+        }
+
+
+        unsigned int Hash(unsigned int inSeed, const char * inBegin, const char * inEnd)
+        {
+            unsigned int result = 2166136261u ^ inSeed;
+            for (const char * it = inBegin; it != inEnd; ++it)
+            {
+                result = (result ^ static_cast<unsigned char>(ToLower(*it))) * 16777619u;
+            }
+            result ^= result >> 16;
+            result *= 0x85EBCA6Bu;
+            result ^= result >> 13;
+            return result;
+        }
+
+    }
+
+
+    bool FindColorName(const char * inBegin, const char * inEnd, RGBColor & outColor)
+    {
+        unsigned int length = static_cast<unsigned int>(inEnd - inBegin);
+        if (length < cMinLength || length > cMaxLength)
+        {
+            return false;
+        }
+
+        unsigned int seed = cSeeds[Hash(0, inBegin, inEnd) % cNumBuckets];
+        const ColorName & entry = cColorNames[Hash(seed, inBegin, inEnd) % cNumSlots];
+        if (!entry.name || entry.length != length)
+        {
+            return false;
+        }
+
+        for (unsigned int idx = 0; idx != length; ++idx)
+        {
+            if (ToLower(inBegin[idx]) != entry.name[idx])
+            {
+                return false;
+            }
+        }
+
+        outColor = RGBColor((entry.rgb >> 16) & 0xFF, (entry.rgb >> 8) & 0xFF, entry.rgb & 0xFF);
+        return true;
+    }
+
+} // namespace XULWin
@@ -0,0 +1,475 @@
+#include "XULWin/CompiledXUL.h"
+#include "XULWin/ElementFactory.h"
+#include "Poco/BinaryReader.h"
+#include "Poco/BinaryWriter.h"
+#include "Poco/Exception.h"
+#include "Poco/File.h"
+#include <fstream>
+
+
+namespace XULWin
+{
+
+    // Identifies the file type and format version.
+    static const Poco::UInt32 cMagic = 0x434C5558; // "XULC"
+    static const Poco::UInt32 cVersion = 1;
+
+
+    // FNV-1a hash of the file contents.
+    static bool HashFile(const std::string & inPath, Poco::UInt32 & outHash)
+    {
+        std::ifstream file(inPath.c_str(), std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        Poco::UInt32 hash = 2166136261u;
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        {
+            std::streamsize count = file.gcount();
+            for (std::streamsize idx = 0; idx != count; ++idx)
+            {
+                hash ^= static_cast<unsigned char>(buffer[idx]);
+                hash *= 16777619u;
+            }
+        }
+        outHash = hash;
+        return true;
+    }
+
+
+    // The number of bytes after the read position.
+    static Poco::UInt64 GetRemainingSize(std::istream & inStream, Poco::UInt64 inFileSize)
+    {
+        std::streamoff pos = inStream.tellg();
+        if (pos < 0 || static_cast<Poco::UInt64>(pos) > inFileSize)
+        {
+            return 0;
+        }
+        return inFileSize - static_cast<Poco::UInt64>(pos);
+    }
+
+
+    // Reads the number of items that follow. Each takes at least
+    // inMinItemSize bytes, so a count that doesn't fit in the rest of the
+    // file is corrupt. Checked before anything is allocated for the items.
+    static bool ReadCount(Poco::BinaryReader & inReader,
+                          std::istream & inStream,
+                          Poco::UInt64 inFileSize,
+                          Poco::UInt64 inMinItemSize,
+                          Poco::UInt32 & outCount)
+    {
+        inReader >> outCount;
+        return inReader.good() && outCount * inMinItemSize <= GetRemainingSize(inStream, inFileSize);
+    }
+
+
+    // Reads a string written by BinaryWriter. BinaryReader would reserve
+    // whatever length the file claims.
+    static bool ReadString(Poco::BinaryReader & inReader,
+                           std::istream & inStream,
+                           Poco::UInt64 inFileSize,
+                           std::string & outValue)
+    {
+        Poco::UInt32 length = 0;
+        inReader.read7BitEncoded(length);
+        if (!inReader.good() || length > GetRemainingSize(inStream, inFileSize))
+        {
+            return false;
+        }
+        outValue.resize(length);
+        if (length != 0)
+        {
+            inStream.read(&outValue[0], length);
+        }
+        return inStream.good();
+    }
+
+
+    CompiledXUL::Dependency::Dependency() :
+        modified(0),
+        size(0),
+        hash(0)
+    {
+    }
+
+
+    CompiledXUL::Node::Node() :
+        tagName(cNoString),
+        innerText(cNoString),
+        childCount(0)
+    {
+    }
+
+
+    CompiledXUL::CompiledXUL() :
+        mValid(true),
+        mNeedsSave(false)
+    {
+    }
+
+
+    std::string CompiledXUL::GetCompiledPath(const std::string & inXULFile)
+    {
+        return inXULFile + "c";
+    }
+
+
+    void CompiledXUL::setLocale(const std::string & inLocale)
+    {
+        mLocale = inLocale;
+    }
+
+
+    bool CompiledXUL::GetDependency(const std::string & inPath, Dependency & outDependency, bool inComputeHash)
+    {
+        try
+        {
+            Poco::File file(inPath);
+            if (!file.exists())
+            {
+                return false;
+            }
+            outDependency.path = inPath;
+            outDependency.modified = file.getLastModified().epochMicroseconds();
+            outDependency.size = file.getSize();
+            return !inComputeHash || HashFile(inPath, outDependency.hash);
+        }
+        catch (const Poco::Exception &)
+        {
+            return false;
+        }
+    }
+
+
+    bool CompiledXUL::IsUpToDate(Dependency & ioDependency)
+    {
+        Dependency current;
+        if (!GetDependency(ioDependency.path, current, false) || current.size != ioDependency.size)
+        {
+            return false;
+        }
+
+        if (current.modified == ioDependency.modified)
+        {
+            return true;
+        }
+
+        // The file was touched, check if the contents changed.
+        if (!HashFile(ioDependency.path, current.hash) || current.hash != ioDependency.hash)
+        {
+            return false;
+        }
+        ioDependency.modified = current.modified;
+        return true;
+    }
+
+
+    void CompiledXUL::addDependency(const std::string & inPath)
+    {
+        Dependency dependency;
+        if (GetDependency(inPath, dependency, true))
+        {
+            mDependencies.push_back(dependency);
+        }
+        else
+        {
+            setInvalid();
+        }
+    }
+
+
+    CompiledXUL::StringId CompiledXUL::intern(const std::string & inString)
+    {
+        std::map<std::string, StringId>::iterator it = mStringIds.find(inString);
+        if (it != mStringIds.end())
+        {
+            return it->second;
+        }
+
+        StringId result = static_cast<StringId>(mStrings.size());
+        mStrings.push_back(inString);
+        mStringIds.insert(std::make_pair(inString, result));
+        return result;
+    }
+
+
+    void CompiledXUL::startElement(const std::string & inTagName, const AttributesMapping & inAttributes)
+    {
+        if (!mOpenNodes.empty())
+        {
+            mNodes[mOpenNodes.back()].childCount++;
+        }
+        else if (!mNodes.empty())
+        {
+            // A document has only one root element.
+            setInvalid();
+        }
+
+        mOpenNodes.push_back(mNodes.size());
+        mNodes.push_back(Node());
+        Node & node = mNodes.back();
+        node.tagName = intern(inTagName);
+        node.attributes.reserve(inAttributes.size());
+        AttributesMapping::const_iterator it = inAttributes.begin(), end = inAttributes.end();
+        for (; it != end; ++it)
+        {
+            node.attributes.push_back(std::make_pair(intern(it->first), intern(it->second)));
+        }
+    }
+
+
+    void CompiledXUL::setInnerText(const std::string & inText)
+    {
+        if (mOpenNodes.empty())
+        {
+            setInvalid();
+            return;
+        }
+        mNodes[mOpenNodes.back()].innerText = intern(inText);
+    }
+
+
+    void CompiledXUL::endElement()
+    {
+        if (mOpenNodes.empty())
+        {
+            setInvalid();
+            return;
+        }
+        mOpenNodes.pop_back();
+    }
+
+
+    void CompiledXUL::setInvalid()
+    {
+        mValid = false;
+    }
+
+
+    bool CompiledXUL::isValid() const
+    {
+        return mValid && !mNodes.empty() && mOpenNodes.empty();
+    }
+
+
+    bool CompiledXUL::save(const std::string & inFileName) const
+    {
+        if (!isValid())
+        {
+            return false;
+        }
+
+        std::ofstream file(inFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+
+        Poco::BinaryWriter writer(file, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+        writer << cMagic << cVersion << mLocale;
+
+        writer << static_cast<Poco::UInt32>(mDependencies.size());
+        for (size_t idx = 0; idx != mDependencies.size(); ++idx)
+        {
+            const Dependency & dep = mDependencies[idx];
+            writer << dep.path << dep.modified << dep.size << dep.hash;
+        }
+
+        writer << static_cast<Poco::UInt32>(mStrings.size());
+        for (size_t idx = 0; idx != mStrings.size(); ++idx)
+        {
+            writer << mStrings[idx];
+        }
+
+        writer << static_cast<Poco::UInt32>(mNodes.size());
+        for (size_t idx = 0; idx != mNodes.size(); ++idx)
+        {
+            const Node & node = mNodes[idx];
+            writer << node.tagName << node.innerText << node.childCount;
+            writer << static_cast<Poco::UInt32>(node.attributes.size());
+            for (size_t attrIdx = 0; attrIdx != node.attributes.size(); ++attrIdx)
+            {
+                writer << node.attributes[attrIdx].first << node.attributes[attrIdx].second;
+            }
+        }
+        writer.flush();
+        return writer.good();
+    }
+
+
+    bool CompiledXUL::load(const std::string & inFileName, const std::string & inLocale)
+    {
+        std::ifstream file(inFileName.c_str(), std::ios::binary);
+        if (!file || !file.seekg(0, std::ios::end))
+        {
+            return false;
+        }
+        std::streamoff fileSize = file.tellg();
+        if (fileSize < 0 || !file.seekg(0, std::ios::beg))
+        {
+            return false;
+        }
+
+        // The smallest encoding of each item: strings have at least their
+        // length byte, the numbers have a fixed size.
+        const Poco::UInt64 cMinStringSize = 1;
+        const Poco::UInt64 cMinDependencySize = cMinStringSize + 8 + 8 + 4;
+        const Poco::UInt64 cMinNodeSize = 4 * 4;
+        const Poco::UInt64 cAttributeSize = 2 * 4;
+        Poco::UInt64 size = static_cast<Poco::UInt64>(fileSize);
+
+        Poco::BinaryReader reader(file, Poco::BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
+        Poco::UInt32 magic = 0, version = 0;
+        reader >> magic >> version;
+        if (!reader.good() || magic != cMagic || version != cVersion ||
+            !ReadString(reader, file, size, mLocale) || mLocale != inLocale)
+        {
+            return false;
+        }
+
+        Poco::UInt32 numDependencies = 0;
+        if (!ReadCount(reader, file, size, cMinDependencySize, numDependencies))
+        {
+            return false;
+        }
+        mDependencies.resize(numDependencies);
+        for (size_t idx = 0; idx != mDependencies.size(); ++idx)
+        {
+            Dependency & dep = mDependencies[idx];
+            if (!ReadString(reader, file, size, dep.path))
+            {
+                return false;
+            }
+            reader >> dep.modified >> dep.size >> dep.hash;
+            Poco::Int64 modified = dep.modified;
+            if (!reader.good() || !IsUpToDate(dep))
+            {
+                return false;
+            }
+            mNeedsSave = mNeedsSave || dep.modified != modified;
+        }
+
+        Poco::UInt32 numStrings = 0;
+        if (!ReadCount(reader, file, size, cMinStringSize, numStrings))
+        {
+            return false;
+        }
+        mStrings.resize(numStrings);
+        for (size_t idx = 0; idx != mStrings.size(); ++idx)
+        {
+            if (!ReadString(reader, file, size, mStrings[idx]))
+            {
+                return false;
+            }
+        }
+
+        Poco::UInt32 numNodes = 0;
+        if (!ReadCount(reader, file, size, cMinNodeSize, numNodes) || numNodes == 0)
+        {
+            return false;
+        }
+        mNodes.resize(numNodes);
+        for (size_t idx = 0; idx != mNodes.size(); ++idx)
+        {
+            Node & node = mNodes[idx];
+            reader >> node.tagName >> node.innerText >> node.childCount;
+            Poco::UInt32 numAttributes = 0;
+            if (!ReadCount(reader, file, size, cAttributeSize, numAttributes) ||
+                node.tagName >= mStrings.size() ||
+                (node.innerText != cNoString && node.innerText >= mStrings.size()))
+            {
+                return false;
+            }
+
+            node.attributes.resize(numAttributes);
+            for (size_t attrIdx = 0; attrIdx != node.attributes.size(); ++attrIdx)
+            {
+                std::pair<StringId, StringId> & attr = node.attributes[attrIdx];
+                reader >> attr.first >> attr.second;
+                if (!reader.good() || attr.first >= mStrings.size() || attr.second >= mStrings.size())
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Check that the child counts describe exactly one tree. The nodes
+        // that are still expected must fit in the rest of the array.
+        size_t pending = 1;
+        for (size_t idx = 0; idx != mNodes.size(); ++idx)
+        {
+            if (pending == 0 || mNodes[idx].childCount > mNodes.size() - idx - pending)
+            {
+                return false;
+            }
+            pending = pending - 1 + mNodes[idx].childCount;
+        }
+        return pending == 0;
+    }
+
+
+    bool CompiledXUL::needsSave() const
+    {
+        return mNeedsSave;
+    }
+
+
+    ElementPtr CompiledXUL::createElements() const
+    {
+        size_t nodeIndex = 0;
+        return mNodes.empty() ? ElementPtr() : createElement(0, nodeIndex);
+    }
+
+
+    ElementPtr CompiledXUL::createElement(Element * inParent, size_t & ioNodeIndex) const
+    {
+        // Same steps as the XULParser: create the element, then its children,
+        // then set the inner text and initialize.
+        const Node & node = mNodes[ioNodeIndex++];
+
+        AttributesMapping attributes;
+        attributes.reserve(node.attributes.size());
+        for (size_t idx = 0; idx != node.attributes.size(); ++idx)
+        {
+            attributes.insert(std::make_pair(mStrings[node.attributes[idx].first],
+                                             mStrings[node.attributes[idx].second]));
+        }
+
+        ElementPtr element = ElementFactory::Instance().createElement(mStrings[node.tagName], inParent, attributes);
+        if (!element)
+        {
+            // The parser ignores child elements of elements that failed.
+            for (size_t idx = 0; idx != node.childCount; ++idx)
+            {
+                skipNode(ioNodeIndex);
+            }
+            return element;
+        }
+
+        for (size_t idx = 0; idx != node.childCount; ++idx)
+        {
+            createElement(element.get(), ioNodeIndex);
+        }
+
+        if (node.innerText != cNoString)
+        {
+            element->setInnerText(mStrings[node.innerText]);
+        }
+        element->init();
+        return element;
+    }
+
+
+    void CompiledXUL::skipNode(size_t & ioNodeIndex) const
+    {
+        const Node & node = mNodes[ioNodeIndex++];
+        for (size_t idx = 0; idx != node.childCount; ++idx)
+        {
+            skipNode(ioNodeIndex);
+        }
+    }
+
+} // namespace XULWin
@@ -1,6 +1,7 @@
 #include "XULWin/ComponentFactory.h"
 #include "XULWin/Conversions.h"
 #include "XULWin/ErrorReporter.h"
+#include "XULWin/StyleDeclarations.h"
 
 
 namespace XULWin
@@ -14,26 +15,11 @@ namespace XULWin
 
     void ComponentFactory::GetStyles(const AttributesMapping & inAttr, StylesMapping & styles)
     {
-        StylesMapping::const_iterator it = inAttr.find("style");
-        if (it != inAttr.end())
+        const StyleDeclarations & declarations = StyleDeclarations::Get(inAttr);
+        for (size_t idx = 0; idx != declarations.size(); ++idx)
         {
-            Poco::StringTokenizer tok(it->second, ";:", Poco::StringTokenizer::TOK_IGNORE_EMPTY | Poco::StringTokenizer::TOK_TRIM);
-            Poco::StringTokenizer::Iterator it = tok.begin(), end = tok.end();
-            std::string key, value;
-            int counter = 0;
-            for (; it != end; ++it)
-            {
-                if (counter%2 == 0)
-                {
-                    key = *it;
-                }
-                else
-                {
-                    value = *it;
-                    styles.insert(std::make_pair(key, value));
-                }
-                counter++;
-            }
+            const StyleDeclaration & declaration = declarations.get(idx);
+            styles.insert(std::make_pair(declaration.name(), declaration.value()));
         }
     }
 
@@ -53,4 +39,20 @@ namespace XULWin
         return CSSOverflow_Hidden;
     }
 
+
+    CSSOverflow ComponentFactory::GetOverflow(const StyleDeclarations & inStyles,
+                                              CSSProperty inOverflow)
+    {
+        const StyleDeclaration * declaration = inStyles.find(inOverflow);
+        if (!declaration)
+        {
+            declaration = inStyles.find(CSSProperty_Overflow);
+        }
+        if (declaration)
+        {
+            return declaration->overflow();
+        }
+        return CSSOverflow_Hidden;
+    }
+
 } // namespace XULWin
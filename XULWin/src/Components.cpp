@@ -1,5 +1,4 @@
 #include "XULWin/Components.h"
-#include "XULWin/Algorithms.h"
 #include "XULWin/Conversions.h"
 #include "XULWin/Decorator.h"
 #include "XULWin/Decorators.h"
@@ -8,12 +7,12 @@
 #include "XULWin/Elements.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/Layout.h"
+#include "XULWin/LayoutTransaction.h"
 #include "XULWin/Unicode.h"
 #include "XULWin/Window.h"
 #include "XULWin/WinUtils.h"
 #include "Poco/String.h"
 #include "Poco/StringTokenizer.h"
-#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 #include <windowsx.h>
 
@@ -46,6 +45,7 @@ namespace XULWin
     void Label::setValue(const std::string & inStringValue)
     {
         WinAPI::Window_SetText(handle(), inStringValue);
+        invalidateSizeCache();
     }
 
 
@@ -230,6 +230,7 @@ namespace XULWin
     void Description::setValue(const std::string & inStringValue)
     {
         WinAPI::Window_SetText(handle(), inStringValue);
+        invalidateSizeCache();
     }
 
 
@@ -320,6 +321,7 @@ namespace XULWin
     void Hyperlink::setValue(const std::string & inStringValue)
     {
         WinAPI::Window_SetText(handle(), inStringValue);
+        invalidateSizeCache();
     }
 
 
@@ -577,6 +579,7 @@ namespace XULWin
     void TextBox::setValue(const std::string & inStringValue)
     {
         WinAPI::Window_SetText(handle(), inStringValue);
+        invalidateSizeCache();
     }
 
 
@@ -601,6 +604,7 @@ namespace XULWin
     void TextBox::setRows(int inRows)
     {
         mRows = inRows;
+        invalidateSizeCache();
     }
 
 
@@ -693,6 +697,7 @@ namespace XULWin
                       TEXT("SCROLLBAR"),
                       0, // exStyle
                       WS_TABSTOP | GetFlags(inAttributesMapping)),
+        mEventListener(0),
         mIncrement(0)
     {
         mExpansive = true;
@@ -953,6 +958,12 @@ namespace XULWin
         mBoxLayouter.rebuildLayout();
     }
 
+    void VirtualBox::onChildRemoved(Component * inChild)
+    {
+        mBoxLayouter.onChildRemoved();
+        Super::onChildRemoved(inChild);
+    }
+
 
     Component * CreateBox(Component * inParent, const AttributesMapping & inAttr)
     {
@@ -991,6 +1002,7 @@ namespace XULWin
     void Box::setOrient(Orient inOrient)
     {
         mOrient = inOrient;
+        invalidateSizeCache();
     }
 
 
@@ -1000,9 +1012,49 @@ namespace XULWin
     }
 
 
+    bool Box::isVirtualized() const
+    {
+        return mBoxLayouter.isVirtualized();
+    }
+
+
+    void Box::setVirtualized(bool inVirtualized)
+    {
+        mBoxLayouter.setVirtualized(inVirtualized);
+        invalidateSizeCache();
+    }
+
+
+    void Box::setScrollOffset(const Point & inScrollOffset)
+    {
+        mBoxLayouter.setScrollOffset(inScrollOffset);
+    }
+
+
+    bool Box::initAttributeControllers()
+    {
+        setAttributeController<VirtualizeController>(this);
+        return Super::initAttributeControllers();
+    }
+
+
     void Box::rebuildLayout()
     {
+        size_t numMeasured = mBoxLayouter.numMeasured();
         mBoxLayouter.rebuildLayout();
+
+        // The size of a virtualized box is estimated from the measured
+        // children, so it changes when more children are measured.
+        if (mBoxLayouter.numMeasured() != numMeasured)
+        {
+            invalidateSizeCache();
+        }
+    }
+
+    void Box::onChildRemoved(Component * inChild)
+    {
+        mBoxLayouter.onChildRemoved();
+        Super::onChildRemoved(inChild);
     }
 
 
@@ -1042,6 +1094,28 @@ namespace XULWin
     }
 
 
+    void Box::BoxLayouter_rebuildChildLayouts()
+    {
+        if (!isVirtualized())
+        {
+            rebuildInvalidatedChildLayouts();
+            return;
+        }
+
+        // Children outside the visible area keep their pending layout
+        // until they are scrolled into view.
+        for (size_t idx = 0; idx != getChildCount(); ++idx)
+        {
+            Component * child = getChild(idx);
+            if (mBoxLayouter.isRealized(idx) && child->needsLayout())
+            {
+                child->rebuildLayout();
+            }
+        }
+        mNeedsLayout = false;
+    }
+
+
     Separator::Separator(Component * inParent, const AttributesMapping & inAttr) :
         NativeControl(inParent,
                       inAttr,
@@ -1105,6 +1179,99 @@ namespace XULWin
     }
 
 
+    GridTracks::GridTracks()
+    {
+        clear();
+    }
+
+
+    void GridTracks::clear()
+    {
+        mColumns.clear();
+        for (size_t idx = 0; idx <= Maximum; ++idx)
+        {
+            mColumnWidths[idx].clear();
+            mMeasured[idx] = false;
+        }
+    }
+
+
+    int GridTracks::getColumnWidth(const Element * inGrid,
+                                   const Element * inColumn,
+                                   SizeConstraint inSizeConstraint,
+                                   const VirtualItems * inMeasuredRows)
+    {
+        if (!mMeasured[inSizeConstraint])
+        {
+            measure(inGrid, inSizeConstraint, inMeasuredRows);
+        }
+
+        const std::vector<int> & widths = mColumnWidths[inSizeConstraint];
+        for (size_t idx = 0; idx != mColumns.size(); ++idx)
+        {
+            if (mColumns[idx] == inColumn)
+            {
+                return widths[idx];
+            }
+        }
+        return 0;
+    }
+
+
+    void GridTracks::measure(const Element * inGrid, SizeConstraint inSizeConstraint, const VirtualItems * inMeasuredRows)
+    {
+        const Element * rows = 0;
+        const Element * columns = 0;
+        for (size_t idx = 0; idx != inGrid->children().size(); ++idx)
+        {
+            const Element * child = inGrid->children()[idx].get();
+            if (child->tagName() == XMLRows::TagName())
+            {
+                rows = child;
+            }
+            else if (child->tagName() == XMLColumns::TagName())
+            {
+                columns = child;
+            }
+        }
+
+        mColumns.clear();
+        if (columns)
+        {
+            for (size_t idx = 0; idx != columns->children().size(); ++idx)
+            {
+                mColumns.push_back(columns->children()[idx].get());
+            }
+        }
+
+        // Visit each cell once.
+        std::vector<int> & widths = mColumnWidths[inSizeConstraint];
+        widths.assign(mColumns.size(), 0);
+        if (rows)
+        {
+            for (size_t rowIdx = 0; rowIdx != rows->children().size(); ++rowIdx)
+            {
+                if (inMeasuredRows && (rowIdx >= inMeasuredRows->size() || !inMeasuredRows->isMeasured(rowIdx)))
+                {
+                    continue;
+                }
+
+                const Children & cells = rows->children()[rowIdx]->children();
+                size_t numCells = std::min<size_t>(cells.size(), widths.size());
+                for (size_t colIdx = 0; colIdx != numCells; ++colIdx)
+                {
+                    int width = cells[colIdx]->component()->getWidth(inSizeConstraint);
+                    if (width > widths[colIdx])
+                    {
+                        widths[colIdx] = width;
+                    }
+                }
+            }
+        }
+        mMeasured[inSizeConstraint] = true;
+    }
+
+
     VirtualGrid::VirtualGrid(Component * inParent,
                              const AttributesMapping & inAttr) :
         VirtualComponent(inParent, inAttr)
@@ -1112,6 +1279,19 @@ namespace XULWin
     }
 
 
+    void VirtualGrid::invalidateSizeCache()
+    {
+        mTracks.clear();
+        Super::invalidateSizeCache();
+    }
+
+
+    int VirtualGrid::getColumnWidth(const Element * inColumn, SizeConstraint inSizeConstraint) const
+    {
+        return mTracks.getColumnWidth(el(), inColumn, inSizeConstraint);
+    }
+
+
     int VirtualGrid::calculateWidth(SizeConstraint inSizeConstraint) const
     {
         int result = 0;
@@ -1137,6 +1317,9 @@ namespace XULWin
 
     void VirtualGrid::rebuildLayout()
     {
+        // Native cells are moved in one batch at the end of the pass.
+        LayoutTransaction transaction;
+
         //
         // Initialize helper variables
         //
@@ -1190,7 +1373,7 @@ namespace XULWin
             if (Column * col = columns->children()[colIdx]->component()->downcast<Column>())
             {
                 colWidths.push_back(
-                    SizeInfo(FlexWrap(String2Int(col->el()->getAttribute("flex"), 0)),
+                    SizeInfo(FlexWrap(col->getFlex()),
                              MinSizeWrap(col->getWidth(Minimum)),
                              OptSizeWrap(col->getWidth(Preferred))));
             }
@@ -1212,7 +1395,7 @@ namespace XULWin
             if (Row * row = rows->children()[rowIdx]->component()->downcast<Row>())
             {
                 rowHeights.push_back(
-                    SizeInfo(FlexWrap(String2Int(row->el()->getAttribute("flex"), 0)),
+                    SizeInfo(FlexWrap(row->getFlex()),
                              MinSizeWrap(row->getHeight(Minimum)),
                              OptSizeWrap(row->getHeight(Preferred))));
             }
@@ -1235,24 +1418,33 @@ namespace XULWin
         //
         // Get size info for each cell
         //
+        std::vector<Align> columnAligns(numCols, Stretch);
+        std::vector<bool> isColumn(numCols, false);
+        for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
+        {
+            if (Column * column = columns->children()[colIdx]->component()->downcast<Column>())
+            {
+                columnAligns[colIdx] = String2Align(column->el()->getAttribute("align"), Stretch);
+                isColumn[colIdx] = true;
+            }
+        }
+
         GenericGrid<CellInfo> widgetInfos(numRows, numCols, CellInfo(0, 0, Start, Start));
         for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
         {
             if (Row * row = rows->children()[rowIdx]->component()->downcast<Row>())
             {
+                Align rowAlign = String2Align(row->el()->getAttribute("align"), Stretch);
                 for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
                 {
-                    if (Column * column = columns->children()[colIdx]->component()->downcast<Column>())
+                    if (isColumn[colIdx] && colIdx < row->getChildCount())
                     {
-                        if (colIdx < row->getChildCount())
-                        {
-                            Component * child = row->el()->children()[colIdx]->component();
-                            widgetInfos.set(rowIdx, colIdx,
-                                            CellInfo(child->getWidth(),
-                                                     child->getHeight(),
-                                                     String2Align(row->el()->getAttribute("align"), Stretch),
-                                                     String2Align(column->el()->getAttribute("align"), Stretch)));
-                        }
+                        Component * child = row->el()->children()[colIdx]->component();
+                        widgetInfos.set(rowIdx, colIdx,
+                                        CellInfo(child->getWidth(),
+                                                 child->getHeight(),
+                                                 rowAlign,
+                                                 columnAligns[colIdx]));
                     }
                 }
             }
@@ -1293,10 +1485,87 @@ namespace XULWin
     }
 
 
+    // Returns true if the row intersects the client rect after scrolling.
+    static bool IsRowVisible(const Rect & inRowRect, const Point & inScrollOffset, const Rect & inClientRect)
+    {
+        int top = inRowRect.y() - inScrollOffset.y();
+        return top < inClientRect.y() + inClientRect.height()
+            && top + inRowRect.height() > inClientRect.y();
+    }
+
+
     Grid::Grid(Component * inParent,
                const AttributesMapping & inAttr) :
-        NativeControl(inParent, inAttr, TEXT("STATIC"), WS_EX_CONTROLPARENT, WS_TABSTOP)
+        NativeControl(inParent, inAttr, TEXT("STATIC"), WS_EX_CONTROLPARENT, WS_TABSTOP),
+        mVirtualized(false)
+    {
+    }
+
+
+    bool Grid::isVirtualized() const
+    {
+        return mVirtualized;
+    }
+
+
+    void Grid::setVirtualized(bool inVirtualized)
+    {
+        mVirtualized = inVirtualized;
+        mRowItems.reset(0);
+        if (!mVirtualized)
+        {
+            mScrollOffset = Point();
+        }
+        invalidateSizeCache();
+    }
+
+
+    void Grid::setScrollOffset(const Point & inScrollOffset)
+    {
+        mScrollOffset = inScrollOffset;
+    }
+
+
+    bool Grid::initAttributeControllers()
+    {
+        setAttributeController<VirtualizeController>(this);
+        return Super::initAttributeControllers();
+    }
+
+
+    void Grid::invalidateSizeCache()
+    {
+        mTracks.clear();
+        Super::invalidateSizeCache();
+    }
+
+
+    int Grid::getColumnWidth(const Element * inColumn, SizeConstraint inSizeConstraint) const
+    {
+        if (mVirtualized)
+        {
+            syncRowItems();
+            return mTracks.getColumnWidth(el(), inColumn, inSizeConstraint, &mRowItems);
+        }
+        return mTracks.getColumnWidth(el(), inColumn, inSizeConstraint);
+    }
+
+
+    int Grid::VirtualItems_getSize(size_t idx, SizeConstraint inSizeConstraint) const
+    {
+        return findChildOfType<Rows>()->getChild(idx)->getHeight(inSizeConstraint);
+    }
+
+
+    void Grid::syncRowItems() const
     {
+        const Rows * rows = findChildOfType<Rows>();
+        size_t numRows = rows ? rows->getChildCount() : 0;
+        if (mRowItems.size() != numRows)
+        {
+            mRowItems.reset(numRows);
+        }
+        mRowItems.measureSample();
     }
 
 
@@ -1314,6 +1583,12 @@ namespace XULWin
 
     int Grid::calculateHeight(SizeConstraint inSizeConstraint) const
     {
+        if (mVirtualized)
+        {
+            syncRowItems();
+            return mRowItems.getTotalSize(*this, inSizeConstraint);
+        }
+
         int result = 0;
         if (const Rows * rows = findChildOfType<Rows>())
         {
@@ -1325,6 +1600,9 @@ namespace XULWin
 
     void Grid::rebuildLayout()
     {
+        // Native cells are moved in one batch at the end of the pass.
+        LayoutTransaction transaction;
+
         //
         // Initialize helper variables
         //
@@ -1370,63 +1648,92 @@ namespace XULWin
 
 
         //
-        // Get column size infos (min width and flex)
+        // Get column and row size infos (min size and flex). A virtualized
+        // grid measures the rows near the visible area first.
         //
-        std::vector<SizeInfo> colWidths;
-        for (size_t colIdx = 0; colIdx != columns->children().size(); ++colIdx)
+        Rect clientRect(clientRect());
+        if (mVirtualized)
         {
-            if (Column * col = columns->children()[colIdx]->component()->downcast<Column>())
+            // The measurements are by index, so they are forgotten when the
+            // rows change.
+            bool rowsChanged = static_cast<size_t>(numRows) != mPrevRows.size()
+                            || static_cast<size_t>(numRows) != mRowItems.size();
+            for (size_t rowIdx = 0; rowIdx != numRows && !rowsChanged; ++rowIdx)
             {
-                colWidths.push_back(
-                    SizeInfo(FlexWrap(col->getFlex()),
-                             MinSizeWrap(col->getWidth(Minimum)),
-                             OptSizeWrap(col->getWidth(Preferred))));
+                rowsChanged = mPrevRows[rowIdx] != rows->children()[rowIdx]->component();
+            }
+            if (rowsChanged)
+            {
+                mRowItems.reset(numRows);
+            }
+
+            if (mRowItems.measureRange(*this, mScrollOffset.y(), clientRect.height()))
+            {
+                // The column widths follow the measured rows.
+                invalidateSizeCache();
             }
         }
 
-        if (colWidths.empty())
+        std::vector<SizeInfo> colWidths;
+        std::vector<SizeInfo> rowHeights;
+        if (!getSizeInfos(columns, rows, colWidths, rowHeights))
         {
-            ReportError("XMLGrid has no columns!");
             return;
         }
 
 
         //
-        // Get row size infos (min height and flex)
+        // Get bounding rect for all cells
         //
-        std::vector<SizeInfo> rowHeights;
-        for (size_t rowIdx = 0; rowIdx != rows->children().size(); ++rowIdx)
+        GenericGrid<Rect> outerRects(numRows, numCols);
+        GridLayoutManager::GetOuterRects(clientRect, colWidths, rowHeights, outerRects);
+
+        // Estimated rows that turn out to be visible are measured, and the
+        // rects are calculated again with their real sizes.
+        bool remeasure = mVirtualized;
+        while (remeasure)
         {
-            if (Row * row = rows->children()[rowIdx]->component()->downcast<Row>())
+            remeasure = false;
+            for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
             {
-                rowHeights.push_back(
-                    SizeInfo(FlexWrap(row->getFlex()),
-                             MinSizeWrap(row->getHeight(Minimum)),
-                             OptSizeWrap(row->getHeight(Preferred))));
+                if (!mRowItems.isMeasured(rowIdx) && IsRowVisible(outerRects.get(rowIdx, 0), mScrollOffset, clientRect))
+                {
+                    mRowItems.setMeasured(rowIdx);
+                    remeasure = true;
+                }
+            }
+            if (remeasure)
+            {
+                invalidateSizeCache();
+                colWidths.clear();
+                rowHeights.clear();
+                getSizeInfos(columns, rows, colWidths, rowHeights);
+                GridLayoutManager::GetOuterRects(clientRect, colWidths, rowHeights, outerRects);
             }
         }
 
-        if (rowHeights.empty())
+        std::vector<bool> rowsVisible(numRows, true);
+        if (mVirtualized)
         {
-            ReportError("XMLGrid has no rows!");
-            return;
+            for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
+            {
+                rowsVisible[rowIdx] = IsRowVisible(outerRects.get(rowIdx, 0), mScrollOffset, clientRect);
+            }
         }
 
 
         //
-        // Get bounding rect for all cells
-        //
-        GenericGrid<Rect> outerRects(numRows, numCols);
-        Rect clientRect(clientRect());
-        GridLayoutManager::GetOuterRects(clientRect, colWidths, rowHeights, outerRects);
-
-
-        //
-        // Get size info for each cell
+        // Get size info for each cell. Only the cells of the visible rows
+        // are measured.
         //
         GenericGrid<CellInfo> widgetInfos(numRows, numCols, CellInfo(0, 0, Start, Start));
         for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
         {
+            if (!rowsVisible[rowIdx])
+            {
+                continue;
+            }
+
             if (Row * row = rows->children()[rowIdx]->component()->downcast<Row>())
             {
                 for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
@@ -1456,161 +1763,162 @@ namespace XULWin
 
 
         //
-        // Apply inner rect to each widget inside a cell
+        // Apply inner rect to each widget inside a cell. A virtualized grid
+        // only moves the rows that intersect the visible area and hides the
+        // native windows of the others.
         //
+        std::vector<const Component *> rowComponents;
+        std::vector<bool> rowsRealized;
         for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
         {
+            ElementPtr rowEl = rows->children()[rowIdx];
+            Component * rowComponent = rowEl->component();
+            bool visible = rowsVisible[rowIdx];
+
+            // Native windows are created visible.
+            bool sameRow = rowIdx < mPrevRows.size() && mPrevRows[rowIdx] == rowComponent;
+            bool wasRealized = !sameRow || mPrevRowsRealized[rowIdx];
+            if (visible != wasRealized)
+            {
+                SetRealized(rowComponent, visible);
+            }
+            rowComponents.push_back(rowComponent);
+            rowsRealized.push_back(visible);
+
+            if (!visible)
+            {
+                continue;
+            }
+
             for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
             {
-                if (rowIdx < rows->children().size())
+                if (colIdx < rowEl->children().size())
                 {
-                    ElementPtr rowEl = rows->children()[rowIdx];
-                    if (colIdx < rowEl->children().size())
-                    {
-                        Component * child = rowEl->children()[colIdx]->component();
-                        const Rect & r = innerRects.get(rowIdx, colIdx);
-                        child->move(r.x(), r.y(), r.width(), r.height());
-                    }
+                    Component * child = rowEl->children()[colIdx]->component();
+                    Rect r(ScrollRect(innerRects.get(rowIdx, colIdx), mScrollOffset));
+                    child->move(r.x(), r.y(), r.width(), r.height());
                 }
             }
         }
+        mPrevRows.swap(rowComponents);
+        mPrevRowsRealized.swap(rowsRealized);
 
         //
         // Rebuild child layoutss
         //
-        rebuildChildLayouts();
-    }
-
+        if (!mVirtualized)
+        {
+            rebuildChildLayouts();
+            return;
+        }
 
-    Rows::Rows(Component * inParent, const AttributesMapping & inAttr) :
-        VirtualComponent(inParent, inAttr)
-    {
+        // Only the cells of the visible rows are rebuilt.
+        for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
+        {
+            if (mPrevRowsRealized[rowIdx])
+            {
+                rows->children()[rowIdx]->component()->rebuildLayout();
+            }
+        }
+        mNeedsLayout = false;
     }
 
 
-    int Rows::calculateWidth(SizeConstraint inSizeConstraint) const
+    bool Grid::getSizeInfos(const ElementPtr & inColumns,
+                            const ElementPtr & inRows,
+                            std::vector<SizeInfo> & outColWidths,
+                            std::vector<SizeInfo> & outRowHeights)
     {
-        int result = 0;
-
-        std::vector<XMLRow *> rows;
-
-        //
-        // 1. Obtain the list of rows from the grid element
-        //
-        if (Component * grid = parent())
+        for (size_t colIdx = 0; colIdx != inColumns->children().size(); ++colIdx)
         {
-            if (XMLGrid::TagName() == grid->el()->tagName())
+            if (Column * col = inColumns->children()[colIdx]->component()->downcast<Column>())
             {
-                grid->el()->getElementsByType<XMLRow>(rows);
+                outColWidths.push_back(
+                    SizeInfo(FlexWrap(col->getFlex()),
+                             MinSizeWrap(col->getWidth(Minimum)),
+                             OptSizeWrap(col->getWidth(Preferred))));
             }
         }
 
-        //
-        // 2. Get the max row width
-        //
-        result = max_element_value(rows.begin(),
-                                   rows.end(),
-                                   0,
-                                   boost::bind(&Component::getWidth,
-                                               boost::bind(&Element::component, _1),
-                                               inSizeConstraint));
-        return result;
-    }
-
-
-    int Rows::calculateHeight(SizeConstraint inSizeConstraint) const
-    {
-        int result = 0;
+        if (outColWidths.empty())
+        {
+            ReportError("XMLGrid has no columns!");
+            return false;
+        }
 
-        std::vector<XMLRow *> rows;
+        // Rows that were not measured get the average height.
+        std::vector<int> estimatedMinHeights;
+        std::vector<int> estimatedOptHeights;
+        if (mVirtualized)
+        {
+            mRowItems.getSizes(*this, Minimum, estimatedMinHeights);
+            mRowItems.getSizes(*this, Preferred, estimatedOptHeights);
+        }
 
-        //
-        // 1. Obtain the list of rows from the grid element
-        //
-        if (Component * grid = parent())
+        for (size_t rowIdx = 0; rowIdx != inRows->children().size(); ++rowIdx)
         {
-            if (XMLGrid::TagName() == grid->el()->tagName())
+            if (Row * row = inRows->children()[rowIdx]->component()->downcast<Row>())
             {
-                grid->el()->getElementsByType<XMLRow>(rows);
+                if (mVirtualized && !mRowItems.isMeasured(rowIdx))
+                {
+                    outRowHeights.push_back(
+                        SizeInfo(FlexWrap(row->getFlex()),
+                                 MinSizeWrap(estimatedMinHeights[rowIdx]),
+                                 OptSizeWrap(estimatedOptHeights[rowIdx])));
+                    continue;
+                }
+
+                outRowHeights.push_back(
+                    SizeInfo(FlexWrap(row->getFlex()),
+                             MinSizeWrap(row->getHeight(Minimum)),
+                             OptSizeWrap(row->getHeight(Preferred))));
             }
         }
 
-        //
-        // 2. Get the sum of row heights
-        //
-        result = sum_element_values(rows.begin(),
-                                    rows.end(),
-                                    0,
-                                    boost::bind(&Component::getHeight,
-                                                boost::bind(&Element::component, _1),
-                                                inSizeConstraint));
-        return result;
+        if (outRowHeights.empty())
+        {
+            ReportError("XMLGrid has no rows!");
+            return false;
+        }
+        return true;
     }
 
 
-    Columns::Columns(Component * inParent, const AttributesMapping & inAttr) :
+    Rows::Rows(Component * inParent, const AttributesMapping & inAttr) :
         VirtualComponent(inParent, inAttr)
     {
     }
 
 
-    int Columns::calculateWidth(SizeConstraint inSizeConstraint) const
+    int Rows::calculateWidth(SizeConstraint inSizeConstraint) const
     {
-        int result = 0;
+        return calculateMaxChildWidth(inSizeConstraint);
+    }
 
-        std::vector<XMLColumn *> columns;
 
-        //
-        // 1. Obtain the list of columns from the grid element
-        //
-        if (Component * grid = parent())
-        {
-            if (XMLGrid::TagName() == grid->el()->tagName())
-            {
-                grid->el()->getElementsByType<XMLColumn>(columns);
-            }
-        }
-
-        //
-        // 2. Get the max column width
-        //
-        result = sum_element_values(columns.begin(),
-                                    columns.end(),
-                                    0,
-                                    boost::bind(&Component::getWidth,
-                                                boost::bind(&Element::component, _1),
-                                                inSizeConstraint));
-        return result;
+    int Rows::calculateHeight(SizeConstraint inSizeConstraint) const
+    {
+        return calculateSumChildHeights(inSizeConstraint);
     }
 
 
-    int Columns::calculateHeight(SizeConstraint inSizeConstraint) const
+    Columns::Columns(Component * inParent, const AttributesMapping & inAttr) :
+        VirtualComponent(inParent, inAttr)
     {
-        int result = 0;
+        // Size depends on the cells of the grid's rows.
+        mCacheSizes = false;
+    }
 
-        std::vector<XMLColumn *> columns;
 
-        //
-        // 1. Obtain the list of columns from the grid element
-        //
-        if (Component * grid = parent())
-        {
-            if (XMLGrid::TagName() == grid->el()->tagName())
-            {
-                grid->el()->getElementsByType<XMLColumn>(columns);
-            }
-        }
+    int Columns::calculateWidth(SizeConstraint inSizeConstraint) const
+    {
+        return calculateSumChildWidths(inSizeConstraint);
+    }
 
-        //
-        // 2. Get the sum of column heights
-        //
-        result = max_element_value(columns.begin(),
-                                   columns.end(),
-                                   0,
-                                   boost::bind(&Component::getHeight,
-                                               boost::bind(&Element::component, _1),
-                                               inSizeConstraint));
-        return result;
+
+    int Columns::calculateHeight(SizeConstraint inSizeConstraint) const
+    {
+        return calculateMaxChildHeight(inSizeConstraint);
     }
 
 
@@ -1635,6 +1943,8 @@ namespace XULWin
     Column::Column(Component * inParent, const AttributesMapping & inAttr) :
         VirtualComponent(inParent, inAttr)
     {
+        // Width depends on the cells of the grid's rows.
+        mCacheSizes = false;
     }
 
 
@@ -1646,58 +1956,22 @@ namespace XULWin
 
     int Column::calculateWidth(SizeConstraint inSizeConstraint) const
     {
-        // This is a special case: we need to get all rows first and calculate
-        // the width of each row's corresponding column
-        ElementPtr rows;
-        int ownIndex = -1;
-        Element * grid = el()->parent()->parent();
-        for (size_t idx = 0; idx != grid->children().size(); ++idx)
+        // The grid measures the cells of all columns at once.
+        const Element * columns = el()->parent();
+        const Element * grid = columns ? columns->parent() : 0;
+        if (grid && grid->component())
         {
-            ElementPtr child = grid->children()[idx];
-            if (child->tagName() == XMLRows::TagName())
-            {
-                rows = child;
-            }
-            else if (child->tagName() == XMLColumns::TagName())
-            {
-                for (size_t ownI = 0; ownI != child->children().size(); ++ownI)
-                {
-                    if (child->children()[ownI]->component()->componentId() == componentId())
-                    {
-                        ownIndex = ownI;
-                    }
-                }
-            }
-            if (rows && ownIndex != -1)
+            if (const VirtualGrid * virtualGrid = grid->component()->downcast<VirtualGrid>())
             {
-                break;
+                return virtualGrid->getColumnWidth(el(), inSizeConstraint);
             }
-        }
-        if (!rows)
-        {
-            ReportError("Could not find 'rows' element in XMLGrid.");
-            return 0;
-        }
-        if (ownIndex == -1)
-        {
-            ReportError("XMLColumn was unable to find itself in its parent container.");
-            return 0;
-        }
-
-        int res = 0;
-        for (size_t rowIdx = 0; rowIdx != rows->children().size(); ++rowIdx)
-        {
-            ElementPtr row = rows->children()[rowIdx];
-            if (ownIndex < row->children().size())
+            else if (const Grid * nativeGrid = grid->component()->downcast<Grid>())
             {
-                int w = row->children()[ownIndex]->component()->getWidth(inSizeConstraint);
-                if (w > res)
-                {
-                    res = w;
-                }
+                return nativeGrid->getColumnWidth(el(), inSizeConstraint);
             }
         }
-        return res;
+        ReportError("XMLColumn is not part of an XMLGrid.");
+        return 0;
     }
 
 
@@ -2086,6 +2360,7 @@ namespace XULWin
     void GroupBox::setCaption(const std::string & inLabel)
     {
         WinAPI::Window_SetText(mGroupBoxHandle, inLabel);
+        invalidateSizeCache();
     }
 
 
@@ -2106,12 +2381,7 @@ namespace XULWin
     void GroupBox::rebuildLayout()
     {
         Rect clientRect(Super::clientRect());
-        ::MoveWindow(mGroupBoxHandle,
-                     clientRect.x(),
-                     clientRect.y(),
-                     clientRect.width(),
-                     clientRect.height(),
-                     FALSE);
+        LayoutTransaction::MoveWindow(mGroupBoxHandle, clientRect);
         mBoxLayouter.rebuildLayout();
     }
 
@@ -2473,6 +2743,7 @@ namespace XULWin
     void TreeCell::setLabel(const std::string & inLabel)
     {
         mLabel = inLabel;
+        invalidateSizeCache();
     }
 
 
@@ -2545,6 +2816,12 @@ namespace XULWin
         mBoxLayouter.rebuildLayout();
     }
 
+    void Statusbar::onChildRemoved(Component * inChild)
+    {
+        mBoxLayouter.onChildRemoved();
+        Super::onChildRemoved(inChild);
+    }
+
 
     void Statusbar::rebuildChildLayouts()
     {
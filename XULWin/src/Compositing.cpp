@@ -0,0 +1,379 @@
+#include "XULWin/Compositing.h"
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define XULWIN_COMPOSITING_SSE2
+#include <emmintrin.h>
+#include <intrin.h>
+#elif defined(__SSE2__) || defined(__x86_64__)
+// GCC and Clang only define __SSE2__ if the target has SSE2.
+#define XULWIN_COMPOSITING_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace XULWin
+{
+
+    // Multiplies the four channels of a pixel by inFactor / 255, rounded to
+    // the nearest integer. Two channels are processed at a time.
+    static unsigned int ScalePixel(unsigned int inPixel, unsigned int inFactor)
+    {
+        unsigned int rb = (inPixel & 0x00FF00FF) * inFactor + 0x00800080;
+        rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        unsigned int ag = ((inPixel >> 8) & 0x00FF00FF) * inFactor + 0x00800080;
+        ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+        return rb | ag;
+    }
+
+
+    // Interpolates between two pixels. inWeight, in the range [0, 256], is
+    // the weight of inSecond. The results are rounded down.
+    static unsigned int InterpolatePixel(unsigned int inFirst, unsigned int inSecond, unsigned int inWeight)
+    {
+        unsigned int rb = ((inFirst & 0x00FF00FF) * (256 - inWeight) + (inSecond & 0x00FF00FF) * inWeight) >> 8;
+        unsigned int ag = ((inFirst >> 8) & 0x00FF00FF) * (256 - inWeight) + ((inSecond >> 8) & 0x00FF00FF) * inWeight;
+        return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+    }
+
+
+    // Sample positions are 16.16 fixed point values. The first sample is
+    // taken at the center of the first pixel of the scaled image.
+    static void GetSamplePositions(int inSourceSize, int inSize, int & outStart, int & outStep)
+    {
+        outStep = (inSourceSize << 16) / inSize;
+        outStart = outStep / 2 - 0x8000;
+    }
+
+
+    // Splits a sample position into the two source pixels around it and the
+    // weight of the second one. Positions outside the image are clamped.
+    static void GetSample(int inPosition, int inSourceSize, int & outIndex0, int & outIndex1, int & outWeight)
+    {
+        int index = inPosition >> 16;
+        if (inPosition <= 0)
+        {
+            outIndex0 = outIndex1 = 0;
+            outWeight = 0;
+        }
+        else if (index >= inSourceSize - 1)
+        {
+            outIndex0 = outIndex1 = inSourceSize - 1;
+            outWeight = 0;
+        }
+        else
+        {
+            outIndex0 = index;
+            outIndex1 = index + 1;
+            outWeight = (inPosition >> 8) & 0xFF;
+        }
+    }
+
+
+    static void FillSpanScalar(unsigned int * ioPixels, const unsigned char * inCoverage, int inCount, unsigned int inColor)
+    {
+        for (int idx = 0; idx < inCount; ++idx)
+        {
+            unsigned int coverage = inCoverage[idx];
+            if (coverage == 0)
+            {
+                continue;
+            }
+
+            unsigned int source = (coverage == 255) ? inColor : ScalePixel(inColor, coverage);
+            unsigned int sourceAlpha = source >> 24;
+            ioPixels[idx] = (sourceAlpha == 255) ? source : source + ScalePixel(ioPixels[idx], 255 - sourceAlpha);
+        }
+    }
+
+
+    static void BlendRowScalar(unsigned int * ioPixels, const unsigned int * inSource, int inCount)
+    {
+        for (int idx = 0; idx < inCount; ++idx)
+        {
+            unsigned int source = inSource[idx];
+            if (source == 0)
+            {
+                continue;
+            }
+
+            unsigned int sourceAlpha = source >> 24;
+            ioPixels[idx] = (sourceAlpha == 255) ? source : source + ScalePixel(ioPixels[idx], 255 - sourceAlpha);
+        }
+    }
+
+
+    static void ScaleRowScalar(const unsigned int * inRow0,
+                               const unsigned int * inRow1,
+                               int inSourceWidth,
+                               int inWeightY,
+                               unsigned int * outRow,
+                               int inWidth)
+    {
+        int start = 0;
+        int step = 0;
+        GetSamplePositions(inSourceWidth, inWidth, start, step);
+        for (int x = 0; x < inWidth; ++x)
+        {
+            int x0 = 0;
+            int x1 = 0;
+            int weightX = 0;
+            GetSample(start + x * step, inSourceWidth, x0, x1, weightX);
+            unsigned int top = InterpolatePixel(inRow0[x0], inRow0[x1], weightX);
+            unsigned int bottom = InterpolatePixel(inRow1[x0], inRow1[x1], weightX);
+            outRow[x] = InterpolatePixel(top, bottom, inWeightY);
+        }
+    }
+
+
+    static const CompositingKernels cScalarKernels =
+    {
+        &FillSpanScalar,
+        &BlendRowScalar,
+        &ScaleRowScalar
+    };
+
+
+#ifdef XULWIN_COMPOSITING_SSE2
+
+    // The SSE2 kernels unpack pixels to 16 bits per channel, so that one
+    // register holds two pixels. They use the same arithmetic as the scalar
+    // kernels and leave the tails of the rows to them.
+
+    // SSE2 version of ScalePixel, for eight channels.
+    static inline __m128i ScaleChannels(__m128i inChannels, __m128i inFactors)
+    {
+        __m128i product = _mm_add_epi16(_mm_mullo_epi16(inChannels, inFactors), _mm_set1_epi16(0x80));
+        return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+    }
+
+
+    // Source over for two pixels.
+    static inline __m128i BlendChannels(__m128i inSource, __m128i inDestination)
+    {
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(inSource, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i inverseAlpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        return _mm_add_epi16(inSource, ScaleChannels(inDestination, inverseAlpha));
+    }
+
+
+    static void FillSpanSSE2(unsigned int * ioPixels, const unsigned char * inCoverage, int inCount, unsigned int inColor)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i colorPixels = _mm_set1_epi32(static_cast<int>(inColor));
+        const __m128i color = _mm_unpacklo_epi8(colorPixels, zero);
+        const bool isOpaque = (inColor >> 24) == 255;
+
+        int idx = 0;
+        for (; idx + 4 <= inCount; idx += 4)
+        {
+            int coverage4 = 0;
+            std::memcpy(&coverage4, inCoverage + idx, sizeof(coverage4));
+            if (coverage4 == 0)
+            {
+                continue;
+            }
+
+            __m128i * pixels = reinterpret_cast<__m128i *>(ioPixels + idx);
+            if (coverage4 == -1 && isOpaque)
+            {
+                _mm_storeu_si128(pixels, colorPixels);
+                continue;
+            }
+
+            // Spread the coverage of each pixel over its four channels.
+            __m128i coverage = _mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage4), zero);
+            coverage = _mm_unpacklo_epi16(coverage, coverage);
+            __m128i coverageLow = _mm_unpacklo_epi32(coverage, coverage);
+            __m128i coverageHigh = _mm_unpackhi_epi32(coverage, coverage);
+
+            __m128i destination = _mm_loadu_si128(pixels);
+            __m128i low = BlendChannels(ScaleChannels(color, coverageLow), _mm_unpacklo_epi8(destination, zero));
+            __m128i high = BlendChannels(ScaleChannels(color, coverageHigh), _mm_unpackhi_epi8(destination, zero));
+            _mm_storeu_si128(pixels, _mm_packus_epi16(low, high));
+        }
+        FillSpanScalar(ioPixels + idx, inCoverage + idx, inCount - idx, inColor);
+    }
+
+
+    static void BlendRowSSE2(unsigned int * ioPixels, const unsigned int * inSource, int inCount)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+        int idx = 0;
+        for (; idx + 4 <= inCount; idx += 4)
+        {
+            __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inSource + idx));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(source, zero)) == 0xFFFF)
+            {
+                continue;
+            }
+
+            __m128i * pixels = reinterpret_cast<__m128i *>(ioPixels + idx);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(source, alphaMask), alphaMask)) == 0xFFFF)
+            {
+                _mm_storeu_si128(pixels, source);
+                continue;
+            }
+
+            __m128i destination = _mm_loadu_si128(pixels);
+            __m128i low = BlendChannels(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero));
+            __m128i high = BlendChannels(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero));
+            _mm_storeu_si128(pixels, _mm_packus_epi16(low, high));
+        }
+        BlendRowScalar(ioPixels + idx, inSource + idx, inCount - idx);
+    }
+
+
+    // Interpolates between the channels in the low halves of inFirst and
+    // inSecond. inWeights holds the weights of both, interleaved. Returns
+    // the results as 32-bit values.
+    static inline __m128i InterpolateChannels(__m128i inFirst, __m128i inSecond, __m128i inWeights)
+    {
+        return _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(inFirst, inSecond), inWeights), 8);
+    }
+
+
+    static inline __m128i GetWeights(int inWeight)
+    {
+        return _mm_set1_epi32((inWeight << 16) | (256 - inWeight));
+    }
+
+
+    static void ScaleRowSSE2(const unsigned int * inRow0,
+                             const unsigned int * inRow1,
+                             int inSourceWidth,
+                             int inWeightY,
+                             unsigned int * outRow,
+                             int inWidth)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i weightsY = GetWeights(inWeightY);
+
+        int start = 0;
+        int step = 0;
+        GetSamplePositions(inSourceWidth, inWidth, start, step);
+        for (int x = 0; x < inWidth; ++x)
+        {
+            int x0 = 0;
+            int x1 = 0;
+            int weightX = 0;
+            GetSample(start + x * step, inSourceWidth, x0, x1, weightX);
+
+            __m128i weightsX = GetWeights(weightX);
+            __m128i top = InterpolateChannels(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(inRow0[x0])), zero),
+                                              _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(inRow0[x1])), zero),
+                                              weightsX);
+            __m128i bottom = InterpolateChannels(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(inRow1[x0])), zero),
+                                                 _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(inRow1[x1])), zero),
+                                                 weightsX);
+
+            // Both fit in 16 bits: interleave them for the vertical pass.
+            __m128i result = _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(top, _mm_slli_epi32(bottom, 16)), weightsY), 8);
+            result = _mm_packs_epi32(result, result);
+            outRow[x] = static_cast<unsigned int>(_mm_cvtsi128_si32(_mm_packus_epi16(result, result)));
+        }
+    }
+
+
+    static const CompositingKernels cSSE2Kernels =
+    {
+        &FillSpanSSE2,
+        &BlendRowSSE2,
+        &ScaleRowSSE2
+    };
+
+
+    static bool HasSSE2()
+    {
+#if defined(_M_X64) || !defined(_M_IX86)
+        return true;
+#else
+        int info[4] = { 0, 0, 0, 0 };
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#endif
+    }
+
+#endif // XULWIN_COMPOSITING_SSE2
+
+
+    bool IsCompositingKernelSetSupported(CompositingKernelSet inKernelSet)
+    {
+        switch (inKernelSet)
+        {
+            case CompositingKernelSet_Scalar:
+            {
+                return true;
+            }
+            case CompositingKernelSet_SSE2:
+            {
+#ifdef XULWIN_COMPOSITING_SSE2
+                static const bool fHasSSE2 = HasSSE2();
+                return fHasSSE2;
+#else
+                return false;
+#endif
+            }
+        }
+        return false;
+    }
+
+
+    const CompositingKernels & GetCompositingKernels(CompositingKernelSet inKernelSet)
+    {
+        // Without XULWIN_COMPOSITING_SSE2 the SSE2 set is never supported.
+        if (inKernelSet == CompositingKernelSet_SSE2 && IsCompositingKernelSetSupported(inKernelSet))
+        {
+#ifdef XULWIN_COMPOSITING_SSE2
+            return cSSE2Kernels;
+#endif
+        }
+        return cScalarKernels;
+    }
+
+
+    const CompositingKernels & GetCompositingKernels()
+    {
+        return GetCompositingKernels(CompositingKernelSet_SSE2);
+    }
+
+
+    void ScaleImageBilinear(const unsigned int * inSource, int inSourceWidth, int inSourceHeight, int inSourceStride,
+                            unsigned int * outPixels, int inWidth, int inHeight, int inStride)
+    {
+        ScaleImageBilinear(GetCompositingKernels(),
+                           inSource, inSourceWidth, inSourceHeight, inSourceStride,
+                           outPixels, inWidth, inHeight, inStride);
+    }
+
+
+    void ScaleImageBilinear(const CompositingKernels & inKernels,
+                            const unsigned int * inSource, int inSourceWidth, int inSourceHeight, int inSourceStride,
+                            unsigned int * outPixels, int inWidth, int inHeight, int inStride)
+    {
+        if (inSourceWidth <= 0 || inSourceHeight <= 0 || inWidth <= 0 || inHeight <= 0)
+        {
+            return;
+        }
+
+        int start = 0;
+        int step = 0;
+        GetSamplePositions(inSourceHeight, inHeight, start, step);
+        for (int y = 0; y < inHeight; ++y)
+        {
+            int y0 = 0;
+            int y1 = 0;
+            int weightY = 0;
+            GetSample(start + y * step, inSourceHeight, y0, y1, weightY);
+            inKernels.scaleRow(inSource + y0 * inSourceStride,
+                               inSource + y1 * inSourceStride,
+                               inSourceWidth,
+                               weightY,
+                               outPixels + y * inStride,
+                               inWidth);
+        }
+    }
+
+} // namespace XULWin
@@ -4,6 +4,7 @@
 #include "XULWin/Element.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/NativeControl.h"
+#include "XULWin/StyleDeclarations.h"
 #include "XULWin/Window.h"
 #include <boost/bind.hpp>
 
@@ -30,7 +31,11 @@ namespace XULWin
         mCSSHeight(0),
         mCSSFill(RGBColor()),
         mCSSStroke(RGBColor(0, 0, 0, 0)),
-        mIsInitialized(false)
+        mIsInitialized(false),
+        mNeedsLayout(true),
+        mCacheSizes(true),
+        mAttributeControllers(0),
+        mStyleControllers(0)
     {
         mCSSX.setInvalid();
         mCSSY.setInvalid();
@@ -256,6 +261,7 @@ namespace XULWin
     void ConcreteComponent::setCSSWidth(int inWidth)
     {
         mCSSWidth = inWidth;
+        invalidateSizeCache();
     }
 
 
@@ -296,6 +302,7 @@ namespace XULWin
     void ConcreteComponent::setCSSHeight(int inHeight)
     {
         mCSSHeight = inHeight;
+        invalidateSizeCache();
     }
 
 
@@ -317,6 +324,7 @@ namespace XULWin
     void ConcreteComponent::setWidth(int inWidth)
     {
         mWidth = inWidth;
+        invalidateSizeCache();
     }
 
 
@@ -339,6 +347,7 @@ namespace XULWin
     void ConcreteComponent::setHeight(int inHeight)
     {
         mHeight = inHeight;
+        invalidateSizeCache();
     }
 
 
@@ -395,6 +404,7 @@ namespace XULWin
     void ConcreteComponent::setFlex(int inFlex)
     {
         mFlex = inFlex;
+        invalidateSizeCache();
     }
 
 
@@ -411,6 +421,7 @@ namespace XULWin
         {
             getChild(idx)->setHidden(inHidden);
         }
+        invalidateSizeCache();
     }
 
 
@@ -423,6 +434,7 @@ namespace XULWin
     void ConcreteComponent::setOrient(Orient inOrient)
     {
         mOrient = inOrient;
+        invalidateSizeCache();
     }
 
 
@@ -435,6 +447,7 @@ namespace XULWin
     void ConcreteComponent::setAlign(Align inAlign)
     {
         mAlign = inAlign;
+        invalidateSizeCache();
     }
 
 
@@ -473,7 +486,9 @@ namespace XULWin
         else
         {
             ReportError("No decorator found!");
+            return;
         }
+        invalidateSizeCache();
     }
 
 
@@ -489,7 +504,17 @@ namespace XULWin
             return mWidth.getValue();
         }
 
-        return calculateWidth(inSizeConstraint);
+        if (!mCacheSizes)
+        {
+            return calculateWidth(inSizeConstraint);
+        }
+
+        Fallible<int> & cachedWidth = mCachedWidths[inSizeConstraint];
+        if (!cachedWidth.isValid())
+        {
+            cachedWidth = calculateWidth(inSizeConstraint);
+        }
+        return cachedWidth.getValue();
     }
 
 
@@ -505,7 +530,51 @@ namespace XULWin
             return mHeight.getValue();
         }
 
-        return calculateHeight(inSizeConstraint);
+        if (!mCacheSizes)
+        {
+            return calculateHeight(inSizeConstraint);
+        }
+
+        Fallible<int> & cachedHeight = mCachedHeights[inSizeConstraint];
+        if (!cachedHeight.isValid())
+        {
+            cachedHeight = calculateHeight(inSizeConstraint);
+        }
+        return cachedHeight.getValue();
+    }
+
+
+    void ConcreteComponent::invalidateSizeCache()
+    {
+        for (size_t idx = 0; idx <= Maximum; ++idx)
+        {
+            mCachedWidths[idx].setInvalid();
+            mCachedHeights[idx].setInvalid();
+        }
+
+        // The size of our parent depends on our size.
+        if (mParent)
+        {
+            mParent->invalidateSizeCache();
+        }
+    }
+
+
+    bool ConcreteComponent::isSizeCacheValid() const
+    {
+        for (size_t idx = 0; idx <= Maximum; ++idx)
+        {
+            SizeConstraint sizeConstraint = static_cast<SizeConstraint>(idx);
+            if (mCachedWidths[idx].isValid() && mCachedWidths[idx].getValue() != calculateWidth(sizeConstraint))
+            {
+                return false;
+            }
+            if (mCachedHeights[idx].isValid() && mCachedHeights[idx].getValue() != calculateHeight(sizeConstraint))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
 
@@ -517,10 +586,8 @@ namespace XULWin
 
     bool ConcreteComponent::getStyle(const std::string & inName, std::string & outValue)
     {
-        StyleControllers::iterator it = mStyleControllers.find(inName);
-        if (it != mStyleControllers.end())
+        if (StyleController * controller = findStyleController(inName))
         {
-            StyleController * controller = it->second;
             controller->get(outValue);
         }
         return false;
@@ -529,10 +596,9 @@ namespace XULWin
 
     bool ConcreteComponent::getAttribute(const std::string & inName, std::string & outValue)
     {
-        AttributeControllers::iterator it = mAttributeControllers.find(inName);
-        if (it != mAttributeControllers.end())
+        if (AttributeController * controller = findAttributeController(inName))
         {
-            it->second->get(outValue);
+            controller->get(outValue);
             return true;
         }
         return false;
@@ -541,10 +607,8 @@ namespace XULWin
 
     bool ConcreteComponent::setStyle(const std::string & inName, const std::string & inValue)
     {
-        StyleControllers::iterator it = mStyleControllers.find(inName);
-        if (it != mStyleControllers.end())
+        if (StyleController * controller = findStyleController(inName))
         {
-            StyleController * controller = it->second;
             controller->set(inValue);
             return true;
         }
@@ -552,12 +616,44 @@ namespace XULWin
     }
 
 
+    bool ConcreteComponent::setStyle(const StyleDeclaration & inDeclaration)
+    {
+        if (StyleController * controller = findStyleController(inDeclaration.name()))
+        {
+            controller->set(inDeclaration);
+            return true;
+        }
+        return false;
+    }
+
+
     bool ConcreteComponent::setAttribute(const std::string & inName, const std::string & inValue)
     {
-        AttributeControllers::iterator it = mAttributeControllers.find(inName);
-        if (it != mAttributeControllers.end())
+        if (AttributeController * controller = findAttributeController(inName))
+        {
+            controller->set(inValue);
+            return true;
+        }
+        return false;
+    }
+
+
+    bool ConcreteComponent::getAttributeValue(const std::string & inName, AttributeValue & outValue)
+    {
+        if (AttributeController * controller = findAttributeController(inName))
+        {
+            controller->get(outValue);
+            return true;
+        }
+        return false;
+    }
+
+
+    bool ConcreteComponent::setAttributeValue(const std::string & inName, const AttributeValue & inValue)
+    {
+        if (AttributeController * controller = findAttributeController(inName))
         {
-            it->second->set(inValue);
+            controller->set(inValue);
             return true;
         }
         return false;
@@ -574,6 +670,10 @@ namespace XULWin
         setAttributeController<OrientController>(this);
         setAttributeController<ScreenXController>(this);
         setAttributeController<ScreenYController>(this);
+
+        // Subclasses register their controllers before calling this, so the
+        // table of this class is complete now.
+        mAttributeControllers->setComplete();
         return true;
     }
 
@@ -589,10 +689,34 @@ namespace XULWin
         setStyleController<CSSBackgroundColorController>(this);
         setStyleController<CSSFillController>(this);
         setStyleController<CSSStrokeController>(this);
+
+        // Subclasses register their controllers before calling this, so the
+        // table of this class is complete now.
+        mStyleControllers->setComplete();
         return true;
     }
 
 
+    AttributeController * ConcreteComponent::findAttributeController(const std::string & inName)
+    {
+        if (!mAttributeControllers)
+        {
+            return 0;
+        }
+        return mAttributeControllers->find(this, inName);
+    }
+
+
+    StyleController * ConcreteComponent::findStyleController(const std::string & inName)
+    {
+        if (!mStyleControllers)
+        {
+            return 0;
+        }
+        return mStyleControllers->find(this, inName);
+    }
+
+
     void ConcreteComponent::move(const Rect & inRect)
     {
         move(inRect.x(), inRect.y(), inRect.width(), inRect.height());
@@ -619,19 +743,63 @@ namespace XULWin
 
     void ConcreteComponent::rebuildChildLayouts()
     {
-        if (!mElement)
+        if (mElement)
         {
-            return;
+            for (size_t idx = 0; idx != mElement->children().size(); ++idx)
+            {
+                Component * nativeComp = mElement->children()[idx]->component();
+                if (nativeComp)
+                {
+                    nativeComp->rebuildLayout();
+                }
+            }
         }
 
-        for (size_t idx = 0; idx != mElement->children().size(); ++idx)
+        // Cleared last, because moving the children during the layout pass
+        // also invalidates the layouts of their ancestors.
+        mNeedsLayout = false;
+    }
+
+
+    void ConcreteComponent::rebuildInvalidatedChildLayouts()
+    {
+        if (mElement)
         {
-            Component * nativeComp = mElement->children()[idx]->component();
-            if (nativeComp)
+            for (size_t idx = 0; idx != mElement->children().size(); ++idx)
             {
-                nativeComp->rebuildLayout();
+                Component * nativeComp = mElement->children()[idx]->component();
+                if (nativeComp && nativeComp->needsLayout())
+                {
+                    nativeComp->rebuildLayout();
+                }
             }
         }
+        mNeedsLayout = false;
+    }
+
+
+    void ConcreteComponent::invalidateLayout()
+    {
+        mNeedsLayout = true;
+        if (mParent)
+        {
+            mParent->invalidateLayout();
+        }
+    }
+
+
+    bool ConcreteComponent::needsLayout() const
+    {
+        return mNeedsLayout;
+    }
+
+
+    void ConcreteComponent::updateLayout()
+    {
+        if (mNeedsLayout)
+        {
+            rebuildLayout();
+        }
     }
 
 } // namespace XULWin
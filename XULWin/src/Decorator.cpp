@@ -625,6 +625,27 @@ namespace XULWin
     }
 
 
+    void Decorator::invalidateSizeCache()
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            mDecoratedComponent->invalidateSizeCache();
+        }
+    }
+
+
+    bool Decorator::isSizeCacheValid() const
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            return mDecoratedComponent->isSizeCacheValid();
+        }
+        return true;
+    }
+
+
     bool Decorator::expansive() const
     {
         assert(mDecoratedComponent);
@@ -720,6 +741,37 @@ namespace XULWin
     }
 
 
+    void Decorator::invalidateLayout()
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            mDecoratedComponent->invalidateLayout();
+        }
+    }
+
+
+    bool Decorator::needsLayout() const
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            return mDecoratedComponent->needsLayout();
+        }
+        return false;
+    }
+
+
+    void Decorator::updateLayout()
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            mDecoratedComponent->updateLayout();
+        }
+    }
+
+
     bool Decorator::getAttribute(const std::string & inName, std::string & outValue)
     {
         assert(mDecoratedComponent);
@@ -753,6 +805,17 @@ namespace XULWin
     }
 
 
+    bool Decorator::setStyle(const StyleDeclaration & inDeclaration)
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            return mDecoratedComponent->setStyle(inDeclaration);
+        }
+        return false;
+    }
+
+
     bool Decorator::setAttribute(const std::string & inName, const std::string & inValue)
     {
         assert(mDecoratedComponent);
@@ -764,6 +827,28 @@ namespace XULWin
     }
 
 
+    bool Decorator::getAttributeValue(const std::string & inName, AttributeValue & outValue)
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            return mDecoratedComponent->getAttributeValue(inName, outValue);
+        }
+        return false;
+    }
+
+
+    bool Decorator::setAttributeValue(const std::string & inName, const AttributeValue & inValue)
+    {
+        assert(mDecoratedComponent);
+        if (mDecoratedComponent)
+        {
+            return mDecoratedComponent->setAttributeValue(inName, inValue);
+        }
+        return false;
+    }
+
+
     bool Decorator::initAttributeControllers()
     {
         assert(mDecoratedComponent);
@@ -4,7 +4,9 @@
 #include "XULWin/Defaults.h"
 #include "XULWin/Element.h"
 #include "XULWin/Elements.h"
+#include "XULWin/LayoutTransaction.h"
 #include "XULWin/Types.h"
+#include "XULWin/Viewport.h"
 #include "XULWin/XMLWindow.h"
 #include "XULWin/WinUtils.h"
 #include "XULWin/Gdiplus.h"
@@ -281,9 +283,57 @@ namespace XULWin
     }
 
 
+    Viewport * ScrollDecorator::getVirtualizedViewport()
+    {
+        Viewport * viewport = mDecoratedComponent->downcast<Viewport>();
+        if (viewport && viewport->isVirtualized())
+        {
+            return viewport;
+        }
+        return 0;
+    }
+
+
+    Point ScrollDecorator::getScrollOffset() const
+    {
+        int x = 0;
+        int y = 0;
+        if (mHorizontalScrollbar)
+        {
+            const Scrollbar * hscrollbar = mHorizontalScrollbar->component()->downcast<Scrollbar>();
+            int minHorSize = mDecoratedComponent->getWidth(Minimum);
+            int horScrollPos = WinAPI::Scrollbar_GetPos(hscrollbar->handle());
+            double horRatio = (double)horScrollPos/(double)Defaults::Attributes::maxpos();
+            x = (int)((horRatio * (double)minHorSize) + 0.5);
+        }
+
+        if (mVerticalScrollbar)
+        {
+            const Scrollbar * vscrollbar = mVerticalScrollbar->component()->downcast<Scrollbar>();
+            int minVerSize = mDecoratedComponent->getHeight(Minimum);
+            int verScrollPos = WinAPI::Scrollbar_GetPos(vscrollbar->handle());
+            double verRatio = (double)verScrollPos/(double)Defaults::Attributes::maxpos();
+            y = (int)((verRatio * (double)minVerSize) + 0.5);
+        }
+        return Point(x, y);
+    }
+
+
     void ScrollDecorator::rebuildLayout()
     {
-        bool refreshScroll = mOldHorScrollPos != 0 || mOldVerScrollPos != 0;
+        // A virtualized viewport positions its children at their scrolled
+        // positions itself, so there is nothing to scroll back.
+        Viewport * viewport = getVirtualizedViewport();
+        bool refreshScroll = !viewport && (mOldHorScrollPos != 0 || mOldVerScrollPos != 0);
+        if (refreshScroll)
+        {
+            // Scroll the children back to their unscrolled positions first.
+            // The layout pass only moves the children whose rect has changed.
+            if (NativeComponent * native = mDecoratedComponent->downcast<NativeComponent>())
+            {
+                ::ScrollWindowEx(native->handle(), mOldHorScrollPos, mOldVerScrollPos, 0, 0, 0, 0, SW_SCROLLCHILDREN);
+            }
+        }
 
         Rect clientRect(clientRect());
         if (mOverflowX != CSSOverflow_Hidden)
@@ -305,11 +355,26 @@ namespace XULWin
             mOldVerScrollPos = 0;
         }
 
+        if (viewport)
+        {
+            viewport->setScrollOffset(getScrollOffset());
+        }
+
         Super::rebuildLayout();
         mOldHorScrollPos = 0;
         mOldVerScrollPos = 0;
+        if (viewport)
+        {
+            // The size of a virtualized viewport is an estimate that
+            // changes when more children are measured.
+            updateHorizontalScrollInfo();
+            updateVerticalScrollInfo();
+        }
         if (refreshScroll)
         {
+            // Scrolling moves the child windows, so they must be
+            // at their new positions first.
+            LayoutTransaction::Flush();
             updateWindowScroll();
         }
     }
@@ -432,41 +497,25 @@ namespace XULWin
             return;
         }
 
-        if (NativeComponent * native = mDecoratedComponent->downcast<NativeComponent>())
+        // A virtualized viewport only lays out the children that are
+        // scrolled into view, instead of scrolling all child windows.
+        if (Viewport * viewport = getVirtualizedViewport())
         {
-            Rect clientRect(mDecoratedComponent->clientRect());
-
-            int newHorScrollPos = 0;
-            int newVerScrollPos = 0;
-            int dx = 0;
-            int dy = 0;
-
-            if (mHorizontalScrollbar)
-            {
-                Scrollbar * hscrollbar = mHorizontalScrollbar->component()->downcast<Scrollbar>();
-                int minHorSize = mDecoratedComponent->getWidth(Minimum);
-                int horScrollPos = WinAPI::Scrollbar_GetPos(hscrollbar->handle());
-                double horRatio = (double)horScrollPos/(double)Defaults::Attributes::maxpos();
-                newHorScrollPos = (int)((horRatio * (double)minHorSize) + 0.5);
-                dx = newHorScrollPos - mOldHorScrollPos;
-            }
-
-            if (mVerticalScrollbar)
-            {
-                Scrollbar * vscrollbar = mVerticalScrollbar->component()->downcast<Scrollbar>();
-                int minVerSize = mDecoratedComponent->getHeight(Minimum);
-                int verScrollPos = WinAPI::Scrollbar_GetPos(vscrollbar->handle());
-                double verRatio = (double)verScrollPos/(double)Defaults::Attributes::maxpos();
-                newVerScrollPos = (int)((verRatio * (double)minVerSize) + 0.5);
-                dy = newVerScrollPos - mOldVerScrollPos;
-            }
+            viewport->setScrollOffset(getScrollOffset());
+            mDecoratedComponent->rebuildLayout();
+            updateHorizontalScrollInfo();
+            updateVerticalScrollInfo();
+            return;
+        }
 
-            if (NativeComponent * native = mDecoratedComponent->downcast<NativeComponent>())
-            {
-                ::ScrollWindowEx(native->handle(), -dx, -dy, 0, 0, 0, 0, SW_SCROLLCHILDREN | SW_INVALIDATE);
-            }
-            mOldHorScrollPos = newHorScrollPos;
-            mOldVerScrollPos = newVerScrollPos;
+        if (NativeComponent * native = mDecoratedComponent->downcast<NativeComponent>())
+        {
+            Point scrollOffset(getScrollOffset());
+            int dx = mHorizontalScrollbar ? scrollOffset.x() - mOldHorScrollPos : 0;
+            int dy = mVerticalScrollbar ? scrollOffset.y() - mOldVerScrollPos : 0;
+            ::ScrollWindowEx(native->handle(), -dx, -dy, 0, 0, 0, 0, SW_SCROLLCHILDREN | SW_INVALIDATE);
+            mOldHorScrollPos = scrollOffset.x();
+            mOldVerScrollPos = scrollOffset.y();
         }
     }
 
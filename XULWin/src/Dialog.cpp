@@ -157,11 +157,31 @@ namespace XULWin
     }
 
 
+    void Dialog::invalidateLayout()
+    {
+        bool scheduled = needsLayout();
+        Super::invalidateLayout();
+        if (!scheduled)
+        {
+            ::PostMessage(handle(), WM_XULWIN_UPDATELAYOUT, 0, 0);
+        }
+    }
+
+
     void Dialog::rebuildLayout()
     {
+        // Moving the children invalidates our layout. Mark it invalid up
+        // front so that this doesn't schedule another layout pass.
+        mNeedsLayout = true;
         mBoxLayouter->rebuildLayout();
     }
 
+    void Dialog::onChildRemoved(Component * inChild)
+    {
+        mBoxLayouter->onChildRemoved();
+        Super::onChildRemoved(inChild);
+    }
+
 
     Orient Dialog::getOrient() const
     {
@@ -283,6 +303,12 @@ namespace XULWin
                 invalidateRect();
                 return 0;
             }
+            case WM_XULWIN_UPDATELAYOUT:
+            {
+                updateLayout();
+                invalidateRect();
+                return 0;
+            }
             case WM_CLOSE:
             {
                 endModal(DialogResult_Cancel);
@@ -7,16 +7,140 @@
 #include "XULWin/ElementFactory.h"
 #include "XULWin/Enums.h"
 #include "XULWin/ErrorReporter.h"
+#include "XULWin/StyleDeclarations.h"
 #include "XULWin/WinUtils.h"
 #include <boost/bind.hpp>
+#include <cassert>
 
 
 namespace XULWin
 {
 
+    // Attributes and styles that the layout managers read directly. Changing
+    // them can move the component, or its siblings, without changing its size.
+    static bool IsLayoutProperty(const std::string & inName)
+    {
+        static const char * cNames[] =
+        {
+            "flex", "orient", "align", "hidden", "selectedIndex", "virtualize", "x", "y"
+        };
+        for (size_t idx = 0; idx != sizeof(cNames) / sizeof(cNames[0]); ++idx)
+        {
+            if (inName == cNames[idx])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    /**
+     * Invalidates the layout of a component after one of its attributes or
+     * styles was set through a controller, but only if that can change the
+     * geometry: the property is read by the layout managers, or the minimum
+     * or preferred size of the component is different afterwards. Something
+     * like the value of a textbox of fixed width doesn't cause a layout pass.
+     *
+     * The sizes are read through the size cache, so a controller that
+     * changes the size of its component must invalidate the cache. Debug
+     * builds check this without clearing the cache.
+     */
+    class LayoutChangeGuard
+    {
+    public:
+        LayoutChangeGuard(Component * inComponent, const std::string & inName) :
+            mComponent(inComponent),
+            mCompareSizes(false)
+        {
+            // No need to check if a layout pass is already pending.
+            if (!mComponent || mComponent->needsLayout())
+            {
+                mComponent = 0;
+            }
+            else if (!IsLayoutProperty(inName))
+            {
+                mSizes = Sizes(mComponent);
+                mCompareSizes = true;
+            }
+        }
+
+        // Call after the controller has accepted the new value.
+        void commit()
+        {
+            if (!mComponent)
+            {
+                return;
+            }
+
+            if (!mCompareSizes || sizesChanged())
+            {
+                mComponent->invalidateLayout();
+            }
+        }
+
+    private:
+        struct Sizes
+        {
+            Sizes() :
+                width(0),
+                height(0),
+                minWidth(0),
+                minHeight(0)
+            {
+            }
+
+            Sizes(const Component * inComponent) :
+                width(inComponent->getWidth()),
+                height(inComponent->getHeight()),
+                minWidth(inComponent->getWidth(Minimum)),
+                minHeight(inComponent->getHeight(Minimum))
+            {
+            }
+
+            bool operator==(const Sizes & rhs) const
+            {
+                return width == rhs.width
+                    && height == rhs.height
+                    && minWidth == rhs.minWidth
+                    && minHeight == rhs.minHeight;
+            }
+
+            int width;
+            int height;
+            int minWidth;
+            int minHeight;
+        };
+
+        bool sizesChanged() const
+        {
+            Sizes sizes(mComponent);
+
+            // Compares the cached sizes with freshly calculated ones. If
+            // they differ, the controller changed the size without
+            // invalidating the size cache. The cache is left as it is, so
+            // debug builds run with the same warm cache as release builds.
+            assert(mComponent->isSizeCacheValid());
+            return !(sizes == mSizes);
+        }
+
+        Component * mComponent;
+        Sizes mSizes;
+        bool mCompareSizes;
+    };
+
+
     Element::Element(const std::string & inType, Element * inParent, Component * inNative) :
         mType(inType),
         mParent(inParent),
+        mAttributes(inParent ? inParent->mAttributes.arena() : AttributeArenaPtr(new AttributeArena)),
+        mDocument(inParent ? inParent->mDocument : this),
+        mNextWithSameId(0),
+        mTagId(cNoTagId),
+        mPosition(0),
+        mLastPosition(0),
+        mNextPosition(0),
+        mTagIndexInDocumentOrder(true),
         mComponent(inNative)
     {
         if (mComponent)
@@ -31,12 +155,66 @@ namespace XULWin
         // Children require parent access while destructing.
         // So we destruct them while parent still alive.
         mChildren.clear();
+
+        unregisterTag();
+        unregisterId();
+    }
+
+
+    typedef std::map<std::string, Element::TagId> TagIds;
+
+
+    static TagIds & GetTagIds()
+    {
+        static TagIds fTagIds;
+        return fTagIds;
+    }
+
+
+    Element::TagId Element::InternTagName(const std::string & inTagName)
+    {
+        TagIds & tagIds = GetTagIds();
+        TagIds::iterator it = tagIds.find(inTagName);
+        if (it != tagIds.end())
+        {
+            return it->second;
+        }
+
+        TagId result = static_cast<TagId>(tagIds.size());
+        tagIds.insert(std::make_pair(inTagName, result));
+        return result;
+    }
+
+
+    Element::TagId Element::FindTagId(const std::string & inTagName)
+    {
+        const TagIds & tagIds = GetTagIds();
+        TagIds::const_iterator it = tagIds.find(inTagName);
+        return it != tagIds.end() ? it->second : cNoTagId;
+    }
+
+
+    void Element::Initialize(ElementPtr inElement,
+                             TagId inTagId,
+                             Element * inParent,
+                             const AttributesMapping & inAttr)
+    {
+        inElement->registerTag(inTagId);
+        inElement->initAttributeControllers();
+        inElement->setAttributes(inAttr);
+        inElement->initStyleControllers();
+        inElement->setStyles(inAttr);
+        if (inParent)
+        {
+            // The addChild() method also calls Component::onChildAdded
+            inParent->addChild(inElement);
+        }
     }
 
 
     bool Element::init()
     {
-        return component()->init();
+        return mComponent ? mComponent->init() : true;
     }
 
 
@@ -46,13 +224,50 @@ namespace XULWin
     }
 
 
+    Element::TagId Element::tagId() const
+    {
+        return mTagId;
+    }
+
+
+    // Returns true if the text is empty or consists of whitespace only, like
+    // the indentation between the child tags of most elements.
+    static bool IsBlank(const std::string & inText)
+    {
+        return inText.find_first_not_of(" \t\r\n") == std::string::npos;
+    }
+
+
     void Element::setInnerText(const std::string & inText)
     {
+        if (IsBlank(inText))
+        {
+            mInnerText.reset();
+            return;
+        }
+        mInnerText.reset(new std::string(inText));
+    }
+
+
+    void Element::setInnerText(const boost::shared_ptr<const std::string> & inText)
+    {
+        if (inText && IsBlank(*inText))
+        {
+            mInnerText.reset();
+            return;
+        }
         mInnerText = inText;
     }
 
 
     const std::string & Element::innerText() const
+    {
+        static const std::string fEmpty;
+        return mInnerText ? *mInnerText : fEmpty;
+    }
+
+
+    boost::shared_ptr<const std::string> Element::sharedInnerText() const
     {
         return mInnerText;
     }
@@ -60,49 +275,208 @@ namespace XULWin
 
     Element * Element::getElementById(const std::string & inId)
     {
-        struct Helper
+        Element * doc = mDocument;
+        IdIndex::iterator it = doc->mIdIndex.find(inId);
+        if (it == doc->mIdIndex.end())
+        {
+            return 0;
+        }
+
+        if (!doc->mTagIndexInDocumentOrder)
+        {
+            doc->reindexTags();
+        }
+
+        for (Element * el = it->second; el != 0; el = el->mNextWithSameId)
+        {
+            if (el->isDescendantOf(this))
+            {
+                return el;
+            }
+        }
+        return 0;
+    }
+
+
+    bool Element::isDescendantOf(const Element * inElement) const
+    {
+        return inElement->mPosition < mPosition && mPosition <= inElement->mLastPosition;
+    }
+
+
+    void Element::registerId()
+    {
+        std::string id = getAttribute("id");
+        if (id.empty())
+        {
+            return;
+        }
+
+        // Appended to the chain, so that the element that was registered
+        // first is found first.
+        std::pair<IdIndex::iterator, bool> inserted = mDocument->mIdIndex.insert(std::make_pair(id, this));
+        if (!inserted.second)
         {
-            static Element * findChildById(const Children & inChildren, const std::string & inId)
+            Element * last = inserted.first->second;
+            while (last->mNextWithSameId)
             {
-                Element * result(0);
-                for (size_t idx = 0; idx != inChildren.size(); ++idx)
+                last = last->mNextWithSameId;
+            }
+            last->mNextWithSameId = this;
+        }
+        mIndexedId = id;
+    }
+
+
+    void Element::unregisterId()
+    {
+        if (mIndexedId.empty())
+        {
+            return;
+        }
+
+        IdIndex::iterator it = mDocument->mIdIndex.find(mIndexedId);
+        if (it != mDocument->mIdIndex.end())
+        {
+            if (it->second == this)
+            {
+                if (mNextWithSameId)
+                {
+                    it->second = mNextWithSameId;
+                }
+                else
                 {
-                    ElementPtr child = inChildren[idx];
-                    if (child->getAttribute("id") == inId)
-                    {
-                        result = child.get();
-                        break;
-                    }
-                    else
-                    {
-                        result = findChildById(child->children(), inId);
-                        if (result)
-                        {
-                            break;
-                        }
-                    }
+                    mDocument->mIdIndex.erase(it);
                 }
-                return result;
             }
-        };
-        Element * result = Helper::findChildById(children(), inId);
-        if (!result)
+            else
+            {
+                Element * previous = it->second;
+                while (previous->mNextWithSameId && previous->mNextWithSameId != this)
+                {
+                    previous = previous->mNextWithSameId;
+                }
+                if (previous->mNextWithSameId == this)
+                {
+                    previous->mNextWithSameId = mNextWithSameId;
+                }
+            }
+        }
+        mNextWithSameId = 0;
+        mIndexedId.clear();
+    }
+
+
+    void Element::registerTag(TagId inTagId)
+    {
+        mTagId = inTagId;
+        registerTag();
+    }
+
+
+    void Element::registerTag()
+    {
+        Element * doc = mDocument;
+
+        // The new element is appended to the document order, which is only
+        // right if its parent is on the last branch of the tree.
+        if (mParent && mParent->mDocument == doc && mParent->mLastPosition + 1 != doc->mNextPosition)
         {
-            ReportError("Element with id '" + inId + "' was not found.");
+            doc->mTagIndexInDocumentOrder = false;
         }
-        return result;
+        mPosition = doc->mNextPosition++;
+        mLastPosition = mPosition;
+        doc->mTagIndex.insert(std::make_pair(TagKey(mTagId, mPosition), this));
     }
 
 
-    void Element::getElementsByTagName(const std::string & inType, std::vector<Element *> & outElements)
+    void Element::unregisterTag()
+    {
+        if (mTagId == cNoTagId)
+        {
+            return;
+        }
+
+        TagIndex & tagIndex = mDocument->mTagIndex;
+        TagIndex::iterator it = tagIndex.find(TagKey(mTagId, mPosition));
+        if (it != tagIndex.end() && it->second == this)
+        {
+            tagIndex.erase(it);
+        }
+    }
+
+
+    void Element::reindexTags()
+    {
+        mTagIndex.clear();
+        mNextPosition = 0;
+        reindexTags(this);
+        mTagIndexInDocumentOrder = true;
+    }
+
+
+    void Element::reindexTags(Element * inElement)
     {
-        if (tagName() == inType)
+        inElement->mPosition = mNextPosition++;
+        if (inElement->mTagId != cNoTagId)
+        {
+            mTagIndex.insert(std::make_pair(TagKey(inElement->mTagId, inElement->mPosition), inElement));
+        }
+        for (size_t idx = 0; idx != inElement->mChildren.size(); ++idx)
         {
-            outElements.push_back(this);
+            reindexTags(inElement->mChildren[idx].get());
         }
+        inElement->mLastPosition = mNextPosition - 1;
+    }
+
+
+    void Element::setDocument(Element * inDocument)
+    {
+        unregisterId();
+        unregisterTag();
+        mDocument = inDocument;
+        if (mTagId != cNoTagId)
+        {
+            registerTag();
+        }
+        registerId();
+
+        // The descendants get the next positions, like in reindexTags. The
+        // range grows with each child, so that registerTag sees the next
+        // child as appended to the last branch.
         for (size_t idx = 0; idx != mChildren.size(); ++idx)
         {
-            mChildren[idx]->getElementsByTagName(inType, outElements);
+            mChildren[idx]->setDocument(inDocument);
+            mLastPosition = mChildren[idx]->mLastPosition;
+        }
+    }
+
+
+    void Element::getElementsByTagName(const std::string & inType, std::vector<Element *> & outElements)
+    {
+        // A tag name that was never interned has no elements.
+        TagId tagId = FindTagId(inType);
+        if (tagId != cNoTagId)
+        {
+            getElementsByTagId(tagId, outElements);
+        }
+    }
+
+
+    void Element::getElementsByTagId(TagId inTagId, std::vector<Element *> & outElements)
+    {
+        Element * doc = mDocument;
+        if (!doc->mTagIndexInDocumentOrder)
+        {
+            doc->reindexTags();
+        }
+
+        // The subtree is the range [mPosition, mLastPosition].
+        TagIndex::iterator it = doc->mTagIndex.lower_bound(TagKey(inTagId, mPosition));
+        TagIndex::iterator end = doc->mTagIndex.upper_bound(TagKey(inTagId, mLastPosition));
+        for (; it != end; ++it)
+        {
+            outElements.push_back(it->second);
         }
     }
 
@@ -114,8 +488,13 @@ namespace XULWin
         {
             ElementPtr keepAlive = *it;
             mChildren.erase(it);
-            mComponent->rebuildLayout();
-            mComponent->onChildRemoved(keepAlive->component());
+            detachChild(keepAlive.get());
+            if (mComponent)
+            {
+                mComponent->invalidateSizeCache();
+                mComponent->invalidateLayout();
+                mComponent->onChildRemoved(keepAlive->component());
+            }
             // keepAlive loses scope here and destroys child
         }
         else
@@ -127,54 +506,56 @@ namespace XULWin
 
     void Element::removeAllChildren()
     {
+        // The last child is removed first. Components that keep an index per
+        // child, like the rows of a list model, then don't need to shift the
+        // indices of the remaining children.
         while (!mChildren.empty())
         {
-            Children::iterator it = mChildren.begin();
-            ElementPtr keepAlive = *it;
-            mChildren.erase(it);
-            mComponent->onChildRemoved(keepAlive->component());
+            ElementPtr keepAlive = mChildren.back();
+            mChildren.pop_back();
+            detachChild(keepAlive.get());
+            if (mComponent)
+            {
+                mComponent->onChildRemoved(keepAlive->component());
+            }
             // keepAlive loses scope here and destroys child
         }
-        mComponent->rebuildLayout();
+        if (mComponent)
+        {
+            mComponent->invalidateSizeCache();
+            mComponent->invalidateLayout();
+        }
     }
 
 
     void Element::setStyles(const AttributesMapping & inAttributes)
     {
-        AttributesMapping::const_iterator it = inAttributes.find("style");
-        if (it != inAttributes.end())
+        // Elements that share a style string also share its parsed form.
+        const StyleDeclarations & declarations = StyleDeclarations::Get(inAttributes);
+        for (size_t idx = 0; idx != declarations.size(); ++idx)
         {
-            Poco::StringTokenizer keyValuePairs(it->second, ";",
-                                                Poco::StringTokenizer::TOK_IGNORE_EMPTY
-                                                | Poco::StringTokenizer::TOK_TRIM);
-
-            Poco::StringTokenizer::Iterator it = keyValuePairs.begin(), end = keyValuePairs.end();
-            for (; it != end; ++it)
-            {
-                std::string::size_type sep = it->find(":");
-                if (sep != std::string::npos && (sep + 1) < it->size())
-                {
-                    std::string key = it->substr(0, sep);
-                    std::string value = it->substr(sep + 1, it->size() - sep - 1);
-                    setStyle(key, value);
-                }
-            }
+            setStyle(declarations.get(idx));
         }
     }
 
 
     void Element::setAttributes(const AttributesMapping & inAttributes)
     {
-        mAttributes = inAttributes;
+        mAttributes.assign(inAttributes);
 
         if (mComponent)
         {
-            AttributesMapping::iterator it = mAttributes.begin(), end = mAttributes.end();
+            // Iterate the argument because setAttribute may add entries to mAttributes.
+            AttributesMapping::const_iterator it = inAttributes.begin(), end = inAttributes.end();
             for (; it != end; ++it)
             {
                 setAttribute(it->first, it->second);
             }
         }
+        else
+        {
+            registerId();
+        }
     }
 
 
@@ -217,11 +598,7 @@ namespace XULWin
         std::string result;
         if (!mComponent || !mComponent->getAttribute(inName, result))
         {
-            AttributesMapping::const_iterator it = mAttributes.find(inName);
-            if (it != mAttributes.end())
-            {
-                result = it->second;
-            }
+            mAttributes.get(inName, result);
         }
         return result;
     }
@@ -230,30 +607,76 @@ namespace XULWin
     std::string Element::getDocumentAttribute(const std::string & inName) const
     {
         std::string result;
-        AttributesMapping::const_iterator it = mAttributes.find(inName);
-        if (it != mAttributes.end())
+        mAttributes.get(inName, result);
+        return result;
+    }
+
+
+    void Element::setStyle(const StyleDeclaration & inDeclaration)
+    {
+        LayoutChangeGuard layoutChange(mComponent.get(), inDeclaration.name());
+        if (!mComponent || !mComponent->setStyle(inDeclaration))
         {
-            result = it->second;
+            mStyles[inDeclaration.name()] = inDeclaration.value();
+            return;
+        }
+        layoutChange.commit();
+    }
+
+
+    AttributeValue Element::getAttributeValue(const std::string & inName) const
+    {
+        AttributeValue result;
+        if (!mComponent || !mComponent->getAttributeValue(inName, result))
+        {
+            std::string value;
+            if (mAttributes.get(inName, value))
+            {
+                result = AttributeValue(value);
+            }
         }
         return result;
     }
 
 
-    void Element::setStyle(const std::string & inName, const std::string & inValue)
+    void Element::setAttributeValue(const std::string & inName, const AttributeValue & inValue)
     {
-        std::string type = this->tagName();
-        if (!mComponent || !mComponent->setStyle(inName, inValue))
+        if (inName == "id" || !mComponent)
         {
-            mStyles[inName] = inValue;
+            setAttribute(inName, inValue.toString());
+            return;
         }
+
+        LayoutChangeGuard layoutChange(mComponent.get(), inName);
+        if (!mComponent->setAttributeValue(inName, inValue))
+        {
+            setAttribute(inName, inValue.toString());
+            return;
+        }
+        layoutChange.commit();
     }
 
 
     void Element::setAttribute(const std::string & inName, const std::string & inValue)
     {
+        if (inName == "id")
+        {
+            unregisterId();
+        }
+
+        LayoutChangeGuard layoutChange(mComponent.get(), inName);
         if (!mComponent || !mComponent->setAttribute(inName, inValue))
         {
-            mAttributes[inName] = inValue;
+            mAttributes.set(inName, inValue);
+        }
+        else
+        {
+            layoutChange.commit();
+        }
+
+        if (inName == "id")
+        {
+            registerId();
         }
     }
 
@@ -296,10 +719,38 @@ namespace XULWin
     }
 
 
+    void Element::detachChild(Element * inChild)
+    {
+        // The removed subtree becomes a document of its own.
+        inChild->mNextPosition = 0;
+        inChild->mTagIndexInDocumentOrder = true;
+        inChild->setDocument(inChild);
+    }
+
+
     void Element::addChild(ElementPtr inChild)
     {
         mChildren.push_back(inChild);
-        component()->onChildAdded(inChild->component());
+        if (inChild->mDocument != mDocument)
+        {
+            inChild->setDocument(mDocument);
+        }
+
+        // Extend the position ranges of the ancestors. The positions are
+        // only used if they follow document order, which is checked by
+        // registerTag.
+        for (Element * el = this; el != 0 && el->mLastPosition < inChild->mLastPosition; el = el->mParent)
+        {
+            el->mLastPosition = inChild->mLastPosition;
+        }
+
+        // Elements without component are used for headless parsing.
+        if (mComponent)
+        {
+            mComponent->invalidateSizeCache();
+            mComponent->invalidateLayout();
+            mComponent->onChildAdded(inChild->component());
+        }
     }
 
 
@@ -0,0 +1,158 @@
+#include "XULWin/ElementAttributes.h"
+#include <algorithm>
+#include <set>
+
+
+namespace XULWin
+{
+
+    AttributeArena::AttributeArena() :
+        mFree(0),
+        mNumFree(0)
+    {
+    }
+
+
+    AttributeArena::~AttributeArena()
+    {
+        for (size_t idx = 0; idx != mBlocks.size(); ++idx)
+        {
+            delete [] mBlocks[idx];
+        }
+    }
+
+
+    char * AttributeArena::allocate(size_t inSize)
+    {
+        if (inSize > mNumFree)
+        {
+            // Large values get a block of their own, so that the rest of
+            // the current block is not wasted.
+            if (inSize > cBlockSize / 4)
+            {
+                mBlocks.push_back(new char[inSize]);
+                return mBlocks.back();
+            }
+            mBlocks.push_back(new char[cBlockSize]);
+            mFree = mBlocks.back();
+            mNumFree = cBlockSize;
+        }
+        char * result = mFree;
+        mFree += inSize;
+        mNumFree -= inSize;
+        return result;
+    }
+
+
+    typedef std::set<std::string> AttributeNames;
+
+
+    static AttributeNames & GetAttributeNames()
+    {
+        static AttributeNames fAttributeNames;
+        return fAttributeNames;
+    }
+
+
+    ElementAttributes::ElementAttributes(const AttributeArenaPtr & inArena) :
+        mArena(inArena)
+    {
+    }
+
+
+    const AttributeArenaPtr & ElementAttributes::arena() const
+    {
+        return mArena;
+    }
+
+
+    size_t ElementAttributes::size() const
+    {
+        return mEntries.size();
+    }
+
+
+    const char * ElementAttributes::InternName(const std::string & inName)
+    {
+        return GetAttributeNames().insert(inName).first->c_str();
+    }
+
+
+    void ElementAttributes::assign(const AttributesMapping & inAttributes)
+    {
+        mEntries.clear();
+        mEntries.reserve(inAttributes.size());
+        AttributesMapping::const_iterator it = inAttributes.begin(), end = inAttributes.end();
+        for (; it != end; ++it)
+        {
+            Entry entry;
+            entry.name = InternName(it->first);
+            entry.value = 0;
+            entry.size = 0;
+            entry.capacity = 0;
+            setValue(entry, it->second);
+            mEntries.push_back(entry);
+        }
+    }
+
+
+    ElementAttributes::Entries::const_iterator ElementAttributes::find(const std::string & inName) const
+    {
+        // An element has only a few attributes, so a linear search is the
+        // cheapest lookup that doesn't need to intern inName first.
+        Entries::const_iterator it = mEntries.begin(), end = mEntries.end();
+        for (; it != end; ++it)
+        {
+            if (inName == it->name)
+            {
+                return it;
+            }
+        }
+        return end;
+    }
+
+
+    bool ElementAttributes::get(const std::string & inName, std::string & outValue) const
+    {
+        Entries::const_iterator it = find(inName);
+        if (it == mEntries.end())
+        {
+            return false;
+        }
+        outValue.assign(it->value, it->value + it->size);
+        return true;
+    }
+
+
+    void ElementAttributes::set(const std::string & inName, const std::string & inValue)
+    {
+        Entries::const_iterator it = find(inName);
+        if (it != mEntries.end())
+        {
+            setValue(mEntries[it - mEntries.begin()], inValue);
+            return;
+        }
+
+        Entry entry;
+        entry.name = InternName(inName);
+        entry.value = 0;
+        entry.size = 0;
+        entry.capacity = 0;
+        setValue(entry, inValue);
+        mEntries.push_back(entry);
+    }
+
+
+    void ElementAttributes::setValue(Entry & ioEntry, const std::string & inValue)
+    {
+        if (inValue.size() > ioEntry.capacity)
+        {
+            ioEntry.value = mArena->allocate(inValue.size());
+            ioEntry.capacity = inValue.size();
+        }
+        std::copy(inValue.begin(), inValue.end(), ioEntry.value);
+        ioEntry.size = inValue.size();
+    }
+
+
+} // namespace XULWin
@@ -1,7 +1,10 @@
 #include "XULWin/ErrorReporter.h"
+#ifdef _WIN32
 #include "XULWin/Unicode.h"
 #include "XULWin/Windows.h"
+#endif
 #include <boost/bind.hpp>
+#include <iostream>
 #include <sstream>
 #include <assert.h>
 
@@ -230,8 +233,13 @@ namespace XULWin
             }
             else if (mEnableMessageBoxLogging)
             {
+#ifdef _WIN32
                 std::wstring utf16Message = XULWin::ToUTF16(inError);
                 ::MessageBox(0, utf16Message.c_str(), 0, MB_OK);
+#else
+                // Headless builds, see HeadlessLayout.
+                std::cerr << inError << std::endl;
+#endif
             }
             else
             {
@@ -0,0 +1,1194 @@
+#include "XULWin/HeadlessLayout.h"
+#include "XULWin/Conversions.h"
+#include "XULWin/Defaults.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/Grid.h"
+#include "XULWin/Layout.h"
+#include "XULWin/StyleDeclarations.h"
+#include "XULWin/TextMetrics.h"
+#include "Poco/SAX/Attributes.h"
+#include "Poco/SAX/ContentHandler.h"
+#include "Poco/SAX/EntityResolver.h"
+#include "Poco/SAX/EntityResolverImpl.h"
+#include "Poco/SAX/SAXParser.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <ostream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        enum NodeType
+        {
+            NodeType_Box,
+            NodeType_GroupBox,
+            NodeType_Statusbar,
+            NodeType_Grid,
+            NodeType_Rows,
+            NodeType_Columns,
+            NodeType_Row,
+            NodeType_Column,
+            NodeType_Deck,
+            NodeType_TabPanels,
+            NodeType_Label,
+            NodeType_Description,
+            NodeType_Button,
+            NodeType_CheckBox,
+            NodeType_Radio,
+            NodeType_TextBox,
+            NodeType_MenuButton,
+            NodeType_MenuList,
+            NodeType_ProgressMeter,
+            NodeType_Scrollbar,
+            NodeType_Separator,
+            NodeType_Spacer,
+            NodeType_Control
+        };
+
+
+        struct NodeInfo
+        {
+            const char * TagName;
+            NodeType Type;
+
+            // Created with a MarginDecorator, which has a default margin.
+            bool HasMargin;
+
+            // Orient of containers without an orient attribute.
+            Orient DefaultOrient;
+
+            // Created with ComponentFactory::createContainer, which adds a
+            // ScrollDecorator if the overflow style is set.
+            bool Scrollable;
+        };
+
+
+        // The elements that the ElementFactory creates, except for those
+        // that have no place in the client area, like script, menubar and
+        // the caption of a groupbox.
+        const NodeInfo cNodeInfos[] =
+        {
+            { "window",         NodeType_Box,           false, Vertical,   false },
+            { "dialog",         NodeType_Box,           false, Vertical,   false },
+            { "hbox",           NodeType_Box,           false, Horizontal, false },
+            { "vbox",           NodeType_Box,           false, Vertical,   false },
+            { "radiogroup",     NodeType_Box,           false, Horizontal, false },
+            { "tabbox",         NodeType_Box,           false, Horizontal, true  },
+            { "tabpanel",       NodeType_Box,           false, Horizontal, false },
+            { "groupbox",       NodeType_GroupBox,      true,  Vertical,   false },
+            { "statusbar",      NodeType_Statusbar,     false, Horizontal, false },
+            { "grid",           NodeType_Grid,          false, Vertical,   true  },
+            { "rows",           NodeType_Rows,          false, Vertical,   false },
+            { "columns",        NodeType_Columns,       false, Vertical,   false },
+            { "row",            NodeType_Row,           false, Vertical,   false },
+            { "column",         NodeType_Column,        false, Vertical,   false },
+            { "deck",           NodeType_Deck,          false, Vertical,   true  },
+            { "tabpanels",      NodeType_TabPanels,     false, Vertical,   false },
+            { "label",          NodeType_Label,         true,  Vertical,   false },
+            { "a",              NodeType_Label,         true,  Vertical,   false },
+            { "statusbarpanel", NodeType_Label,         false, Vertical,   false },
+            { "description",    NodeType_Description,   true,  Vertical,   false },
+            { "button",         NodeType_Button,        true,  Vertical,   false },
+            { "checkbox",       NodeType_CheckBox,      true,  Vertical,   false },
+            { "radio",          NodeType_Radio,         true,  Vertical,   false },
+            { "textbox",        NodeType_TextBox,       true,  Vertical,   false },
+            { "menubutton",     NodeType_MenuButton,    true,  Vertical,   false },
+            { "menulist",       NodeType_MenuList,      true,  Vertical,   false },
+            { "progressmeter",  NodeType_ProgressMeter, true,  Vertical,   false },
+            { "scrollbar",      NodeType_Scrollbar,     false, Vertical,   false },
+            { "separator",      NodeType_Separator,     true,  Vertical,   false },
+            { "spacer",         NodeType_Spacer,        false, Vertical,   false },
+            { "image",          NodeType_Spacer,        true,  Vertical,   false },
+            { "listbox",        NodeType_Control,       true,  Vertical,   false },
+            { "tree",           NodeType_Control,       false, Vertical,   false },
+            { "toolbar",        NodeType_Control,       false, Vertical,   false },
+            { "svg",            NodeType_Control,       false, Vertical,   false }
+        };
+
+        const size_t cNumNodeInfos = sizeof(cNodeInfos) / sizeof(cNodeInfos[0]);
+
+
+        // Indices in HeadlessNode::mMargin, in the order of
+        // StyleDeclaration::getMargin.
+        enum
+        {
+            cTop,
+            cLeft,
+            cRight,
+            cBottom
+        };
+
+
+        // Margins between a groupbox and its contents, see GroupBox.
+        const int cGroupBoxMarginTop = 16;
+        const int cGroupBoxMarginSide = 2;
+
+
+        int GetNodeType(const std::string & inTagName)
+        {
+            for (size_t idx = 0; idx != cNumNodeInfos; ++idx)
+            {
+                if (inTagName == cNodeInfos[idx].TagName)
+                {
+                    return static_cast<int>(idx);
+                }
+            }
+            return -1;
+        }
+
+
+        // Returns the text that the native control would display.
+        const std::string & GetText(const HeadlessNode * inNode)
+        {
+            const std::string & tagName = inNode->tagName();
+            if (tagName == "a" || tagName == "description")
+            {
+                // XMLHyperlink and XMLDescription set their value to the
+                // inner text.
+                if (!inNode->innerText().empty())
+                {
+                    return inNode->innerText();
+                }
+                return inNode->getAttribute("value");
+            }
+            else if (tagName == "label" || tagName == "textbox")
+            {
+                return inNode->getAttribute("value");
+            }
+            return inNode->getAttribute("label");
+        }
+
+
+        // Resolves chrome URLs like ChromeURL::convertToLocalPath does:
+        // chrome://myapp/locale/myapp.dtd becomes
+        // <application directory>/chrome/locale/en-US/myapp.dtd
+        std::string GetLocalPath(const std::string & inApplicationDirectory, const std::string & inURL)
+        {
+            static const std::string cChrome = "chrome://";
+            if (inURL.compare(0, cChrome.size(), cChrome) != 0)
+            {
+                return inURL;
+            }
+
+            size_t slashIdx = inURL.find('/', cChrome.size());
+            if (slashIdx == std::string::npos)
+            {
+                return inURL;
+            }
+
+            std::string result = inApplicationDirectory + "chrome" + inURL.substr(slashIdx);
+            static const std::string cLocale = "/locale/";
+            size_t localeIdx = result.find(cLocale, inApplicationDirectory.size());
+            if (localeIdx != std::string::npos)
+            {
+                result.insert(localeIdx + cLocale.size(), Defaults::defaultLocale() + "/");
+            }
+            return result;
+        }
+
+
+        // The application directory is the parent of the chrome directory,
+        // for example "hello/" for "hello/chrome/content/hello.xul".
+        std::string GetApplicationDirectory(const std::string & inPath)
+        {
+            std::string path(inPath);
+            std::replace(path.begin(), path.end(), '\\', '/');
+            size_t chromeIdx = path.rfind("chrome/");
+            while (chromeIdx != std::string::npos && chromeIdx > 0 && path[chromeIdx - 1] != '/')
+            {
+                chromeIdx = path.rfind("chrome/", chromeIdx - 1);
+            }
+            if (chromeIdx != std::string::npos)
+            {
+                return path.substr(0, chromeIdx);
+            }
+            size_t slashIdx = path.rfind('/');
+            return slashIdx == std::string::npos ? std::string() : path.substr(0, slashIdx + 1);
+        }
+
+
+        /**
+         * Builds a tree of HeadlessNode objects with the same SAX parser
+         * that the XULParser uses.
+         */
+        class HeadlessParser : public Poco::XML::SAXParser,
+                               public Poco::XML::ContentHandler,
+                               public Poco::XML::EntityResolver
+        {
+        public:
+            HeadlessParser(const std::string & inApplicationDirectory) :
+                mApplicationDirectory(inApplicationDirectory),
+                mRootNode(0),
+                mCurrentNode(0)
+            {
+                setFeature(FEATURE_EXTERNAL_GENERAL_ENTITIES, true);
+                setFeature(FEATURE_EXTERNAL_PARAMETER_ENTITIES, true);
+
+                setContentHandler(this);
+                setEntityResolver(this);
+            }
+
+            ~HeadlessParser()
+            {
+                delete mRootNode;
+            }
+
+            HeadlessNode * releaseRootNode()
+            {
+                HeadlessNode * result = mRootNode;
+                mRootNode = 0;
+                return result;
+            }
+
+        protected:
+            // ContentHandler
+            virtual void setDocumentLocator(const Poco::XML::Locator *) {}
+
+            virtual void startDocument() {}
+
+            virtual void endDocument() {}
+
+            virtual void startElement(const Poco::XML::XMLString &,
+                                      const Poco::XML::XMLString & localName,
+                                      const Poco::XML::XMLString &,
+                                      const Poco::XML::Attributes & attributes)
+            {
+                mAttributes.clear();
+                mAttributes.reserve(attributes.getLength());
+                for (int idx = 0; idx != attributes.getLength(); ++idx)
+                {
+                    mAttributes[attributes.getLocalName(idx)] = attributes.getValue(idx);
+                }
+
+                HeadlessNode * node = new HeadlessNode(mCurrentNode, localName, mAttributes);
+                if (!mRootNode)
+                {
+                    mRootNode = node;
+                }
+                mCurrentNode = node;
+                mTexts.push_back(std::string());
+            }
+
+            virtual void endElement(const Poco::XML::XMLString &,
+                                    const Poco::XML::XMLString &,
+                                    const Poco::XML::XMLString &)
+            {
+                if (!mTexts.back().empty())
+                {
+                    mCurrentNode->setInnerText(mTexts.back());
+                }
+                mTexts.pop_back();
+                mCurrentNode = mCurrentNode->parent();
+            }
+
+            virtual void characters(const Poco::XML::XMLChar ch[], int start, int length)
+            {
+                if (!mTexts.empty())
+                {
+                    mTexts.back().append(ch + start, length);
+                }
+            }
+
+            virtual void ignorableWhitespace(const Poco::XML::XMLChar [], int, int) {}
+
+            virtual void processingInstruction(const Poco::XML::XMLString &, const Poco::XML::XMLString &) {}
+
+            virtual void startPrefixMapping(const Poco::XML::XMLString &, const Poco::XML::XMLString &) {}
+
+            virtual void endPrefixMapping(const Poco::XML::XMLString &) {}
+
+            virtual void skippedEntity(const Poco::XML::XMLString &) {}
+
+            // EntityResolver
+            virtual Poco::XML::InputSource * resolveEntity(const Poco::XML::XMLString * publicId, const Poco::XML::XMLString & systemId)
+            {
+                try
+                {
+                    Poco::XML::EntityResolverImpl entityResolverImpl;
+                    return entityResolverImpl.resolveEntity(publicId, GetLocalPath(mApplicationDirectory, systemId));
+                }
+                catch (const Poco::Exception & inExc)
+                {
+                    ReportError(inExc.displayText());
+                }
+                return 0;
+            }
+
+            virtual void releaseInputSource(Poco::XML::InputSource * pSource)
+            {
+                Poco::XML::EntityResolverImpl entityResolverImpl;
+                entityResolverImpl.releaseInputSource(pSource);
+            }
+
+        private:
+            std::string mApplicationDirectory;
+            HeadlessNode * mRootNode;
+            HeadlessNode * mCurrentNode;
+            AttributesMapping mAttributes;
+            std::vector<std::string> mTexts;
+        };
+
+    } // anonymous namespace
+
+
+    HeadlessNode::HeadlessNode(HeadlessNode * inParent,
+                               const std::string & inTagName,
+                               const AttributesMapping & inAttributes) :
+        mTagName(inTagName),
+        mParent(inParent),
+        mAttributes(inAttributes),
+        mType(-1),
+        mFlex(0),
+        mHidden(false),
+        mWidth(-1),
+        mHeight(-1),
+        mCSSWidth(-1),
+        mCSSHeight(-1),
+        mOrient(Vertical),
+        mAlign(Stretch),
+        mScrollX(false),
+        mScrollY(false)
+    {
+        for (size_t idx = 0; idx != 4; ++idx)
+        {
+            mMargin[idx] = 0;
+        }
+        for (size_t idx = 0; idx <= Maximum; ++idx)
+        {
+            mCachedWidths[idx] = -1;
+            mCachedHeights[idx] = -1;
+        }
+        if (mParent)
+        {
+            mParent->mChildren.push_back(this);
+        }
+    }
+
+
+    HeadlessNode::~HeadlessNode()
+    {
+        for (size_t idx = 0; idx != mChildren.size(); ++idx)
+        {
+            delete mChildren[idx];
+        }
+    }
+
+
+    const std::string & HeadlessNode::tagName() const
+    {
+        return mTagName;
+    }
+
+
+    HeadlessNode * HeadlessNode::parent() const
+    {
+        return mParent;
+    }
+
+
+    size_t HeadlessNode::getChildCount() const
+    {
+        return mChildren.size();
+    }
+
+
+    const HeadlessNode * HeadlessNode::getChild(size_t idx) const
+    {
+        return mChildren[idx];
+    }
+
+
+    const AttributesMapping & HeadlessNode::attributes() const
+    {
+        return mAttributes;
+    }
+
+
+    const std::string & HeadlessNode::getAttribute(const std::string & inName) const
+    {
+        static const std::string cEmpty;
+        AttributesMapping::const_iterator it = mAttributes.find(inName);
+        return it != mAttributes.end() ? it->second : cEmpty;
+    }
+
+
+    const std::string & HeadlessNode::innerText() const
+    {
+        return mInnerText;
+    }
+
+
+    void HeadlessNode::setInnerText(const std::string & inText)
+    {
+        mInnerText = inText;
+    }
+
+
+    const Rect & HeadlessNode::rect() const
+    {
+        return mRect;
+    }
+
+
+    HeadlessLayout::HeadlessLayout(const TextMetrics & inTextMetrics) :
+        mTextMetrics(inTextMetrics)
+    {
+    }
+
+
+    HeadlessLayout::~HeadlessLayout()
+    {
+    }
+
+
+    bool HeadlessLayout::loadFile(const std::string & inPath)
+    {
+        return load(std::string(), inPath);
+    }
+
+
+    bool HeadlessLayout::loadXUL(const std::string & inXUL)
+    {
+        return load(inXUL, std::string());
+    }
+
+
+    bool HeadlessLayout::load(const std::string & inXUL, const std::string & inPath)
+    {
+        mRootNode.reset();
+        HeadlessParser parser(GetApplicationDirectory(inPath));
+        try
+        {
+            if (!inPath.empty())
+            {
+                parser.parse(inPath);
+            }
+            else
+            {
+                parser.parseString(inXUL);
+            }
+        }
+        catch (const Poco::Exception & inExc)
+        {
+            ReportError(inExc.displayText());
+            return false;
+        }
+
+        mRootNode.reset(parser.releaseRootNode());
+        if (!mRootNode)
+        {
+            ReportError("HeadlessLayout: the document is empty.");
+            return false;
+        }
+        init(mRootNode.get());
+        return true;
+    }
+
+
+    const HeadlessNode * HeadlessLayout::rootNode() const
+    {
+        return mRootNode.get();
+    }
+
+
+    void HeadlessLayout::init(HeadlessNode * inNode)
+    {
+        inNode->mType = GetNodeType(inNode->tagName());
+        for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+        {
+            init(inNode->mChildren[idx]);
+        }
+
+        if (inNode->mType < 0)
+        {
+            return;
+        }
+
+        const NodeInfo & info = cNodeInfos[inNode->mType];
+        inNode->mFlex = String2Int(inNode->getAttribute("flex"), 0);
+        inNode->mHidden = String2Bool(inNode->getAttribute("hidden"), false);
+        if (!ParseInt(inNode->getAttribute("width"), inNode->mWidth))
+        {
+            inNode->mWidth = -1;
+        }
+        if (!ParseInt(inNode->getAttribute("height"), inNode->mHeight))
+        {
+            inNode->mHeight = -1;
+        }
+
+        const StyleDeclarations & styles = StyleDeclarations::Get(inNode->attributes());
+        if (const StyleDeclaration * width = styles.find(CSSProperty_Width))
+        {
+            inNode->mCSSWidth = width->size();
+        }
+        if (const StyleDeclaration * height = styles.find(CSSProperty_Height))
+        {
+            inNode->mCSSHeight = height->size();
+        }
+
+        // A margin style adds a MarginDecorator to any component.
+        if (const StyleDeclaration * margin = styles.find(CSSProperty_Margin))
+        {
+            margin->getMargin(inNode->mMargin[cTop], inNode->mMargin[cLeft], inNode->mMargin[cRight], inNode->mMargin[cBottom]);
+        }
+        else if (info.HasMargin)
+        {
+            inNode->mMargin[cTop] = 2;
+            inNode->mMargin[cLeft] = 4;
+            inNode->mMargin[cRight] = 4;
+            inNode->mMargin[cBottom] = 2;
+        }
+
+        if (info.Scrollable)
+        {
+            // See ComponentFactory::GetOverflow.
+            const StyleDeclaration * overflow = styles.find(CSSProperty_Overflow);
+            const StyleDeclaration * overflowX = styles.find(CSSProperty_OverflowX);
+            const StyleDeclaration * overflowY = styles.find(CSSProperty_OverflowY);
+            if (!overflowX)
+            {
+                overflowX = overflow;
+            }
+            if (!overflowY)
+            {
+                overflowY = overflow;
+            }
+            inNode->mScrollX = overflowX && overflowX->overflow() != CSSOverflow_Hidden;
+            inNode->mScrollY = overflowY && overflowY->overflow() != CSSOverflow_Hidden;
+        }
+
+        // The native container of a scrolled tabbox is a Box, which is
+        // vertical by default.
+        Orient defaultOrient = info.DefaultOrient;
+        if (inNode->mScrollX || inNode->mScrollY)
+        {
+            defaultOrient = Vertical;
+        }
+        inNode->mOrient = String2Orient(inNode->getAttribute("orient"), defaultOrient);
+
+        // Windows and rows use the default alignment of ConcreteComponent,
+        // containers are stretched.
+        Align defaultAlign = Stretch;
+        if (info.Type == NodeType_Row || inNode->tagName() == "window" || inNode->tagName() == "dialog")
+        {
+            defaultAlign = inNode->mOrient == Vertical ? Stretch : Start;
+        }
+        inNode->mAlign = String2Align(inNode->getAttribute("align"), defaultAlign);
+
+        if (info.Type == NodeType_Statusbar)
+        {
+            inNode->mOrient = Horizontal;
+            inNode->mAlign = Center;
+        }
+        else if (info.Type == NodeType_Deck)
+        {
+            // Only the selected child is shown.
+            int selectedIndex = String2Int(inNode->getAttribute("selectedIndex"), 0);
+            for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+            {
+                inNode->mChildren[idx]->mHidden = static_cast<int>(idx) != selectedIndex;
+            }
+        }
+        else if (info.Type == NodeType_TabPanels)
+        {
+            // The first tab is selected.
+            for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+            {
+                inNode->mChildren[idx]->mHidden = idx != 0;
+            }
+        }
+    }
+
+
+    int HeadlessLayout::getWidth(const HeadlessNode * inNode, SizeConstraint inSizeConstraint) const
+    {
+        // Like MarginDecorator, which adds the margins even if the
+        // component is hidden.
+        return inNode->mMargin[cLeft] + getSize(inNode, true, inSizeConstraint) + inNode->mMargin[cRight];
+    }
+
+
+    int HeadlessLayout::getHeight(const HeadlessNode * inNode, SizeConstraint inSizeConstraint) const
+    {
+        return inNode->mMargin[cTop] + getSize(inNode, false, inSizeConstraint) + inNode->mMargin[cBottom];
+    }
+
+
+    int HeadlessLayout::getSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const
+    {
+        // A ScrollDecorator needs no room in the directions it scrolls.
+        if (inSizeConstraint == Minimum && (inWidth ? inNode->mScrollX : inNode->mScrollY))
+        {
+            return 0;
+        }
+
+        if (inNode->mType < 0 || inNode->mHidden)
+        {
+            return 0;
+        }
+
+        int size = inWidth ? inNode->mWidth : inNode->mHeight;
+        if (size >= 0)
+        {
+            return size;
+        }
+
+        int & cachedSize = inWidth ? inNode->mCachedWidths[inSizeConstraint] : inNode->mCachedHeights[inSizeConstraint];
+        if (cachedSize < 0)
+        {
+            cachedSize = calculateSize(inNode, inWidth, inSizeConstraint);
+        }
+        return cachedSize;
+    }
+
+
+    int HeadlessLayout::calculateSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const
+    {
+        switch (cNodeInfos[inNode->mType].Type)
+        {
+            case NodeType_Box:
+            {
+                return calculateBoxSize(inNode, inWidth, inSizeConstraint);
+            }
+            case NodeType_GroupBox:
+            {
+                int contentSize = calculateBoxSize(inNode, inWidth, inSizeConstraint);
+                if (!inWidth)
+                {
+                    return cGroupBoxMarginTop + contentSize + cGroupBoxMarginSide;
+                }
+
+                // The caption sets the title of the groupbox.
+                int textWidth = Defaults::textPadding();
+                for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+                {
+                    const HeadlessNode * child = inNode->getChild(idx);
+                    if (child->tagName() == "caption")
+                    {
+                        textWidth += getTextWidth(child->getAttribute("label"));
+                        break;
+                    }
+                }
+                return cGroupBoxMarginSide + std::max<int>(textWidth, contentSize) + cGroupBoxMarginSide;
+            }
+            case NodeType_Statusbar:
+            {
+                int contentSize = calculateBoxSize(inNode, inWidth, inSizeConstraint);
+                return inWidth ? contentSize : std::max<int>(Defaults::statusBarHeight(), contentSize);
+            }
+            case NodeType_Grid:
+            {
+                NodeType tracksType = inWidth ? NodeType_Columns : NodeType_Rows;
+                for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+                {
+                    const HeadlessNode * child = inNode->getChild(idx);
+                    if (child->mType >= 0 && cNodeInfos[child->mType].Type == tracksType)
+                    {
+                        return inWidth ? getWidth(child, inSizeConstraint) : getHeight(child, inSizeConstraint);
+                    }
+                }
+                return 0;
+            }
+            case NodeType_Rows:
+            {
+                return calculateChildSize(inNode, inWidth, !inWidth, inSizeConstraint);
+            }
+            case NodeType_Columns:
+            case NodeType_Row:
+            {
+                return calculateChildSize(inNode, inWidth, inWidth, inSizeConstraint);
+            }
+            case NodeType_Column:
+            {
+                if (inWidth)
+                {
+                    return getColumnWidth(inNode, inSizeConstraint);
+                }
+                return calculateChildSize(inNode, false, true, inSizeConstraint);
+            }
+            case NodeType_Deck:
+            {
+                return calculateChildSize(inNode, inWidth, false, inSizeConstraint);
+            }
+            case NodeType_TabPanels:
+            {
+                int contentSize = calculateChildSize(inNode, inWidth, false, inSizeConstraint);
+                return inWidth ? contentSize : Defaults::tabHeight() + contentSize;
+            }
+            case NodeType_Label:
+            {
+                return inWidth ? getTextWidth(GetText(inNode)) : getTextHeight(GetText(inNode));
+            }
+            case NodeType_Description:
+            {
+                return inWidth ? Defaults::textPadding() : getTextHeight(GetText(inNode));
+            }
+            case NodeType_Button:
+            {
+                if (!inWidth)
+                {
+                    return Defaults::buttonHeight();
+                }
+                int minWidth = getTextWidth(GetText(inNode)) + Defaults::textPadding();
+                return std::max<int>(minWidth, Defaults::buttonWidth());
+            }
+            case NodeType_CheckBox:
+            {
+                return inWidth ? Defaults::checkBoxMinimumWidth() + getTextWidth(GetText(inNode))
+                               : Defaults::controlHeight();
+            }
+            case NodeType_Radio:
+            {
+                return inWidth ? Defaults::radioButtonMinimumWidth() + getTextWidth(GetText(inNode))
+                               : Defaults::controlHeight();
+            }
+            case NodeType_TextBox:
+            {
+                if (inWidth)
+                {
+                    return Defaults::textBoxMinimumWidth() + getTextWidth(GetText(inNode));
+                }
+                return Defaults::controlHeight() * String2Int(inNode->getAttribute("rows"), 1);
+            }
+            case NodeType_MenuButton:
+            {
+                return inWidth ? getTextWidth(GetText(inNode)) + Defaults::textPadding() * 2
+                               : Defaults::buttonHeight();
+            }
+            case NodeType_MenuList:
+            {
+                if (!inWidth)
+                {
+                    return Defaults::controlHeight();
+                }
+
+                // The popup has the default margin of a MarginDecorator and
+                // is as wide as its widest item.
+                int popupWidth = 0;
+                for (size_t popupIdx = 0; popupIdx != inNode->getChildCount(); ++popupIdx)
+                {
+                    const HeadlessNode * popup = inNode->getChild(popupIdx);
+                    if (popup->tagName() != "menupopup")
+                    {
+                        continue;
+                    }
+                    int itemWidth = 0;
+                    for (size_t itemIdx = 0; itemIdx != popup->getChildCount(); ++itemIdx)
+                    {
+                        const HeadlessNode * item = popup->getChild(itemIdx);
+                        if (item->tagName() == "menuitem")
+                        {
+                            itemWidth = std::max<int>(itemWidth, getTextWidth(item->getAttribute("label")));
+                        }
+                    }
+                    popupWidth = std::max<int>(popupWidth, 4 + itemWidth + 4);
+                }
+                return Defaults::menuListMinWidth() + popupWidth;
+            }
+            case NodeType_ProgressMeter:
+            {
+                return inWidth ? Defaults::progressMeterWidth() : Defaults::progressMeterHeight();
+            }
+            case NodeType_Scrollbar:
+            {
+                return Defaults::scrollbarWidth();
+            }
+            case NodeType_Separator:
+            {
+                return 1;
+            }
+            case NodeType_Spacer:
+            {
+                return 0;
+            }
+            case NodeType_Control:
+            {
+                return inWidth ? Defaults::controlWidth() : Defaults::controlHeight();
+            }
+        }
+        return 0;
+    }
+
+
+    int HeadlessLayout::calculateBoxSize(const HeadlessNode * inNode, bool inWidth, SizeConstraint inSizeConstraint) const
+    {
+        // Sum in the direction of the box, maximum in the other.
+        bool horizontal = inNode->mOrient == Horizontal;
+        return calculateChildSize(inNode, inWidth, inWidth == horizontal, inSizeConstraint);
+    }
+
+
+    int HeadlessLayout::calculateChildSize(const HeadlessNode * inNode, bool inWidth, bool inSum, SizeConstraint inSizeConstraint) const
+    {
+        int result = 0;
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            const HeadlessNode * child = inNode->getChild(idx);
+            if (child->mType < 0)
+            {
+                continue;
+            }
+
+            int size = inWidth ? getWidth(child, inSizeConstraint) : getHeight(child, inSizeConstraint);
+            if (inSum)
+            {
+                result += size;
+            }
+            else if (size > result)
+            {
+                result = size;
+            }
+        }
+        return result;
+    }
+
+
+    int HeadlessLayout::getTextWidth(const std::string & inText) const
+    {
+        return mTextMetrics.getTextSize(inText).width();
+    }
+
+
+    int HeadlessLayout::getTextHeight(const std::string & inText) const
+    {
+        return mTextMetrics.getTextSize(inText).height();
+    }
+
+
+    int HeadlessLayout::getCellSize(const HeadlessNode * inNode, bool inWidth) const
+    {
+        // See ConcreteComponent::getWidth and MarginDecorator::getWidth.
+        int size = inWidth ? inNode->mWidth : inNode->mHeight;
+        if (size < 0)
+        {
+            int cssSize = inWidth ? inNode->mCSSWidth : inNode->mCSSHeight;
+            if (cssSize >= 0)
+            {
+                size = std::max<int>(cssSize, getSize(inNode, inWidth, Minimum));
+            }
+            else
+            {
+                size = getSize(inNode, inWidth, Preferred);
+            }
+        }
+        return inWidth ? inNode->mMargin[cLeft] + size + inNode->mMargin[cRight]
+                       : inNode->mMargin[cTop] + size + inNode->mMargin[cBottom];
+    }
+
+
+    int HeadlessLayout::getColumnWidth(const HeadlessNode * inColumn, SizeConstraint inSizeConstraint) const
+    {
+        const HeadlessNode * columns = inColumn->parent();
+        const HeadlessNode * grid = columns ? columns->parent() : 0;
+        if (!grid || grid->mType < 0 || cNodeInfos[grid->mType].Type != NodeType_Grid)
+        {
+            ReportError("XMLColumn is not part of an XMLGrid.");
+            return 0;
+        }
+
+        // Find the index of the column.
+        size_t columnIdx = 0;
+        size_t numColumns = 0;
+        for (size_t idx = 0; idx != columns->getChildCount(); ++idx)
+        {
+            const HeadlessNode * column = columns->getChild(idx);
+            if (column->mType < 0)
+            {
+                continue;
+            }
+            if (column == inColumn)
+            {
+                columnIdx = numColumns;
+            }
+            numColumns++;
+        }
+
+        // The grid measures the cells of all columns at once.
+        std::vector<int> & widths = grid->mColumnWidths[inSizeConstraint];
+        if (widths.size() != numColumns)
+        {
+            widths.assign(numColumns, 0);
+            for (size_t rowsIdx = 0; rowsIdx != grid->getChildCount(); ++rowsIdx)
+            {
+                const HeadlessNode * rows = grid->getChild(rowsIdx);
+                if (rows->tagName() != "rows")
+                {
+                    continue;
+                }
+                for (size_t rowIdx = 0; rowIdx != rows->getChildCount(); ++rowIdx)
+                {
+                    const HeadlessNode * row = rows->getChild(rowIdx);
+                    size_t cellIdx = 0;
+                    for (size_t idx = 0; idx != row->getChildCount() && cellIdx != numColumns; ++idx)
+                    {
+                        const HeadlessNode * cell = row->getChild(idx);
+                        if (cell->mType < 0)
+                        {
+                            continue;
+                        }
+                        widths[cellIdx] = std::max<int>(widths[cellIdx], getWidth(cell, inSizeConstraint));
+                        cellIdx++;
+                    }
+                }
+            }
+        }
+        return widths[columnIdx];
+    }
+
+
+    void HeadlessLayout::layout(int inWidth, int inHeight)
+    {
+        if (mRootNode)
+        {
+            layoutNode(mRootNode.get(), Rect(0, 0, inWidth, inHeight));
+        }
+    }
+
+
+    void HeadlessLayout::layoutNode(HeadlessNode * inNode, const Rect & inRect)
+    {
+        inNode->mRect = inRect;
+        if (inNode->mType < 0)
+        {
+            return;
+        }
+
+        const int * margin = inNode->mMargin;
+        Rect clientRect(inRect.x() + margin[cLeft],
+                        inRect.y() + margin[cTop],
+                        inRect.width() - margin[cLeft] - margin[cRight],
+                        inRect.height() - margin[cTop] - margin[cBottom]);
+
+        switch (cNodeInfos[inNode->mType].Type)
+        {
+            case NodeType_Box:
+            case NodeType_Statusbar:
+            {
+                layoutBox(inNode, clientRect);
+                break;
+            }
+            case NodeType_GroupBox:
+            {
+                layoutBox(inNode, Rect(clientRect.x() + cGroupBoxMarginSide,
+                                       clientRect.y() + cGroupBoxMarginTop,
+                                       clientRect.width() - 2 * cGroupBoxMarginSide,
+                                       clientRect.height() - cGroupBoxMarginTop - cGroupBoxMarginSide));
+                break;
+            }
+            case NodeType_Grid:
+            {
+                layoutGrid(inNode, clientRect);
+                break;
+            }
+            case NodeType_Deck:
+            {
+                for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+                {
+                    HeadlessNode * child = inNode->mChildren[idx];
+                    if (!child->mHidden)
+                    {
+                        layoutNode(child, clientRect);
+                    }
+                }
+                break;
+            }
+            case NodeType_TabPanels:
+            {
+                Rect panelRect(clientRect.x(),
+                               clientRect.y() + Defaults::tabHeight(),
+                               clientRect.width(),
+                               clientRect.height() - Defaults::tabHeight());
+                for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+                {
+                    layoutNode(inNode->mChildren[idx], panelRect);
+                }
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+
+    void HeadlessLayout::layoutBox(HeadlessNode * inNode, const Rect & inClientRect)
+    {
+        // See BoxLayouter::rebuildLayout.
+        bool horizontal = inNode->mOrient == Horizontal;
+        std::vector<HeadlessNode *> children;
+        std::vector<ExtendedSizeInfo> sizeInfos;
+        for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+        {
+            HeadlessNode * child = inNode->mChildren[idx];
+            if (child->mType < 0)
+            {
+                continue;
+            }
+
+            NodeType type = cNodeInfos[child->mType].Type;
+            bool expansive = type == NodeType_Separator || type == NodeType_Scrollbar;
+            children.push_back(child);
+            sizeInfos.push_back(
+                ExtendedSizeInfo(FlexWrap(child->mFlex),
+                                 MinSizeWrap(horizontal ? getWidth(child, Minimum) : getHeight(child, Minimum)),
+                                 OptSizeWrap(horizontal ? getWidth(child, Preferred) : getHeight(child, Preferred)),
+                                 MinSizeOppositeWrap(horizontal ? getHeight(child, Minimum) : getWidth(child, Minimum)),
+                                 expansive));
+        }
+
+        std::vector<Rect> childRects;
+        LinearLayoutManager layout(inNode->mOrient);
+        layout.getRects(inClientRect, inNode->mAlign, sizeInfos, childRects);
+        for (size_t idx = 0; idx != children.size(); ++idx)
+        {
+            layoutNode(children[idx], childRects[idx]);
+        }
+    }
+
+
+    void HeadlessLayout::layoutGrid(HeadlessNode * inNode, const Rect & inClientRect)
+    {
+        // See Grid::rebuildLayout.
+        HeadlessNode * rows = 0;
+        HeadlessNode * columns = 0;
+        for (size_t idx = 0; idx != inNode->mChildren.size(); ++idx)
+        {
+            HeadlessNode * child = inNode->mChildren[idx];
+            if (child->tagName() == "rows")
+            {
+                rows = child;
+            }
+            else if (child->tagName() == "columns")
+            {
+                columns = child;
+            }
+        }
+        if (!rows || !columns)
+        {
+            ReportError("XMLGrid has no rows or no columns!");
+            return;
+        }
+
+        std::vector<HeadlessNode *> columnNodes;
+        std::vector<SizeInfo> colWidths;
+        for (size_t idx = 0; idx != columns->mChildren.size(); ++idx)
+        {
+            HeadlessNode * column = columns->mChildren[idx];
+            if (column->tagName() == "column")
+            {
+                columnNodes.push_back(column);
+                colWidths.push_back(
+                    SizeInfo(FlexWrap(column->mFlex),
+                             MinSizeWrap(getWidth(column, Minimum)),
+                             OptSizeWrap(getWidth(column, Preferred))));
+            }
+        }
+
+        std::vector<HeadlessNode *> rowNodes;
+        std::vector<SizeInfo> rowHeights;
+        for (size_t idx = 0; idx != rows->mChildren.size(); ++idx)
+        {
+            HeadlessNode * row = rows->mChildren[idx];
+            if (row->tagName() == "row")
+            {
+                rowNodes.push_back(row);
+                rowHeights.push_back(
+                    SizeInfo(FlexWrap(row->mFlex),
+                             MinSizeWrap(getHeight(row, Minimum)),
+                             OptSizeWrap(getHeight(row, Preferred))));
+            }
+        }
+
+        if (colWidths.empty() || rowHeights.empty())
+        {
+            ReportError("XMLGrid has no rows or no columns!");
+            return;
+        }
+
+        size_t numRows = rowNodes.size();
+        size_t numCols = columnNodes.size();
+        GenericGrid<Rect> outerRects(numRows, numCols);
+        GridLayoutManager::GetOuterRects(inClientRect, colWidths, rowHeights, outerRects);
+
+        // The cells of each row, in column order.
+        GenericGrid<HeadlessNode *> cells(numRows, numCols, 0);
+        GenericGrid<CellInfo> cellInfos(numRows, numCols, CellInfo(0, 0, Start, Start));
+        for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
+        {
+            HeadlessNode * row = rowNodes[rowIdx];
+            size_t colIdx = 0;
+            for (size_t idx = 0; idx != row->mChildren.size() && colIdx != numCols; ++idx)
+            {
+                HeadlessNode * cell = row->mChildren[idx];
+                if (cell->mType < 0)
+                {
+                    continue;
+                }
+                cells.set(rowIdx, colIdx, cell);
+                cellInfos.set(rowIdx, colIdx,
+                              CellInfo(getCellSize(cell, true),
+                                       getCellSize(cell, false),
+                                       row->mAlign,
+                                       columnNodes[colIdx]->mAlign));
+                colIdx++;
+            }
+        }
+
+        GenericGrid<Rect> innerRects(numRows, numCols);
+        GridLayoutManager::GetInnerRects(outerRects, cellInfos, innerRects);
+
+        // Rows and columns have no window. They get the area of their
+        // track, which is what a snapshot of the layout should show.
+        rows->mRect = inClientRect;
+        columns->mRect = inClientRect;
+        for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
+        {
+            const Rect & outerRect = outerRects.get(0, colIdx);
+            columnNodes[colIdx]->mRect = Rect(outerRect.x(), inClientRect.y(), outerRect.width(), inClientRect.height());
+        }
+        for (size_t rowIdx = 0; rowIdx != numRows; ++rowIdx)
+        {
+            const Rect & outerRect = outerRects.get(rowIdx, 0);
+            rowNodes[rowIdx]->mRect = Rect(inClientRect.x(), outerRect.y(), inClientRect.width(), outerRect.height());
+            for (size_t colIdx = 0; colIdx != numCols; ++colIdx)
+            {
+                if (HeadlessNode * cell = cells.get(rowIdx, colIdx))
+                {
+                    layoutNode(cell, innerRects.get(rowIdx, colIdx));
+                }
+            }
+        }
+    }
+
+
+    void HeadlessLayout::dump(std::ostream & outStream) const
+    {
+        if (mRootNode)
+        {
+            dump(mRootNode.get(), 0, outStream);
+        }
+    }
+
+
+    void HeadlessLayout::dump(const HeadlessNode * inNode, int inDepth, std::ostream & outStream) const
+    {
+        const Rect & rect = inNode->rect();
+        outStream << std::string(2 * inDepth, ' ') << inNode->tagName();
+        const std::string & id = inNode->getAttribute("id");
+        if (!id.empty())
+        {
+            outStream << "#" << id;
+        }
+        outStream << " " << rect.x() << " " << rect.y() << " " << rect.width() << " " << rect.height() << "\n";
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            dump(inNode->getChild(idx), inDepth + 1, outStream);
+        }
+    }
+
+} // namespace XULWin
@@ -4,6 +4,7 @@
 #include "XULWin/ChromeURL.h"
 #include "XULWin/Defaults.h"
 #include "XULWin/Component.h"
+#include "XULWin/Compositing.h"
 #include "XULWin/GdiplusLoader.h"
 #include "XULWin/Gdiplus.h"
 #include "Poco/Path.h"
@@ -17,6 +18,47 @@
 namespace XULWin
 {
 
+    // Scales inSource to the size of outTarget with the software compositor.
+    // Returns false if the image is enlarged, because GDI+ gives smoother
+    // results with high quality bicubic interpolation. Also returns false if
+    // the image is reduced too much for bilinear filtering, or if the pixels
+    // can't be accessed.
+    static bool ScaleBitmapBilinear(Gdiplus::Bitmap & inSource, Gdiplus::Bitmap & outTarget)
+    {
+        INT sourceWidth = static_cast<INT>(inSource.GetWidth());
+        INT sourceHeight = static_cast<INT>(inSource.GetHeight());
+        INT width = static_cast<INT>(outTarget.GetWidth());
+        INT height = static_cast<INT>(outTarget.GetHeight());
+        if (width > sourceWidth || height > sourceHeight ||
+            2 * width < sourceWidth || 2 * height < sourceHeight ||
+            sourceWidth >= 32768 || sourceHeight >= 32768 || width >= 32768 || height >= 32768)
+        {
+            return false;
+        }
+
+        Gdiplus::Rect sourceRect(0, 0, sourceWidth, sourceHeight);
+        Gdiplus::BitmapData sourceData;
+        if (inSource.LockBits(&sourceRect, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &sourceData) != Gdiplus::Ok)
+        {
+            return false;
+        }
+
+        Gdiplus::Rect targetRect(0, 0, width, height);
+        Gdiplus::BitmapData targetData;
+        if (outTarget.LockBits(&targetRect, Gdiplus::ImageLockModeWrite, PixelFormat32bppPARGB, &targetData) != Gdiplus::Ok)
+        {
+            inSource.UnlockBits(&sourceData);
+            return false;
+        }
+
+        ScaleImageBilinear(static_cast<const unsigned int *>(sourceData.Scan0), sourceWidth, sourceHeight, sourceData.Stride / 4,
+                           static_cast<unsigned int *>(targetData.Scan0), width, height, targetData.Stride / 4);
+        outTarget.UnlockBits(&targetData);
+        inSource.UnlockBits(&sourceData);
+        return true;
+    }
+
+
     Component * CreateImage(XULWin::Component * inParent, const AttributesMapping & inAttr)
     {
         return new MarginDecorator(new Image(inParent, inAttr));
@@ -55,6 +97,7 @@ namespace XULWin
         {
             mImage.reset();
         }
+        invalidateSizeCache();
     }
 
 
@@ -166,12 +209,16 @@ namespace XULWin
         if (mImage && (w != clientRect().width() || h != clientRect().height()))
         {
             // create a resized copy of the original
-            mCachedImage.reset(new Gdiplus::Bitmap(w, h, PixelFormat32bppARGB));
+            mCachedImage.reset(new Gdiplus::Bitmap(w, h, PixelFormat32bppPARGB));
 
-            Gdiplus::Graphics g(mCachedImage.get());
-            g.SetInterpolationMode(Gdiplus::InterpolationModeHighQuality);
-            g.SetSmoothingMode(Gdiplus::SmoothingModeHighQuality);
-            g.DrawImage(mImage.get(), Gdiplus::Rect(0, 0, INT(w), INT(h)));
+            // enlargements and large reductions are left to GDI+
+            if (!ScaleBitmapBilinear(*mImage, *mCachedImage))
+            {
+                Gdiplus::Graphics g(mCachedImage.get());
+                g.SetInterpolationMode(Gdiplus::InterpolationModeHighQuality);
+                g.SetSmoothingMode(Gdiplus::SmoothingModeHighQuality);
+                g.DrawImage(mImage.get(), Gdiplus::Rect(0, 0, INT(w), INT(h)));
+            }
         }
         Super::move(x, y, w, h);
     }
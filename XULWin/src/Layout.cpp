@@ -1,112 +1,219 @@
 #include "XULWin/Layout.h"
 #include "XULWin/ErrorReporter.h"
+#include "XULWin/Types.h"
+#include <algorithm>
 #include <assert.h>
 
 
 namespace XULWin
 {
 
-    void LinearLayoutManager::GetSizes(int inLength,
-                                       const std::vector<int> & inFlexValues,
-                                       std::vector<int> & outSizes)
+    namespace
     {
-        assert(outSizes.empty());
 
-        int sumOfProportions = 0;
-        for (size_t idx = 0; idx != inFlexValues.size(); ++idx)
+        // The item that ends at inCumulativeWeight gets the space between the
+        // end of its predecessor and its own end. Each share differs less
+        // than one from its exact value and the shares add up to inLength.
+        int GetShareEnd(int inLength, Int64 inCumulativeWeight, Int64 inTotalWeight)
         {
-            sumOfProportions += inFlexValues[idx];
+            return static_cast<int>(static_cast<Int64>(inLength) * inCumulativeWeight / inTotalWeight);
         }
 
-        for (size_t idx = 0; idx != inFlexValues.size(); ++idx)
+
+        int GetMinSize(const SizeInfo & inSizeInfo)
         {
-            int proportion = 0;
-            if (inFlexValues[idx] != 0 && sumOfProportions != 0)
-            {
-                proportion = (int)(0.5 + (float)inLength*(float)inFlexValues[idx]/(float)sumOfProportions);
-            }
-            outSizes.push_back(proportion);
+            return std::max<int>(inSizeInfo.MinSize, 0);
         }
-    }
 
 
-    void LinearLayoutManager::GetSizes
-    (
-        int inLength,
-        const std::vector<SizeInfo> & inFlexValues,
-        std::vector<int> & outSizes
-    )
-    {
-        assert(outSizes.empty());
+        int GetOptSize(const SizeInfo & inSizeInfo)
+        {
+            return std::max<int>(inSizeInfo.OptSize, GetMinSize(inSizeInfo));
+        }
 
-        int availableLength = inLength;
-        std::vector<int> flexValues;
-        for (size_t idx = 0; idx != inFlexValues.size(); ++idx)
+
+        // Orders flex items by optimal size per unit of flex, largest first.
+        template<class SizeInfoType>
+        class CompareOptSizePerFlex
         {
-            if (inFlexValues[idx].Flex != 0)
+        public:
+            CompareOptSizePerFlex(const SizeInfoType * inSizeInfos) : mSizeInfos(inSizeInfos) {}
+
+            bool operator()(int inLeft, int inRight) const
             {
-                // it's a widget with flex
-                flexValues.push_back(inFlexValues[idx].Flex);
+                const SizeInfo & left = mSizeInfos[inLeft];
+                const SizeInfo & right = mSizeInfos[inRight];
+                return static_cast<Int64>(GetOptSize(left)) * right.Flex > static_cast<Int64>(GetOptSize(right)) * left.Flex;
             }
-            else
+
+        private:
+            const SizeInfoType * mSizeInfos;
+        };
+
+
+        // SizeInfoType is SizeInfo or ExtendedSizeInfo. A template, because
+        // an array of ExtendedSizeInfo can't be walked with a SizeInfo pointer.
+        template<class SizeInfoType>
+        void SolveSizes(int inLength, const SizeInfoType * inSizeInfos, size_t inCount, int * outSizes)
+        {
+            int minSize = 0;
+            int optSize = 0;
+            int fixedOptSize = 0;
+            Int64 totalFlex = 0;
+            for (size_t idx = 0; idx != inCount; ++idx)
             {
-                // it's a widget without flex
-                availableLength -= inFlexValues[idx].MinSize;
+                const SizeInfo & info = inSizeInfos[idx];
+                minSize += GetMinSize(info);
+                optSize += GetOptSize(info);
+                if (info.Flex > 0)
+                {
+                    totalFlex += info.Flex;
+                }
+                else
+                {
+                    fixedOptSize += GetOptSize(info);
+                }
             }
-        }
-        std::vector<int> sizes;
-        GetSizes(availableLength, flexValues, sizes);
 
-        std::vector<int> componentsToTrim_FlexValues;
-        std::vector<int> componentsToTrim_Indices;
+            if (inLength < optSize)
+            {
+                // Every item shrinks from its optimal size towards its
+                // minimum size, in proportion to how much it can shrink.
+                int extra = std::max<int>(inLength - minSize, 0);
+                Int64 totalShrink = optSize - minSize;
+                Int64 cumulativeShrink = 0;
+                int prevEnd = 0;
+                for (size_t idx = 0; idx != inCount; ++idx)
+                {
+                    const SizeInfo & info = inSizeInfos[idx];
+                    outSizes[idx] = GetMinSize(info);
+                    if (totalShrink > 0)
+                    {
+                        cumulativeShrink += GetOptSize(info) - GetMinSize(info);
+                        int end = GetShareEnd(extra, cumulativeShrink, totalShrink);
+                        outSizes[idx] += end - prevEnd;
+                        prevEnd = end;
+                    }
+                }
+                return;
+            }
 
-        int sizesIdx = 0;
-        int amountExceeded = 0;
-        for (size_t idx = 0; idx != inFlexValues.size(); ++idx)
-        {
-            if (inFlexValues[idx].Flex != 0)
+            // The flex items share what the others leave, but an item whose
+            // share is smaller than its optimal size gets its optimal size.
+            // Fixing an item at its optimal size lowers the share per unit of
+            // flex of the others, so the items are visited from the largest
+            // optimal size per unit of flex down, and the first one that fits
+            // ends the pass. The last one always fits because the optimal
+            // sizes fit. outSizes holds the indices of the flex items until
+            // the sizes are written.
+            int remaining = inLength - fixedOptSize;
+            size_t numFlexItems = 0;
+            for (size_t idx = 0; idx != inCount; ++idx)
             {
-                int size = sizes[sizesIdx];
-                if (size < inFlexValues[idx].MinSize)
+                if (inSizeInfos[idx].Flex > 0)
                 {
-                    int minSize = inFlexValues[idx].MinSize;
-                    amountExceeded += minSize - size;
-                    size = inFlexValues[idx].MinSize;
+                    outSizes[numFlexItems++] = static_cast<int>(idx);
                 }
-                else if (size > inFlexValues[idx].MinSize)
+            }
+            std::sort(outSizes, outSizes + numFlexItems, CompareOptSizePerFlex<SizeInfoType>(inSizeInfos));
+            for (size_t flexIdx = 0; flexIdx != numFlexItems; ++flexIdx)
+            {
+                const SizeInfo & info = inSizeInfos[outSizes[flexIdx]];
+                if (static_cast<Int64>(GetOptSize(info)) * totalFlex <= static_cast<Int64>(remaining) * info.Flex)
                 {
-                    componentsToTrim_FlexValues.push_back(inFlexValues[idx].Flex);
-                    componentsToTrim_Indices.push_back(idx);
+                    break;
                 }
-                outSizes.push_back(size);
-                sizesIdx++;
+                remaining -= GetOptSize(info);
+                totalFlex -= info.Flex;
             }
-            else
+
+            // The items that were fixed are exactly those whose optimal size
+            // per unit of flex exceeds the final share per unit of flex.
+            Int64 cumulativeFlex = 0;
+            int prevEnd = 0;
+            for (size_t idx = 0; idx != inCount; ++idx)
             {
-                outSizes.push_back(inFlexValues[idx].MinSize);
+                const SizeInfo & info = inSizeInfos[idx];
+                if (info.Flex <= 0 || static_cast<Int64>(GetOptSize(info)) * totalFlex > static_cast<Int64>(remaining) * info.Flex)
+                {
+                    outSizes[idx] = GetOptSize(info);
+                }
+                else
+                {
+                    cumulativeFlex += info.Flex;
+                    int end = GetShareEnd(remaining, cumulativeFlex, totalFlex);
+                    outSizes[idx] = end - prevEnd;
+                    prevEnd = end;
+                }
             }
         }
 
-        // If we lack the space to display all components, we gonna trim the
-        // flex widgets according to their own flex values. So widgets with
-        // high flex will lose more space.
-        if (amountExceeded > 0 && !componentsToTrim_FlexValues.empty())
+    } // anonymous namespace
+
+
+    void LinearLayoutManager::GetSizes(int inLength, const int * inWeights, size_t inCount, int * outSizes)
+    {
+        int length = std::max<int>(inLength, 0);
+        Int64 totalWeight = 0;
+        for (size_t idx = 0; idx != inCount; ++idx)
+        {
+            totalWeight += std::max<int>(inWeights[idx], 0);
+        }
+
+        Int64 cumulativeWeight = 0;
+        int prevEnd = 0;
+        for (size_t idx = 0; idx != inCount; ++idx)
         {
-            std::vector<int> spacerCuts;
-            GetSizes(amountExceeded, componentsToTrim_FlexValues, spacerCuts);
-            if (!spacerCuts.empty())
+            if (totalWeight == 0)
             {
-                for (size_t idx = 0; idx != componentsToTrim_Indices.size(); ++idx)
-                {
-                    int flexIdx = componentsToTrim_Indices[idx];
-                    outSizes[flexIdx] -= spacerCuts[idx];
-                    if (outSizes[idx] < inFlexValues[flexIdx].MinSize)
-                    {
-                        int size = inFlexValues[flexIdx].MinSize;
-                        outSizes[flexIdx] = size;
-                    }
-                }
+                outSizes[idx] = 0;
+                continue;
             }
+            cumulativeWeight += std::max<int>(inWeights[idx], 0);
+            int end = GetShareEnd(length, cumulativeWeight, totalWeight);
+            outSizes[idx] = end - prevEnd;
+            prevEnd = end;
+        }
+    }
+
+
+    void LinearLayoutManager::GetSizes(int inLength, const SizeInfo * inSizeInfos, size_t inCount, int * outSizes)
+    {
+        SolveSizes(inLength, inSizeInfos, inCount, outSizes);
+    }
+
+
+    void LinearLayoutManager::GetSizes(int inLength, const ExtendedSizeInfo * inSizeInfos, size_t inCount, int * outSizes)
+    {
+        SolveSizes(inLength, inSizeInfos, inCount, outSizes);
+    }
+
+
+    void LinearLayoutManager::GetSizes(int inLength,
+                                       const std::vector<int> & inFlexValues,
+                                       std::vector<int> & outSizes)
+    {
+        assert(outSizes.empty());
+        outSizes.resize(inFlexValues.size());
+        if (!inFlexValues.empty())
+        {
+            GetSizes(inLength, &inFlexValues[0], inFlexValues.size(), &outSizes[0]);
+        }
+    }
+
+
+    void LinearLayoutManager::GetSizes
+    (
+        int inLength,
+        const std::vector<SizeInfo> & inFlexValues,
+        std::vector<int> & outSizes
+    )
+    {
+        assert(outSizes.empty());
+        outSizes.resize(inFlexValues.size());
+        if (!inFlexValues.empty())
+        {
+            GetSizes(inLength, &inFlexValues[0], inFlexValues.size(), &outSizes[0]);
         }
     }
 
@@ -128,14 +235,12 @@ namespace XULWin
                                        const std::vector<ExtendedSizeInfo> & inSizeInfos,
                                        std::vector<Rect> & outRects)
     {
-        std::vector<int> sizes;
-
-        std::vector<SizeInfo> sizeInfos;
-        for (size_t idx = 0; idx != inSizeInfos.size(); ++idx)
+        std::vector<int> sizes(inSizeInfos.size());
+        if (!inSizeInfos.empty())
         {
-            sizeInfos.push_back(inSizeInfos[idx]);
+            GetSizes(mOrient == Horizontal ? inRect.width() : inRect.height(),
+                     &inSizeInfos[0], inSizeInfos.size(), &sizes[0]);
         }
-        GetSizes(mOrient == Horizontal ? inRect.width() : inRect.height(), sizeInfos, sizes);
         int xOffset = inRect.x();
         int yOffset = inRect.y();
         bool horizontal = mOrient == Horizontal;
@@ -179,14 +284,19 @@ namespace XULWin
                     x = xOffset + inRect.width() - inSizeInfos[idx].MinSizeOpposite;
                 }
             }
-            else if (inAlign == Stretch)
+
+            // Expansive items, like separators, fill the box in the opposite
+            // direction regardless of the alignment.
+            if (inAlign == Stretch || inSizeInfos[idx].Expansive)
             {
                 if (horizontal)
                 {
+                    y = inRect.y();
                     h = inRect.height();
                 }
                 else if (vertical)
                 {
+                    x = inRect.x();
                     w = inRect.width();
                 }
             }
@@ -0,0 +1,338 @@
+#include "XULWin/LayoutSnapshot.h"
+#include "XULWin/ErrorReporter.h"
+#include "XULWin/HeadlessLayout.h"
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        const char * cHeader = "# XULWin layout snapshot 1";
+
+        const int cNumFields = 8;
+
+        const char * cFieldNames[cNumFields] =
+        {
+            "x", "y", "width", "height", "minwidth", "minheight", "prefwidth", "prefheight"
+        };
+
+
+        void GetFields(const LayoutSnapshot::Entry & inEntry, int * outFields)
+        {
+            outFields[0] = inEntry.rect.x();
+            outFields[1] = inEntry.rect.y();
+            outFields[2] = inEntry.rect.width();
+            outFields[3] = inEntry.rect.height();
+            outFields[4] = inEntry.minimumWidth;
+            outFields[5] = inEntry.minimumHeight;
+            outFields[6] = inEntry.preferredWidth;
+            outFields[7] = inEntry.preferredHeight;
+        }
+
+
+        void SetFields(const int * inFields, LayoutSnapshot::Entry & outEntry)
+        {
+            outEntry.rect = Rect(inFields[0], inFields[1], inFields[2], inFields[3]);
+            outEntry.minimumWidth = inFields[4];
+            outEntry.minimumHeight = inFields[5];
+            outEntry.preferredWidth = inFields[6];
+            outEntry.preferredHeight = inFields[7];
+        }
+
+
+        void WriteFields(const LayoutSnapshot::Entry & inEntry, std::ostream & outStream)
+        {
+            int fields[cNumFields];
+            GetFields(inEntry, fields);
+            for (int idx = 0; idx != cNumFields; ++idx)
+            {
+                outStream << (idx == 0 ? "" : " ") << fields[idx];
+            }
+        }
+
+
+        bool ParseInt(const std::string & inValue, int & outValue)
+        {
+            std::istringstream ss(inValue);
+            return (ss >> outValue) && ss.eof();
+        }
+
+
+        // The path may contain spaces, so the fields are read from the end.
+        bool ParseEntry(const std::string & inLine, LayoutSnapshot::Entry & outEntry)
+        {
+            int fields[cNumFields];
+            std::string::size_type end = inLine.find_last_not_of(" \t\r");
+            for (int idx = cNumFields - 1; idx >= 0; --idx)
+            {
+                if (end == std::string::npos)
+                {
+                    return false;
+                }
+
+                std::string::size_type begin = inLine.find_last_of(" \t", end);
+                if (begin == std::string::npos || !ParseInt(inLine.substr(begin + 1, end - begin), fields[idx]))
+                {
+                    return false;
+                }
+                end = inLine.find_last_not_of(" \t", begin);
+            }
+
+            if (end == std::string::npos)
+            {
+                return false;
+            }
+            outEntry.path = inLine.substr(0, end + 1);
+            SetFields(fields, outEntry);
+            return true;
+        }
+
+    }
+
+
+    LayoutSnapshot::Entry::Entry() :
+        minimumWidth(0),
+        minimumHeight(0),
+        preferredWidth(0),
+        preferredHeight(0)
+    {
+    }
+
+
+    bool LayoutSnapshot::Entry::operator==(const Entry & inOther) const
+    {
+        return path == inOther.path &&
+               rect == inOther.rect &&
+               minimumWidth == inOther.minimumWidth &&
+               minimumHeight == inOther.minimumHeight &&
+               preferredWidth == inOther.preferredWidth &&
+               preferredHeight == inOther.preferredHeight;
+    }
+
+
+    bool LayoutSnapshot::Entry::operator!=(const Entry & inOther) const
+    {
+        return !(*this == inOther);
+    }
+
+
+    LayoutSnapshot::LayoutSnapshot()
+    {
+    }
+
+
+    LayoutSnapshot::LayoutSnapshot(const HeadlessLayout & inLayout)
+    {
+        if (const HeadlessNode * rootNode = inLayout.rootNode())
+        {
+            add(inLayout, rootNode, rootNode->tagName());
+        }
+    }
+
+
+    void LayoutSnapshot::add(const HeadlessLayout & inLayout, const HeadlessNode * inNode, const std::string & inPath)
+    {
+        Entry entry;
+        entry.path = inPath;
+        const std::string & id = inNode->getAttribute("id");
+        if (!id.empty())
+        {
+            entry.path += "#" + id;
+        }
+        entry.rect = inNode->rect();
+        entry.minimumWidth = inLayout.getWidth(inNode, Minimum);
+        entry.minimumHeight = inLayout.getHeight(inNode, Minimum);
+        entry.preferredWidth = inLayout.getWidth(inNode, Preferred);
+        entry.preferredHeight = inLayout.getHeight(inNode, Preferred);
+        mEntries.push_back(entry);
+
+        std::map<std::string, int> tagCounts;
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            tagCounts[inNode->getChild(idx)->tagName()]++;
+        }
+
+        std::map<std::string, int> tagIndices;
+        for (size_t idx = 0; idx != inNode->getChildCount(); ++idx)
+        {
+            const HeadlessNode * child = inNode->getChild(idx);
+            std::stringstream path;
+            path << entry.path << "/" << child->tagName();
+            int tagIndex = ++tagIndices[child->tagName()];
+            if (tagCounts[child->tagName()] > 1)
+            {
+                path << "[" << tagIndex << "]";
+            }
+            add(inLayout, child, path.str());
+        }
+    }
+
+
+    size_t LayoutSnapshot::size() const
+    {
+        return mEntries.size();
+    }
+
+
+    const LayoutSnapshot::Entry & LayoutSnapshot::get(size_t idx) const
+    {
+        return mEntries[idx];
+    }
+
+
+    bool LayoutSnapshot::operator==(const LayoutSnapshot & inOther) const
+    {
+        return mEntries == inOther.mEntries;
+    }
+
+
+    bool LayoutSnapshot::operator!=(const LayoutSnapshot & inOther) const
+    {
+        return !(*this == inOther);
+    }
+
+
+    void LayoutSnapshot::write(std::ostream & outStream) const
+    {
+        outStream << cHeader << "\n";
+        for (size_t idx = 0; idx != mEntries.size(); ++idx)
+        {
+            outStream << mEntries[idx].path << " ";
+            WriteFields(mEntries[idx], outStream);
+            outStream << "\n";
+        }
+    }
+
+
+    bool LayoutSnapshot::read(std::istream & inStream)
+    {
+        mEntries.clear();
+        std::string line;
+        if (!std::getline(inStream, line) || line.substr(0, line.find_last_not_of("\r") + 1) != cHeader)
+        {
+            ReportError("LayoutSnapshot: the stream doesn't start with \"" + std::string(cHeader) + "\".");
+            return false;
+        }
+
+        int lineNumber = 1;
+        while (std::getline(inStream, line))
+        {
+            lineNumber++;
+            if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            {
+                continue;
+            }
+
+            Entry entry;
+            if (!ParseEntry(line, entry))
+            {
+                std::stringstream ss;
+                ss << "LayoutSnapshot: invalid entry on line " << lineNumber << ": " << line;
+                ReportError(ss.str());
+                mEntries.clear();
+                return false;
+            }
+            mEntries.push_back(entry);
+        }
+        return true;
+    }
+
+
+    void LayoutSnapshot::Compare(const LayoutSnapshot & inBefore,
+                                 const LayoutSnapshot & inAfter,
+                                 std::vector<Delta> & outDeltas)
+    {
+        std::map<std::string, size_t> afterIndices;
+        for (size_t idx = 0; idx != inAfter.mEntries.size(); ++idx)
+        {
+            afterIndices.insert(std::make_pair(inAfter.mEntries[idx].path, idx));
+        }
+
+        std::vector<bool> matched(inAfter.mEntries.size(), false);
+        for (size_t idx = 0; idx != inBefore.mEntries.size(); ++idx)
+        {
+            const Entry & before = inBefore.mEntries[idx];
+            std::map<std::string, size_t>::const_iterator it = afterIndices.find(before.path);
+            if (it == afterIndices.end())
+            {
+                Delta delta;
+                delta.kind = Delta::Kind_Removed;
+                delta.before = before;
+                outDeltas.push_back(delta);
+                continue;
+            }
+
+            matched[it->second] = true;
+            const Entry & after = inAfter.mEntries[it->second];
+            if (before != after)
+            {
+                Delta delta;
+                delta.kind = Delta::Kind_Changed;
+                delta.before = before;
+                delta.after = after;
+                outDeltas.push_back(delta);
+            }
+        }
+
+        for (size_t idx = 0; idx != inAfter.mEntries.size(); ++idx)
+        {
+            if (!matched[idx])
+            {
+                Delta delta;
+                delta.kind = Delta::Kind_Added;
+                delta.after = inAfter.mEntries[idx];
+                outDeltas.push_back(delta);
+            }
+        }
+    }
+
+
+    void LayoutSnapshot::WriteDeltas(const std::vector<Delta> & inDeltas, std::ostream & outStream)
+    {
+        for (size_t idx = 0; idx != inDeltas.size(); ++idx)
+        {
+            const Delta & delta = inDeltas[idx];
+            switch (delta.kind)
+            {
+                case Delta::Kind_Changed:
+                {
+                    int before[cNumFields];
+                    int after[cNumFields];
+                    GetFields(delta.before, before);
+                    GetFields(delta.after, after);
+                    outStream << "changed " << delta.after.path << ":";
+                    const char * separator = " ";
+                    for (int field = 0; field != cNumFields; ++field)
+                    {
+                        if (before[field] != after[field])
+                        {
+                            outStream << separator << cFieldNames[field] << " " << before[field] << " -> " << after[field];
+                            separator = ", ";
+                        }
+                    }
+                    break;
+                }
+                case Delta::Kind_Added:
+                {
+                    outStream << "added " << delta.after.path << ": ";
+                    WriteFields(delta.after, outStream);
+                    break;
+                }
+                case Delta::Kind_Removed:
+                {
+                    outStream << "removed " << delta.before.path << ": ";
+                    WriteFields(delta.before, outStream);
+                    break;
+                }
+            }
+            outStream << "\n";
+        }
+    }
+
+} // namespace XULWin
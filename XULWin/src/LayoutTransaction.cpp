@@ -0,0 +1,201 @@
+#include "XULWin/LayoutTransaction.h"
+#include "XULWin/Windows.h"
+#include <cassert>
+
+
+namespace XULWin
+{
+
+    LayoutTransaction * LayoutTransaction::sCurrent(0);
+
+
+    void LayoutTransaction::DeferWindowPosBackend::commit(const Moves & inMoves)
+    {
+        // All windows in a DeferWindowPos batch must have the same parent.
+        typedef std::map<HWND, Moves> MovesByParent;
+        MovesByParent movesByParent;
+        for (size_t idx = 0; idx != inMoves.size(); ++idx)
+        {
+            const Move & move = inMoves[idx];
+            HWND parent = ::GetParent(static_cast<HWND>(move.handle));
+            MovesByParent::iterator it = movesByParent.find(parent);
+            if (it == movesByParent.end())
+            {
+                it = movesByParent.insert(std::make_pair(parent, Moves())).first;
+            }
+            it->second.push_back(move);
+        }
+
+        MovesByParent::const_iterator it = movesByParent.begin(), end = movesByParent.end();
+        for (; it != end; ++it)
+        {
+            const Moves & moves = it->second;
+            HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(moves.size()));
+            for (size_t idx = 0; hdwp && idx != moves.size(); ++idx)
+            {
+                const Move & move = moves[idx];
+                hdwp = ::DeferWindowPos(hdwp,
+                                        static_cast<HWND>(move.handle),
+                                        0,
+                                        move.rect.x(),
+                                        move.rect.y(),
+                                        move.rect.width(),
+                                        move.rect.height(),
+                                        SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOREDRAW);
+            }
+
+            if (hdwp)
+            {
+                ::EndDeferWindowPos(hdwp);
+            }
+            else
+            {
+                // If DeferWindowPos fails the entire batch is discarded.
+                // Fall back to moving the windows one by one.
+                for (size_t idx = 0; idx != moves.size(); ++idx)
+                {
+                    const Move & move = moves[idx];
+                    ::MoveWindow(static_cast<HWND>(move.handle),
+                                 move.rect.x(),
+                                 move.rect.y(),
+                                 move.rect.width(),
+                                 move.rect.height(),
+                                 FALSE);
+                }
+            }
+        }
+    }
+
+
+    void LayoutTransaction::RecordingBackend::commit(const Moves & inMoves)
+    {
+        mCommits.push_back(inMoves);
+    }
+
+
+    const std::vector<LayoutTransaction::Moves> & LayoutTransaction::RecordingBackend::commits() const
+    {
+        return mCommits;
+    }
+
+
+    void LayoutTransaction::RecordingBackend::clear()
+    {
+        mCommits.clear();
+    }
+
+
+    LayoutTransaction::LayoutTransaction() :
+        mBackend(&mDefaultBackend),
+        mOwns(sCurrent == 0)
+    {
+        if (mOwns)
+        {
+            sCurrent = this;
+        }
+    }
+
+
+    LayoutTransaction::LayoutTransaction(Backend & inBackend) :
+        mBackend(&inBackend),
+        mOwns(sCurrent == 0)
+    {
+        assert(mOwns || sCurrent->mBackend == &inBackend);
+        if (mOwns)
+        {
+            sCurrent = this;
+        }
+    }
+
+
+    LayoutTransaction::~LayoutTransaction()
+    {
+        if (mOwns)
+        {
+            // Committing may cause new moves to be recorded.
+            while (!mMoves.empty())
+            {
+                commit();
+            }
+            sCurrent = 0;
+        }
+    }
+
+
+    LayoutTransaction * LayoutTransaction::Current()
+    {
+        return sCurrent;
+    }
+
+
+    void LayoutTransaction::MoveWindow(Handle inHandle, const Rect & inRect)
+    {
+        if (sCurrent)
+        {
+            sCurrent->record(inHandle, inRect);
+        }
+        else
+        {
+            ::MoveWindow(static_cast<HWND>(inHandle), inRect.x(), inRect.y(), inRect.width(), inRect.height(), FALSE);
+        }
+    }
+
+
+    bool LayoutTransaction::GetPendingRect(Handle inHandle, Rect & outRect)
+    {
+        return sCurrent && sCurrent->getPendingRect(inHandle, outRect);
+    }
+
+
+    void LayoutTransaction::Flush()
+    {
+        if (sCurrent)
+        {
+            sCurrent->commit();
+        }
+    }
+
+
+    void LayoutTransaction::record(Handle inHandle, const Rect & inRect)
+    {
+        Indices::iterator it = mIndices.find(inHandle);
+        if (it != mIndices.end())
+        {
+            mMoves[it->second].rect = inRect;
+        }
+        else
+        {
+            mIndices.insert(std::make_pair(inHandle, mMoves.size()));
+            mMoves.push_back(Move(inHandle, inRect));
+        }
+    }
+
+
+    bool LayoutTransaction::getPendingRect(Handle inHandle, Rect & outRect) const
+    {
+        Indices::const_iterator it = mIndices.find(inHandle);
+        if (it == mIndices.end())
+        {
+            return false;
+        }
+        outRect = mMoves[it->second].rect;
+        return true;
+    }
+
+
+    void LayoutTransaction::commit()
+    {
+        if (mMoves.empty())
+        {
+            return;
+        }
+
+        // Swap first, because moving the windows may trigger a nested
+        // layout pass that records new moves.
+        Moves moves;
+        moves.swap(mMoves);
+        mIndices.clear();
+        mBackend->commit(moves);
+    }
+
+} // namespace XULWin
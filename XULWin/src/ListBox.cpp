@@ -20,11 +20,13 @@ namespace XULWin
         {
             throw std::logic_error("inListBox is null!");
         }
+        mListBox->listModel().addListener(this);
     }
 
 
     ListBoxImpl::~ListBoxImpl()
     {
+        mListBox->listModel().removeListener(this);
     }
 
 
@@ -34,6 +36,12 @@ namespace XULWin
     }
 
 
+    void ListBoxImpl::onListModelChanged(ListModel::Change /*inChange*/, size_t /*inRow*/, size_t /*inCount*/)
+    {
+        rebuild();
+    }
+
+
     ListBoxImpl_ListBox::ListBoxImpl_ListBox(ListBox * inListBox) :
         ListBoxImpl(inListBox)
     {
@@ -58,16 +66,40 @@ namespace XULWin
 
     void ListBoxImpl_ListBox::rebuild()
     {
-        std::vector<XMLListItem*> listItems;
-        mListBox->el()->getElementsByType<XMLListItem>(listItems);
+        mWinAPI_ListBox->clear();
+        const ListModel & listModel = mListBox->listModel();
+        for (size_t idx = 0; idx != listModel.rowCount(); ++idx)
+        {
+            mWinAPI_ListBox->add(listModel.getLabel(idx, 0));
+        }
+    }
 
-        for (size_t idx = 0; idx != listItems.size(); ++idx)
+
+    void ListBoxImpl_ListBox::onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount)
+    {
+        // Appended and removed rows don't require a full rebuild.
+        const ListModel & listModel = mListBox->listModel();
+        if (inChange == ListModel::Change_RowsInserted &&
+            inRow == mWinAPI_ListBox->size() &&
+            inRow + inCount == listModel.rowCount())
+        {
+            for (size_t idx = inRow; idx != listModel.rowCount(); ++idx)
+            {
+                mWinAPI_ListBox->add(listModel.getLabel(idx, 0));
+            }
+            return;
+        }
+        if (inChange == ListModel::Change_RowsRemoved &&
+            inRow + inCount <= mWinAPI_ListBox->size() &&
+            mWinAPI_ListBox->size() - inCount == listModel.rowCount())
         {
-            if (ListItem * item = listItems[idx]->component()->downcast<ListItem>())
+            for (size_t idx = 0; idx != inCount; ++idx)
             {
-                mWinAPI_ListBox->add(item->getLabel());
+                mWinAPI_ListBox->removeByIndex(inRow);
             }
+            return;
         }
+        rebuild();
     }
 
 
@@ -95,33 +127,25 @@ namespace XULWin
 
     void ListBoxImpl_ListView::rebuild()
     {
-        std::vector<XMLListItem *> listItems;
-        mListBox->el()->getElementsByType<XMLListItem>(listItems);
-        
-
-        for (size_t itemIdx = 0; itemIdx != listItems.size(); ++itemIdx)
+        mWinAPI_ListView->clear();
+        const ListModel & listModel = mListBox->listModel();
+        for (size_t rowIdx = 0; rowIdx != listModel.rowCount(); ++rowIdx)
         {
-            if (ListItem * listItem = listItems[itemIdx]->component()->downcast<ListItem>())
+            const ListModel::Row & row = listModel.getRow(rowIdx);
+            for (size_t colIdx = 0; colIdx != row.size(); ++colIdx)
             {
-                Children & children = listItem->el()->children();
-
-                for (size_t colIdx = 0; colIdx != children.size(); ++colIdx)
+                const ListModel::Cell & cell = row[colIdx];
+                if (!cell.image.empty())
                 {
-                    if (ListCell * listCell = children[colIdx]->component()->downcast<ListCell>())
-                    {
-                        if (!listCell->getImage().empty())
-                        {
-                            mWinAPI_ListView->add(
-                                new WinAPI::ListItem_Image(mWinAPI_ListView.get(),
-                                                           WinAPI::CreateImage(listCell->getImage())));
-                        }
-                        else if (!listCell->getLabel().empty())
-                        {
-                            mWinAPI_ListView->add(
-                                new WinAPI::ListItem_Text(mWinAPI_ListView.get(),
-                                                          listCell->getLabel()));
-                        }
-                    }
+                    mWinAPI_ListView->add(
+                        new WinAPI::ListItem_Image(mWinAPI_ListView.get(),
+                                                   WinAPI::CreateImage(cell.image)));
+                }
+                else if (!cell.label.empty())
+                {
+                    mWinAPI_ListView->add(
+                        new WinAPI::ListItem_Text(mWinAPI_ListView.get(),
+                                                  cell.label));
                 }
             }
         }
@@ -195,6 +219,7 @@ namespace XULWin
     void ListBox::setRows(int inRows)
     {
         mRows = inRows;
+        invalidateSizeCache();
     }
 
 
@@ -224,6 +249,28 @@ namespace XULWin
     }
 
 
+    void ListBox::onChildRemoved(Component * inChild)
+    {
+        if (ListItem * item = inChild->downcast<ListItem>())
+        {
+            item->removeListModelRow();
+        }
+        Super::onChildRemoved(inChild);
+    }
+
+
+    ListModel & ListBox::listModel()
+    {
+        return mListModel;
+    }
+
+
+    const ListModel & ListBox::listModel() const
+    {
+        return mListModel;
+    }
+
+
     Component * CreateListCell(XULWin::Component * inParent, const AttributesMapping & inAttr)
     {
         return new Decorator(new ListCell(inParent, inAttr));
@@ -277,6 +324,10 @@ namespace XULWin
     void ListCell::setLabel(const std::string & inLabel)
     {
         mLabel = inLabel;
+        if (ListItem * item = parent()->downcast<ListItem>())
+        {
+            item->updateListModelRow();
+        }
     }
 
 
@@ -289,6 +340,10 @@ namespace XULWin
     void ListCell::setImage(const std::string & inImage)
     {
         mImage = inImage;
+        if (ListItem * item = parent()->downcast<ListItem>())
+        {
+            item->updateListModelRow();
+        }
     }
 
     
@@ -301,6 +356,8 @@ namespace XULWin
     ListCol::ListCol(Component * inParent, const AttributesMapping & inAttr) :
         Super(inParent, inAttr)
     {
+        // Width depends on the cells of the listbox's items.
+        mCacheSizes = false;
     }
 
 
@@ -465,7 +522,9 @@ namespace XULWin
 
     ListItem::ListItem(Component * inParent, const AttributesMapping & inAttr) :
         VirtualComponent(inParent, inAttr),
-        mSelected(false)
+        mSelected(false),
+        mListModel(0),
+        mListModelRow(0)
     {
     }
 
@@ -475,36 +534,72 @@ namespace XULWin
         // XUL hierarchy:
         // listbox/listitem/listcell
         //    ^---> listbox here has ListView object (not ListBox)
+        // The list view inserts the item when it is notified by its model.
+        // Items without cells get an empty row, so that the rows of the
+        // model keep matching the items of the list view.
         if (ListView * listView = parent()->downcast<ListView>())
         {
-            LVITEM lvItem;
-            lvItem.mask = LVIF_TEXT | LVIF_PARAM | LVIF_STATE;
-            lvItem.state = 0;
-            lvItem.stateMask = 0;
-            lvItem.iSubItem = 0;
-            lvItem.lParam = (LPARAM)0;
-            std::vector<XMLListCell *> listCells;
-            el()->getElementsByType<XMLListCell>(listCells);
-
-            if (!listCells.empty())
+            mListModel = &listView->listModel();
+            mListModelRow = mListModel->rowCount();
+            mListModel->appendRow(getListModelRow());
+        }
+        else if (ListBox * listBox = parent()->downcast<ListBox>())
+        {
+            mListModel = &listBox->listModel();
+            mListModelRow = mListModel->rowCount();
+            mListModel->appendRow(getListModelRow());
+        }
+        return Super::init();
+    }
+
+
+    ListModel::Row ListItem::getListModelRow() const
+    {
+        ListModel::Row result;
+        for (size_t idx = 0; idx != getChildCount(); ++idx)
+        {
+            if (const ListCell * cell = getChild(idx)->downcast<ListCell>())
             {
-                static std::vector<std::wstring> labels;
-                labels.clear();
+                result.push_back(ListModel::Cell(cell->getLabel(), cell->getImage()));
+            }
+        }
+        if (result.empty() && !getLabel().empty())
+        {
+            result.push_back(ListModel::Cell(getLabel()));
+        }
+        return result;
+    }
 
-                for (size_t idx = 0; idx != listCells.size(); ++idx)
-                {
-                    labels.push_back(ToUTF16(listCells[idx]->component()->downcast<ListCell>()->getLabel()));
-                }
-                lvItem.lParam = (LPARAM)labels[0].c_str();
-                lvItem.iItem = getIndex();
-                lvItem.pszText = LPSTR_TEXTCALLBACK;
-                if (-1 == ListView_InsertItem(listView->handle(), &lvItem))
-                {
-                    ReportError("Inserting item into list view failed. Reason: " + WinAPI::System_GetLastError(::GetLastError()));
-                }
+
+    void ListItem::updateListModelRow()
+    {
+        if (mListModel)
+        {
+            mListModel->setRow(mListModelRow, getListModelRow());
+        }
+    }
+
+
+    void ListItem::removeListModelRow()
+    {
+        if (!mListModel)
+        {
+            return;
+        }
+
+        // The last row is removed without visiting the siblings. This keeps
+        // Element::removeAllChildren linear, it removes the last child first.
+        bool isLastRow = mListModelRow + 1 == mListModel->rowCount();
+        for (size_t idx = 0; !isLastRow && idx != parent()->getChildCount(); ++idx)
+        {
+            ListItem * sibling = parent()->getChild(idx)->downcast<ListItem>();
+            if (sibling && sibling->mListModel == mListModel && sibling->mListModelRow > mListModelRow)
+            {
+                sibling->mListModelRow--;
             }
         }
-        return Super::init();
+        mListModel->removeRow(mListModelRow);
+        mListModel = 0;
     }
 
 
@@ -517,6 +612,8 @@ namespace XULWin
     void ListItem::setLabel(const std::string & inLabel)
     {
         mLabel = inLabel;
+        invalidateSizeCache();
+        updateListModelRow();
     }
 
 
@@ -577,11 +674,13 @@ namespace XULWin
         {
             mEventListener.connect(parent->el(), WM_NOTIFY, boost::bind(&ListView::handleGetDispInfo, this, _1, _2));
         }
+        mListModel.addListener(this);
     }
 
 
     ListView::~ListView()
     {
+        mListModel.removeListener(this);
     }
 
 
@@ -640,6 +739,80 @@ namespace XULWin
     }
 
 
+    void ListView::onChildRemoved(Component * inChild)
+    {
+        if (ListItem * item = inChild->downcast<ListItem>())
+        {
+            item->removeListModelRow();
+        }
+        Super::onChildRemoved(inChild);
+    }
+
+
+    ListModel & ListView::listModel()
+    {
+        return mListModel;
+    }
+
+
+    void ListView::onListModelChanged(ListModel::Change inChange, size_t inRow, size_t inCount)
+    {
+        switch (inChange)
+        {
+            case ListModel::Change_RowsInserted:
+            {
+                for (size_t idx = 0; idx != inCount; ++idx)
+                {
+                    insertItem(inRow + idx);
+                }
+                break;
+            }
+            case ListModel::Change_RowsRemoved:
+            {
+                for (size_t idx = 0; idx != inCount; ++idx)
+                {
+                    ListView_DeleteItem(handle(), static_cast<int>(inRow));
+                }
+                break;
+            }
+            case ListModel::Change_RowChanged:
+            {
+                // The text is requested again when the items are redrawn.
+                ListView_RedrawItems(handle(), static_cast<int>(inRow), static_cast<int>(inRow + inCount - 1));
+                break;
+            }
+            case ListModel::Change_Reset:
+            {
+                ListView_DeleteAllItems(handle());
+                for (size_t idx = 0; idx != mListModel.rowCount(); ++idx)
+                {
+                    insertItem(idx);
+                }
+                ::InvalidateRect(handle(), 0, FALSE);
+                break;
+            }
+        }
+    }
+
+
+    void ListView::insertItem(size_t inRow)
+    {
+        // The text is provided by the list model on LVN_GETDISPINFO.
+        LVITEM lvItem;
+        lvItem.mask = LVIF_TEXT | LVIF_PARAM | LVIF_STATE;
+        lvItem.state = 0;
+        lvItem.stateMask = 0;
+        lvItem.iSubItem = 0;
+        lvItem.lParam = (LPARAM)0;
+        lvItem.iItem = static_cast<int>(inRow);
+        lvItem.pszText = LPSTR_TEXTCALLBACK;
+        if (-1 == ListView_InsertItem(handle(), &lvItem))
+        {
+            ReportError("Inserting item into list view failed. Reason: " + WinAPI::System_GetLastError(::GetLastError()));
+        }
+    }
+
+
     void ListView::addListHeader(ListHeader * inListHeader)
     {
         WinAPI::ListView_AddColumn(handle(), 0, inListHeader->getLabel());
@@ -652,26 +825,20 @@ namespace XULWin
         if (LVN_GETDISPINFO == messageHeader->code)
         {
             NMLVDISPINFO * dispInfo = (NMLVDISPINFO *)lParam;
+            size_t rowIndex = dispInfo->item.iItem;
             size_t columnIndex = dispInfo->item.iSubItem;
 
-            std::vector<XMLListItem *> listItems;
-            el()->getElementsByType<XMLListItem>(listItems);
-
-            if (dispInfo->item.iItem >= static_cast<int>(listItems.size()))
+            if (rowIndex >= mListModel.rowCount())
             {
                 //
                 return 1;
             }
 
-            // listbox/listitem/listcell
-            std::vector<XMLListCell *> listCells;
-            listItems[dispInfo->item.iItem]->getElementsByType<XMLListCell>(listCells);
-            assert(columnIndex < listCells.size());
-            if (columnIndex < listCells.size())
+            // Rows of items without cells are empty.
+            if (columnIndex < mListModel.columnCount(rowIndex))
             {
-                std::string label = listCells[columnIndex]->component()->downcast<ListCell>()->getLabel();
                 static std::wstring utf16Label;
-                utf16Label = ToUTF16(label);
+                utf16Label = ToUTF16(mListModel.getLabel(rowIndex, columnIndex));
                 dispInfo->item.pszText = const_cast<LPWSTR>(utf16Label.c_str());
             }
         }
@@ -0,0 +1,200 @@
+#include "XULWin/ListModel.h"
+#include <algorithm>
+#include <assert.h>
+
+
+namespace XULWin
+{
+
+    ListModel::Cell::Cell()
+    {
+    }
+
+
+    ListModel::Cell::Cell(const std::string & inLabel, const std::string & inImage) :
+        label(inLabel),
+        image(inImage)
+    {
+    }
+
+
+    ListModel::ListModel()
+    {
+    }
+
+
+    size_t ListModel::rowCount() const
+    {
+        return mRows.size();
+    }
+
+
+    size_t ListModel::columnCount(size_t inRow) const
+    {
+        return getRow(inRow).size();
+    }
+
+
+    const ListModel::Row & ListModel::getRow(size_t inRow) const
+    {
+        static const Row fEmptyRow;
+        if (inRow < mRows.size())
+        {
+            return mRows[inRow];
+        }
+        return fEmptyRow;
+    }
+
+
+    const ListModel::Cell * ListModel::getCell(size_t inRow, size_t inColumn) const
+    {
+        if (inRow < mRows.size() && inColumn < mRows[inRow].size())
+        {
+            return &mRows[inRow][inColumn];
+        }
+        return 0;
+    }
+
+
+    ListModel::Cell * ListModel::getOrCreateCell(size_t inRow, size_t inColumn)
+    {
+        assert(inRow < mRows.size());
+        if (inRow >= mRows.size())
+        {
+            return 0;
+        }
+
+        Row & row = mRows[inRow];
+        if (inColumn >= row.size())
+        {
+            row.resize(inColumn + 1);
+        }
+        return &row[inColumn];
+    }
+
+
+    const std::string & ListModel::getLabel(size_t inRow, size_t inColumn) const
+    {
+        static const std::string fEmpty;
+        const Cell * cell = getCell(inRow, inColumn);
+        return cell ? cell->label : fEmpty;
+    }
+
+
+    const std::string & ListModel::getImage(size_t inRow, size_t inColumn) const
+    {
+        static const std::string fEmpty;
+        const Cell * cell = getCell(inRow, inColumn);
+        return cell ? cell->image : fEmpty;
+    }
+
+
+    void ListModel::appendRow(const Row & inRow)
+    {
+        mRows.push_back(inRow);
+        notify(Change_RowsInserted, mRows.size() - 1, 1);
+    }
+
+
+    void ListModel::insertRow(size_t inIndex, const Row & inRow)
+    {
+        assert(inIndex <= mRows.size());
+        if (inIndex > mRows.size())
+        {
+            inIndex = mRows.size();
+        }
+        mRows.insert(mRows.begin() + inIndex, inRow);
+        notify(Change_RowsInserted, inIndex, 1);
+    }
+
+
+    void ListModel::setRow(size_t inIndex, const Row & inRow)
+    {
+        assert(inIndex < mRows.size());
+        if (inIndex < mRows.size())
+        {
+            mRows[inIndex] = inRow;
+            notify(Change_RowChanged, inIndex, 1);
+        }
+    }
+
+
+    void ListModel::removeRow(size_t inIndex)
+    {
+        assert(inIndex < mRows.size());
+        if (inIndex < mRows.size())
+        {
+            mRows.erase(mRows.begin() + inIndex);
+            notify(Change_RowsRemoved, inIndex, 1);
+        }
+    }
+
+
+    void ListModel::setLabel(size_t inRow, size_t inColumn, const std::string & inLabel)
+    {
+        if (Cell * cell = getOrCreateCell(inRow, inColumn))
+        {
+            cell->label = inLabel;
+            notify(Change_RowChanged, inRow, 1);
+        }
+    }
+
+
+    void ListModel::setImage(size_t inRow, size_t inColumn, const std::string & inImage)
+    {
+        if (Cell * cell = getOrCreateCell(inRow, inColumn))
+        {
+            cell->image = inImage;
+            notify(Change_RowChanged, inRow, 1);
+        }
+    }
+
+
+    void ListModel::setRows(const Rows & inRows)
+    {
+        mRows = inRows;
+        notify(Change_Reset, 0, 0);
+    }
+
+
+    void ListModel::clear()
+    {
+        mRows.clear();
+        notify(Change_Reset, 0, 0);
+    }
+
+
+    void ListModel::addListener(Listener * inListener)
+    {
+        if (std::find(mListeners.begin(), mListeners.end(), inListener) == mListeners.end())
+        {
+            mListeners.push_back(inListener);
+        }
+    }
+
+
+    void ListModel::removeListener(Listener * inListener)
+    {
+        std::vector<Listener *>::iterator it = std::find(mListeners.begin(), mListeners.end(), inListener);
+        if (it != mListeners.end())
+        {
+            mListeners.erase(it);
+        }
+    }
+
+
+    void ListModel::notify(Change inChange, size_t inRow, size_t inCount)
+    {
+        // Listeners may add or remove listeners while they are notified.
+        // Those that were removed are not notified anymore.
+        std::vector<Listener *> listeners(mListeners);
+        for (size_t idx = 0; idx != listeners.size(); ++idx)
+        {
+            if (std::find(mListeners.begin(), mListeners.end(), listeners[idx]) != mListeners.end())
+            {
+                listeners[idx]->onListModelChanged(inChange, inRow, inCount);
+            }
+        }
+    }
+
+} // namespace XULWin
@@ -140,6 +140,7 @@ namespace XULWin
     void NativeComponent::setLabel(const std::string & inLabel)
     {
         WinAPI::Window_SetText(handle(), inLabel);
+        invalidateSizeCache();
     }
 
 
@@ -435,4 +436,20 @@ namespace XULWin
         return ::DefWindowProc(hWnd, inMessage, wParam, lParam);
     }
 
+
+    void SetRealized(Component * inComponent, bool inRealized)
+    {
+        if (NativeComponent * native = inComponent->downcast<NativeComponent>())
+        {
+            // Child windows are shown and hidden along with their parent.
+            WinAPI::Window_SetVisible(native->handle(), inRealized && !native->isHidden());
+            return;
+        }
+
+        for (size_t idx = 0; idx != inComponent->getChildCount(); ++idx)
+        {
+            SetRealized(inComponent->getChild(idx), inRealized);
+        }
+    }
+
 } // namespace XULWin
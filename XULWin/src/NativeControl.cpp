@@ -1,5 +1,6 @@
 #include "XULWin/NativeControl.h"
 #include "XULWin/Decorator.h"
+#include "XULWin/LayoutTransaction.h"
 #include "XULWin/WinUtils.h"
 #include "XULWin/VirtualComponent.h"
 
@@ -80,12 +81,12 @@ namespace XULWin
             // the scrollable rectangular area. This new context requires that we
             // re-adjust the x and y coords.
             Rect scrollRect = nativeParent->clientRect();
-            ::MoveWindow(handle(), x - scrollRect.x(), y - scrollRect.y(), w, h, FALSE);
+            LayoutTransaction::MoveWindow(handle(), Rect(x - scrollRect.x(), y - scrollRect.y(), w, h));
         }
         else
         {
             // If the parent is a virtual element, then we can position this control normally.
-            ::MoveWindow(handle(), x, y, w, h, FALSE);
+            LayoutTransaction::MoveWindow(handle(), Rect(x, y, w, h));
         }
     }
 
@@ -107,6 +108,22 @@ namespace XULWin
         ::GetClientRect(handle(), &rc_self);
         ::MapWindowPoints(handle(), HWND_DESKTOP, (LPPOINT)&rc_self, 2);
 
+        Rect pendingRect;
+        if (LayoutTransaction::GetPendingRect(handle(), pendingRect))
+        {
+            // The window has not been moved yet. Apply the
+            // border sizes of the window to the pending rect.
+            RECT rw;
+            ::GetWindowRect(handle(), &rw);
+            int left = rc_self.left - rw.left;
+            int top = rc_self.top - rw.top;
+            int right = rw.right - rc_self.right;
+            int bottom = rw.bottom - rc_self.bottom;
+            return Rect(pendingRect.x() + left,
+                        pendingRect.y() + top,
+                        pendingRect.width() - left - right,
+                        pendingRect.height() - top - bottom);
+        }
 
         int x = rc_self.left - rc_parent.left;
         int y = rc_self.top - rc_parent.top;
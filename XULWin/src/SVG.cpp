@@ -2,17 +2,225 @@
 #include "XULWin/SVGPathInstructions.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/Gdiplus.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
 
 
 namespace XULWin
 {
 
+    static bool IsEmpty(const RectF & inRect)
+    {
+        return inRect.width() <= 0 || inRect.height() <= 0;
+    }
+
+
+    // Returns the smallest rectangle that contains both rectangles. Empty
+    // rectangles are ignored.
+    static RectF Unite(const RectF & inA, const RectF & inB)
+    {
+        if (IsEmpty(inA))
+        {
+            return inB;
+        }
+        if (IsEmpty(inB))
+        {
+            return inA;
+        }
+        float left = std::min<float>(inA.x(), inB.x());
+        float top = std::min<float>(inA.y(), inB.y());
+        float right = std::max<float>(inA.x() + inA.width(), inB.x() + inB.width());
+        float bottom = std::max<float>(inA.y() + inA.height(), inB.y() + inB.height());
+        return RectF(left, top, right - left, bottom - top);
+    }
+
+
+    static bool Intersects(const RECT & inA, const RECT & inB)
+    {
+        return inA.left < inB.right && inB.left < inA.right &&
+               inA.top < inB.bottom && inB.top < inA.bottom;
+    }
+
+
+    // Paints the SVG children of a component. Children that the renderer
+    // would clip away entirely are skipped.
+    static void PaintChildren(Component * inComponent, SVGRenderer & inRenderer)
+    {
+        for (size_t idx = 0; idx != inComponent->getChildCount(); ++idx)
+        {
+            if (SVGPainter * svg = inComponent->getChild(idx)->downcast<SVGPainter>())
+            {
+                RectF bounds = svg->getPaintBounds();
+                if (!IsEmpty(bounds) && inRenderer.isVisible(bounds))
+                {
+                    svg->paint(inRenderer);
+                }
+            }
+        }
+    }
+
+
+    // Converts the geometry to the format of Gdiplus::GraphicsPath.
+    static Gdiplus::GraphicsPath * CreateGraphicsPath(const SVGPathGeometry & inGeometry)
+    {
+        std::vector<Gdiplus::PointF> gdiplusPoints;
+        std::vector<BYTE> gdiplusTypes;
+        const PointFs & points = inGeometry.points();
+        const SVGPathGeometry::PointTypes & pointTypes = inGeometry.pointTypes();
+        gdiplusPoints.reserve(points.size());
+        gdiplusTypes.reserve(points.size());
+        for (size_t idx = 0; idx != points.size(); ++idx)
+        {
+            gdiplusPoints.push_back(Gdiplus::PointF(points[idx].x(), points[idx].y()));
+            switch (pointTypes[idx])
+            {
+                case SVGPathGeometry::PointType_Start:  gdiplusTypes.push_back(Gdiplus::PathPointTypeStart); break;
+                case SVGPathGeometry::PointType_Line:   gdiplusTypes.push_back(Gdiplus::PathPointTypeLine); break;
+                case SVGPathGeometry::PointType_Bezier: gdiplusTypes.push_back(Gdiplus::PathPointTypeBezier); break;
+            }
+        }
+
+        const SVGPathGeometry::Figures & figures = inGeometry.figures();
+        for (size_t idx = 0; idx != figures.size(); ++idx)
+        {
+            if (figures[idx].closed)
+            {
+                gdiplusTypes[figures[idx].end - 1] |= static_cast<BYTE>(Gdiplus::PathPointTypeCloseSubpath);
+            }
+        }
+
+        return new Gdiplus::GraphicsPath(&gdiplusPoints[0],
+                                         &gdiplusTypes[0],
+                                         static_cast<INT>(gdiplusPoints.size()),
+                                         Gdiplus::FillModeWinding);
+    }
+
+
+    GdiplusPathCache::Entry::Entry() :
+        version(0),
+        used(false)
+    {
+    }
+
+
+    GdiplusPathCache::GdiplusPathCache()
+    {
+    }
+
+
+    GdiplusPathCache::~GdiplusPathCache()
+    {
+    }
+
+
+    Gdiplus::GraphicsPath & GdiplusPathCache::getPath(const SVGPathGeometry & inGeometry)
+    {
+        assert(!inGeometry.empty());
+        Entry & entry = mEntries[&inGeometry];
+        if (!entry.path || entry.version != inGeometry.version())
+        {
+            entry.path.reset(CreateGraphicsPath(inGeometry));
+            entry.version = inGeometry.version();
+        }
+        entry.used = true;
+        return *entry.path;
+    }
+
+
+    void GdiplusPathCache::releaseUnused()
+    {
+        Entries::iterator it = mEntries.begin();
+        while (it != mEntries.end())
+        {
+            if (it->second.used)
+            {
+                it->second.used = false;
+                ++it;
+            }
+            else
+            {
+                mEntries.erase(it++);
+            }
+        }
+    }
+
+
+    // Damages the area where a child of the canvas or of one of its groups
+    // is painted.
+    static void InvalidateChild(SVGCanvas * inCanvas, Component * inChild)
+    {
+        if (!inCanvas || !inChild)
+        {
+            return;
+        }
+
+        if (const SVGPainter * painter = inChild->downcast<SVGPainter>())
+        {
+            inCanvas->invalidateRect(painter->getPaintBounds());
+        }
+    }
+
+
+    GdiplusSVGRenderer::GdiplusSVGRenderer(Gdiplus::Graphics & inGraphics, GdiplusPathCache & inPathCache) :
+        mGraphics(inGraphics),
+        mPathCache(inPathCache)
+    {
+    }
+
+
+    void GdiplusSVGRenderer::fillPath(const SVGPathGeometry & inGeometry, const RGBColor & inColor)
+    {
+        if (inGeometry.empty())
+        {
+            return;
+        }
+
+        Gdiplus::SolidBrush brush(Gdiplus::Color(inColor.alpha(), inColor.red(), inColor.green(), inColor.blue()));
+        mGraphics.FillPath(&brush, &mPathCache.getPath(inGeometry));
+    }
+
+
+    void GdiplusSVGRenderer::strokePath(const SVGPathGeometry & inGeometry, const RGBColor & inColor, float inWidth)
+    {
+        if (inGeometry.empty())
+        {
+            return;
+        }
+
+        Gdiplus::Pen pen(Gdiplus::Color(inColor.alpha(), inColor.red(), inColor.green(), inColor.blue()), inWidth);
+
+        // Same joins as SVGRasterizer. They also keep the stroke within the
+        // paint bounds, which miter joins would exceed.
+        pen.SetLineJoin(Gdiplus::LineJoinRound);
+        mGraphics.DrawPath(&pen, &mPathCache.getPath(inGeometry));
+    }
+
+
+    bool GdiplusSVGRenderer::isVisible(const RectF & inRect) const
+    {
+        return mGraphics.IsVisible(Gdiplus::RectF(inRect.x(), inRect.y(), inRect.width(), inRect.height())) != FALSE;
+    }
+
+
     SVGCanvas::SVGCanvas(Component * inParent, const AttributesMapping & inAttr) :
-        NativeControl(inParent, inAttr, TEXT("STATIC"), 0, 0)
+        NativeControl(inParent, inAttr, TEXT("STATIC"), 0, 0),
+        mBufferDC(0),
+        mBuffer(0),
+        mOriginalBitmap(0),
+        mBufferWidth(0),
+        mBufferHeight(0)
     {
     }
 
 
+    SVGCanvas::~SVGCanvas()
+    {
+        releaseBuffer();
+    }
+
+
     int SVGCanvas::calculateWidth(SizeConstraint inSizeConstraint) const
     {
         return 1;
@@ -30,75 +238,245 @@ namespace XULWin
         Gdiplus::Graphics g(inHDC);
         g.SetInterpolationMode(Gdiplus::InterpolationModeHighQuality);
         g.SetSmoothingMode(Gdiplus::SmoothingModeHighQuality);
-        for (size_t idx = 0; idx != getChildCount(); ++idx)
+        GdiplusSVGRenderer renderer(g, mPathCache);
+        render(renderer);
+        mPathCache.releaseUnused();
+    }
+
+
+    void SVGCanvas::onChildAdded(Component * inChild)
+    {
+        InvalidateChild(this, inChild);
+        Super::onChildAdded(inChild);
+    }
+
+
+    void SVGCanvas::onChildRemoved(Component * inChild)
+    {
+        InvalidateChild(this, inChild);
+        Super::onChildRemoved(inChild);
+    }
+
+
+    void SVGCanvas::render(SVGRenderer & inRenderer)
+    {
+        PaintChildren(this, inRenderer);
+    }
+
+
+    void SVGCanvas::invalidateRect(const RectF & inRect)
+    {
+        if (IsEmpty(inRect))
+        {
+            return;
+        }
+
+        // Add a pixel on each side for the anti-aliased edges.
+        RECT rect;
+        rect.left = static_cast<LONG>(std::floor(inRect.x())) - 1;
+        rect.top = static_cast<LONG>(std::floor(inRect.y())) - 1;
+        rect.right = static_cast<LONG>(std::ceil(inRect.x() + inRect.width())) + 1;
+        rect.bottom = static_cast<LONG>(std::ceil(inRect.y() + inRect.height())) + 1;
+
+        // Without a buffer the next paint renders everything anyway.
+        if (mBuffer)
         {
-            if (SVGPainter * svg = getChild(idx)->downcast<SVGPainter>())
+            rect.left = std::max<LONG>(rect.left, 0);
+            rect.top = std::max<LONG>(rect.top, 0);
+            rect.right = std::min<LONG>(rect.right, mBufferWidth);
+            rect.bottom = std::min<LONG>(rect.bottom, mBufferHeight);
+            if (rect.left >= rect.right || rect.top >= rect.bottom)
             {
-                svg->paint(g);
+                return;
             }
+
+            // Merge with the damaged areas that overlap. The merged area
+            // can overlap others, so start over after each merge.
+            for (size_t idx = 0; idx < mDamage.size(); )
+            {
+                if (Intersects(mDamage[idx], rect))
+                {
+                    rect.left = std::min<LONG>(rect.left, mDamage[idx].left);
+                    rect.top = std::min<LONG>(rect.top, mDamage[idx].top);
+                    rect.right = std::max<LONG>(rect.right, mDamage[idx].right);
+                    rect.bottom = std::max<LONG>(rect.bottom, mDamage[idx].bottom);
+                    mDamage.erase(mDamage.begin() + idx);
+                    idx = 0;
+                }
+                else
+                {
+                    ++idx;
+                }
+            }
+            mDamage.push_back(rect);
+        }
+
+        if (handle())
+        {
+            ::InvalidateRect(handle(), &rect, FALSE);
         }
     }
 
 
-    void SVGCanvas::bufferedPaint(HDC inHDC)
+    const SVGStyleNode * SVGCanvas::SVGStyleNode_parent() const
     {
+        return 0;
+    }
+
+
+    bool SVGCanvas::SVGStyleNode_getCSSFill(RGBColor & outColor) const
+    {
+        if (mCSSFill.isValid())
+        {
+            outColor = mCSSFill.getValue();
+            return true;
+        }
+        return false;
+    }
+
+
+    bool SVGCanvas::SVGStyleNode_getFill(RGBColor & outColor) const
+    {
+        return false;
+    }
+
+
+    bool SVGCanvas::SVGStyleNode_getStroke(RGBColor & outColor) const
+    {
+        return false;
+    }
 
-        //
-        // Get the size of the client rectangle.
-        //
-        RECT rc;
-        GetClientRect(handle(), &rc);
 
-        HDC compatibleDC = CreateCompatibleDC(inHDC);
+    bool SVGCanvas::SVGStyleNode_getStrokeWidth(int & outWidth) const
+    {
+        return false;
+    }
 
 
-        //
-        // Create a bitmap big enough for our client rectangle.
-        //
-        HBITMAP backgroundBuffer = CreateCompatibleBitmap(inHDC, rc.right - rc.left, rc.bottom - rc.top);
+    void SVGCanvas::updateBuffer(HDC inHDC, int inWidth, int inHeight)
+    {
+        if (mBuffer && inWidth == mBufferWidth && inHeight == mBufferHeight)
+        {
+            return;
+        }
+
+        releaseBuffer();
+        if (inWidth <= 0 || inHeight <= 0)
+        {
+            return;
+        }
 
+        mBufferDC = ::CreateCompatibleDC(inHDC);
+        mBuffer = ::CreateCompatibleBitmap(inHDC, inWidth, inHeight);
+        if (!mBufferDC || !mBuffer)
+        {
+            ReportError("SVGCanvas: failed to create the back buffer.");
+            releaseBuffer();
+            return;
+        }
+
+        mOriginalBitmap = ::SelectObject(mBufferDC, mBuffer);
+        ::SetBkMode(mBufferDC, TRANSPARENT);
+        mBufferWidth = inWidth;
+        mBufferHeight = inHeight;
+
+        RECT all = { 0, 0, inWidth, inHeight };
+        mDamage.assign(1, all);
+    }
+
+
+    void SVGCanvas::releaseBuffer()
+    {
+        if (mBufferDC && mOriginalBitmap)
+        {
+            ::SelectObject(mBufferDC, mOriginalBitmap);
+        }
+        if (mBuffer)
+        {
+            ::DeleteObject(mBuffer);
+        }
+        if (mBufferDC)
+        {
+            ::DeleteDC(mBufferDC);
+        }
+        mBufferDC = 0;
+        mBuffer = 0;
+        mOriginalBitmap = 0;
+        mBufferWidth = 0;
+        mBufferHeight = 0;
+        mDamage.clear();
+    }
 
-        //
-        // Select the bitmap into the off-screen DC.
-        //
-        HBITMAP backgroundBitmap = (HBITMAP)SelectObject(compatibleDC, backgroundBuffer);
 
+    void SVGCanvas::repairBuffer()
+    {
+        if (mDamage.empty())
+        {
+            return;
+        }
 
-        //
         // Erase the background.
-        //
-        HBRUSH backgroundBrush = CreateSolidBrush(GetSysColor(COLOR_WINDOW));
-        FillRect(compatibleDC, &rc, backgroundBrush);
-        DeleteObject(backgroundBrush);
+        HBRUSH backgroundBrush = ::CreateSolidBrush(::GetSysColor(COLOR_WINDOW));
+        for (size_t idx = 0; idx != mDamage.size(); ++idx)
+        {
+            ::FillRect(mBufferDC, &mDamage[idx], backgroundBrush);
+        }
+        ::DeleteObject(backgroundBrush);
+
+        // The paths of shapes outside the damaged areas are not requested,
+        // so unused paths can only be released after a full render.
+        RECT all = { 0, 0, mBufferWidth, mBufferHeight };
+        bool renderAll = mDamage.size() == 1 && ::EqualRect(&mDamage[0], &all);
 
-        //
-        // Render the image into the offscreen DC.
-        //
-        SetBkMode(compatibleDC, TRANSPARENT);
+        // Render the shapes that intersect the damaged areas. The clip
+        // region makes the renderer skip all others.
+        {
+            Gdiplus::Graphics g(mBufferDC);
+            g.SetInterpolationMode(Gdiplus::InterpolationModeHighQuality);
+            g.SetSmoothingMode(Gdiplus::SmoothingModeHighQuality);
+            Gdiplus::Region clip;
+            clip.MakeEmpty();
+            for (size_t idx = 0; idx != mDamage.size(); ++idx)
+            {
+                const RECT & rect = mDamage[idx];
+                clip.Union(Gdiplus::Rect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top));
+            }
+            g.SetClip(&clip);
+            GdiplusSVGRenderer renderer(g, mPathCache);
+            render(renderer);
+        }
+        mDamage.clear();
 
+        if (renderAll)
+        {
+            mPathCache.releaseUnused();
+        }
+    }
 
-        paint(compatibleDC);
 
+    void SVGCanvas::bufferedPaint(HDC inHDC, const RECT & inPaintRect)
+    {
+        RECT rc;
+        ::GetClientRect(handle(), &rc);
+        updateBuffer(inHDC, rc.right - rc.left, rc.bottom - rc.top);
+        if (!mBuffer)
+        {
+            return;
+        }
 
-        //
-        // Blt the changes to the screen DC.
-        //
-        BitBlt
-        (
-            inHDC,
-            rc.left,
-            rc.top,
-            rc.right - rc.left,
-            rc.bottom - rc.top,
-            compatibleDC, 0, 0, SRCCOPY
-        );
+        repairBuffer();
 
-        //
-        // Done with off-screen bitmap and DC.
-        //
-        SelectObject(compatibleDC, backgroundBitmap);
-        DeleteObject(backgroundBuffer);
-        DeleteDC(compatibleDC);
+        // Copy the part that the system asked for. It can be larger than
+        // the damaged areas, for example when another window moved away.
+        ::BitBlt(inHDC,
+                 inPaintRect.left,
+                 inPaintRect.top,
+                 inPaintRect.right - inPaintRect.left,
+                 inPaintRect.bottom - inPaintRect.top,
+                 mBufferDC,
+                 inPaintRect.left,
+                 inPaintRect.top,
+                 SRCCOPY);
     }
 
 
@@ -106,15 +484,17 @@ namespace XULWin
     {
         if (inMessage == WM_PAINT)
         {
-            HDC hDC = ::GetDC(handle());
             PAINTSTRUCT ps;
-            ps.hdc = hDC;
-            ::BeginPaint(handle(), &ps);
-            bufferedPaint(hDC);
+            HDC hDC = ::BeginPaint(handle(), &ps);
+            bufferedPaint(hDC, ps.rcPaint);
             ::EndPaint(handle(), &ps);
-            ::ReleaseDC(handle(), hDC);
             return 0;
         }
+        else if (inMessage == WM_ERASEBKGND)
+        {
+            // The back buffer covers the whole client area.
+            return 1;
+        }
         return Super::handleMessage(inMessage, wParam, lParam);
     }
 
@@ -161,6 +541,7 @@ namespace XULWin
     void SVG::setSVGFill(const RGBColor & inColor)
     {
         mSVGFill = inColor;
+        invalidateCanvas();
     }
 
 
@@ -172,7 +553,10 @@ namespace XULWin
 
     void SVG::setSVGStroke(const RGBColor & inColor)
     {
+        // A visible stroke enlarges the paint bounds.
+        invalidateCanvas();
         mSVGStroke = inColor;
+        invalidateCanvas();
     }
 
 
@@ -197,7 +581,9 @@ namespace XULWin
 
     void SVG::setSVGStrokeWidth(int inStrokeWidth)
     {
+        invalidateCanvas();
         mStrokeWidth = inStrokeWidth;
+        invalidateCanvas();
     }
 
 
@@ -220,20 +606,81 @@ namespace XULWin
     }
 
 
-    static SVG * findSVGParent(Component * inEl)
+    void SVG::onChildAdded(Component * inChild)
+    {
+        InvalidateChild(findParentOfType<SVGCanvas>(), inChild);
+        Super::onChildAdded(inChild);
+    }
+
+
+    void SVG::onChildRemoved(Component * inChild)
     {
-        if (!inEl)
+        InvalidateChild(findParentOfType<SVGCanvas>(), inChild);
+        Super::onChildRemoved(inChild);
+    }
+
+
+    const SVGStyleNode * SVG::SVGStyleNode_parent() const
+    {
+        return parent() ? parent()->downcast<SVGStyleNode>() : 0;
+    }
+
+
+    bool SVG::SVGStyleNode_getCSSFill(RGBColor & outColor) const
+    {
+        if (mCSSFill.isValid())
         {
-            return 0;
+            outColor = mCSSFill.getValue();
+            return true;
         }
+        return false;
+    }
 
-        if (SVG * g = inEl->downcast<SVG>())
+
+    bool SVG::SVGStyleNode_getFill(RGBColor & outColor) const
+    {
+        if (mSVGFill.isValid())
         {
-            return g;
+            outColor = mSVGFill.getValue();
+            return true;
         }
-        else
+        return false;
+    }
+
+
+    bool SVG::SVGStyleNode_getStroke(RGBColor & outColor) const
+    {
+        if (mSVGStroke.isValid())
         {
-            return findSVGParent(inEl->parent());
+            outColor = mSVGStroke.getValue();
+            return true;
+        }
+        return false;
+    }
+
+
+    bool SVG::SVGStyleNode_getStrokeWidth(int & outWidth) const
+    {
+        if (mStrokeWidth.isValid())
+        {
+            outWidth = mStrokeWidth.getValue();
+            return true;
+        }
+        return false;
+    }
+
+
+    void SVG::invalidateCanvas()
+    {
+        const SVGPainter * painter = downcast<SVGPainter>();
+        if (!painter)
+        {
+            return;
+        }
+
+        if (SVGCanvas * canvas = findParentOfType<SVGCanvas>())
+        {
+            canvas->invalidateRect(painter->getPaintBounds());
         }
     }
 
@@ -250,20 +697,29 @@ namespace XULWin
     }
 
 
-    void SVGGroup::paint(Gdiplus::Graphics & g)
+    void SVGGroup::paint(SVGRenderer & inRenderer)
+    {
+        PaintChildren(this, inRenderer);
+    }
+
+
+    RectF SVGGroup::getPaintBounds() const
     {
+        RectF result;
         for (size_t idx = 0; idx != getChildCount(); ++idx)
         {
-            if (SVGPainter * svg = getChild(idx)->downcast<SVGPainter>())
+            if (const SVGPainter * svg = getChild(idx)->downcast<SVGPainter>())
             {
-                svg->paint(g);
+                result = Unite(result, svg->getPaintBounds());
             }
         }
+        return result;
     }
 
 
     SVGPolygon::SVGPolygon(Component * inParent, const AttributesMapping & inAttr) :
-        SVG(inParent, inAttr)
+        SVG(inParent, inAttr),
+        mShape(SVGShape::Type_Polygon)
     {
     }
 
@@ -283,36 +739,36 @@ namespace XULWin
 
     void SVGPolygon::setPoints(const Points & inPoints)
     {
+        invalidateCanvas();
         mPoints = inPoints;
-        mPointFs.clear();
-        for (size_t idx = 0; idx != mPoints.size(); ++idx)
-        {
-            const Point & point = mPoints[idx];
-            mPointFs.push_back(Gdiplus::PointF((Gdiplus::REAL)point.x(), (Gdiplus::REAL)point.y()));
-        }
+        mShape.setPoints(mPoints);
+        invalidateCanvas();
     }
 
 
-    void SVGPolygon::paint(Gdiplus::Graphics & g)
+    void SVGPolygon::paint(SVGRenderer & inRenderer)
     {
-        if (!mPointFs.empty())
-        {
-            Gdiplus::Color color(Gdiplus::Color::Black);
-            SVG * svg = findSVGParent(this);
-            if (svg)
-            {
-                RGBColor fill = svg->getCSSFill();
-                color = Gdiplus::Color(fill.alpha(), fill.red(), fill.green(), fill.blue());
-            }
-            Gdiplus::SolidBrush solidBrush(color);
-            g.FillPolygon(&solidBrush, &mPointFs[0], mPointFs.size());
-        }
+        mShape.paint(*this, inRenderer);
+    }
+
+
+    RectF SVGPolygon::getPaintBounds() const
+    {
+        return mShape.getPaintBounds(*this);
     }
 
 
     SVGRect::SVGRect(Component * inParent, const AttributesMapping & inAttr) :
-        SVG(inParent, inAttr)
+        SVG(inParent, inAttr),
+        mShape(SVGShape::Type_Rect)
+    {
+    }
+
+
+    bool SVGRect::init()
     {
+        updateGeometry();
+        return Super::init();
     }
 
 
@@ -326,443 +782,148 @@ namespace XULWin
     }
 
 
-    void SVGRect::paint(Gdiplus::Graphics & g)
+    void SVGRect::setCSSX(int inX)
     {
-        Gdiplus::Color color(Gdiplus::Color::Black);
-        RGBColor fill = getSVGFill();
-        color = Gdiplus::Color(fill.alpha(), fill.red(), fill.green(), fill.blue());
-        Gdiplus::SolidBrush solidBrush(color);
-        g.FillRectangle(&solidBrush, Gdiplus::RectF((Gdiplus::REAL)getCSSX(),
-                                                    (Gdiplus::REAL)getCSSY(),
-                                                    (Gdiplus::REAL)getWidth(),
-                                                    (Gdiplus::REAL)getHeight()));
+        invalidateCanvas();
+        Super::setCSSX(inX);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    SVGPath::SVGPath(Component * inParent, const AttributesMapping & inAttr) :
-        SVG(inParent, inAttr)
+    void SVGRect::setCSSY(int inY)
     {
+        invalidateCanvas();
+        Super::setCSSY(inY);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    bool SVGPath::initAttributeControllers()
+    void SVGRect::setCSSWidth(int inWidth)
     {
-        setAttributeController<SVG_Path_InstructionsController>(this);
-        return Super::initAttributeControllers();
+        invalidateCanvas();
+        Super::setCSSWidth(inWidth);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    bool SVGPath::initStyleControllers()
+    void SVGRect::setCSSHeight(int inHeight)
     {
-        return Super::initStyleControllers();
+        invalidateCanvas();
+        Super::setCSSHeight(inHeight);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    void SVGPath::getFloatPoints(const PathInstruction & instruction,
-                                 const Gdiplus::PointF & inPrevPoint,
-                                 std::vector<Gdiplus::PointF> & outPoints)
+    void SVGRect::setWidth(int inWidth)
     {
-        for (size_t idx = 0; idx != instruction.numPoints(); ++idx)
-        {
-            const PointF & point = instruction.getPoint(idx);
-            Gdiplus::PointF pointF;
-            if (instruction.positioning() == PathInstruction::Absolute)
-            {
-                pointF = Gdiplus::PointF((Gdiplus::REAL)point.x(),
-                                         (Gdiplus::REAL)point.y());
-            }
-            else
-            {
-                pointF = Gdiplus::PointF(inPrevPoint.X + (Gdiplus::REAL)point.x(),
-                                         inPrevPoint.Y + (Gdiplus::REAL)point.y());
-            }
-            outPoints.push_back(pointF);
-        }
+        invalidateCanvas();
+        Super::setWidth(inWidth);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    void SVGPath::GetAbsolutePositions(const PointFs & inRelativePoints,
-                                       const PointF & inPrevPoint,
-                                       PointFs & outPoints)
+    void SVGRect::setHeight(int inHeight)
     {
-        for (size_t idx = 0; idx != inRelativePoints.size(); ++idx)
-        {
-            const PointF & point = inRelativePoints[idx];
-            PointF pointF(inPrevPoint.x() + point.x(), inPrevPoint.y() + point.y());
-            outPoints.push_back(pointF);
-        }
+        invalidateCanvas();
+        Super::setHeight(inHeight);
+        updateGeometry();
+        invalidateCanvas();
     }
 
 
-    void SVGPath::GetAbsolutePositions(const PathInstruction & instruction,
-                                       const PointF & inPrevPoint,
-                                       PointFs & outPoints)
+    void SVGRect::updateGeometry()
     {
-        for (size_t idx = 0; idx != instruction.numPoints(); ++idx)
-        {
-            const PointF & point = instruction.getPoint(idx);
-            PointF pointF;
-            if (instruction.positioning() == PathInstruction::Absolute)
-            {
-                pointF = PointF(point.x(), point.y());
-            }
-            else
-            {
-                pointF = PointF(inPrevPoint.x() + point.x(), inPrevPoint.y() + point.y());
-            }
-            outPoints.push_back(pointF);
-        }
+        mShape.setRect(RectF(static_cast<float>(getCSSX()),
+                             static_cast<float>(getCSSY()),
+                             static_cast<float>(getWidth()),
+                             static_cast<float>(getHeight())));
     }
 
 
-    void SVGPath::GetPointReflection(const PointF & inPoint,
-                                     const PointF & inOrigin,
-                                     PointF & outReflection)
+    void SVGRect::paint(SVGRenderer & inRenderer)
     {
-        float x = inOrigin.x() - inPoint.x();
-        float y = inOrigin.y() - inPoint.y();
-        outReflection = PointF(x, y);
+        mShape.paint(*this, inRenderer);
     }
 
 
-    void SVGPath::GetPreparedInstructions(const SVGPathInstructions & inData, SVGPathInstructions & outPrepData)
+    RectF SVGRect::getPaintBounds() const
     {
-        PointFs preppedPoints;
-        PointF prevPoint;
-        PathInstruction prevInstruction(PathInstruction::MoveTo,
-                                        PathInstruction::Relative,
-                                        PointFs());
-        for (size_t idx = 0; idx != inData.size(); ++idx)
-        {
-            const PathInstruction & instruction = inData[idx];
-            switch (instruction.tagName())
-            {
-                case PathInstruction::MoveTo: // M
-                {
-                    if (!preppedPoints.empty())
-                    {
-                        outPrepData.push_back(PathInstruction(prevInstruction.tagName(),
-                                                              PathInstruction::Absolute,
-                                                              preppedPoints));
-                        preppedPoints.clear();
-                    }
-                    if (instruction.numPoints() == 1)
-                    {
-                        GetAbsolutePositions(instruction, prevPoint, preppedPoints);
-                        if (!preppedPoints.empty())
-                        {
-                            prevPoint = preppedPoints[preppedPoints.size() - 1];
-                        }
-                    }
-                    else
-                    {
-                        ReportError("XMLSVG XMLSVGPath of type MoveTo has more than one points.");
-                    }
-                    break;
-                }
-                case PathInstruction::LineTo: // L
-                case PathInstruction::HorizontalLineTo: // H
-                case PathInstruction::VerticalLineTo: // V
-                {
-                    if (!preppedPoints.empty() && prevInstruction.tagName() != PathInstruction::MoveTo)
-                    {
-                        outPrepData.push_back(PathInstruction(prevInstruction.tagName(),
-                                                              PathInstruction::Absolute,
-                                                              preppedPoints));
-                        if (!preppedPoints.empty())
-                        {
-                            prevPoint = preppedPoints[preppedPoints.size() - 1];
-                        }
-                        preppedPoints.clear();
-                    }
-                    if (instruction.numPoints() == 1)
-                    {
-                        if (preppedPoints.empty())
-                        {
-                            preppedPoints.push_back(prevPoint);
-                        }
-                        GetAbsolutePositions(instruction, prevPoint, preppedPoints);
-                        outPrepData.push_back(PathInstruction(instruction.tagName(),
-                                                              PathInstruction::Absolute,
-                                                              preppedPoints));
-                        if (!preppedPoints.empty())
-                        {
-                            prevPoint = preppedPoints[preppedPoints.size() - 1];
-                        }
-                        preppedPoints.clear();
-                    }
-                    else
-                    {
-                        ReportError("XMLSVG XMLSVGPath of type LineTo, HorizontalLineTo or VerticalLineTo has more than one points.");
-                    }
-                    break;
-                }
-                case PathInstruction::CurveTo: // C
-                {
-                    if (preppedPoints.empty())
-                    {
-                        // If preppedPoints is empty at this point then we need
-                        // to add the begin point ourselves. We do this after
-                        // the call to GetAbsolutePositions because prevPoint
-                        // is already absolute positioned.
-                        GetAbsolutePositions(instruction, prevPoint, preppedPoints);
-                        preppedPoints.insert(preppedPoints.begin(), prevPoint);
-                    }
-                    else
-                    {
-                        GetAbsolutePositions(instruction, prevPoint, preppedPoints);
-                    }
-                    if (!preppedPoints.empty())
-                    {
-                        prevPoint = preppedPoints[preppedPoints.size() - 1];
-                    }
-                    break;
-                }
-                case PathInstruction::SmoothCurveTo: // S
-                {
-                    // We'll convert it to a curve instruction
-                    PathInstruction curveInstruction = instruction;
-                    if (prevInstruction.tagName() == PathInstruction::CurveTo)
-                    {
-                        PointF c2 = instruction.getPoint(0);
-                        PointF endPoint = instruction.getPoint(1);
-
-                        // S produces the same type of curve as C, but if it
-                        // follows another S command or a C command, the first
-                        // control point is assumed to be a reflection of the
-                        // one used previously.
-                        PointF c1;
-                        if (instruction.positioning() == PathInstruction::Relative)
-                        {
-                            GetPointReflection(prevInstruction.getPoint(1),
-                                               prevInstruction.getPoint(2),
-                                               c1);
-                        }
-                        else
-                        {
-                            GetPointReflection(prevInstruction.getAbsolutePoint(prevPoint, 1),
-                                               prevInstruction.getAbsolutePoint(prevPoint, 2),
-                                               c1);
-                            // now also make it absolute position
-                            c1 = PointF(prevPoint.x() + c1.x(), prevPoint.y() + c1.y());
-                        }
-                        curveInstruction.points().insert(curveInstruction.points().begin(), c1);
-                    }
-                    else if (prevInstruction.tagName() == PathInstruction::SmoothCurveTo)
-                    {
-                        PointF c2 = instruction.getPoint(0);
-                        PointF endPoint = instruction.getPoint(1);
-
-                        // S produces the same type of curve as C, but if it
-                        // follows another S command or a C command, the first
-                        // control point is assumed to be a reflection of the
-                        // one used previously.
-                        PointF c1;
-                        if (instruction.positioning() == PathInstruction::Relative)
-                        {
-                            GetPointReflection(prevInstruction.getPoint(0),
-                                               prevInstruction.getPoint(1),
-                                               c1);
-                        }
-                        else
-                        {
-                            GetPointReflection(prevInstruction.getAbsolutePoint(prevPoint, 0),
-                                               prevInstruction.getAbsolutePoint(prevPoint, 1),
-                                               c1);
-                            // now also make it absolute position
-                            c1 = PointF(prevPoint.x() + c1.x(), prevPoint.y() + c1.y());
-                        }
-                        curveInstruction.points().insert(curveInstruction.points().begin(), c1);
-                    }
-                    else
-                    {
-                        //"M186.2,26
-                        //s-2.3, 5.9 -5.2, 5.9
-                        //S186.2,29.2 186.2,26z"
-                        // If the S command doesn't follow another S or C command, then it is
-                        // assumed that both control points for the curve are the same.
-                        if (instruction.positioning() == PathInstruction::Relative)
-                        {
-                            curveInstruction.points().insert(curveInstruction.points().begin(),
-                                                             instruction.getPoint(0));
-                        }
-                        else
-                        {
-                            curveInstruction.points().insert(curveInstruction.points().begin(),
-                                                             instruction.getAbsolutePoint(prevPoint, 0));
-                        }
-                    }
-                    if (preppedPoints.empty())
-                    {
-                        // If preppedPoints is empty at this point then we need
-                        // to add the begin point ourselves. We do this after
-                        // the call to GetAbsolutePositions because prevPoint
-                        // is already absolute positioned.
-                        GetAbsolutePositions(curveInstruction, prevPoint, preppedPoints);
-                        preppedPoints.insert(preppedPoints.begin(), prevPoint);
-                    }
-                    else
-                    {
-                        GetAbsolutePositions(curveInstruction, prevPoint, preppedPoints);
-                    }
-                    if (!preppedPoints.empty())
-                    {
-                        prevPoint = preppedPoints[preppedPoints.size() - 1];
-                    }
-                    break;
-                }
-                case PathInstruction::QuadraticBelzierCurve: // Q
-                case PathInstruction::SmoothQuadraticBelzierCurveTo: // T
-                case PathInstruction::EllipticalArc: // A
-                {
-                    assert(false); // not yet implemented
-                    break;
-                }
-                case PathInstruction::ClosePath: // Z
-                {
-                    if (!preppedPoints.empty())
-                    {
-                        outPrepData.push_back(PathInstruction(prevInstruction.tagName(),
-                                                              PathInstruction::Absolute,
-                                                              preppedPoints));
-                        prevPoint = preppedPoints[preppedPoints.size() - 1];
-                        preppedPoints.clear();
-                    }
-                    // This command draws a straight line from your current
-                    // position back to the first point that started the path.
-                    if (!inData.empty())
-                    {
-                        if (!inData[0].points().empty())
-                        {
-                            preppedPoints.push_back(inData[0].points()[0]);
-                            preppedPoints.push_back(prevPoint);
-                            if (preppedPoints[0] != preppedPoints[1])
-                            {
-                                outPrepData.push_back(PathInstruction(PathInstruction::LineTo,
-                                                                      PathInstruction::Absolute,
-                                                                      preppedPoints));
-                            }
-                            preppedPoints.clear();
-                        }
-                    }
-                    else
-                    {
-                        // How could inData be empty if we are inside the for loop??
-                        assert(false);
-                    }
-                    break;
-                }
-            }
+        return mShape.getPaintBounds(*this);
+    }
 
-            prevInstruction = instruction;
-        }
-        if (!preppedPoints.empty())
-        {
-            outPrepData.push_back(PathInstruction(prevInstruction.tagName(),
-                                                  PathInstruction::Absolute,
-                                                  preppedPoints));
-            preppedPoints.clear();
-        }
+
+    SVGPath::SVGPath(Component * inParent, const AttributesMapping & inAttr) :
+        SVG(inParent, inAttr),
+        mShape(SVGShape::Type_Path)
+    {
     }
 
 
-    void SVGPath::paint(Gdiplus::Graphics & g)
+    bool SVGPath::initAttributeControllers()
     {
-        RGBColor fillColorRGB(getSVGFill());
-        Gdiplus::Color fillColor(fillColorRGB.alpha(),
-                                 fillColorRGB.red(),
-                                 fillColorRGB.green(),
-                                 fillColorRGB.blue());
-        Gdiplus::SolidBrush brush(fillColor);
+        setAttributeController<SVG_Path_InstructionsController>(this);
+        return Super::initAttributeControllers();
+    }
 
 
-        RGBColor strokeColorRGB(getSVGStroke());
-        Gdiplus::Color strokeColor(strokeColorRGB.alpha(),
-                                   strokeColorRGB.red(),
-                                   strokeColorRGB.green(),
-                                   strokeColorRGB.blue());
+    bool SVGPath::initStyleControllers()
+    {
+        return Super::initStyleControllers();
+    }
 
-        Gdiplus::Pen pen(strokeColor, static_cast<float>(getSVGStrokeWidth()));
 
-        Gdiplus::GraphicsPath path;
-        path.SetFillMode(Gdiplus::FillModeWinding);
-        for (size_t idx = 0; idx != mPreparedInstructions.size(); ++idx)
-        {
-            const PathInstruction & instruction = mPreparedInstructions[idx];
-            const PointFs & points = instruction.points();
-            switch (instruction.tagName())
-            {
-                case PathInstruction::MoveTo: // should not be found in mPreparedInstructions
-                {
-                    assert(false);
-                    break;
-                }
-                case PathInstruction::LineTo:
-                {
-                    if (instruction.numPoints() == 2)
-                    {
-                        path.AddLine(Gdiplus::PointF(instruction.getPoint(0).x(), instruction.getPoint(0).y()),
-                                     Gdiplus::PointF(instruction.getPoint(1).x(), instruction.getPoint(1).y()));
-                    }
-                    else
-                    {
-                        ReportError("LineTo: paint failed because number of prepared points is not equal to 2.");
-                    }
-                    break;
-                }
-                case PathInstruction::HorizontalLineTo:
-                case PathInstruction::VerticalLineTo:
-                {
-                    assert(false); // not yet supported
-                    break;
-                }
-                case PathInstruction::CurveTo:
-                case PathInstruction::SmoothCurveTo:
-                {
-                    std::vector<Gdiplus::PointF> gdiplusPoints;
-                    for (size_t idx = 0; idx != points.size(); ++idx)
-                    {
-                        const PointF & point = points[idx];
-                        gdiplusPoints.push_back(Gdiplus::PointF(point.x(), point.y()));
-                    }
-                    path.AddBeziers(&gdiplusPoints[0], gdiplusPoints.size());
-                    break;
-                }
-                case PathInstruction::QuadraticBelzierCurve:
-                case PathInstruction::SmoothQuadraticBelzierCurveTo:
-                case PathInstruction::EllipticalArc:
-                {
-                    assert(false); // not yet implemented
-                    break;
-                }
-                case PathInstruction::ClosePath: // should not be found in mPreparedInstructions
-                {
-                    assert(false);
-                    break;
-                }
-                default:
-                {
-                    assert(false);
-                    ReportError("Unsupported type");
-                }
-            }
-        }
-        g.FillPath(&brush, &path);
-        g.DrawPath(&pen, &path);
+    void SVGPath::paint(SVGRenderer & inRenderer)
+    {
+        mShape.paint(*this, inRenderer);
+    }
+
+
+    RectF SVGPath::getPaintBounds() const
+    {
+        return mShape.getPaintBounds(*this);
+    }
+
+
+    const SVGPathData & SVGPath::getPathData() const
+    {
+        return mPathData;
+    }
+
+
+    void SVGPath::setPathData(const SVGPathData & inPathData)
+    {
+        invalidateCanvas();
+        mPathData = inPathData;
+        mShape.setPathData(mPathData);
+        invalidateCanvas();
+
+        // calculateWidth and calculateHeight follow the bounds.
+        invalidateSizeCache();
+    }
+
+
+    int SVGPath::calculateWidth(SizeConstraint inSizeConstraint) const
+    {
+        const RectF & bounds = mShape.geometry().bounds();
+        return std::max<int>(1, static_cast<int>(std::ceil(bounds.x() + bounds.width())));
     }
 
 
-    const SVGPathInstructions & SVGPath::getPathInstructions() const
+    int SVGPath::calculateHeight(SizeConstraint inSizeConstraint) const
     {
-        return mInstructions;
+        const RectF & bounds = mShape.geometry().bounds();
+        return std::max<int>(1, static_cast<int>(std::ceil(bounds.y() + bounds.height())));
     }
 
 
-    void SVGPath::setPathInstructions(const SVGPathInstructions & inPathInstructions)
+    const SVGPathGeometry & SVGPath::geometry() const
     {
-        mInstructions = inPathInstructions;
-        mPreparedInstructions.clear();
-        GetPreparedInstructions(mInstructions, mPreparedInstructions);
+        return mShape.geometry();
     }
 
 } // namespace XULWin
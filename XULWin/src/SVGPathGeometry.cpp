@@ -0,0 +1,501 @@
+#include "XULWin/SVGPathGeometry.h"
+#include "XULWin/ErrorReporter.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace XULWin
+{
+
+    static const float cPi = 3.14159265358979f;
+
+
+    static PointF Add(const PointF & inA, const PointF & inB)
+    {
+        return PointF(inA.x() + inB.x(), inA.y() + inB.y());
+    }
+
+
+    // Returns inA + inFactor * (inB - inA).
+    static PointF Interpolate(const PointF & inA, const PointF & inB, float inFactor)
+    {
+        return PointF(inA.x() + inFactor * (inB.x() - inA.x()),
+                      inA.y() + inFactor * (inB.y() - inA.y()));
+    }
+
+
+    // Reflection of inPoint relative to inOrigin.
+    static PointF Reflect(const PointF & inPoint, const PointF & inOrigin)
+    {
+        return PointF(2 * inOrigin.x() - inPoint.x(), 2 * inOrigin.y() - inPoint.y());
+    }
+
+
+    // Extends the range [ioMin, ioMax] with the extrema of one coordinate of
+    // a cubic bezier.
+    static void GetBezierExtrema(float p0, float p1, float p2, float p3, float & ioMin, float & ioMax)
+    {
+        // The derivative divided by 3 is a * t^2 + b * t + c.
+        float a = -p0 + 3 * p1 - 3 * p2 + p3;
+        float b = 2 * (p0 - 2 * p1 + p2);
+        float c = p1 - p0;
+
+        float roots[2];
+        size_t numRoots = 0;
+        if (std::fabs(a) < 1e-6f)
+        {
+            if (std::fabs(b) > 1e-6f)
+            {
+                roots[numRoots++] = -c / b;
+            }
+        }
+        else
+        {
+            float discriminant = b * b - 4 * a * c;
+            if (discriminant >= 0)
+            {
+                float root = std::sqrt(discriminant);
+                roots[numRoots++] = (-b + root) / (2 * a);
+                roots[numRoots++] = (-b - root) / (2 * a);
+            }
+        }
+
+        for (size_t idx = 0; idx != numRoots; ++idx)
+        {
+            float t = roots[idx];
+            if (t > 0 && t < 1)
+            {
+                float s = 1 - t;
+                float value = s * s * s * p0 + 3 * s * s * t * p1 + 3 * s * t * t * p2 + t * t * t * p3;
+                ioMin = std::min<float>(ioMin, value);
+                ioMax = std::max<float>(ioMax, value);
+            }
+        }
+    }
+
+
+    unsigned int SVGPathGeometry::sLastVersion = 0;
+
+
+    SVGPathGeometry::SVGPathGeometry() :
+        mFigureOpen(false),
+        mVersion(++sLastVersion)
+    {
+    }
+
+
+    void SVGPathGeometry::build(const SVGPathData & inPathData)
+    {
+        clear();
+
+        PointF current;
+        PointF start;
+        PointF lastControl;
+        PathInstruction::Type lastType = PathInstruction::MoveTo;
+        for (size_t idx = 0; idx != inPathData.numCommands(); ++idx)
+        {
+            const SVGPathData::Command & command = inPathData.getCommand(idx);
+            PathInstruction::Type type = command.type;
+            if (command.offset + SVGPathData::GetNumArguments(type) > inPathData.values().size())
+            {
+                ReportError("SVGPathGeometry: path command has too few arguments.");
+                break;
+            }
+            const float * args = inPathData.getValues(idx);
+
+            // Drawing commands that follow a ClosePath start a new figure at
+            // the start point of the previous one.
+            if (!mFigureOpen && type != PathInstruction::MoveTo && type != PathInstruction::ClosePath)
+            {
+                moveTo(current);
+            }
+
+            PointF offset;
+            if (command.positioning == PathInstruction::Relative)
+            {
+                offset = current;
+            }
+
+            switch (type)
+            {
+                case PathInstruction::MoveTo:
+                {
+                    current = Add(offset, PointF(args[0], args[1]));
+                    start = current;
+                    moveTo(current);
+                    break;
+                }
+                case PathInstruction::LineTo:
+                {
+                    current = Add(offset, PointF(args[0], args[1]));
+                    lineTo(current);
+                    break;
+                }
+                case PathInstruction::HorizontalLineTo:
+                {
+                    current = PointF(offset.x() + args[0], current.y());
+                    lineTo(current);
+                    break;
+                }
+                case PathInstruction::VerticalLineTo:
+                {
+                    current = PointF(current.x(), offset.y() + args[0]);
+                    lineTo(current);
+                    break;
+                }
+                case PathInstruction::CurveTo:
+                case PathInstruction::SmoothCurveTo:
+                {
+                    // The first control point of a smooth curve is the
+                    // reflection of the second control point of the previous
+                    // curve, or the current point if there is none.
+                    const float * values = args;
+                    PointF control1;
+                    if (type == PathInstruction::CurveTo)
+                    {
+                        control1 = Add(offset, PointF(values[0], values[1]));
+                        values += 2;
+                    }
+                    else if (lastType == PathInstruction::CurveTo || lastType == PathInstruction::SmoothCurveTo)
+                    {
+                        control1 = Reflect(lastControl, current);
+                    }
+                    else
+                    {
+                        control1 = current;
+                    }
+                    lastControl = Add(offset, PointF(values[0], values[1]));
+                    current = Add(offset, PointF(values[2], values[3]));
+                    bezierTo(control1, lastControl, current);
+                    break;
+                }
+                case PathInstruction::QuadraticBelzierCurve:
+                case PathInstruction::SmoothQuadraticBelzierCurveTo:
+                {
+                    const float * values = args;
+                    PointF control;
+                    if (type == PathInstruction::QuadraticBelzierCurve)
+                    {
+                        control = Add(offset, PointF(values[0], values[1]));
+                        values += 2;
+                    }
+                    else if (lastType == PathInstruction::QuadraticBelzierCurve || lastType == PathInstruction::SmoothQuadraticBelzierCurveTo)
+                    {
+                        control = Reflect(lastControl, current);
+                    }
+                    else
+                    {
+                        control = current;
+                    }
+
+                    // Raise the quadratic curve to a cubic one.
+                    PointF end = Add(offset, PointF(values[0], values[1]));
+                    bezierTo(Interpolate(current, control, 2.0f / 3.0f),
+                             Interpolate(end, control, 2.0f / 3.0f),
+                             end);
+                    lastControl = control;
+                    current = end;
+                    break;
+                }
+                case PathInstruction::EllipticalArc:
+                {
+                    PointF end = Add(offset, PointF(args[5], args[6]));
+                    arcTo(args[0], args[1], args[2], args[3] != 0, args[4] != 0, end);
+                    current = end;
+                    break;
+                }
+                case PathInstruction::ClosePath:
+                {
+                    closeFigure();
+                    current = start;
+                    break;
+                }
+            }
+            lastType = type;
+        }
+        endFigure();
+        calculateBounds();
+    }
+
+
+    void SVGPathGeometry::buildPolygon(const Points & inPoints)
+    {
+        clear();
+        for (size_t idx = 0; idx != inPoints.size(); ++idx)
+        {
+            PointF point(static_cast<float>(inPoints[idx].x()), static_cast<float>(inPoints[idx].y()));
+            if (idx == 0)
+            {
+                moveTo(point);
+            }
+            else
+            {
+                lineTo(point);
+            }
+        }
+        closeFigure();
+        calculateBounds();
+    }
+
+
+    void SVGPathGeometry::buildRect(const RectF & inRect)
+    {
+        clear();
+        float right = inRect.x() + inRect.width();
+        float bottom = inRect.y() + inRect.height();
+        moveTo(inRect.location());
+        lineTo(PointF(right, inRect.y()));
+        lineTo(PointF(right, bottom));
+        lineTo(PointF(inRect.x(), bottom));
+        closeFigure();
+        calculateBounds();
+    }
+
+
+    void SVGPathGeometry::clear()
+    {
+        mPoints.clear();
+        mPointTypes.clear();
+        mFigures.clear();
+        mFigureOpen = false;
+        mBounds = RectF();
+        mVersion = ++sLastVersion;
+    }
+
+
+    bool SVGPathGeometry::empty() const
+    {
+        return mFigures.empty();
+    }
+
+
+    unsigned int SVGPathGeometry::version() const
+    {
+        return mVersion;
+    }
+
+
+    const PointFs & SVGPathGeometry::points() const
+    {
+        return mPoints;
+    }
+
+
+    const SVGPathGeometry::PointTypes & SVGPathGeometry::pointTypes() const
+    {
+        return mPointTypes;
+    }
+
+
+    const SVGPathGeometry::Figures & SVGPathGeometry::figures() const
+    {
+        return mFigures;
+    }
+
+
+    const RectF & SVGPathGeometry::bounds() const
+    {
+        return mBounds;
+    }
+
+
+    void SVGPathGeometry::moveTo(const PointF & inPoint)
+    {
+        endFigure();
+
+        Figure figure;
+        figure.begin = mPoints.size();
+        figure.end = mPoints.size();
+        figure.closed = false;
+        mFigures.push_back(figure);
+        mFigureOpen = true;
+
+        mPoints.push_back(inPoint);
+        mPointTypes.push_back(PointType_Start);
+    }
+
+
+    void SVGPathGeometry::lineTo(const PointF & inPoint)
+    {
+        mPoints.push_back(inPoint);
+        mPointTypes.push_back(PointType_Line);
+    }
+
+
+    void SVGPathGeometry::bezierTo(const PointF & inControl1, const PointF & inControl2, const PointF & inEnd)
+    {
+        mPoints.push_back(inControl1);
+        mPoints.push_back(inControl2);
+        mPoints.push_back(inEnd);
+        mPointTypes.insert(mPointTypes.end(), 3, PointType_Bezier);
+    }
+
+
+    // Implementation of the endpoint to center parameterization conversion
+    // from appendix F.6 of the SVG 1.1 specification. The arc is split in
+    // segments of at most 90 degrees, each approximated by a cubic bezier.
+    void SVGPathGeometry::arcTo(float inRadiusX, float inRadiusY, float inRotation,
+                                bool inLargeArc, bool inSweep, const PointF & inEnd)
+    {
+        PointF begin = mPoints.back();
+        if (begin == inEnd)
+        {
+            return;
+        }
+
+        float rx = std::fabs(inRadiusX);
+        float ry = std::fabs(inRadiusY);
+        if (rx == 0 || ry == 0)
+        {
+            lineTo(inEnd);
+            return;
+        }
+
+        float phi = inRotation * cPi / 180.0f;
+        float cosPhi = std::cos(phi);
+        float sinPhi = std::sin(phi);
+
+        // The begin point in the coordinate system of the ellipse.
+        float dx = (begin.x() - inEnd.x()) / 2;
+        float dy = (begin.y() - inEnd.y()) / 2;
+        float x1 = cosPhi * dx + sinPhi * dy;
+        float y1 = -sinPhi * dx + cosPhi * dy;
+
+        // Scale up radii that are too small to reach the end point.
+        float lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+        if (lambda > 1)
+        {
+            rx *= std::sqrt(lambda);
+            ry *= std::sqrt(lambda);
+        }
+
+        float numerator = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+        float denominator = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+        float coefficient = std::sqrt(std::max<float>(0.0f, numerator / denominator));
+        if (inLargeArc == inSweep)
+        {
+            coefficient = -coefficient;
+        }
+        float cx1 = coefficient * rx * y1 / ry;
+        float cy1 = -coefficient * ry * x1 / rx;
+        float cx = cosPhi * cx1 - sinPhi * cy1 + (begin.x() + inEnd.x()) / 2;
+        float cy = sinPhi * cx1 + cosPhi * cy1 + (begin.y() + inEnd.y()) / 2;
+
+        float ux = (x1 - cx1) / rx;
+        float uy = (y1 - cy1) / ry;
+        float vx = (-x1 - cx1) / rx;
+        float vy = (-y1 - cy1) / ry;
+        float theta = std::atan2(uy, ux);
+        float deltaTheta = std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+        if (!inSweep && deltaTheta > 0)
+        {
+            deltaTheta -= 2 * cPi;
+        }
+        else if (inSweep && deltaTheta < 0)
+        {
+            deltaTheta += 2 * cPi;
+        }
+
+        int numSegments = static_cast<int>(std::ceil(std::fabs(deltaTheta) / (cPi / 2) - 0.001f));
+        numSegments = std::max<int>(numSegments, 1);
+        float delta = deltaTheta / numSegments;
+        float t = 4.0f / 3.0f * std::tan(delta / 4);
+
+        PointF from = begin;
+        float cosTheta = std::cos(theta);
+        float sinTheta = std::sin(theta);
+        for (int idx = 0; idx != numSegments; ++idx)
+        {
+            float nextTheta = theta + delta;
+            float cosNext = std::cos(nextTheta);
+            float sinNext = std::sin(nextTheta);
+
+            // Derivatives of the ellipse at both ends of the segment.
+            PointF derivative1(-rx * sinTheta * cosPhi - ry * cosTheta * sinPhi,
+                               -rx * sinTheta * sinPhi + ry * cosTheta * cosPhi);
+            PointF derivative2(-rx * sinNext * cosPhi - ry * cosNext * sinPhi,
+                               -rx * sinNext * sinPhi + ry * cosNext * cosPhi);
+
+            PointF to = (idx + 1 == numSegments)
+                      ? inEnd
+                      : PointF(cx + rx * cosNext * cosPhi - ry * sinNext * sinPhi,
+                               cy + rx * cosNext * sinPhi + ry * sinNext * cosPhi);
+
+            bezierTo(PointF(from.x() + t * derivative1.x(), from.y() + t * derivative1.y()),
+                     PointF(to.x() - t * derivative2.x(), to.y() - t * derivative2.y()),
+                     to);
+
+            from = to;
+            theta = nextTheta;
+            cosTheta = cosNext;
+            sinTheta = sinNext;
+        }
+    }
+
+
+    void SVGPathGeometry::closeFigure()
+    {
+        if (mFigureOpen)
+        {
+            mFigures.back().closed = true;
+            endFigure();
+        }
+    }
+
+
+    void SVGPathGeometry::endFigure()
+    {
+        if (!mFigureOpen)
+        {
+            return;
+        }
+        mFigureOpen = false;
+
+        // A lone moveto doesn't paint anything.
+        Figure & figure = mFigures.back();
+        figure.end = mPoints.size();
+        if (figure.end - figure.begin < 2)
+        {
+            mPoints.resize(figure.begin);
+            mPointTypes.resize(figure.begin);
+            mFigures.pop_back();
+        }
+    }
+
+
+    void SVGPathGeometry::calculateBounds()
+    {
+        if (mPoints.empty())
+        {
+            mBounds = RectF();
+            return;
+        }
+
+        float minX = mPoints[0].x();
+        float minY = mPoints[0].y();
+        float maxX = minX;
+        float maxY = minY;
+        for (size_t idx = 0; idx < mPoints.size(); ++idx)
+        {
+            // Control points only contribute through the extrema of the curve.
+            if (mPointTypes[idx] == PointType_Bezier)
+            {
+                const PointF & p0 = mPoints[idx - 1];
+                const PointF & p1 = mPoints[idx];
+                const PointF & p2 = mPoints[idx + 1];
+                const PointF & p3 = mPoints[idx + 2];
+                GetBezierExtrema(p0.x(), p1.x(), p2.x(), p3.x(), minX, maxX);
+                GetBezierExtrema(p0.y(), p1.y(), p2.y(), p3.y(), minY, maxY);
+                idx += 2;
+            }
+
+            const PointF & point = mPoints[idx];
+            minX = std::min<float>(minX, point.x());
+            minY = std::min<float>(minY, point.y());
+            maxX = std::max<float>(maxX, point.x());
+            maxY = std::max<float>(maxY, point.y());
+        }
+        mBounds = RectF(minX, minY, maxX - minX, maxY - minY);
+    }
+
+} // namespace XULWin
@@ -1,4 +1,6 @@
 #include "XULWin/SVGPathInstructions.h"
+#include "XULWin/Conversions.h"
+#include <cassert>
 
 
 namespace XULWin
@@ -54,4 +56,332 @@ namespace XULWin
         return mPoints;
     }
 
+
+    size_t SVGPathData::GetNumArguments(PathInstruction::Type inType)
+    {
+        switch (inType)
+        {
+            case PathInstruction::MoveTo:                           return 2;
+            case PathInstruction::LineTo:                           return 2;
+            case PathInstruction::HorizontalLineTo:                 return 1;
+            case PathInstruction::VerticalLineTo:                   return 1;
+            case PathInstruction::CurveTo:                          return 6;
+            case PathInstruction::SmoothCurveTo:                    return 4;
+            case PathInstruction::QuadraticBelzierCurve:            return 4;
+            case PathInstruction::SmoothQuadraticBelzierCurveTo:    return 2;
+            case PathInstruction::EllipticalArc:                    return 7;
+            case PathInstruction::ClosePath:                        return 0;
+        }
+        assert(false);
+        return 0;
+    }
+
+
+    SVGPathData::SVGPathData()
+    {
+    }
+
+
+    void SVGPathData::clear()
+    {
+        mCommands.clear();
+        mValues.clear();
+    }
+
+
+    void SVGPathData::reserve(size_t inNumCommands, size_t inNumValues)
+    {
+        mCommands.reserve(inNumCommands);
+        mValues.reserve(inNumValues);
+    }
+
+
+    bool SVGPathData::empty() const
+    {
+        return mCommands.empty();
+    }
+
+
+    size_t SVGPathData::numCommands() const
+    {
+        return mCommands.size();
+    }
+
+
+    const SVGPathData::Command & SVGPathData::getCommand(size_t inIdx) const
+    {
+        return mCommands[inIdx];
+    }
+
+
+    const float * SVGPathData::getValues(size_t inIdx) const
+    {
+        const Command & command = mCommands[inIdx];
+        return command.offset < mValues.size() ? &mValues[command.offset] : 0;
+    }
+
+
+    const SVGPathData::Commands & SVGPathData::commands() const
+    {
+        return mCommands;
+    }
+
+
+    const SVGPathData::Values & SVGPathData::values() const
+    {
+        return mValues;
+    }
+
+
+    void SVGPathData::addCommand(PathInstruction::Type inType, PathInstruction::Positioning inPositioning)
+    {
+        Command command;
+        command.type = inType;
+        command.positioning = inPositioning;
+        command.offset = mValues.size();
+        mCommands.push_back(command);
+    }
+
+
+    void SVGPathData::addValue(float inValue)
+    {
+        assert(!mCommands.empty());
+        mValues.push_back(inValue);
+    }
+
+
+    void SVGPathData::removeLastCommand()
+    {
+        assert(!mCommands.empty());
+        mValues.resize(mCommands.back().offset);
+        mCommands.pop_back();
+    }
+
+
+    static bool GetCommandType(char inChar,
+                               PathInstruction::Type & outType,
+                               PathInstruction::Positioning & outPositioning)
+    {
+        switch (inChar | 0x20)
+        {
+            case 'm': outType = PathInstruction::MoveTo; break;
+            case 'l': outType = PathInstruction::LineTo; break;
+            case 'h': outType = PathInstruction::HorizontalLineTo; break;
+            case 'v': outType = PathInstruction::VerticalLineTo; break;
+            case 'c': outType = PathInstruction::CurveTo; break;
+            case 's': outType = PathInstruction::SmoothCurveTo; break;
+            case 'q': outType = PathInstruction::QuadraticBelzierCurve; break;
+            case 't': outType = PathInstruction::SmoothQuadraticBelzierCurveTo; break;
+            case 'a': outType = PathInstruction::EllipticalArc; break;
+            case 'z': outType = PathInstruction::ClosePath; break;
+            default: return false;
+        }
+
+        // Lower case letters are relative, upper case letters absolute.
+        outPositioning = (inChar >= 'a') ? PathInstruction::Relative : PathInstruction::Absolute;
+        return true;
+    }
+
+
+    static bool IsPathWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+
+    static bool IsPathDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+
+    static void SkipWhitespace(const char *& ioPos, const char * inEnd)
+    {
+        while (ioPos != inEnd && IsPathWhitespace(*ioPos))
+        {
+            ++ioPos;
+        }
+    }
+
+
+    // Skips whitespace with at most one comma. Returns true if a comma was skipped.
+    static bool SkipSeparator(const char *& ioPos, const char * inEnd)
+    {
+        SkipWhitespace(ioPos, inEnd);
+        if (ioPos != inEnd && *ioPos == ',')
+        {
+            ++ioPos;
+            SkipWhitespace(ioPos, inEnd);
+            return true;
+        }
+        return false;
+    }
+
+
+    static bool IsNumberStart(char c)
+    {
+        return IsPathDigit(c) || c == '-' || c == '+' || c == '.';
+    }
+
+
+    // Scans the longest prefix that forms a number and converts it. A number
+    // ends where a character appears that can't continue it, so "0.5.5"
+    // yields 0.5 and "1-2" yields 1.
+    static bool ParseNumber(const char *& ioPos, const char * inEnd, float & outValue)
+    {
+        const char * pos = ioPos;
+        if (pos != inEnd && (*pos == '-' || *pos == '+'))
+        {
+            ++pos;
+        }
+
+        const char * digits = pos;
+        while (pos != inEnd && IsPathDigit(*pos))
+        {
+            ++pos;
+        }
+        bool hasDigits = pos != digits;
+
+        if (pos != inEnd && *pos == '.')
+        {
+            ++pos;
+            const char * fraction = pos;
+            while (pos != inEnd && IsPathDigit(*pos))
+            {
+                ++pos;
+            }
+            hasDigits = hasDigits || pos != fraction;
+        }
+
+        if (!hasDigits)
+        {
+            return false;
+        }
+
+        // The exponent only belongs to the number if it has digits.
+        if (pos != inEnd && (*pos == 'e' || *pos == 'E'))
+        {
+            const char * exponent = pos + 1;
+            if (exponent != inEnd && (*exponent == '-' || *exponent == '+'))
+            {
+                ++exponent;
+            }
+            if (exponent != inEnd && IsPathDigit(*exponent))
+            {
+                pos = exponent;
+                while (pos != inEnd && IsPathDigit(*pos))
+                {
+                    ++pos;
+                }
+            }
+        }
+
+        if (!ParseFloat(ioPos, pos, outValue))
+        {
+            return false;
+        }
+        ioPos = pos;
+        return true;
+    }
+
+
+    // The large-arc and sweep flags of an arc are a single '0' or '1' and
+    // don't need a separator from the next number.
+    static bool ParseFlag(const char *& ioPos, const char * inEnd, float & outValue)
+    {
+        if (ioPos != inEnd && (*ioPos == '0' || *ioPos == '1'))
+        {
+            outValue = static_cast<float>(*ioPos++ - '0');
+            return true;
+        }
+        return false;
+    }
+
+
+    static bool ParseSegment(const char *& ioPos,
+                             const char * inEnd,
+                             PathInstruction::Type inType,
+                             PathInstruction::Positioning inPositioning,
+                             SVGPathData & outData)
+    {
+        outData.addCommand(inType, inPositioning);
+        size_t numArguments = SVGPathData::GetNumArguments(inType);
+        for (size_t idx = 0; idx != numArguments; ++idx)
+        {
+            if (idx != 0)
+            {
+                SkipSeparator(ioPos, inEnd);
+            }
+
+            float value = 0;
+            bool isFlag = inType == PathInstruction::EllipticalArc && (idx == 3 || idx == 4);
+            if (!(isFlag ? ParseFlag(ioPos, inEnd, value) : ParseNumber(ioPos, inEnd, value)))
+            {
+                outData.removeLastCommand();
+                return false;
+            }
+            outData.addValue(value);
+        }
+        return true;
+    }
+
+
+    bool ParseSVGPathData(const char * inBegin, const char * inEnd, SVGPathData & outData)
+    {
+        outData.clear();
+
+        // Rough estimate: one argument per four characters.
+        outData.reserve((inEnd - inBegin) / 16, (inEnd - inBegin) / 4);
+
+        const char * pos = inBegin;
+        SkipWhitespace(pos, inEnd);
+
+        PathInstruction::Type type = PathInstruction::MoveTo;
+        PathInstruction::Positioning positioning = PathInstruction::Absolute;
+        while (pos != inEnd)
+        {
+            if (GetCommandType(*pos, type, positioning))
+            {
+                // Path data must start with a moveto.
+                if (outData.empty() && type != PathInstruction::MoveTo)
+                {
+                    return false;
+                }
+
+                ++pos;
+                SkipWhitespace(pos, inEnd);
+                if (type == PathInstruction::ClosePath)
+                {
+                    outData.addCommand(type, positioning);
+                    continue;
+                }
+            }
+            else if (!outData.empty() && type != PathInstruction::ClosePath && IsNumberStart(*pos))
+            {
+                // Implicitly repeated command. Extra pairs after a moveto
+                // are treated as lineto commands.
+                if (type == PathInstruction::MoveTo)
+                {
+                    type = PathInstruction::LineTo;
+                }
+            }
+            else
+            {
+                return false;
+            }
+
+            if (!ParseSegment(pos, inEnd, type, positioning, outData))
+            {
+                return false;
+            }
+
+            // A comma separates numbers, so it can't precede a command or the end.
+            if (SkipSeparator(pos, inEnd) && (pos == inEnd || !IsNumberStart(*pos)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
 } // namespace XULWin
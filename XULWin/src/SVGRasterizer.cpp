@@ -0,0 +1,451 @@
+#include "XULWin/SVGRasterizer.h"
+#include "XULWin/SVGPathGeometry.h"
+#include "XULWin/Compositing.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace XULWin
+{
+
+    static const float cPi = 3.14159265358979f;
+
+
+    // Returns the point on the line through inBegin and inEnd with the given y.
+    static PointF GetPointAtY(const PointF & inBegin, const PointF & inEnd, float inY)
+    {
+        float t = (inY - inBegin.y()) / (inEnd.y() - inBegin.y());
+        return PointF(inBegin.x() + t * (inEnd.x() - inBegin.x()), inY);
+    }
+
+
+    static PointF ClampX(const PointF & inPoint, float inMaxX)
+    {
+        return PointF(std::min<float>(std::max<float>(inPoint.x(), 0), inMaxX), inPoint.y());
+    }
+
+
+    SVGRasterizer::SVGRasterizer(int inWidth, int inHeight) :
+        mWidth(std::max<int>(inWidth, 0)),
+        mHeight(std::max<int>(inHeight, 0)),
+        mPixels(mWidth * mHeight, 0),
+        mTolerance(0.25f),
+        mNumPixelsFilled(0),
+        mBoxWidth(0),
+        mBoxHeight(0)
+    {
+    }
+
+
+    int SVGRasterizer::width() const
+    {
+        return mWidth;
+    }
+
+
+    int SVGRasterizer::height() const
+    {
+        return mHeight;
+    }
+
+
+    const unsigned int * SVGRasterizer::pixels() const
+    {
+        return mPixels.empty() ? 0 : &mPixels[0];
+    }
+
+
+    unsigned int * SVGRasterizer::pixels()
+    {
+        return mPixels.empty() ? 0 : &mPixels[0];
+    }
+
+
+    void SVGRasterizer::clear(const RGBColor & inColor)
+    {
+        std::fill(mPixels.begin(), mPixels.end(), GetPremultipliedColor(inColor));
+    }
+
+
+    void SVGRasterizer::fillPath(const SVGPathGeometry & inGeometry, const RGBColor & inColor)
+    {
+        if (inGeometry.empty() || inColor.alpha() == 0)
+        {
+            return;
+        }
+
+        flatten(inGeometry, mPolygons, mClosed);
+        fillPolygons(mPolygons, inColor);
+    }
+
+
+    void SVGRasterizer::strokePath(const SVGPathGeometry & inGeometry, const RGBColor & inColor, float inWidth)
+    {
+        if (inGeometry.empty() || inColor.alpha() == 0 || inWidth <= 0)
+        {
+            return;
+        }
+
+        flatten(inGeometry, mPolygons, mClosed);
+
+        // The stroke is the union of a rectangle for every segment and a
+        // polygonal circle for every join. All of them are created with the
+        // same orientation, so that the nonzero fill unites them.
+        float halfWidth = inWidth / 2;
+        int numSides = std::max<int>(8, std::min<int>(64, static_cast<int>(std::ceil(cPi * inWidth / 2))));
+        mStrokePolygons.clear();
+        for (size_t idx = 0; idx != mPolygons.size(); ++idx)
+        {
+            const PointFs & polygon = mPolygons[idx];
+            size_t numPoints = polygon.size();
+            size_t numSegments = mClosed[idx] ? numPoints : numPoints - 1;
+            for (size_t segment = 0; segment < numSegments; ++segment)
+            {
+                const PointF & begin = polygon[segment];
+                const PointF & end = polygon[(segment + 1) % numPoints];
+                float dx = end.x() - begin.x();
+                float dy = end.y() - begin.y();
+                float length = std::sqrt(dx * dx + dy * dy);
+                if (length == 0)
+                {
+                    continue;
+                }
+
+                float nx = -dy / length * halfWidth;
+                float ny = dx / length * halfWidth;
+                mStrokePolygons.push_back(PointFs());
+                PointFs & rect = mStrokePolygons.back();
+                rect.push_back(PointF(begin.x() + nx, begin.y() + ny));
+                rect.push_back(PointF(end.x() + nx, end.y() + ny));
+                rect.push_back(PointF(end.x() - nx, end.y() - ny));
+                rect.push_back(PointF(begin.x() - nx, begin.y() - ny));
+            }
+
+            size_t firstJoin = mClosed[idx] ? 0 : 1;
+            size_t lastJoin = mClosed[idx] ? numPoints : numPoints - 1;
+            for (size_t join = firstJoin; join < lastJoin; ++join)
+            {
+                const PointF & center = polygon[join];
+                mStrokePolygons.push_back(PointFs());
+                PointFs & circle = mStrokePolygons.back();
+                for (int side = 0; side != numSides; ++side)
+                {
+                    float angle = -2 * cPi * side / numSides;
+                    circle.push_back(PointF(center.x() + halfWidth * std::cos(angle),
+                                            center.y() + halfWidth * std::sin(angle)));
+                }
+            }
+        }
+        fillPolygons(mStrokePolygons, inColor);
+    }
+
+
+    bool SVGRasterizer::isVisible(const RectF & inRect) const
+    {
+        return inRect.x() < mWidth && inRect.y() < mHeight &&
+               inRect.x() + inRect.width() > 0 && inRect.y() + inRect.height() > 0;
+    }
+
+
+    void SVGRasterizer::setTolerance(float inTolerance)
+    {
+        mTolerance = std::max<float>(inTolerance, 0.01f);
+    }
+
+
+    size_t SVGRasterizer::numPixelsFilled() const
+    {
+        return mNumPixelsFilled;
+    }
+
+
+    unsigned int SVGRasterizer::GetPremultipliedColor(const RGBColor & inColor)
+    {
+        unsigned int alpha = inColor.alpha() & 0xFF;
+        unsigned int red = ((inColor.red() & 0xFF) * alpha + 127) / 255;
+        unsigned int green = ((inColor.green() & 0xFF) * alpha + 127) / 255;
+        unsigned int blue = ((inColor.blue() & 0xFF) * alpha + 127) / 255;
+        return (alpha << 24) | (red << 16) | (green << 8) | blue;
+    }
+
+
+    void SVGRasterizer::flatten(const SVGPathGeometry & inGeometry, Polygons & outPolygons, std::vector<bool> & outClosed) const
+    {
+        const PointFs & points = inGeometry.points();
+        const SVGPathGeometry::PointTypes & pointTypes = inGeometry.pointTypes();
+        const SVGPathGeometry::Figures & figures = inGeometry.figures();
+
+        outPolygons.resize(figures.size());
+        outClosed.resize(figures.size());
+        for (size_t figureIdx = 0; figureIdx != figures.size(); ++figureIdx)
+        {
+            const SVGPathGeometry::Figure & figure = figures[figureIdx];
+            PointFs & polygon = outPolygons[figureIdx];
+            polygon.clear();
+            outClosed[figureIdx] = figure.closed;
+            for (size_t idx = figure.begin; idx < figure.end; ++idx)
+            {
+                if (pointTypes[idx] != SVGPathGeometry::PointType_Bezier)
+                {
+                    polygon.push_back(points[idx]);
+                    continue;
+                }
+
+                // The number of segments follows from the second differences
+                // of the control points, which bound the flattening error.
+                const PointF & p0 = points[idx - 1];
+                const PointF & p1 = points[idx];
+                const PointF & p2 = points[idx + 1];
+                const PointF & p3 = points[idx + 2];
+                float ddx1 = p0.x() - 2 * p1.x() + p2.x();
+                float ddy1 = p0.y() - 2 * p1.y() + p2.y();
+                float ddx2 = p1.x() - 2 * p2.x() + p3.x();
+                float ddy2 = p1.y() - 2 * p2.y() + p3.y();
+                float dd = std::sqrt(std::max<float>(ddx1 * ddx1 + ddy1 * ddy1, ddx2 * ddx2 + ddy2 * ddy2));
+                int numSegments = static_cast<int>(std::ceil(std::sqrt(0.75f * dd / mTolerance)));
+                numSegments = std::min<int>(std::max<int>(numSegments, 1), 256);
+                for (int segment = 1; segment <= numSegments; ++segment)
+                {
+                    float t = static_cast<float>(segment) / numSegments;
+                    float s = 1 - t;
+                    float a = s * s * s;
+                    float b = 3 * s * s * t;
+                    float c = 3 * s * t * t;
+                    float d = t * t * t;
+                    polygon.push_back(PointF(a * p0.x() + b * p1.x() + c * p2.x() + d * p3.x(),
+                                             a * p0.y() + b * p1.y() + c * p2.y() + d * p3.y()));
+                }
+                idx += 2;
+            }
+        }
+    }
+
+
+    void SVGRasterizer::fillPolygons(const Polygons & inPolygons, const RGBColor & inColor)
+    {
+        // Bounding box of the shape, clipped to the buffer.
+        bool hasPoints = false;
+        float minX = 0;
+        float minY = 0;
+        float maxX = 0;
+        float maxY = 0;
+        for (size_t idx = 0; idx != inPolygons.size(); ++idx)
+        {
+            const PointFs & polygon = inPolygons[idx];
+            for (size_t pointIdx = 0; pointIdx != polygon.size(); ++pointIdx)
+            {
+                const PointF & point = polygon[pointIdx];
+                if (!hasPoints)
+                {
+                    minX = maxX = point.x();
+                    minY = maxY = point.y();
+                    hasPoints = true;
+                }
+                minX = std::min<float>(minX, point.x());
+                minY = std::min<float>(minY, point.y());
+                maxX = std::max<float>(maxX, point.x());
+                maxY = std::max<float>(maxY, point.y());
+            }
+        }
+
+        if (!hasPoints)
+        {
+            return;
+        }
+
+        int left = std::max<int>(0, static_cast<int>(std::floor(minX)));
+        int top = std::max<int>(0, static_cast<int>(std::floor(minY)));
+        int right = std::min<int>(mWidth, static_cast<int>(std::ceil(maxX)));
+        int bottom = std::min<int>(mHeight, static_cast<int>(std::ceil(maxY)));
+        if (left >= right || top >= bottom)
+        {
+            return;
+        }
+
+        // Accumulate the signed area of all edges. Every row has two extra
+        // cells for the contributions of edges on the right border.
+        mBoxWidth = right - left;
+        mBoxHeight = bottom - top;
+        size_t stride = mBoxWidth + 2;
+        mAccumulation.assign(stride * mBoxHeight, 0.0f);
+        PointF origin(static_cast<float>(left), static_cast<float>(top));
+        for (size_t idx = 0; idx != inPolygons.size(); ++idx)
+        {
+            const PointFs & polygon = inPolygons[idx];
+            for (size_t pointIdx = 0; pointIdx < polygon.size(); ++pointIdx)
+            {
+                const PointF & begin = polygon[pointIdx];
+                const PointF & end = polygon[(pointIdx + 1) % polygon.size()];
+                addLine(PointF(begin.x() - origin.x(), begin.y() - origin.y()),
+                        PointF(end.x() - origin.x(), end.y() - origin.y()));
+            }
+        }
+
+        // The running sum of a row is the winding number, weighted by the
+        // covered area. Nonzero winding: its absolute value is the coverage.
+        unsigned int color = GetPremultipliedColor(inColor);
+        FillSpanFunction fillSpan = GetCompositingKernels().fillSpan;
+        mCoverage.resize(mBoxWidth);
+        for (int y = 0; y != mBoxHeight; ++y)
+        {
+            const float * cells = &mAccumulation[y * stride];
+            float sum = 0;
+            for (int x = 0; x != mBoxWidth; ++x)
+            {
+                sum += cells[x];
+                float coverage = std::fabs(sum);
+                mCoverage[x] = coverage >= 1 ? 255 : static_cast<unsigned char>(coverage * 255 + 0.5f);
+                if (mCoverage[x] != 0)
+                {
+                    mNumPixelsFilled++;
+                }
+            }
+            fillSpan(&mPixels[(top + y) * mWidth + left], &mCoverage[0], mBoxWidth, color);
+        }
+    }
+
+
+    void SVGRasterizer::addLine(PointF inBegin, PointF inEnd)
+    {
+        // Clip to the rows of the box. Edges above or below it don't
+        // affect the pixels inside.
+        float bottom = static_cast<float>(mBoxHeight);
+        if (inBegin.y() == inEnd.y() ||
+            (inBegin.y() <= 0 && inEnd.y() <= 0) ||
+            (inBegin.y() >= bottom && inEnd.y() >= bottom))
+        {
+            return;
+        }
+
+        if (inBegin.y() < 0)
+        {
+            inBegin = GetPointAtY(inBegin, inEnd, 0);
+        }
+        else if (inBegin.y() > bottom)
+        {
+            inBegin = GetPointAtY(inBegin, inEnd, bottom);
+        }
+
+        if (inEnd.y() < 0)
+        {
+            inEnd = GetPointAtY(inBegin, inEnd, 0);
+        }
+        else if (inEnd.y() > bottom)
+        {
+            inEnd = GetPointAtY(inBegin, inEnd, bottom);
+        }
+
+        // Split at the left and right borders. The parts outside the box are
+        // moved onto the border: they still change the winding number of
+        // the pixels inside.
+        float right = static_cast<float>(mBoxWidth);
+        float splits[2];
+        size_t numSplits = 0;
+        float borders[2] = { 0, right };
+        for (size_t idx = 0; idx != 2; ++idx)
+        {
+            float border = borders[idx];
+            if ((inBegin.x() < border) != (inEnd.x() < border) && inBegin.x() != inEnd.x())
+            {
+                float t = (border - inBegin.x()) / (inEnd.x() - inBegin.x());
+                if (t > 0 && t < 1)
+                {
+                    splits[numSplits++] = t;
+                }
+            }
+        }
+        if (numSplits == 2 && splits[0] > splits[1])
+        {
+            std::swap(splits[0], splits[1]);
+        }
+
+        PointF from = inBegin;
+        for (size_t idx = 0; idx != numSplits; ++idx)
+        {
+            PointF to(inBegin.x() + splits[idx] * (inEnd.x() - inBegin.x()),
+                      inBegin.y() + splits[idx] * (inEnd.y() - inBegin.y()));
+            accumulateLine(ClampX(from, right), ClampX(to, right));
+            from = to;
+        }
+        accumulateLine(ClampX(from, right), ClampX(inEnd, right));
+    }
+
+
+    // Adds the signed area that the line covers to the accumulation buffer.
+    // The line must lie within the box, give or take rounding. Every cell receives the area between
+    // the line and the left border of the next cell, so that the running sum
+    // of a row gives the coverage of each pixel.
+    void SVGRasterizer::accumulateLine(const PointF & inBegin, const PointF & inEnd)
+    {
+        if (inBegin.y() == inEnd.y())
+        {
+            return;
+        }
+
+        float direction = 1;
+        PointF p0 = inBegin;
+        PointF p1 = inEnd;
+        if (p0.y() > p1.y())
+        {
+            direction = -1;
+            std::swap(p0, p1);
+        }
+
+        // Rounding can carry x a little beyond the left or right border, so
+        // it is clamped on every row to stay inside the row of cells.
+        size_t stride = mBoxWidth + 2;
+        float right = static_cast<float>(mBoxWidth);
+        float dxdy = (p1.x() - p0.x()) / (p1.y() - p0.y());
+        float x = std::min<float>(std::max<float>(p0.x(), 0), right);
+        int yBegin = std::max<int>(static_cast<int>(p0.y()), 0);
+        int yEnd = std::min<int>(mBoxHeight, static_cast<int>(std::ceil(p1.y())));
+        for (int y = yBegin; y < yEnd; ++y)
+        {
+            float * cells = &mAccumulation[y * stride];
+            float dy = std::min<float>(static_cast<float>(y + 1), p1.y()) - std::max<float>(static_cast<float>(y), p0.y());
+            float xNext = std::min<float>(std::max<float>(x + dxdy * dy, 0), right);
+            float d = dy * direction;
+
+            float x0 = std::min<float>(x, xNext);
+            float x1 = std::max<float>(x, xNext);
+            float x0Floor = std::floor(x0);
+            float x1Ceil = std::ceil(x1);
+            int x0i = static_cast<int>(x0Floor);
+            int x1i = static_cast<int>(x1Ceil);
+            if (x1i <= x0i + 1)
+            {
+                // The line stays within one pixel on this row.
+                float xmf = 0.5f * (x + xNext) - x0Floor;
+                cells[x0i] += d - d * xmf;
+                cells[x0i + 1] += d * xmf;
+            }
+            else
+            {
+                float s = 1 / (x1 - x0);
+                float x0f = x0 - x0Floor;
+                float a0 = 0.5f * s * (1 - x0f) * (1 - x0f);
+                float x1f = x1 - x1Ceil + 1;
+                float am = 0.5f * s * x1f * x1f;
+                cells[x0i] += d * a0;
+                if (x1i == x0i + 2)
+                {
+                    cells[x0i + 1] += d * (1 - a0 - am);
+                }
+                else
+                {
+                    float a1 = s * (1.5f - x0f);
+                    cells[x0i + 1] += d * (a1 - a0);
+                    for (int xi = x0i + 2; xi < x1i - 1; ++xi)
+                    {
+                        cells[xi] += d * s;
+                    }
+                    float a2 = a1 + (x1i - x0i - 3) * s;
+                    cells[x1i - 1] += d * (1 - a2 - am);
+                }
+                cells[x1i] += d * am;
+            }
+            x = xNext;
+        }
+    }
+
+} // namespace XULWin
@@ -0,0 +1,148 @@
+#include "XULWin/SVGShape.h"
+#include "XULWin/SVGRenderer.h"
+
+
+namespace XULWin
+{
+
+    SVGShape::SVGShape(Type inType) :
+        mType(inType)
+    {
+    }
+
+
+    SVGShape::Type SVGShape::type() const
+    {
+        return mType;
+    }
+
+
+    void SVGShape::setPoints(const Points & inPoints)
+    {
+        mGeometry.buildPolygon(inPoints);
+    }
+
+
+    void SVGShape::setRect(const RectF & inRect)
+    {
+        mGeometry.buildRect(inRect);
+    }
+
+
+    void SVGShape::setPathData(const SVGPathData & inPathData)
+    {
+        mGeometry.build(inPathData);
+    }
+
+
+    const SVGPathGeometry & SVGShape::geometry() const
+    {
+        return mGeometry;
+    }
+
+
+    void SVGShape::paint(const SVGStyleNode & inStyle, SVGRenderer & inRenderer) const
+    {
+        if (mGeometry.empty())
+        {
+            return;
+        }
+
+        switch (mType)
+        {
+            case Type_Polygon:
+            {
+                inRenderer.fillPath(mGeometry, GetCSSFill(inStyle));
+                break;
+            }
+            case Type_Rect:
+            {
+                inRenderer.fillPath(mGeometry, GetFill(inStyle));
+                break;
+            }
+            case Type_Path:
+            {
+                inRenderer.fillPath(mGeometry, GetFill(inStyle));
+                inRenderer.strokePath(mGeometry, GetStroke(inStyle), static_cast<float>(GetStrokeWidth(inStyle)));
+                break;
+            }
+        }
+    }
+
+
+    RectF SVGShape::getPaintBounds(const SVGStyleNode & inStyle) const
+    {
+        const RectF & bounds = mGeometry.bounds();
+        if (mType != Type_Path || mGeometry.empty())
+        {
+            return bounds;
+        }
+
+        // With butt caps and round joins the stroke extends half its width
+        // beyond the path.
+        float strokeWidth = static_cast<float>(GetStrokeWidth(inStyle));
+        if (GetStroke(inStyle).alpha() == 0 || strokeWidth <= 0)
+        {
+            return bounds;
+        }
+        float margin = strokeWidth / 2;
+        return RectF(bounds.x() - margin, bounds.y() - margin, bounds.width() + strokeWidth, bounds.height() + strokeWidth);
+    }
+
+
+    RGBColor SVGShape::GetCSSFill(const SVGStyleNode & inStyle)
+    {
+        RGBColor result;
+        for (const SVGStyleNode * node = &inStyle; node; node = node->SVGStyleNode_parent())
+        {
+            if (node->SVGStyleNode_getCSSFill(result))
+            {
+                return result;
+            }
+        }
+        return RGBColor();
+    }
+
+
+    RGBColor SVGShape::GetFill(const SVGStyleNode & inStyle)
+    {
+        RGBColor result;
+        for (const SVGStyleNode * node = &inStyle; node; node = node->SVGStyleNode_parent())
+        {
+            if (node->SVGStyleNode_getFill(result))
+            {
+                return result;
+            }
+        }
+        return RGBColor(0, 0, 0);
+    }
+
+
+    RGBColor SVGShape::GetStroke(const SVGStyleNode & inStyle)
+    {
+        RGBColor result;
+        for (const SVGStyleNode * node = &inStyle; node; node = node->SVGStyleNode_parent())
+        {
+            if (node->SVGStyleNode_getStroke(result))
+            {
+                return result;
+            }
+        }
+        return RGBColor(0, 0, 0, 0);
+    }
+
+
+    int SVGShape::GetStrokeWidth(const SVGStyleNode & inStyle)
+    {
+        int result = 1;
+        for (const SVGStyleNode * node = &inStyle; node; node = node->SVGStyleNode_parent())
+        {
+            if (node->SVGStyleNode_getStrokeWidth(result))
+            {
+                return result;
+            }
+        }
+        return 1;
+    }
+
+} // namespace XULWin
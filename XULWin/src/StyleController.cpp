@@ -1,12 +1,18 @@
 #include "XULWin/StyleController.h"
 #include "XULWin/Conversions.h"
-#include "Poco/StringTokenizer.h"
+#include "XULWin/StyleDeclarations.h"
 #include <sstream>
 
 
 namespace XULWin
 {
 
+    void StyleController::set(const StyleDeclaration & inDeclaration)
+    {
+        set(inDeclaration.value());
+    }
+
+
     void CSSTextAlignController::get(std::string & outValue)
     {
         outValue = CSSTextAlign2String(getCSSTextAlign());
@@ -15,7 +21,13 @@ namespace XULWin
 
     void CSSTextAlignController::set(const std::string & inValue)
     {
-        setCSSTextAlign(String2CSSTextAlign(inValue, CSSTextAlign_Left));
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSTextAlignController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSTextAlign(inDeclaration.textAlign());
     }
 
 
@@ -27,7 +39,13 @@ namespace XULWin
 
     void CSSXController::set(const std::string & inValue)
     {
-        setCSSX(String2CSSSize(inValue, 0));
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSXController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSX(inDeclaration.size());
     }
 
 
@@ -39,7 +57,13 @@ namespace XULWin
 
     void CSSYController::set(const std::string & inValue)
     {
-        setCSSY(String2CSSSize(inValue, 0));
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSYController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSY(inDeclaration.size());
     }
 
 
@@ -51,7 +75,13 @@ namespace XULWin
 
     void CSSWidthController::set(const std::string & inValue)
     {
-        setCSSWidth(String2CSSSize(inValue, 0));
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSWidthController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSWidth(inDeclaration.size());
     }
 
 
@@ -63,7 +93,13 @@ namespace XULWin
 
     void CSSHeightController::set(const std::string & inValue)
     {
-        setCSSHeight(String2CSSSize(inValue, 0));
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSHeightController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSHeight(inDeclaration.size());
     }
 
 
@@ -83,59 +119,18 @@ namespace XULWin
 
 
     void CSSMarginController::set(const std::string & inValue)
+    {
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSMarginController::set(const StyleDeclaration & inDeclaration)
     {
         int top = 0;
         int left = 0;
-        int bottom = 0;
         int right = 0;
-
-        Poco::StringTokenizer tokenizer(inValue,
-                                        " ",
-                                        Poco::StringTokenizer::TOK_IGNORE_EMPTY
-                                        | Poco::StringTokenizer::TOK_TRIM);
-        Poco::StringTokenizer::Iterator it = tokenizer.begin(), end = tokenizer.end();
-        std::vector<int> values;
-        for (; it != end; ++it)
-        {
-            if (!it->empty())
-            {
-                values.push_back(String2CSSSize(*it, 0));
-            }
-        }
-        if (values.size() == 1)
-        {
-            // One single value applies to all four sides.
-            top = values[0];
-            left = values[0];
-            bottom = values[0];
-            right = values[0];
-        }
-        else if (values.size() == 2)
-        {
-            //Two values apply first to top and bottom, the second one to left and right.
-            top = values[0];
-            bottom = values[0];
-            left = values[1];
-            right = values[1];
-        }
-        else if (values.size() == 3)
-        {
-            //Three values apply first to top, second to left and right and third to bottom.
-            top = values[0];
-            left = values[1];
-            right = values[1];
-            bottom = values[2];
-
-        }
-        else if (values.size() == 4)
-        {
-            // Four values apply to top, right, bottom and left in that order.
-            top = values[0];
-            right = values[1];
-            bottom = values[2];
-            left = values[3];
-
-        }
+        int bottom = 0;
+        inDeclaration.getMargin(top, left, right, bottom);
         setCSSMargin(top, left, right, bottom);
     }
 
@@ -148,10 +143,15 @@ namespace XULWin
 
     void CSSFillController::set(const std::string & inValue)
     {
-        RGBColor result;
-        if (String2RGBColor(inValue, result))
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSFillController::set(const StyleDeclaration & inDeclaration)
+    {
+        if (inDeclaration.hasColor())
         {
-            setCSSFill(result);
+            setCSSFill(inDeclaration.color());
         }
     }
 
@@ -164,10 +164,15 @@ namespace XULWin
 
     void CSSStrokeController::set(const std::string & inValue)
     {
-        RGBColor result;
-        if (String2RGBColor(inValue, result))
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSStrokeController::set(const StyleDeclaration & inDeclaration)
+    {
+        if (inDeclaration.hasColor())
         {
-            setCSSStroke(result);
+            setCSSStroke(inDeclaration.color());
         }
     }
 
@@ -192,9 +197,13 @@ namespace XULWin
 
     void CSSColorController::set(const std::string & inValue)
     {
-        RGBColor rgbColor(0, 0, 0);
-        String2RGBColor(inValue, rgbColor);
-        setCSSColor(rgbColor);
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSColorController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSColor(inDeclaration.color());
     }
 
 
@@ -206,9 +215,13 @@ namespace XULWin
 
     void CSSBackgroundColorController::set(const std::string & inValue)
     {
-        RGBColor rgbColor(0, 0, 0);
-        String2RGBColor(inValue, rgbColor);
-        setCSSBackgroundColor(rgbColor);
+        set(StyleDeclaration(PropertyName(), inValue));
+    }
+
+
+    void CSSBackgroundColorController::set(const StyleDeclaration & inDeclaration)
+    {
+        setCSSBackgroundColor(inDeclaration.color());
     }
 
 
@@ -0,0 +1,326 @@
+#include "XULWin/StyleDeclarations.h"
+#include "XULWin/Conversions.h"
+#include <cctype>
+#include <map>
+
+
+namespace XULWin
+{
+
+    namespace
+    {
+
+        struct PropertyName
+        {
+            const char * name;
+            CSSProperty property;
+        };
+
+        const PropertyName cPropertyNames[] =
+        {
+            { "x", CSSProperty_X },
+            { "y", CSSProperty_Y },
+            { "width", CSSProperty_Width },
+            { "height", CSSProperty_Height },
+            { "margin", CSSProperty_Margin },
+            { "text-align", CSSProperty_TextAlign },
+            { "color", CSSProperty_Color },
+            { "background-color", CSSProperty_BackgroundColor },
+            { "fill", CSSProperty_Fill },
+            { "stroke", CSSProperty_Stroke },
+            { "list-style-image", CSSProperty_ListStyleImage },
+            { "overflow", CSSProperty_Overflow },
+            { "overflow-x", CSSProperty_OverflowX },
+            { "overflow-y", CSSProperty_OverflowY }
+        };
+
+
+        bool IsSpace(char c)
+        {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+
+
+        // Returns the range [inBegin, inEnd) of inText without leading and
+        // trailing whitespace.
+        std::string Trim(const std::string & inText, std::string::size_type inBegin, std::string::size_type inEnd)
+        {
+            while (inBegin < inEnd && IsSpace(inText[inBegin]))
+            {
+                ++inBegin;
+            }
+            while (inEnd > inBegin && IsSpace(inText[inEnd - 1]))
+            {
+                --inEnd;
+            }
+            return inText.substr(inBegin, inEnd - inBegin);
+        }
+
+    }
+
+
+    StyleDeclaration::StyleDeclaration(const std::string & inName, const std::string & inValue) :
+        mName(inName),
+        mValue(inValue),
+        mProperty(GetProperty(inName)),
+        mSize(0),
+        mColor(0, 0, 0),
+        mHasColor(false),
+        mTextAlign(CSSTextAlign_Left),
+        mOverflow(CSSOverflow_Visible)
+    {
+        mMargin[0] = mMargin[1] = mMargin[2] = mMargin[3] = 0;
+
+        switch (mProperty)
+        {
+            case CSSProperty_X:
+            case CSSProperty_Y:
+            case CSSProperty_Width:
+            case CSSProperty_Height:
+            {
+                mSize = String2CSSSize(mValue, 0);
+                break;
+            }
+            case CSSProperty_Margin:
+            {
+                parseMargin();
+                break;
+            }
+            case CSSProperty_TextAlign:
+            {
+                mTextAlign = String2CSSTextAlign(mValue, CSSTextAlign_Left);
+                break;
+            }
+            case CSSProperty_Color:
+            case CSSProperty_BackgroundColor:
+            case CSSProperty_Fill:
+            case CSSProperty_Stroke:
+            {
+                mHasColor = String2RGBColor(mValue, mColor);
+                break;
+            }
+            case CSSProperty_Overflow:
+            case CSSProperty_OverflowX:
+            case CSSProperty_OverflowY:
+            {
+                mOverflow = String2CSSOverflow(mValue, CSSOverflow_Visible);
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+
+    void StyleDeclaration::parseMargin()
+    {
+        std::vector<int> values;
+        std::string::size_type begin = 0;
+        while (begin < mValue.size())
+        {
+            while (begin < mValue.size() && IsSpace(mValue[begin]))
+            {
+                ++begin;
+            }
+            std::string::size_type end = begin;
+            while (end < mValue.size() && !IsSpace(mValue[end]))
+            {
+                ++end;
+            }
+            if (end > begin)
+            {
+                values.push_back(String2CSSSize(mValue.substr(begin, end - begin), 0));
+            }
+            begin = end;
+        }
+
+        int & top = mMargin[0];
+        int & left = mMargin[1];
+        int & right = mMargin[2];
+        int & bottom = mMargin[3];
+        if (values.size() == 1)
+        {
+            // One single value applies to all four sides.
+            top = left = right = bottom = values[0];
+        }
+        else if (values.size() == 2)
+        {
+            // Two values apply first to top and bottom, the second one to left and right.
+            top = bottom = values[0];
+            left = right = values[1];
+        }
+        else if (values.size() == 3)
+        {
+            // Three values apply first to top, second to left and right and third to bottom.
+            top = values[0];
+            left = right = values[1];
+            bottom = values[2];
+        }
+        else if (values.size() == 4)
+        {
+            // Four values apply to top, right, bottom and left in that order.
+            top = values[0];
+            right = values[1];
+            bottom = values[2];
+            left = values[3];
+        }
+    }
+
+
+    const std::string & StyleDeclaration::name() const
+    {
+        return mName;
+    }
+
+
+    const std::string & StyleDeclaration::value() const
+    {
+        return mValue;
+    }
+
+
+    CSSProperty StyleDeclaration::property() const
+    {
+        return mProperty;
+    }
+
+
+    int StyleDeclaration::size() const
+    {
+        return mSize;
+    }
+
+
+    void StyleDeclaration::getMargin(int & outTop, int & outLeft, int & outRight, int & outBottom) const
+    {
+        outTop = mMargin[0];
+        outLeft = mMargin[1];
+        outRight = mMargin[2];
+        outBottom = mMargin[3];
+    }
+
+
+    const RGBColor & StyleDeclaration::color() const
+    {
+        return mColor;
+    }
+
+
+    bool StyleDeclaration::hasColor() const
+    {
+        return mHasColor;
+    }
+
+
+    CSSTextAlign StyleDeclaration::textAlign() const
+    {
+        return mTextAlign;
+    }
+
+
+    CSSOverflow StyleDeclaration::overflow() const
+    {
+        return mOverflow;
+    }
+
+
+    CSSProperty StyleDeclaration::GetProperty(const std::string & inName)
+    {
+        for (size_t idx = 0; idx != sizeof(cPropertyNames) / sizeof(cPropertyNames[0]); ++idx)
+        {
+            if (inName == cPropertyNames[idx].name)
+            {
+                return cPropertyNames[idx].property;
+            }
+        }
+        return CSSProperty_Unknown;
+    }
+
+
+    StyleDeclarations::StyleDeclarations(const std::string & inStyle)
+    {
+        // Split "key:value;key:value". Names and values are trimmed,
+        // declarations without a name or a value are skipped.
+        std::string::size_type begin = 0;
+        while (begin < inStyle.size())
+        {
+            std::string::size_type end = inStyle.find(';', begin);
+            if (end == std::string::npos)
+            {
+                end = inStyle.size();
+            }
+
+            std::string::size_type sep = inStyle.find(':', begin);
+            if (sep < end)
+            {
+                std::string name = Trim(inStyle, begin, sep);
+                std::string value = Trim(inStyle, sep + 1, end);
+                if (!name.empty() && !value.empty())
+                {
+                    mDeclarations.push_back(StyleDeclaration(name, value));
+                }
+            }
+            begin = end + 1;
+        }
+    }
+
+
+    const StyleDeclarations & StyleDeclarations::Get(const std::string & inStyle)
+    {
+        // The entries are never removed, so references to them stay valid.
+        typedef std::map<std::string, StyleDeclarations> Cache;
+        static Cache fCache;
+        Cache::iterator it = fCache.find(inStyle);
+        if (it == fCache.end())
+        {
+            it = fCache.insert(std::make_pair(inStyle, StyleDeclarations(inStyle))).first;
+        }
+        return it->second;
+    }
+
+
+    const StyleDeclarations & StyleDeclarations::Get(const AttributesMapping & inAttributes)
+    {
+        static const StyleDeclarations fEmpty("");
+        AttributesMapping::const_iterator it = inAttributes.find("style");
+        if (it == inAttributes.end())
+        {
+            return fEmpty;
+        }
+        return Get(it->second);
+    }
+
+
+    size_t StyleDeclarations::size() const
+    {
+        return mDeclarations.size();
+    }
+
+
+    bool StyleDeclarations::empty() const
+    {
+        return mDeclarations.empty();
+    }
+
+
+    const StyleDeclaration & StyleDeclarations::get(size_t inIndex) const
+    {
+        return mDeclarations[inIndex];
+    }
+
+
+    const StyleDeclaration * StyleDeclarations::find(CSSProperty inProperty) const
+    {
+        for (size_t idx = mDeclarations.size(); idx != 0; --idx)
+        {
+            if (mDeclarations[idx - 1].property() == inProperty)
+            {
+                return &mDeclarations[idx - 1];
+            }
+        }
+        return 0;
+    }
+
+} // namespace XULWin
@@ -0,0 +1,39 @@
+#include "XULWin/TextMetrics.h"
+
+
+namespace XULWin
+{
+
+    FixedTextMetrics::FixedTextMetrics(int inCharWidth, int inLineHeight) :
+        mCharWidth(inCharWidth),
+        mLineHeight(inLineHeight)
+    {
+    }
+
+
+    Size FixedTextMetrics::getTextSize(const std::string & inText) const
+    {
+        int numLines = 1;
+        int maxLineLength = 0;
+        int lineLength = 0;
+        for (size_t idx = 0; idx != inText.size(); ++idx)
+        {
+            unsigned char c = static_cast<unsigned char>(inText[idx]);
+            if (c == '\n')
+            {
+                numLines++;
+                lineLength = 0;
+            }
+            else if ((c & 0xC0) != 0x80) // skip UTF-8 continuation bytes
+            {
+                lineLength++;
+                if (lineLength > maxLineLength)
+                {
+                    maxLineLength = lineLength;
+                }
+            }
+        }
+        return Size(maxLineLength * mCharWidth, numLines * mLineHeight);
+    }
+
+} // namespace XULWin
@@ -4,6 +4,7 @@
 #include "XULWin/Defaults.h"
 #include "XULWin/Element.h"
 #include "XULWin/Gdiplus.h"
+#include "XULWin/LayoutTransaction.h"
 #include "XULWin/Menu.h"
 #include "XULWin/Unicode.h"
 
@@ -63,6 +64,8 @@ namespace XULWin
 
     void Toolbar::rebuildLayout()
     {
+        // The toolbar buttons are laid out using the current size of the toolbar window.
+        LayoutTransaction::Flush();
         mToolbar->rebuildLayout();
     }
 
@@ -221,6 +224,7 @@ namespace XULWin
             mButton->setText(inLabel);
         }
         mLabel = inLabel;
+        invalidateSizeCache();
     }
 
 
@@ -256,6 +260,7 @@ namespace XULWin
             mButton->setImage(img);
         }
         mCSSListStyleImage = inURL;
+        invalidateSizeCache();
     }
 
 
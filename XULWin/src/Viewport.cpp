@@ -0,0 +1,157 @@
+#include "XULWin/Viewport.h"
+#include <algorithm>
+
+
+namespace XULWin
+{
+
+    // Number of items that are measured for the first estimate.
+    static const size_t cEstimateSampleSize = 10;
+
+
+    VirtualItems::VirtualItems() :
+        mNumMeasured(0)
+    {
+    }
+
+
+    void VirtualItems::reset(size_t inItemCount)
+    {
+        mMeasured.assign(inItemCount, false);
+        mNumMeasured = 0;
+    }
+
+
+    size_t VirtualItems::size() const
+    {
+        return mMeasured.size();
+    }
+
+
+    bool VirtualItems::isMeasured(size_t idx) const
+    {
+        return mMeasured[idx];
+    }
+
+
+    bool VirtualItems::setMeasured(size_t idx)
+    {
+        if (mMeasured[idx])
+        {
+            return false;
+        }
+        mMeasured[idx] = true;
+        mNumMeasured++;
+        return true;
+    }
+
+
+    size_t VirtualItems::numMeasured() const
+    {
+        return mNumMeasured;
+    }
+
+
+    bool VirtualItems::measureSample()
+    {
+        if (mNumMeasured != 0)
+        {
+            return false;
+        }
+
+        size_t sampleSize = std::min<size_t>(mMeasured.size(), cEstimateSampleSize);
+        for (size_t idx = 0; idx != sampleSize; ++idx)
+        {
+            setMeasured(idx);
+        }
+        return sampleSize != 0;
+    }
+
+
+    bool VirtualItems::measureRange(const Measurer & inMeasurer, int inStart, int inLength)
+    {
+        bool result = measureSample();
+
+        std::vector<int> sizes;
+        getSizes(inMeasurer, Preferred, sizes);
+
+        int measureStart = inStart - inLength;
+        int measureEnd = inStart + 2 * inLength;
+        int position = 0;
+        for (size_t idx = 0; idx != sizes.size() && position < measureEnd; ++idx)
+        {
+            int size = sizes[idx];
+            if (!mMeasured[idx] && position + size > measureStart)
+            {
+                setMeasured(idx);
+                size = inMeasurer.VirtualItems_getSize(idx, Preferred);
+                result = true;
+            }
+            position += size;
+        }
+        return result;
+    }
+
+
+    void VirtualItems::getSizes(const Measurer & inMeasurer,
+                                SizeConstraint inSizeConstraint,
+                                std::vector<int> & outSizes) const
+    {
+        outSizes.assign(mMeasured.size(), 0);
+        int total = 0;
+        for (size_t idx = 0; idx != mMeasured.size(); ++idx)
+        {
+            if (mMeasured[idx])
+            {
+                outSizes[idx] = inMeasurer.VirtualItems_getSize(idx, inSizeConstraint);
+                total += outSizes[idx];
+            }
+        }
+
+        if (mNumMeasured == 0 || mNumMeasured == mMeasured.size())
+        {
+            return;
+        }
+
+        int estimate = total / static_cast<int>(mNumMeasured);
+        for (size_t idx = 0; idx != mMeasured.size(); ++idx)
+        {
+            if (!mMeasured[idx])
+            {
+                outSizes[idx] = estimate;
+            }
+        }
+    }
+
+
+    int VirtualItems::getTotalSize(const Measurer & inMeasurer, SizeConstraint inSizeConstraint) const
+    {
+        std::vector<int> sizes;
+        getSizes(inMeasurer, inSizeConstraint, sizes);
+        int result = 0;
+        for (size_t idx = 0; idx != sizes.size(); ++idx)
+        {
+            result += sizes[idx];
+        }
+        return result;
+    }
+
+
+    Rect ScrollRect(const Rect & inRect, const Point & inScrollOffset)
+    {
+        return Rect(inRect.x() - inScrollOffset.x(),
+                    inRect.y() - inScrollOffset.y(),
+                    inRect.width(),
+                    inRect.height());
+    }
+
+
+    bool Intersects(const Rect & inRect, const Rect & inOtherRect)
+    {
+        return inRect.x() < inOtherRect.x() + inOtherRect.width()
+            && inOtherRect.x() < inRect.x() + inRect.width()
+            && inRect.y() < inOtherRect.y() + inOtherRect.height()
+            && inOtherRect.y() < inRect.y() + inRect.height();
+    }
+
+} // namespace XULWin
@@ -152,7 +152,7 @@ namespace XULWin
 
     void Window::BoxLayouter_rebuildChildLayouts()
     {
-        rebuildChildLayouts();
+        rebuildInvalidatedChildLayouts();
     }
 
 
@@ -184,11 +184,31 @@ namespace XULWin
     }
 
 
+    void Window::invalidateLayout()
+    {
+        bool scheduled = needsLayout();
+        Super::invalidateLayout();
+        if (!scheduled)
+        {
+            ::PostMessage(handle(), WM_XULWIN_UPDATELAYOUT, 0, 0);
+        }
+    }
+
+
     void Window::rebuildLayout()
     {
+        // Moving the children invalidates our layout. Mark it invalid up
+        // front so that this doesn't schedule another layout pass.
+        mNeedsLayout = true;
         mBoxLayouter->rebuildLayout();
     }
 
+    void Window::onChildRemoved(Component * inChild)
+    {
+        mBoxLayouter->onChildRemoved();
+        Super::onChildRemoved(inChild);
+    }
+
 
     std::string Window::getTitle() const
     {
@@ -314,6 +334,12 @@ namespace XULWin
                 invalidateRect();
                 return 0;
             }
+            case WM_XULWIN_UPDATELAYOUT:
+            {
+                updateLayout();
+                invalidateRect();
+                return 0;
+            }
             case WM_CLOSE:
             {
                 close();
@@ -6,12 +6,26 @@
 namespace XULWin
 {
 
-    class Script : public PhonyComponent 
+    class Script : public PhonyComponent,
+                   public StringValueController
     {
     public:
         typedef PhonyComponent Super;
 
         Script(Component * inParent, const AttributesMapping & inAttr);
+
+        virtual bool initAttributeControllers();
+
+        virtual std::string getValue() const;
+
+        virtual void setValue(const std::string & inValue);
+
+        boost::shared_ptr<const std::string> script() const;
+
+        void setScript(const boost::shared_ptr<const std::string> & inScript);
+
+    private:
+        boost::shared_ptr<const std::string> mScript;
     };
 
 
@@ -25,14 +39,59 @@ namespace XULWin
 
     bool XMLScript::init()
     {
-        setAttribute("value", innerText());
+        // Share the body instead of copying it into the value attribute.
+        if (Script * script = component()->downcast<Script>())
+        {
+            script->setScript(sharedInnerText());
+        }
         return Element::init();
     }
 
 
+    boost::shared_ptr<const std::string> XMLScript::script() const
+    {
+        if (const Script * script = component()->downcast<Script>())
+        {
+            return script->script();
+        }
+        return boost::shared_ptr<const std::string>();
+    }
+
+
     Script::Script(Component * inParent, const AttributesMapping & inAttr) :
         PhonyComponent(inParent, inAttr)
     {
     }
 
+
+    bool Script::initAttributeControllers()
+    {
+        setAttributeController<StringValueController>(this);
+        return Super::initAttributeControllers();
+    }
+
+
+    std::string Script::getValue() const
+    {
+        return mScript ? *mScript : std::string();
+    }
+
+
+    void Script::setValue(const std::string & inValue)
+    {
+        mScript.reset(new std::string(inValue));
+    }
+
+
+    boost::shared_ptr<const std::string> Script::script() const
+    {
+        return mScript;
+    }
+
+
+    void Script::setScript(const boost::shared_ptr<const std::string> & inScript)
+    {
+        mScript = inScript;
+    }
+
 } // namespace XULWin
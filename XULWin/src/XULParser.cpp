@@ -1,6 +1,7 @@
 #include "XULWin/XULParser.h"
 #include "XULWin/ElementFactory.h"
 #include "XULWin/ChromeURL.h"
+#include "XULWin/CompiledXUL.h"
 #include "XULWin/Defaults.h"
 #include "XULWin/ErrorReporter.h"
 #include "Poco/SAX/Attributes.h"
@@ -12,7 +13,10 @@ namespace XULWin
 
     AbstractXULParser::AbstractXULParser() :
         mIgnores(0),
-        mLanguage("en")
+        mLanguage("en"),
+        mTextDepth(0),
+        mSharedTextThreshold(4096),
+        mCompiledXUL(0)
     {
         setFeature(FEATURE_EXTERNAL_GENERAL_ENTITIES, true);
         setFeature(FEATURE_EXTERNAL_PARAMETER_ENTITIES, true);
@@ -28,6 +32,18 @@ namespace XULWin
     }
 
 
+    void AbstractXULParser::setSharedTextThreshold(size_t inNumBytes)
+    {
+        mSharedTextThreshold = inNumBytes;
+    }
+
+
+    void AbstractXULParser::setCompiledXUL(CompiledXUL * inCompiledXUL)
+    {
+        mCompiledXUL = inCompiledXUL;
+    }
+
+
     void AbstractXULParser::setDocumentLocator(const Poco::XML::Locator * inLocator)
     {
         mLocator = inLocator;
@@ -49,6 +65,8 @@ namespace XULWin
     void AbstractXULParser::getAttributes(const Poco::XML::Attributes & inXMLAttributes,
                                           AttributesMapping & outXULAttributes)
     {
+        outXULAttributes.clear();
+        outXULAttributes.reserve(inXMLAttributes.getLength());
         for (int idx = 0; idx != inXMLAttributes.getLength(); ++idx)
         {
             const Poco::XML::XMLString & name = inXMLAttributes.getLocalName(idx);
@@ -72,11 +90,15 @@ namespace XULWin
             }
 
             Element * parent = getCurrentParentElement();
-            AttributesMapping attr;
-            getAttributes(attributes, attr);
+            getAttributes(attributes, mAttributes);
             ElementPtr element;
-            if (createElement(localName, parent, attr, element))
+            if (createElement(localName, parent, mAttributes, element))
             {
+                if (mCompiledXUL)
+                {
+                    mCompiledXUL->startElement(localName, mAttributes);
+                }
+                pushTextBuffer();
                 pushStack(element);
             }
             else
@@ -88,6 +110,10 @@ namespace XULWin
         }
         catch (const Poco::Exception & inExc)
         {
+            if (mCompiledXUL)
+            {
+                mCompiledXUL->setInvalid();
+            }
             ReportError(inExc.displayText());
         }
     }
@@ -102,17 +128,66 @@ namespace XULWin
             mIgnores--;
             return;
         }
+        popTextBuffer();
         popStack();
+        if (mCompiledXUL)
+        {
+            mCompiledXUL->endElement();
+        }
     }
 
 
     void AbstractXULParser::characters(const Poco::XML::XMLChar ch[], int start, int length)
     {
-        if (!mStack.empty() && mStack.top())
+        // Text is collected per element and committed in endElement. Text
+        // inside ignored elements goes to the nearest created ancestor.
+        if (mTextDepth > 0)
+        {
+            mTextBuffers[mTextDepth - 1].append(ch + start, length);
+        }
+    }
+
+
+    void AbstractXULParser::pushTextBuffer()
+    {
+        if (mTextDepth == mTextBuffers.size())
         {
-            std::string innerText = std::string(ch + start, length);
-            mStack.top()->setInnerText(mStack.top()->innerText() + innerText);
+            mTextBuffers.push_back(std::string());
         }
+        mTextBuffers[mTextDepth++].clear();
+    }
+
+
+    void AbstractXULParser::popTextBuffer()
+    {
+        assert(mTextDepth > 0);
+        if (mTextDepth == 0)
+        {
+            return;
+        }
+
+        std::string & text = mTextBuffers[--mTextDepth];
+        Element * element = mStack.empty() ? 0 : mStack.top();
+        if (element && !text.empty())
+        {
+            if (mCompiledXUL)
+            {
+                mCompiledXUL->setInnerText(text);
+            }
+
+            if (text.size() >= mSharedTextThreshold)
+            {
+                // Hand over the buffer itself.
+                boost::shared_ptr<std::string> sharedText(new std::string);
+                sharedText->swap(text);
+                element->setInnerText(boost::shared_ptr<const std::string>(sharedText));
+            }
+            else
+            {
+                element->setInnerText(text);
+            }
+        }
+        text.clear();
     }
 
 
@@ -125,6 +200,10 @@ namespace XULWin
             {
                 ChromeURL url(systemId);
                 std::string path = url.convertToLocalPath();
+                if (mCompiledXUL)
+                {
+                    mCompiledXUL->addDependency(path);
+                }
                 Poco::XML::EntityResolverImpl entityResolverImpl;
                 return entityResolverImpl.resolveEntity(publicId, path);
             }
@@ -133,6 +212,12 @@ namespace XULWin
         {
             ReportError(inExc.displayText());
         }
+
+        // Entities that are not resolved here can't be tracked.
+        if (mCompiledXUL)
+        {
+            mCompiledXUL->setInvalid();
+        }
         return 0;
     }
 
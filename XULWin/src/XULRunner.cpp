@@ -1,5 +1,6 @@
 #include "XULWin/XULRunner.h"
 #include "XULWin/ChromeURL.h"
+#include "XULWin/CompiledXUL.h"
 #include "XULWin/Defaults.h"
 #include "XULWin/ErrorReporter.h"
 #include "XULWin/XULOverlayParser.h"
@@ -10,6 +11,7 @@
 #include "Poco/Path.h"
 #include "Poco/String.h"
 #include <boost/noncopyable.hpp>
+#include <map>
 
 
 namespace XULWin
@@ -140,6 +142,7 @@ namespace XULWin
 
     Fallible<std::string> XULRunner::sLocale;
     HMODULE XULRunner::sModuleHandle(0);
+    bool XULRunner::sCompiledXULEnabled(false);
 
 
     XULRunner::XULRunner()
@@ -182,6 +185,18 @@ namespace XULWin
     }
 
 
+    void XULRunner::SetCompiledXULEnabled(bool inEnabled)
+    {
+        sCompiledXULEnabled = inEnabled;
+    }
+
+
+    bool XULRunner::IsCompiledXULEnabled()
+    {
+        return sCompiledXULEnabled;
+    }
+
+
     HICON XULRunner::GetDefaultIcon(const std::string & inAppDir,
                                     const std::string & inWindowId,
                                     const std::string & inExtension)
@@ -229,17 +244,62 @@ namespace XULWin
 
     void XULRunner::run(const std::string & inApplicationIniFile)
     {
-        XULParser parser;
         Poco::Path topLevelAppDir = WinAPI::System_GetCurrentDirectory();
         std::string mainXULFile = getMainXULFile(topLevelAppDir);
-        parser.parse(mainXULFile);
-        if (XMLWindow * window = parser.rootElement()->downcast<XMLWindow>())
+        ElementPtr rootElement = LoadFile(mainXULFile);
+        if (XMLWindow * window = rootElement->downcast<XMLWindow>())
         {
             window->showModal(WindowPos_CenterInScreen);
         }
     }
 
 
+    ElementPtr XULRunner::LoadFile(const std::string & inXULFile)
+    {
+        if (!sCompiledXULEnabled)
+        {
+            XULParser parser;
+            return ParseFile(parser, inXULFile);
+        }
+
+        std::string compiledFile = CompiledXUL::GetCompiledPath(inXULFile);
+        try
+        {
+            CompiledXUL compiledXUL;
+            if (compiledXUL.load(compiledFile, GetLocale()))
+            {
+                if (ElementPtr result = compiledXUL.createElements())
+                {
+                    if (compiledXUL.needsSave())
+                    {
+                        compiledXUL.save(compiledFile);
+                    }
+                    return result;
+                }
+            }
+        }
+        catch (const std::exception &)
+        {
+            // The compiled file is only a cache. Whatever is wrong with it,
+            // parsing the XUL file will replace it.
+        }
+
+        CompiledXUL compiledXUL;
+        compiledXUL.setLocale(GetLocale());
+        compiledXUL.addDependency(inXULFile);
+
+        XULParser parser;
+        parser.setCompiledXUL(&compiledXUL);
+        ElementPtr result = ParseFile(parser, inXULFile);
+        if (result)
+        {
+            // Failing to write the cache is not an error, we will just parse again next time.
+            compiledXUL.save(compiledFile);
+        }
+        return result;
+    }
+
+
     ElementPtr XULRunner::ParseFile(AbstractXULParser & inParser, const std::string & inXULFile)
     {
         if (!Poco::File(inXULFile).exists())
@@ -269,17 +329,15 @@ namespace XULWin
             throw std::runtime_error(msg.c_str());
         }
 
-        XULParser parser;
-        mRootElement = ParseFile(parser, getMainXULFile(WinAPI::System_GetCurrentDirectory()));
+        mRootElement = LoadFile(getMainXULFile(WinAPI::System_GetCurrentDirectory()));
         return mRootElement;
     }
 
 
     ElementPtr XULRunner::loadXULFromFile(const std::string & inXULURL)
     {
-        XULParser parser;
         ChromeURL url(inXULURL);
-        mRootElement = ParseFile(parser, url.convertToLocalPath());
+        mRootElement = LoadFile(url.convertToLocalPath());
         return mRootElement;
     }
 